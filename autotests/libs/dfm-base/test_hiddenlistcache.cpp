@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_hiddenlistcache.cpp - HiddenListCache unit tests
+
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <dfm-base/utils/hiddenlistcache.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+using namespace dfmbase;
+
+class HiddenListCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        HiddenListCache::instance().clear();
+        ASSERT_TRUE(QDir().mkpath(tempDir.filePath("a/b/c")));
+    }
+
+    // write a .hidden file with an mtime old enough to be cached
+    void writeHidden(const QString &dir, const QByteArray &content)
+    {
+        const QString path = tempDir.filePath(dir + "/.hidden");
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(content);
+        file.close();
+
+        struct timespec times[2];
+        clock_gettime(CLOCK_REALTIME, &times[0]);
+        times[0].tv_sec -= 60;
+        times[1] = times[0];
+        ASSERT_EQ(::utimensat(AT_FDCWD, QFile::encodeName(path).constData(), times, 0), 0);
+    }
+
+    QTemporaryDir tempDir;
+    HiddenListCache &cache { HiddenListCache::instance() };
+};
+
+TEST_F(HiddenListCacheTest, HiddenNames_ParsedAndShared)
+{
+    writeHidden("a", "b\nfoo\n\nbar");
+
+    const auto names = cache.hiddenNames(tempDir.filePath("a"));
+    EXPECT_EQ(*names, QSet<QString>({ "b", "foo", "bar" }));
+    EXPECT_EQ(cache.hiddenNames(tempDir.filePath("a/")), names);
+    EXPECT_TRUE(cache.isHidden(tempDir.filePath("a"), "foo"));
+    EXPECT_FALSE(cache.isHidden(tempDir.filePath("a"), "baz"));
+}
+
+TEST_F(HiddenListCacheTest, HiddenNames_MissingFile_Empty)
+{
+    EXPECT_TRUE(cache.hiddenNames(tempDir.filePath("a/b"))->isEmpty());
+    EXPECT_TRUE(cache.hiddenNames(tempDir.filePath("nodir"))->isEmpty());
+}
+
+TEST_F(HiddenListCacheTest, Invalidate_RereadsChangedFile)
+{
+    writeHidden("a", "foo");
+    const auto before = cache.hiddenNames(tempDir.filePath("a"));
+    EXPECT_TRUE(before->contains("foo"));
+
+    writeHidden("a", "bar");
+    cache.invalidate(tempDir.filePath("a"));
+    const auto after = cache.hiddenNames(tempDir.filePath("a"));
+    EXPECT_TRUE(after->contains("bar"));
+    EXPECT_FALSE(after->contains("foo"));
+    // the set handed out before is left untouched
+    EXPECT_TRUE(before->contains("foo"));
+}
+
+TEST_F(HiddenListCacheTest, IsHiddenBelow_ChecksAncestorsUpToRoot)
+{
+    writeHidden("a", "b");
+
+    const QString file = tempDir.filePath("a/b/c/file.txt");
+    EXPECT_TRUE(cache.isHiddenBelow(file, tempDir.path()));
+    EXPECT_TRUE(cache.isHiddenBelow(tempDir.filePath("a/b"), tempDir.path()));
+    // the root itself and paths outside it are never hidden by it
+    EXPECT_FALSE(cache.isHiddenBelow(file, tempDir.filePath("a/b")));
+    EXPECT_FALSE(cache.isHiddenBelow(tempDir.path(), tempDir.path()));
+    EXPECT_FALSE(cache.isHiddenBelow("relative/file", tempDir.path()));
+
+    EXPECT_TRUE(cache.isHiddenBelow(tempDir.filePath("x/.dot/file"), tempDir.path()));
+    EXPECT_FALSE(cache.isHiddenBelow(tempDir.filePath("x/y/file"), tempDir.path()));
+}
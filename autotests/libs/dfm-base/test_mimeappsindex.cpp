@@ -0,0 +1,222 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_mimeappsindex.cpp - MimeAppsIndex unit tests
+
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <dfm-base/mimetype/mimeappsindex.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+using namespace dfmbase;
+
+class MimeAppsIndexTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        ASSERT_TRUE(QDir().mkpath(tempDir.filePath("apps/sub")));
+        cacheFile = tempDir.filePath("cache/MimeAppsIndex.cache");
+        folders = QStringList { tempDir.filePath("apps") };
+        ddeFile = tempDir.filePath("dde-mimetype.list");
+    }
+
+    // set an mtime old enough to be trusted by the index
+    void age(const QString &path)
+    {
+        struct timespec times[2];
+        clock_gettime(CLOCK_REALTIME, &times[0]);
+        times[0].tv_sec -= 60;
+        times[1] = times[0];
+        ASSERT_EQ(::utimensat(AT_FDCWD, QFile::encodeName(path).constData(), times, 0), 0);
+    }
+
+    void writeDesktop(const QString &relPath, const QString &name, const QString &mimeTypes)
+    {
+        const QString path = tempDir.filePath("apps/" + relPath);
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QString("[Desktop Entry]\nType=Application\nName=%1\nExec=%1 %U\nMimeType=%2\n")
+                           .arg(name, mimeTypes)
+                           .toUtf8());
+        file.close();
+        age(path);
+        age(QFileInfo(path).absolutePath());
+    }
+
+    QString appPath(const QString &relPath) const { return tempDir.filePath("apps/" + relPath); }
+
+    QTemporaryDir tempDir;
+    QString cacheFile;
+    QStringList folders;
+    QString ddeFile;
+};
+
+TEST_F(MimeAppsIndexTest, Refresh_IndexesDesktopFilesByMimeType)
+{
+    writeDesktop("a.desktop", "A", "text/plain;image/png;");
+    writeDesktop("sub/b.desktop", "B", "text/plain;");
+
+    MimeAppsIndex index(cacheFile, folders, ddeFile);
+    EXPECT_TRUE(index.refresh());
+    EXPECT_FALSE(index.statistics().loaded);
+    EXPECT_EQ(index.statistics().filesParsed, 2);
+
+    EXPECT_EQ(index.desktopFiles().keys(), QStringList({ appPath("a.desktop"), appPath("sub/b.desktop") }));
+    EXPECT_EQ(index.appsForMimeType("image/png"), QStringList({ appPath("a.desktop") }));
+    EXPECT_EQ(index.appsForMimeType("text/plain").size(), 2);
+
+    DesktopFile desktop;
+    ASSERT_TRUE(index.desktopFile(appPath("sub/b.desktop"), &desktop));
+    EXPECT_EQ(desktop.desktopName(), QString("B"));
+}
+
+TEST_F(MimeAppsIndexTest, Refresh_UnchangedFolders_NothingParsed)
+{
+    writeDesktop("a.desktop", "A", "text/plain;");
+
+    MimeAppsIndex index(cacheFile, folders, ddeFile);
+    index.refresh();
+    const quint64 generation = index.generation();
+
+    EXPECT_FALSE(index.refresh());
+    EXPECT_EQ(index.statistics().dirsScanned, 0);
+    EXPECT_EQ(index.statistics().filesParsed, 0);
+    EXPECT_EQ(index.generation(), generation);
+}
+
+TEST_F(MimeAppsIndexTest, Load_SecondInstance_ServedFromCache)
+{
+    writeDesktop("a.desktop", "A", "text/plain;");
+    writeDesktop("sub/b.desktop", "B", "image/png;");
+    {
+        MimeAppsIndex index(cacheFile, folders, ddeFile);
+        index.refresh();
+    }
+    ASSERT_TRUE(QFile::exists(cacheFile));
+
+    MimeAppsIndex index(cacheFile, folders, ddeFile);
+    EXPECT_FALSE(index.refresh());
+    EXPECT_TRUE(index.statistics().loaded);
+    EXPECT_EQ(index.statistics().filesParsed, 0);
+    EXPECT_EQ(index.appsForMimeType("image/png"), QStringList({ appPath("sub/b.desktop") }));
+    EXPECT_GT(index.generation(), 0u);
+}
+
+TEST_F(MimeAppsIndexTest, Load_OtherFolders_CacheDiscarded)
+{
+    writeDesktop("a.desktop", "A", "text/plain;");
+    {
+        MimeAppsIndex index(cacheFile, folders, ddeFile);
+        index.refresh();
+    }
+
+    MimeAppsIndex index(cacheFile, { tempDir.filePath("apps/sub") }, ddeFile);
+    index.refresh();
+    EXPECT_FALSE(index.statistics().loaded);
+    EXPECT_TRUE(index.appsForMimeType("text/plain").isEmpty());
+}
+
+TEST_F(MimeAppsIndexTest, Invalidate_ChangedFile_OnlyItIsParsed)
+{
+    writeDesktop("a.desktop", "A", "text/plain;");
+    writeDesktop("b.desktop", "B", "text/plain;");
+
+    MimeAppsIndex index(cacheFile, folders, ddeFile);
+    index.refresh();
+    const quint64 generation = index.generation();
+
+    // an edit in place leaves the folder mtime as it is
+    const QString folderPath = tempDir.filePath("apps");
+    struct stat before;
+    ASSERT_EQ(::stat(QFile::encodeName(folderPath).constData(), &before), 0);
+    writeDesktop("b.desktop", "B", "text/plain;image/png;");
+    struct timespec times[2] = { before.st_atim, before.st_mtim };
+    ASSERT_EQ(::utimensat(AT_FDCWD, QFile::encodeName(folderPath).constData(), times, 0), 0);
+
+    index.invalidate(appPath("b.desktop"));
+    EXPECT_TRUE(index.refresh());
+    EXPECT_EQ(index.statistics().filesParsed, 1);
+    EXPECT_EQ(index.statistics().dirsScanned, 0);
+    EXPECT_EQ(index.appsForMimeType("image/png"), QStringList({ appPath("b.desktop") }));
+    EXPECT_GT(index.generation(), generation);
+}
+
+TEST_F(MimeAppsIndexTest, Refresh_AddedAndRemovedFiles_Followed)
+{
+    writeDesktop("a.desktop", "A", "text/plain;");
+    writeDesktop("sub/b.desktop", "B", "text/plain;");
+
+    MimeAppsIndex index(cacheFile, folders, ddeFile);
+    index.refresh();
+
+    writeDesktop("c.desktop", "C", "image/png;");
+    ASSERT_TRUE(QFile::remove(appPath("sub/b.desktop")));
+    age(tempDir.filePath("apps/sub"));
+
+    EXPECT_TRUE(index.refresh());
+    EXPECT_EQ(index.statistics().filesParsed, 1);
+    EXPECT_EQ(index.appsForMimeType("text/plain"), QStringList({ appPath("a.desktop") }));
+    EXPECT_EQ(index.appsForMimeType("image/png"), QStringList({ appPath("c.desktop") }));
+
+    ASSERT_TRUE(QDir(tempDir.filePath("apps/sub")).removeRecursively());
+    age(tempDir.filePath("apps"));
+    index.refresh();
+    EXPECT_FALSE(index.desktopFiles().contains(appPath("sub/b.desktop")));
+}
+
+TEST_F(MimeAppsIndexTest, Refresh_HiddenAndDDEMimeTypes)
+{
+    writeDesktop("a.desktop", "A", "text/plain;");
+    const QString hidden = appPath("h.desktop");
+    QFile file(hidden);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("[Desktop Entry]\nType=Application\nName=H\nExec=h\nMimeType=text/plain;\nHidden=true\n");
+    file.close();
+    age(hidden);
+    age(tempDir.filePath("apps"));
+
+    QFile dde(ddeFile);
+    ASSERT_TRUE(dde.open(QIODevice::WriteOnly));
+    dde.write("[a.desktop]\nMimeType=application/x-dde;\n");
+    dde.close();
+    age(ddeFile);
+
+    MimeAppsIndex index(cacheFile, folders, ddeFile);
+    index.refresh();
+    EXPECT_EQ(index.appsForMimeType("text/plain"), QStringList({ appPath("a.desktop") }));
+    EXPECT_EQ(index.appsForMimeType("application/x-dde"), QStringList({ appPath("a.desktop") }));
+    EXPECT_FALSE(index.desktopFiles().contains(hidden));
+    EXPECT_TRUE(index.ddeMimeTypes().contains("a.desktop"));
+}
+
+TEST_F(MimeAppsIndexTest, Load_FileEditedInPlace_ParsedAgain)
+{
+    writeDesktop("a.desktop", "A", "text/plain;");
+    writeDesktop("b.desktop", "B", "text/plain;");
+    {
+        MimeAppsIndex index(cacheFile, folders, ddeFile);
+        index.refresh();
+    }
+
+    // edited while no index watched it, the folder mtime stays the same
+    const QString folderPath = tempDir.filePath("apps");
+    struct stat before;
+    ASSERT_EQ(::stat(QFile::encodeName(folderPath).constData(), &before), 0);
+    writeDesktop("b.desktop", "B", "text/plain;image/png;");
+    struct timespec times[2] = { before.st_atim, before.st_mtim };
+    ASSERT_EQ(::utimensat(AT_FDCWD, QFile::encodeName(folderPath).constData(), times, 0), 0);
+
+    MimeAppsIndex index(cacheFile, folders, ddeFile);
+    EXPECT_TRUE(index.refresh());
+    EXPECT_TRUE(index.statistics().loaded);
+    EXPECT_EQ(index.statistics().filesParsed, 1);
+    EXPECT_EQ(index.appsForMimeType("image/png"), QStringList({ appPath("b.desktop") }));
+}
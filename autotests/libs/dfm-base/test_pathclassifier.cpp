@@ -0,0 +1,198 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_pathclassifier.cpp - PathClassifier unit tests and lookup microbenchmark
+
+#include <gtest/gtest.h>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QMap>
+
+#include <dfm-base/utils/pathclassifier.h>
+#include <dfm-base/base/device/deviceutils.h>
+
+using namespace dfmbase;
+
+namespace {
+
+// the checks PathClassifier replaces, kept as the reference behaviour
+bool legacyMatch(const QString &txt, const QString &rex)
+{
+    QRegularExpression re(rex);
+    return re.match(txt).hasMatch();
+}
+
+PathClassifier::PathTypes legacyClassify(const QString &filePath,
+                                         const QMap<QString, QString> &allMounts,
+                                         const QMap<QString, QString> &externalMounts)
+{
+    PathClassifier::PathTypes types { PathClassifier::kNone };
+    if (legacyMatch(filePath, R"((^/run/user/\d+/gvfs/|^/root/.gvfs/|^/(?:run/)?media/[\s\S]*/smbmounts))"))
+        types |= PathClassifier::kRemote;
+    if (legacyMatch(filePath, R"(^/run/user/\d+/gvfs/mtp:host|^/root/.gvfs/mtp:host)"))
+        types |= PathClassifier::kMTP;
+    if (legacyMatch(filePath, R"(^/run/user/\d+/gvfs/gphoto2:host|^/root/.gvfs/gphoto2:host)"))
+        types |= PathClassifier::kGphoto;
+    if (legacyMatch(filePath, R"((^/run/user/\d+/gvfs/s?ftp|^/root/.gvfs/s?ftp))"))
+        types |= PathClassifier::kFTP;
+    if (legacyMatch(filePath, R"((^/run/user/\d+/gvfs/sftp|^/root/.gvfs/sftp))"))
+        types |= PathClassifier::kSFTP;
+    if (legacyMatch(filePath, R"((^/run/user/\d+/gvfs/smb|^/root/.gvfs/smb|^/(?:run/)?media/[\s\S]*/smbmounts))"))
+        types |= PathClassifier::kSMB;
+    if (legacyMatch(filePath, R"((^/run/user/\d+/gvfs/nfs|^/root/.gvfs/nfs))"))
+        types |= PathClassifier::kNFS;
+    if (legacyMatch(filePath, R"((^/run/user/\d+/gvfs/dav.*ssl=false|^/root/.gvfs/dav.*ssl=false))"))
+        types |= PathClassifier::kDav;
+    if (legacyMatch(filePath, R"((^/run/user/\d+/gvfs/dav.*ssl=true|^/root/.gvfs/dav.*ssl=true))"))
+        types |= PathClassifier::kDavs;
+
+    const QString path = filePath.endsWith("/") ? filePath : filePath + "/";
+    for (auto it = allMounts.cbegin(); it != allMounts.cend(); ++it) {
+        if (!path.startsWith(it.value()))
+            continue;
+        if (!it.key().startsWith(kBlockDeviceIdPrefix))
+            types |= PathClassifier::kProtocolMount;
+        else if (it.key().startsWith(QString(kBlockDeviceIdPrefix) + "sr"))
+            types |= PathClassifier::kOpticalMount;
+    }
+    for (auto it = externalMounts.cbegin(); it != externalMounts.cend(); ++it) {
+        if (!path.startsWith(it.value()))
+            continue;
+        types |= PathClassifier::kExternalMount;
+        if (it.key().startsWith(kBlockDeviceIdPrefix))
+            types |= PathClassifier::kExternalBlockMount;
+    }
+    return types;
+}
+
+}   // namespace
+
+class PathClassifierTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        const QString block(kBlockDeviceIdPrefix);
+        allMounts.insert(block + "nvme0n1p2", "/");
+        allMounts.insert(block + "nvme0n1p3", "/data/");
+        allMounts.insert(block + "sr0", "/media/user/CDROM/");
+        allMounts.insert(block + "sdb1", "/media/user/USB/");
+        allMounts.insert("smb://host/share/", "/media/user/smbmounts/share/");
+        externalMounts.insert(block + "sdb1", "/media/user/USB/");
+        externalMounts.insert(block + "sr0", "/media/user/CDROM/");
+        externalMounts.insert("smb://host/share/", "/media/user/smbmounts/share/");
+        classifier.setMounts(allMounts, externalMounts);
+    }
+
+    // a mix of plain, gvfs, mounted and look-alike paths
+    QStringList samplePaths() const
+    {
+        return {
+            "/home/user/Documents/a.txt",
+            "/data/projects/x",
+            "/media/user/USB",
+            "/media/user/USB/dir/file",
+            "/media/user/USB2/file",
+            "/media/user/CDROM/disc.iso",
+            "/media/user/smbmounts/share/doc",
+            "/run/media/user/x/smbmounts",
+            "/run/user/1000/gvfs/mtp:host=phone/Internal",
+            "/run/user/1000/gvfs/gphoto2:host=cam/DCIM",
+            "/run/user/1000/gvfs/ftp:host=srv/pub",
+            "/run/user/1000/gvfs/sftp:host=srv/home",
+            "/run/user/1000/gvfs/smb-share:server=srv,share=s/a",
+            "/run/user/1000/gvfs/nfs:host=srv,prefix=/x",
+            "/run/user/1000/gvfs/dav:host=srv,ssl=false/x",
+            "/run/user/1000/gvfs/dav:host=srv,ssl=true/x",
+            "/run/user/1000/gvfs/",
+            "/run/user/abc/gvfs/smb-share:server=x",
+            "/run/user//gvfs/smb-share:server=x",
+            "/root/.gvfs/sftp:host=srv",
+            "/runner/user/1000/gvfs/mtp:host",
+            "",
+        };
+    }
+
+    QMap<QString, QString> allMounts;
+    QMap<QString, QString> externalMounts;
+    PathClassifier classifier;
+};
+
+TEST_F(PathClassifierTest, Classify_MatchesLegacyChecks)
+{
+    for (const QString &path : samplePaths())
+        EXPECT_EQ(int(classifier.classify(path)), int(legacyClassify(path, allMounts, externalMounts))) << path.toStdString();
+}
+
+TEST_F(PathClassifierTest, Classify_GvfsTypes)
+{
+    EXPECT_TRUE(PathClassifier::classifyGvfsPath("/run/user/1000/gvfs/mtp:host=phone").testFlag(PathClassifier::kMTP));
+    EXPECT_TRUE(PathClassifier::classifyGvfsPath("/run/user/1000/gvfs/sftp:host=srv").testFlag(PathClassifier::kFTP));
+    EXPECT_TRUE(PathClassifier::classifyGvfsPath("/run/user/1000/gvfs/sftp:host=srv").testFlag(PathClassifier::kSFTP));
+    EXPECT_FALSE(PathClassifier::classifyGvfsPath("/run/user/1000/gvfs/ftp:host=srv").testFlag(PathClassifier::kSFTP));
+    EXPECT_EQ(PathClassifier::classifyGvfsPath("/home/user"), PathClassifier::PathTypes(PathClassifier::kNone));
+}
+
+TEST_F(PathClassifierTest, SetMounts_ReplacesTrie)
+{
+    EXPECT_TRUE(classifier.classifyMountPath("/media/user/USB/a").testFlag(PathClassifier::kExternalBlockMount));
+
+    allMounts.remove(QString(kBlockDeviceIdPrefix) + "sdb1");
+    externalMounts.remove(QString(kBlockDeviceIdPrefix) + "sdb1");
+    classifier.setMounts(allMounts, externalMounts);
+
+    EXPECT_FALSE(classifier.classifyMountPath("/media/user/USB/a").testFlag(PathClassifier::kExternalBlockMount));
+    EXPECT_TRUE(classifier.classifyMountPath("/media/user/CDROM/a").testFlag(PathClassifier::kOpticalMount));
+}
+
+// microbenchmark: synthetic paths against a synthetic mount table, the legacy checks as baseline
+TEST_F(PathClassifierTest, Benchmark_LookupAgainstLegacy)
+{
+    const QString block(kBlockDeviceIdPrefix);
+    for (int i = 0; i < 64; ++i) {
+        allMounts.insert(block + QString("sdx%1").arg(i), QString("/media/user/disk%1/").arg(i));
+        externalMounts.insert(block + QString("sdx%1").arg(i), QString("/media/user/disk%1/").arg(i));
+        allMounts.insert(QString("sftp://host%1/").arg(i), QString("/run/user/1000/gvfs/sftp:host=host%1/").arg(i));
+    }
+    classifier.setMounts(allMounts, externalMounts);
+
+    QStringList paths;
+    for (int i = 0; i < 2000; ++i) {
+        switch (i % 4) {
+        case 0:
+            paths << QString("/home/user/project/src/module%1/file%2.cpp").arg(i % 37).arg(i);
+            break;
+        case 1:
+            paths << QString("/media/user/disk%1/photos/%2.jpg").arg(i % 80).arg(i);
+            break;
+        case 2:
+            paths << QString("/run/user/1000/gvfs/sftp:host=host%1/home/%2").arg(i % 70).arg(i);
+            break;
+        default:
+            paths << QString("/run/user/1000/gvfs/mtp:host=phone/DCIM/%1.jpg").arg(i);
+            break;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int legacyHits = 0;
+    for (const QString &path : std::as_const(paths))
+        legacyHits += legacyClassify(path, allMounts, externalMounts) != PathClassifier::kNone;
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    timer.restart();
+    int hits = 0;
+    for (const QString &path : std::as_const(paths))
+        hits += classifier.classify(path) != PathClassifier::kNone;
+    const qint64 classifierNs = timer.nsecsElapsed();
+
+    for (const QString &path : std::as_const(paths))
+        ASSERT_EQ(int(classifier.classify(path)), int(legacyClassify(path, allMounts, externalMounts))) << path.toStdString();
+
+    EXPECT_EQ(hits, legacyHits);
+    std::cout << "[ BENCH    ] " << paths.size() << " paths, " << allMounts.size() << " mounts: legacy "
+              << legacyNs / paths.size() << " ns/path, classifier " << classifierNs / paths.size() << " ns/path" << std::endl;
+}
@@ -0,0 +1,242 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_symlinkhintcache.cpp - SymlinkHintCache unit tests and syscall count benchmark
+
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <dfm-base/utils/symlinkhintcache.h>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/ptrace.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <functional>
+#include <iostream>
+
+using namespace dfmbase;
+
+namespace {
+// syscalls made by body, counted by tracing it in a forked child; -1 if the child can not be traced
+qint64 countSyscalls(const std::function<void()> &body)
+{
+    const pid_t pid = fork();
+    if (pid < 0)
+        return -1;
+    if (pid == 0) {
+        if (ptrace(PTRACE_TRACEME, 0, nullptr, nullptr) != 0)
+            _exit(1);
+        raise(SIGSTOP);
+        body();
+        _exit(0);
+    }
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFSTOPPED(status))
+        return -1;
+    ptrace(PTRACE_SETOPTIONS, pid, nullptr, PTRACE_O_TRACESYSGOOD | PTRACE_O_EXITKILL);
+
+    // a syscall stops once on entry and once on exit, exit_group only on entry
+    qint64 stops = 0;
+    int signal = 0;
+    forever {
+        if (ptrace(PTRACE_SYSCALL, pid, nullptr, signal) != 0 || waitpid(pid, &status, 0) != pid)
+            return -1;
+        if (WIFEXITED(status))
+            return WEXITSTATUS(status) == 0 ? (stops + 1) / 2 : -1;
+        if (WIFSIGNALED(status))
+            return -1;
+
+        signal = 0;
+        if (WSTOPSIG(status) == (SIGTRAP | 0x80))
+            ++stops;
+        else
+            signal = WSTOPSIG(status);
+    }
+}
+}   // namespace
+
+class SymlinkHintCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        cache.clear();
+    }
+
+    void touch(const QString &name)
+    {
+        int fd = ::open(QFile::encodeName(tempDir.filePath(name)).constData(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+    }
+
+    void link(const QString &target, const QString &name)
+    {
+        ASSERT_EQ(::symlink(QFile::encodeName(target).constData(), QFile::encodeName(tempDir.filePath(name)).constData()), 0);
+    }
+
+    QTemporaryDir tempDir;
+    SymlinkHintCache &cache { SymlinkHintCache::instance() };
+};
+
+TEST_F(SymlinkHintCacheTest, Hint_FromDirectoryListing)
+{
+    touch("file.txt");
+    QDir().mkpath(tempDir.filePath("dir"));
+    link(tempDir.filePath("file.txt"), "link.txt");
+    link("/run/user/1000/gvfs/smb-share:server=srv,share=s", "remote");
+
+    EXPECT_EQ(cache.hint(tempDir.filePath("file.txt")), SymlinkHintCache::Hint::kNotSymlink);
+    EXPECT_EQ(cache.hint(tempDir.filePath("dir")), SymlinkHintCache::Hint::kNotSymlink);
+    EXPECT_EQ(cache.hint(tempDir.filePath("link.txt")), SymlinkHintCache::Hint::kSymlink);
+    EXPECT_EQ(cache.hint(tempDir.filePath("remote")), SymlinkHintCache::Hint::kSymlink);
+    EXPECT_EQ(cache.hint(tempDir.filePath("missing")), SymlinkHintCache::Hint::kUnknown);
+}
+
+TEST_F(SymlinkHintCacheTest, Hint_UnlistableDirectory_Unknown)
+{
+    EXPECT_EQ(cache.hint(tempDir.filePath("nodir/a.txt")), SymlinkHintCache::Hint::kUnknown);
+    EXPECT_EQ(cache.hint("relative"), SymlinkHintCache::Hint::kUnknown);
+}
+
+TEST_F(SymlinkHintCacheTest, Invalidate_SeesNewSymlink)
+{
+    touch("file.txt");
+    EXPECT_EQ(cache.hint(tempDir.filePath("file.txt")), SymlinkHintCache::Hint::kNotSymlink);
+
+    ASSERT_TRUE(QFile::remove(tempDir.filePath("file.txt")));
+    link(tempDir.filePath("other"), "file.txt");
+    cache.invalidate(tempDir.path());
+    EXPECT_EQ(cache.hint(tempDir.filePath("file.txt")), SymlinkHintCache::Hint::kSymlink);
+}
+
+TEST_F(SymlinkHintCacheTest, Hint_NameNewerThanListing_Unknown)
+{
+    touch("file.txt");
+    EXPECT_EQ(cache.hint(tempDir.filePath("file.txt")), SymlinkHintCache::Hint::kNotSymlink);
+
+    // still inside the trusted window, the file itself is asked
+    link(tempDir.filePath("file.txt"), "later");
+    EXPECT_EQ(cache.hint(tempDir.filePath("later")), SymlinkHintCache::Hint::kUnknown);
+}
+
+TEST_F(SymlinkHintCacheTest, SetListing_UsedWithoutReading)
+{
+    // names the directory does not hold, so a read of it would not know them
+    cache.setListing(tempDir.path(), { "a", "b" }, { "b" });
+    EXPECT_EQ(cache.hint(tempDir.filePath("a")), SymlinkHintCache::Hint::kNotSymlink);
+    EXPECT_EQ(cache.hint(tempDir.filePath("b")), SymlinkHintCache::Hint::kSymlink);
+    EXPECT_EQ(cache.hint(tempDir.filePath("c")), SymlinkHintCache::Hint::kUnknown);
+}
+
+TEST_F(SymlinkHintCacheTest, Store_EvictsLeastRecentlyUsed)
+{
+    constexpr int kDirCount { 64 };
+    for (int i = 0; i <= kDirCount * 2; ++i)
+        ASSERT_TRUE(QDir().mkpath(tempDir.filePath(QString("d%1").arg(i))));
+    auto listDir = [this](int i) {
+        cache.hint(tempDir.filePath(QString("d%1/file").arg(i)));
+    };
+
+    cache.setListing(tempDir.filePath("d0"), { "fake" }, { "fake" });
+    for (int i = 1; i < kDirCount; ++i)
+        listDir(i);
+
+    // the used listing stays, the oldest other one goes
+    EXPECT_EQ(cache.hint(tempDir.filePath("d0/fake")), SymlinkHintCache::Hint::kSymlink);
+    listDir(kDirCount);
+    EXPECT_EQ(cache.hint(tempDir.filePath("d0/fake")), SymlinkHintCache::Hint::kSymlink);
+
+    for (int i = kDirCount + 1; i <= kDirCount * 2; ++i)
+        listDir(i);
+    EXPECT_EQ(cache.hint(tempDir.filePath("d0/fake")), SymlinkHintCache::Hint::kUnknown);
+}
+
+TEST_F(SymlinkHintCacheTest, Hint_ManyFiles_OnlySymlinksReported)
+{
+    constexpr int kFileCount { 2000 };
+    constexpr int kLinkEvery { 100 };
+
+    for (int i = 0; i < kFileCount; ++i) {
+        const QString name = QString("f%1").arg(i);
+        if (i % kLinkEvery == 0)
+            link(tempDir.filePath("f1"), name);
+        else
+            touch(name);
+    }
+
+    int links = 0;
+    for (int i = 0; i < kFileCount; ++i) {
+        const auto hint = cache.hint(tempDir.filePath(QString("f%1").arg(i)));
+        EXPECT_NE(hint, SymlinkHintCache::Hint::kUnknown);
+        links += hint == SymlinkHintCache::Hint::kSymlink;
+    }
+    EXPECT_EQ(links, kFileCount / kLinkEvery);
+}
+
+// benchmark: syscalls needed to resolve the scheme of every file of a 100k file directory,
+// one lstat per create (the least the DFileInfo probe did) as baseline
+TEST_F(SymlinkHintCacheTest, Benchmark_SyscallsPerCreate)
+{
+    constexpr int kFileCount { 100000 };
+    constexpr int kLinkEvery { 1000 };
+
+    QStringList paths;
+    paths.reserve(kFileCount);
+    for (int i = 0; i < kFileCount; ++i) {
+        const QString name = QString("f%1").arg(i);
+        if (i % kLinkEvery == 0)
+            link(tempDir.filePath("f1"), name);
+        else
+            touch(name);
+        paths << tempDir.filePath(name);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int legacyLinks = 0;
+    for (const QString &path : std::as_const(paths)) {
+        struct stat st;
+        if (lstat(QFile::encodeName(path).constData(), &st) == 0 && S_ISLNK(st.st_mode))
+            ++legacyLinks;
+    }
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    cache.clear();
+    timer.restart();
+    int links = 0;
+    for (const QString &path : std::as_const(paths))
+        links += cache.hint(path) == SymlinkHintCache::Hint::kSymlink;
+    const qint64 cacheNs = timer.nsecsElapsed();
+
+    EXPECT_EQ(links, legacyLinks);
+    EXPECT_EQ(links, kFileCount / kLinkEvery);
+
+    // the same lookups on a cold cache, minus what the traced child costs by itself
+    auto lookups = [this, &paths]() {
+        cache.clear();
+        for (const QString &path : std::as_const(paths))
+            cache.hint(path);
+    };
+    const qint64 traced = countSyscalls(lookups);
+    const qint64 idle = countSyscalls([]() {});
+    if (traced < 0 || idle < 0)
+        GTEST_SKIP() << "can not trace a child process";
+
+    const double perCreate = double(traced - idle) / kFileCount;
+    EXPECT_LT(perCreate, 0.01);
+
+    std::cout << "[ BENCH    ] " << kFileCount << " files: lstat probe 1 syscall/create, " << legacyNs / kFileCount
+              << " ns/create; cache " << perCreate << " syscalls/create, " << cacheNs / kFileCount
+              << " ns/create" << std::endl;
+}
@@ -300,4 +300,53 @@ TEST_F(DFMExtEmblemIconPluginTest, Compatibility)
     
     DFMExtEmblem emblem = plugin->locationEmblemIcons(testPath, 2);
     EXPECT_TRUE(true); // 基本功能测试
-} 
\ No newline at end of file
+} 
+/**
+ * @brief 测试locationEmblemIconsBatch未注册批量回调时的回退
+ * 验证逐个调用locationEmblemIcons，结果与文件一一对应
+ */
+TEST_F(DFMExtEmblemIconPluginTest, LocationEmblemIconsBatch_FallbackToSingle)
+{
+    std::vector<std::string> queried;
+    plugin->registerLocationEmblemIcons([&queried](const std::string &filePath, int iconCount) {
+        queried.push_back(filePath);
+        DFMExtEmblem emblem;
+        emblem.setEmblem({ DFMExtEmblemIconLayout(DFMExtEmblemIconLayout::LocationType::BottomLeft, filePath + std::to_string(iconCount)) });
+        return emblem;
+    });
+
+    auto emblems = plugin->locationEmblemIconsBatch("/home/test", { "/home/test/a", "/home/test/b" }, { 1, 2 });
+
+    ASSERT_EQ(emblems.size(), 2u);
+    EXPECT_EQ(queried.size(), 2u);
+    EXPECT_EQ(emblems[0].emblems().at(0).iconPath(), "/home/test/a1");
+    EXPECT_EQ(emblems[1].emblems().at(0).iconPath(), "/home/test/b2");
+}
+
+/**
+ * @brief 测试registerLocationEmblemIconsBatch方法
+ * 验证批量回调只调用一次，返回数量与文件数不一致时按文件数补齐
+ */
+TEST_F(DFMExtEmblemIconPluginTest, RegisterLocationEmblemIconsBatch)
+{
+    int batchCallCount = 0;
+    bool singleCalled = false;
+    plugin->registerLocationEmblemIcons([&singleCalled](const std::string &, int) {
+        singleCalled = true;
+        return DFMExtEmblem();
+    });
+    plugin->registerLocationEmblemIconsBatch([&batchCallCount](const std::string &dirPath,
+                                                              const std::vector<std::string> &filePaths,
+                                                              const std::vector<int> &counts) {
+        ++batchCallCount;
+        EXPECT_EQ(dirPath, "/home/test");
+        EXPECT_EQ(filePaths.size(), counts.size());
+        return std::vector<DFMExtEmblem>(1);
+    });
+
+    auto emblems = plugin->locationEmblemIconsBatch("/home/test", { "/home/test/a", "/home/test/b", "/home/test/c" }, { 0, 0, 0 });
+
+    EXPECT_EQ(batchCallCount, 1);
+    EXPECT_FALSE(singleCalled);
+    EXPECT_EQ(emblems.size(), 3u);
+}
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_imagedecoder.cpp - ImageDecoder unit tests and decode benchmark
+
+#include <gtest/gtest.h>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QImage>
+#include <QImageWriter>
+#include <QPainter>
+#include <QTemporaryDir>
+#include <QTimer>
+
+#include "imagedecoder.h"
+
+#include <iostream>
+
+using namespace plugin_filepreview;
+
+namespace {
+
+constexpr int kSourceWidth { 8000 };
+constexpr int kSourceHeight { 6000 };
+const QSize kBoxSize { 1344, 756 };   // 70% of a 1920x1080 screen
+
+}   // namespace
+
+class ImageDecoderTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tempDir = new QTemporaryDir;
+        ASSERT_TRUE(tempDir->isValid());
+
+        QImage image(kSourceWidth, kSourceHeight, QImage::Format_RGB32);
+        QPainter painter(&image);
+        QLinearGradient gradient(0, 0, kSourceWidth, kSourceHeight);
+        gradient.setColorAt(0, Qt::darkBlue);
+        gradient.setColorAt(1, Qt::yellow);
+        painter.fillRect(image.rect(), gradient);
+        painter.end();
+
+        if (QImageWriter::supportedImageFormats().contains("jpeg"))
+            image.save(tempDir->filePath("large.jpg"), "jpeg", 90);
+        image.save(tempDir->filePath("large.png"), "png");
+        image.scaled(16, 12).save(tempDir->filePath("small.png"), "png");
+    }
+
+    static void TearDownTestSuite()
+    {
+        delete tempDir;
+        tempDir = nullptr;
+    }
+
+    static QString sample(const QString &name)
+    {
+        const QString &path = tempDir->filePath(name);
+        return QFile::exists(path) ? path : QString();
+    }
+
+    // full size decode and scale on the calling thread, as the previewer did before
+    static QImage legacyDecode(const QString &fileName, const QSize &boxSize)
+    {
+        const QImage image(fileName);
+        return image.scaled(ImageDecoder::fittedSize(image.size(), boxSize), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+    static void benchmark(const QString &fileName, const char *label)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        const QImage &legacy = legacyDecode(fileName, kBoxSize);
+        const qint64 legacyMs = timer.elapsed();
+
+        timer.restart();
+        const DecodedImage &decoded = ImageDecoder::decode(fileName, QByteArray(), kBoxSize);
+        const qint64 scaledMs = timer.elapsed();
+
+        EXPECT_EQ(decoded.image.size(), legacy.size());
+        std::cout << "[ BENCH    ] " << label << " " << kSourceWidth << "x" << kSourceHeight << " -> "
+                  << decoded.image.width() << "x" << decoded.image.height() << ": full decode + scale "
+                  << legacyMs << " ms, scaled decode " << scaledMs << " ms" << std::endl;
+    }
+
+    static QTemporaryDir *tempDir;
+};
+
+QTemporaryDir *ImageDecoderTest::tempDir = nullptr;
+
+TEST_F(ImageDecoderTest, FittedSize_ScalesDownOnly)
+{
+    EXPECT_EQ(ImageDecoder::fittedSize(QSize(8000, 6000), QSize(1344, 756)), QSize(1008, 756));
+    EXPECT_EQ(ImageDecoder::fittedSize(QSize(6000, 8000), QSize(1344, 756)), QSize(567, 756));
+    EXPECT_EQ(ImageDecoder::fittedSize(QSize(640, 480), QSize(1344, 756)), QSize(640, 480));
+    EXPECT_EQ(ImageDecoder::fittedSize(QSize(640, 480), QSize()), QSize(640, 480));
+}
+
+TEST_F(ImageDecoderTest, Decode_Png_FittedToBox)
+{
+    const QString &fileName = sample("large.png");
+    ASSERT_FALSE(fileName.isEmpty());
+
+    const DecodedImage &decoded = ImageDecoder::decode(fileName, "png", kBoxSize);
+    EXPECT_EQ(decoded.sourceSize, QSize(kSourceWidth, kSourceHeight));
+    EXPECT_EQ(decoded.image.size(), QSize(1008, 756));
+    EXPECT_EQ(decoded.boxSize, kBoxSize);
+}
+
+TEST_F(ImageDecoderTest, Decode_Jpeg_FittedToBox)
+{
+    const QString &fileName = sample("large.jpg");
+    if (fileName.isEmpty())
+        GTEST_SKIP() << "no jpeg image plugin";
+
+    const DecodedImage &decoded = ImageDecoder::decode(fileName, QByteArray(), kBoxSize);
+    EXPECT_EQ(decoded.sourceSize, QSize(kSourceWidth, kSourceHeight));
+    EXPECT_EQ(decoded.image.size(), QSize(1008, 756));
+}
+
+TEST_F(ImageDecoderTest, Decode_MissingFile_NullImage)
+{
+    const DecodedImage &decoded = ImageDecoder::decode(tempDir->filePath("missing.png"), QByteArray(), kBoxSize);
+    EXPECT_TRUE(decoded.image.isNull());
+}
+
+TEST_F(ImageDecoderTest, Prefetch_CachesForSameBox)
+{
+    const QString &fileName = sample("large.png");
+    ASSERT_FALSE(fileName.isEmpty());
+
+    ImageDecoder decoder;
+    QEventLoop loop;
+    QObject::connect(&decoder, &ImageDecoder::imageDecoded, &loop, &QEventLoop::quit);
+    QTimer::singleShot(30000, &loop, &QEventLoop::quit);
+    decoder.prefetch({ fileName }, kBoxSize);
+    loop.exec();
+
+    DecodedImage decoded;
+    ASSERT_TRUE(decoder.cachedImage(fileName, kBoxSize, &decoded));
+    EXPECT_EQ(decoded.image.size(), QSize(1008, 756));
+    EXPECT_FALSE(decoder.cachedImage(fileName, QSize(800, 600), &decoded));
+
+    decoder.keepOnly({});
+    EXPECT_FALSE(decoder.cachedImage(fileName, kBoxSize, &decoded));
+}
+
+TEST_F(ImageDecoderTest, KeepOnly_DropsRunningDecode)
+{
+    const QString &fileName = sample("small.png");
+    ASSERT_FALSE(fileName.isEmpty());
+
+    ImageDecoder decoder;
+    int decodedCount = 0;
+    QObject::connect(&decoder, &ImageDecoder::imageDecoded, [&decodedCount]() { ++decodedCount; });
+    decoder.prefetch({ fileName }, kBoxSize);
+    decoder.keepOnly({});
+
+    // a 16x12 png is decoded well within this
+    QEventLoop loop;
+    QTimer::singleShot(200, &loop, &QEventLoop::quit);
+    loop.exec();
+
+    DecodedImage decoded;
+    EXPECT_EQ(decodedCount, 0);
+    EXPECT_FALSE(decoder.cachedImage(fileName, kBoxSize, &decoded));
+}
+
+TEST_F(ImageDecoderTest, Benchmark_Jpeg)
+{
+    const QString &fileName = sample("large.jpg");
+    if (fileName.isEmpty())
+        GTEST_SKIP() << "no jpeg image plugin";
+    benchmark(fileName, "jpeg");
+}
+
+TEST_F(ImageDecoderTest, Benchmark_Png)
+{
+    const QString &fileName = sample("large.png");
+    ASSERT_FALSE(fileName.isEmpty());
+    benchmark(fileName, "png");
+}
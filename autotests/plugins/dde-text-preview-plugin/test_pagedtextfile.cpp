@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_pagedtextfile.cpp - PagedTextFile unit tests
+
+#include <gtest/gtest.h>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "pagedtextfile.h"
+
+using namespace plugin_filepreview;
+
+class PagedTextFileTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+    }
+
+    QString writeFile(const QString &name, const QByteArray &content)
+    {
+        const QString &path = tempDir.filePath(name);
+        QFile file(path);
+        EXPECT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(content);
+        return path;
+    }
+
+    static QString readAll(PagedTextFile &file, qint64 pageSize)
+    {
+        QString text;
+        while (!file.atEnd())
+            text += file.readPage(pageSize);
+        return text;
+    }
+
+    QTemporaryDir tempDir;
+};
+
+TEST_F(PagedTextFileTest, DetectEncoding_Utf8AndBom)
+{
+    const QByteArray ascii("plain ascii text\n");
+    EXPECT_EQ(PagedTextFile::detectEncoding(ascii.constData(), ascii.size()), QByteArray("UTF-8"));
+
+    const QByteArray chinese = QString("中文文本\n").toUtf8();
+    EXPECT_EQ(PagedTextFile::detectEncoding(chinese.constData(), chinese.size()), QByteArray("UTF-8"));
+
+    const QByteArray utf16("\xFF\xFE" "a\0b\0", 6);
+    EXPECT_EQ(PagedTextFile::detectEncoding(utf16.constData(), utf16.size()), QByteArray("UTF-16LE"));
+
+    const QByteArray utf8Bom("\xEF\xBB\xBF" "abc");
+    EXPECT_EQ(PagedTextFile::detectEncoding(utf8Bom.constData(), utf8Bom.size()), QByteArray("UTF-8"));
+}
+
+TEST_F(PagedTextFileTest, DetectEncoding_InvalidUtf8_NotUtf8)
+{
+    // "中文" in GBK
+    const QByteArray gbk("\xD6\xD0\xCE\xC4\n");
+    EXPECT_NE(PagedTextFile::detectEncoding(gbk.constData(), gbk.size()), QByteArray("UTF-8"));
+}
+
+TEST_F(PagedTextFileTest, Open_EmptyOrMissing_Fails)
+{
+    PagedTextFile file;
+    EXPECT_FALSE(file.open(writeFile("empty.txt", QByteArray())));
+    EXPECT_FALSE(file.open(tempDir.filePath("missing.txt")));
+    EXPECT_FALSE(file.open(tempDir.path()));
+}
+
+TEST_F(PagedTextFileTest, ReadPage_PagesJoinToWholeText)
+{
+    QString expected;
+    for (int i = 0; i < 2000; ++i)
+        expected += QString("第 %1 行 line %1\n").arg(i);
+
+    PagedTextFile file;
+    ASSERT_TRUE(file.open(writeFile("lines.txt", expected.toUtf8())));
+    EXPECT_EQ(file.encoding(), QByteArray("UTF-8"));
+
+    // a small page size splits inside multi-byte characters when there is no newline
+    EXPECT_EQ(readAll(file, 7), expected);
+    EXPECT_TRUE(file.atEnd());
+    EXPECT_EQ(file.position(), file.size());
+}
+
+TEST_F(PagedTextFileTest, ReadPage_Utf16)
+{
+    const QString expected("utf-16 文本\nsecond line\n");
+    QByteArray content("\xFF\xFE", 2);
+    content.append(reinterpret_cast<const char *>(expected.utf16()), expected.size() * 2);
+
+    PagedTextFile file;
+    ASSERT_TRUE(file.open(writeFile("utf16.txt", content)));
+    EXPECT_EQ(file.encoding(), QByteArray("UTF-16LE"));
+    EXPECT_EQ(readAll(file, 5), expected);
+}
+
+TEST_F(PagedTextFileTest, ReadPage_BreaksAtNewline)
+{
+    PagedTextFile file;
+    ASSERT_TRUE(file.open(writeFile("break.txt", "aaaaaaaa\nbbbbbbbbbbbb")));
+
+    EXPECT_EQ(file.readPage(12), QString("aaaaaaaa\n"));
+    EXPECT_EQ(file.readPage(12), QString("bbbbbbbbbbbb"));
+    EXPECT_TRUE(file.atEnd());
+}
+
+TEST_F(PagedTextFileTest, ReadPage_GbkWithoutNewline_NotSplit)
+{
+    // "中文" in GBK, no newline to break the pages at
+    const QByteArray gbk = QByteArray("\xD6\xD0\xCE\xC4").repeated(2000);
+
+    PagedTextFile file;
+    ASSERT_TRUE(file.open(writeFile("gbk.txt", gbk)));
+    if (!file.encoding().startsWith("GB"))
+        GTEST_SKIP() << "detected as" << file.encoding().toStdString();
+
+    // an odd page size ends every other page inside a character
+    EXPECT_EQ(readAll(file, 7), QString("中文").repeated(2000));
+}
+
+TEST_F(PagedTextFileTest, ReadPage_TruncatedWhileOpen_StopsAtNewEnd)
+{
+    const QByteArray content = QByteArray("line of text\n").repeated(1000);
+    const QString &path = writeFile("shrink.txt", content);
+
+    PagedTextFile file;
+    ASSERT_TRUE(file.open(path));
+    EXPECT_EQ(file.readPage(100), QString("line of text\n").repeated(7));
+
+    ASSERT_TRUE(QFile::resize(path, 200));
+    EXPECT_EQ(readAll(file, 100), QString::fromUtf8(content.mid(91, 200 - 91)));
+    EXPECT_TRUE(file.atEnd());
+}
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "backgroundimageloader.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+DDP_BACKGROUND_USE_NAMESPACE
+
+class UT_BackgroundImageLoader : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        wallpaper = tempDir.filePath("wallpaper.png");
+
+        QImage image(400, 200, QImage::Format_RGB32);
+        image.fill(Qt::blue);
+        ASSERT_TRUE(image.save(wallpaper, "png"));
+    }
+
+    QTemporaryDir tempDir;
+    QString wallpaper;
+};
+
+TEST_F(UT_BackgroundImageLoader, centeredCrop_KeepsTargetAspectRatio)
+{
+    EXPECT_EQ(BackgroundImageLoader::centeredCrop(QSize(400, 200), QSize(100, 100)), QRect(100, 0, 200, 200));
+    EXPECT_EQ(BackgroundImageLoader::centeredCrop(QSize(400, 200), QSize(400, 50)), QRect(0, 50, 400, 100));
+    EXPECT_EQ(BackgroundImageLoader::centeredCrop(QSize(400, 200), QSize(800, 400)), QRect(0, 0, 400, 200));
+    EXPECT_EQ(BackgroundImageLoader::centeredCrop(QSize(400, 200), QSize()), QRect(0, 0, 400, 200));
+}
+
+TEST_F(UT_BackgroundImageLoader, fitToSize_ReturnsExactSize)
+{
+    QImage image(400, 200, QImage::Format_RGB32);
+    image.fill(Qt::red);
+
+    EXPECT_EQ(BackgroundImageLoader::fitToSize(image, QSize(100, 100)).size(), QSize(100, 100));
+    EXPECT_EQ(BackgroundImageLoader::fitToSize(image, QSize(800, 100)).size(), QSize(800, 100));
+    EXPECT_EQ(BackgroundImageLoader::fitToSize(image, QSize()).size(), image.size());
+}
+
+TEST_F(UT_BackgroundImageLoader, decode_SharedForSeveralSizes)
+{
+    BackgroundImageLoader loader(tempDir.filePath("cache"));
+    const QList<QSize> sizes { QSize(100, 100), QSize(200, 50), QSize(800, 400) };
+
+    const QList<QImage> &images = loader.decode(wallpaper, sizes);
+    ASSERT_EQ(images.size(), sizes.size());
+    for (int i = 0; i < sizes.size(); ++i)
+        EXPECT_EQ(images.at(i).size(), sizes.at(i));
+
+    const QList<QImage> &single = loader.decode(wallpaper, { QSize(50, 50) });
+    ASSERT_EQ(single.size(), 1);
+    EXPECT_EQ(single.first().size(), QSize(50, 50));
+}
+
+TEST_F(UT_BackgroundImageLoader, decode_InvalidFile_ReturnsNullImages)
+{
+    BackgroundImageLoader loader(tempDir.filePath("cache"));
+    const QList<QImage> &images = loader.decode(tempDir.filePath("missing.png"), { QSize(100, 100) });
+
+    ASSERT_EQ(images.size(), 1);
+    EXPECT_TRUE(images.first().isNull());
+}
+
+TEST_F(UT_BackgroundImageLoader, cache_RoundTripAndStaleSource)
+{
+    BackgroundImageLoader loader(tempDir.filePath("cache"));
+    const QSize size(100, 100);
+
+    EXPECT_TRUE(loader.loadCached(wallpaper, { size }).first().isNull());
+
+    const QImage &image = loader.decode(wallpaper, { size }).first();
+    EXPECT_TRUE(loader.save(wallpaper, image));
+    EXPECT_EQ(loader.loadCached(wallpaper, { size }).first().size(), size);
+    EXPECT_TRUE(loader.loadCached(wallpaper, { QSize(50, 50) }).first().isNull());
+
+    // the source changed after caching
+    QFile file(wallpaper);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(QDateTime::currentDateTime().addSecs(60), QFileDevice::FileModificationTime));
+    file.close();
+    EXPECT_TRUE(loader.loadCached(wallpaper, { size }).first().isNull());
+}
+
+TEST_F(UT_BackgroundImageLoader, save_EvictsLeastRecentlyUsedBeyondBudget)
+{
+    const QString cacheDir = tempDir.filePath("cache");
+    BackgroundImageLoader loader(cacheDir, 1);
+    const QSize older(100, 100);
+    const QSize newer(50, 50);
+
+    ASSERT_TRUE(loader.save(wallpaper, loader.decode(wallpaper, { older }).first()));
+    for (const QFileInfo &info : QDir(cacheDir).entryInfoList(QDir::Files)) {
+        QFile file(info.absoluteFilePath());
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(QDateTime::currentDateTime().addSecs(-60), QFileDevice::FileModificationTime));
+    }
+
+    const QImage &image = loader.decode(wallpaper, { newer }).first();
+    ASSERT_TRUE(loader.save(wallpaper, image));
+    EXPECT_TRUE(loader.save(wallpaper, image));
+    EXPECT_EQ(QDir(cacheDir).entryList(QDir::Files).size(), 1);
+    EXPECT_TRUE(loader.loadCached(wallpaper, { older }).first().isNull());
+    EXPECT_EQ(loader.loadCached(wallpaper, { newer }).first().size(), newer);
+}
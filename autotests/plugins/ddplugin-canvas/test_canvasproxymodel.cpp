@@ -5,6 +5,7 @@
 #include <gtest/gtest.h>
 #include "stubext.h"
 #include "model/canvasproxymodel.h"
+#include "model/canvasproxymodel_p.h"
 #include "model/fileinfomodel.h"
 #include "model/modelhookinterface.h"
 
@@ -1139,3 +1140,26 @@ TEST_F(UT_CanvasProxyModel, fileInfo_WithInvalidRow_ReturnsNull)
 }
 
 
+
+TEST_F(UT_CanvasProxyModel, rowMapping_AppendRemoveReplace_KeepsRowsInStep)
+{
+    const QUrl a("file:///desktop/a"), b("file:///desktop/b"), c("file:///desktop/c"), d("file:///desktop/d");
+    CanvasProxyModelPrivate *dp = proxyModel->d;
+
+    dp->setFiles({ a, b }, { { a, nullptr }, { b, nullptr } });
+    dp->appendFile(c, nullptr);
+    EXPECT_EQ(proxyModel->index(c).row(), 2);
+
+    dp->removeFile(0);
+    EXPECT_FALSE(proxyModel->index(a).isValid());
+    EXPECT_EQ(proxyModel->index(b).row(), 0);
+    EXPECT_EQ(proxyModel->index(c).row(), 1);
+
+    dp->replaceFile(0, d, nullptr);
+    EXPECT_FALSE(proxyModel->index(b).isValid());
+    EXPECT_EQ(proxyModel->index(d).row(), 0);
+    EXPECT_EQ(proxyModel->files(), QList<QUrl>({ d, c }));
+
+    dp->clearMapping();
+    EXPECT_FALSE(proxyModel->index(d).isValid());
+}
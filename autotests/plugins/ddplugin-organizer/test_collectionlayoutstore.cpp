@@ -0,0 +1,220 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "config/collectionlayoutstore.h"
+#include "config/organizerconfig.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+using namespace ddplugin_organizer;
+
+class UT_CollectionLayoutStore : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        filePath = tempDir.filePath("organizer.layout");
+    }
+
+    static CollectionBaseDataPtr makeBase(const QString &key, const QString &name, const QList<QUrl> &items)
+    {
+        CollectionBaseDataPtr base(new CollectionBaseData);
+        base->key = key;
+        base->name = name;
+        base->items = items;
+        return base;
+    }
+
+    static QList<QUrl> makeUrls(const QString &prefix, int count)
+    {
+        QList<QUrl> urls;
+        for (int i = 0; i < count; ++i)
+            urls << QUrl::fromLocalFile(QString("/home/user/Desktop/%1 %2.txt").arg(prefix).arg(i));
+        return urls;
+    }
+
+    // the collections as a fresh store reads them from disk
+    QList<CollectionBaseDataPtr> reload()
+    {
+        CollectionLayoutStore store(filePath);
+        return store.collections();
+    }
+
+    QTemporaryDir tempDir;
+    QString filePath;
+};
+
+TEST_F(UT_CollectionLayoutStore, write_reloadsSameLayout)
+{
+    {
+        CollectionLayoutStore store(filePath);
+        EXPECT_FALSE(store.exists());
+        store.write({ makeBase("k1", "Name one", makeUrls("a", 3)), makeBase("k 2", "名称", makeUrls("b", 2)) });
+        EXPECT_TRUE(store.flush());
+        EXPECT_TRUE(store.exists());
+    }
+
+    const auto bases = reload();
+    ASSERT_EQ(bases.size(), 2);
+    EXPECT_EQ(bases.at(0)->key, QString("k1"));
+    EXPECT_EQ(bases.at(0)->name, QString("Name one"));
+    EXPECT_EQ(bases.at(0)->items, makeUrls("a", 3));
+    EXPECT_EQ(bases.at(1)->key, QString("k 2"));
+    EXPECT_EQ(bases.at(1)->name, QString("名称"));
+    EXPECT_EQ(bases.at(1)->items, makeUrls("b", 2));
+}
+
+TEST_F(UT_CollectionLayoutStore, moveOneItem_appendsTwoRecords)
+{
+    const QList<QUrl> urls = makeUrls("a", 100);
+    CollectionLayoutStore store(filePath);
+    store.write({ makeBase("k1", "One", urls) });
+    store.flush();
+    const qint64 size = QFileInfo(filePath).size();
+
+    QList<QUrl> moved = urls;
+    moved.move(0, 99);
+    store.write({ makeBase("k1", "One", moved) });
+    EXPECT_EQ(store.pendingRecords(), 2);
+    store.flush();
+    EXPECT_LT(QFileInfo(filePath).size() - size, 200);
+
+    const auto bases = reload();
+    ASSERT_EQ(bases.size(), 1);
+    EXPECT_EQ(bases.first()->items, moved);
+}
+
+TEST_F(UT_CollectionLayoutStore, changes_replayedInOrder)
+{
+    QList<QUrl> a = makeUrls("a", 5);
+    QList<QUrl> b = makeUrls("b", 5);
+    CollectionLayoutStore store(filePath);
+    store.write({ makeBase("k1", "One", a), makeBase("k2", "Two", b), makeBase("k3", "Three", {}) });
+    store.flush();
+
+    // move between collections, insert, remove, rename and drop
+    b.insert(2, a.takeAt(1));
+    a.append(QUrl::fromLocalFile("/home/user/Desktop/new file"));
+    b.removeAt(0);
+    store.write({ makeBase("k1", "One", a), makeBase("k2", "Renamed", b) });
+    store.update(makeBase("k1", "One", QList<QUrl>({ a.at(3), a.at(0) })));
+    store.flush();
+
+    const auto bases = reload();
+    ASSERT_EQ(bases.size(), 2);
+    EXPECT_EQ(bases.at(0)->items, QList<QUrl>({ a.at(3), a.at(0) }));
+    EXPECT_EQ(bases.at(1)->name, QString("Renamed"));
+    EXPECT_EQ(bases.at(1)->items, b);
+}
+
+TEST_F(UT_CollectionLayoutStore, longJournal_compacted)
+{
+    QList<QUrl> urls = makeUrls("a", 10);
+    CollectionLayoutStore store(filePath);
+    store.write({ makeBase("k1", "One", urls) });
+    store.flush();
+
+    for (int i = 0; i < 600; ++i) {
+        urls.move(0, urls.size() - 1);
+        store.write({ makeBase("k1", "One", urls) });
+        store.flush();
+    }
+    EXPECT_LT(store.journalRecords(), 600);
+
+    const auto bases = reload();
+    ASSERT_EQ(bases.size(), 1);
+    EXPECT_EQ(bases.first()->items, urls);
+}
+
+TEST_F(UT_CollectionLayoutStore, incompleteLastRecord_ignored)
+{
+    {
+        CollectionLayoutStore store(filePath);
+        store.write({ makeBase("k1", "One", makeUrls("a", 3)) });
+        store.flush();
+    }
+
+    QFile file(filePath);
+    ASSERT_TRUE(file.open(QIODevice::Append));
+    file.write("R k1 file:///home");
+    file.close();
+
+    CollectionLayoutStore store(filePath);
+    const auto bases = store.collections();
+    ASSERT_EQ(bases.size(), 1);
+    EXPECT_EQ(bases.first()->items, makeUrls("a", 3));
+
+    // the next flush rewrites the file without the broken record
+    EXPECT_TRUE(store.flush());
+    EXPECT_EQ(reload().first()->items, makeUrls("a", 3));
+}
+
+
+namespace {
+// exposes the config path to the stub
+class TestOrganizerConfig : public OrganizerConfig
+{
+public:
+    using OrganizerConfig::path;
+};
+}   // namespace
+
+TEST_F(UT_CollectionLayoutStore, legacyConfig_movedToLayoutStore)
+{
+    const QString confPath = tempDir.filePath("ddplugin-organizer.conf");
+    const QList<QUrl> urls = makeUrls("a", 12);
+    {
+        // the format of the previous versions: one ini key per item
+        QSettings settings(confPath, QSettings::IniFormat);
+        settings.beginGroup("Collection_Normalized");
+        settings.setValue("Classification", 1);
+        settings.beginGroup("CollectionBase");
+        settings.beginGroup("k1");
+        settings.setValue("Name", "One");
+        settings.setValue("Key", "k1");
+        settings.beginGroup("Items");
+        for (int i = 0; i < urls.size(); ++i)
+            settings.setValue(QString::number(i), urls.at(i).toString());
+        settings.endGroup();
+        settings.endGroup();
+        settings.endGroup();
+        settings.endGroup();
+    }
+
+    stub_ext::StubExt stub;
+    stub.set_lamda(&TestOrganizerConfig::path, [&confPath](const OrganizerConfig *) {
+        return confPath;
+    });
+
+    {
+        OrganizerConfig config;
+        const auto bases = config.collectionBase(false);
+        ASSERT_EQ(bases.size(), 1);
+        EXPECT_EQ(bases.first()->key, QString("k1"));
+        EXPECT_EQ(bases.first()->items, urls);
+        EXPECT_TRUE(config.collectionBase(true).isEmpty());
+    }
+
+    EXPECT_TRUE(QFile::exists(tempDir.filePath("ddplugin-organizer-normalized.layout")));
+    EXPECT_FALSE(QFile::exists(tempDir.filePath("ddplugin-organizer-customed.layout")));
+
+    QSettings settings(confPath, QSettings::IniFormat);
+    settings.beginGroup("Collection_Normalized");
+    EXPECT_FALSE(settings.childGroups().contains("CollectionBase"));
+    EXPECT_EQ(settings.value("Classification").toInt(), 1);
+    settings.endGroup();
+
+    // the next start reads the layout store only
+    OrganizerConfig config;
+    const auto bases = config.collectionBase(false);
+    ASSERT_EQ(bases.size(), 1);
+    EXPECT_EQ(bases.first()->items, urls);
+}
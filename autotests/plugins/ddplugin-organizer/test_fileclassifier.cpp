@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+#include "mode/normalized/type/typeclassifier.h"
+#include "config/configpresenter.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+using namespace ddplugin_organizer;
+
+namespace {
+class TestClassifier : public TypeClassifier
+{
+public:
+    using FileClassifier::appendItem;
+};
+}
+
+class UT_FileClassifier : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        stub.set_lamda(&ConfigPresenter::enabledTypeCategories, [](const ConfigPresenter *) {
+            return ItemCategories(kCatAll);
+        });
+        stub.set_lamda(&ConfigPresenter::saveNormalProfile, [](ConfigPresenter *, const QList<CollectionBaseDataPtr> &) {});
+        ASSERT_TRUE(tempDir.isValid());
+        classifier = new TestClassifier;
+    }
+
+    void TearDown() override
+    {
+        delete classifier;
+        stub.clear();
+    }
+
+    QUrl touch(const QString &name)
+    {
+        QFile file(tempDir.filePath(name));
+        file.open(QIODevice::WriteOnly);
+        return QUrl::fromLocalFile(file.fileName());
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir tempDir;
+    TestClassifier *classifier = nullptr;
+};
+
+TEST_F(UT_FileClassifier, classifyAll_bySuffixAndDirentType)
+{
+    QDir(tempDir.path()).mkdir("folder.png");
+    const QList<QUrl> urls { touch("a.TXT"), touch("b.png"), touch("c.mkv"), touch("d.mp3"),
+                             touch("e.desktop"), touch("f.bin"), touch(".png"), touch("g.pdf."),
+                             QUrl::fromLocalFile(tempDir.filePath("folder.png")) };
+
+    EXPECT_EQ(classifier->classifyAll(urls),
+              QStringList({ kTypeKeyDoc, kTypeKeyPic, kTypeKeyVid, kTypeKeyMuz, kTypeKeyApp,
+                            kTypeKeyOth, kTypeKeyOth, kTypeKeyOth, kTypeKeyFld }));
+}
+
+TEST_F(UT_FileClassifier, reset_indexesItems)
+{
+    const QUrl doc = touch("a.txt");
+    const QUrl pic = touch("b.png");
+    classifier->reset({ doc, pic, doc });
+
+    EXPECT_EQ(classifier->key(doc), QString(kTypeKeyDoc));
+    EXPECT_EQ(classifier->key(pic), QString(kTypeKeyPic));
+    EXPECT_TRUE(classifier->contains(kTypeKeyDoc, doc));
+    EXPECT_FALSE(classifier->contains(kTypeKeyPic, doc));
+    EXPECT_EQ(classifier->items(kTypeKeyDoc), QList<QUrl>({ doc }));
+}
+
+TEST_F(UT_FileClassifier, remove_dropsItemAndKey)
+{
+    const QUrl doc = touch("a.txt");
+    const QUrl doc2 = touch("b.txt");
+    classifier->reset({ doc, doc2 });
+
+    EXPECT_EQ(classifier->remove(doc), QString(kTypeKeyDoc));
+    EXPECT_TRUE(classifier->key(doc).isEmpty());
+    EXPECT_EQ(classifier->items(kTypeKeyDoc), QList<QUrl>({ doc2 }));
+    EXPECT_TRUE(classifier->remove(doc).isEmpty());
+}
+
+TEST_F(UT_FileClassifier, itemOperations_keepIndexInStep)
+{
+    const QUrl doc = touch("a.txt");
+    const QUrl doc2 = touch("b.txt");
+    const QUrl pic = touch("c.png");
+    classifier->reset({ doc, doc2, pic });
+
+    const QUrl renamed = QUrl::fromLocalFile(tempDir.filePath("renamed.txt"));
+    EXPECT_TRUE(classifier->replaceItem(kTypeKeyDoc, doc, renamed));
+    EXPECT_TRUE(classifier->key(doc).isEmpty());
+    EXPECT_EQ(classifier->items(kTypeKeyDoc), QList<QUrl>({ renamed, doc2 }));
+
+    classifier->moveUrls({ doc2 }, kTypeKeyPic, 0);
+    EXPECT_EQ(classifier->key(doc2), QString(kTypeKeyPic));
+    EXPECT_EQ(classifier->items(kTypeKeyPic), QList<QUrl>({ doc2, pic }));
+
+    classifier->setItems(kTypeKeyPic, { pic });
+    EXPECT_TRUE(classifier->key(doc2).isEmpty());
+    EXPECT_EQ(classifier->removeItem(pic), QString(kTypeKeyPic));
+    EXPECT_TRUE(classifier->items(kTypeKeyPic).isEmpty());
+}
+
+TEST_F(UT_FileClassifier, benchmark_resetInsertRemove)
+{
+    constexpr int kFileCount = 10000;
+    const char *suffixes[] = { "txt", "png", "mkv", "mp3", "bin" };
+    QList<QUrl> urls;
+    for (int i = 0; i < kFileCount; ++i)
+        urls << touch(QString("f%1.%2").arg(i).arg(suffixes[i % 5]));
+
+    QElapsedTimer timer;
+    timer.start();
+    classifier->reset(urls);
+    const qint64 resetNs = timer.nsecsElapsed();
+
+    // the linear scans the classifier did before, on a copy of the lists
+    QHash<QString, QList<QUrl>> legacy;
+    for (const QString &key : classifier->keys())
+        legacy.insert(key, classifier->items(key));
+    timer.restart();
+    for (const QUrl &url : std::as_const(urls)) {
+        for (auto it = legacy.begin(); it != legacy.end(); ++it) {
+            if (it->contains(url)) {
+                it->removeOne(url);
+                break;
+            }
+        }
+    }
+    const qint64 legacyRemoveNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (const QUrl &url : std::as_const(urls))
+        classifier->remove(url);
+    const qint64 removeNs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (const QUrl &url : std::as_const(urls))
+        classifier->appendItem(kTypeKeyOth, url);
+    const qint64 insertNs = timer.nsecsElapsed();
+
+    EXPECT_EQ(classifier->items(kTypeKeyOth).size(), kFileCount);
+    EXPECT_EQ(classifier->key(urls.last()), QString(kTypeKeyOth));
+    EXPECT_LT(removeNs, legacyRemoveNs);
+
+    std::cout << "[ BENCH    ] " << kFileCount << " items: reset " << resetNs / 1000000 << " ms, insert "
+              << insertNs / kFileCount << " ns/item, remove " << removeNs / kFileCount << " ns/item (linear scan "
+              << legacyRemoveNs / kFileCount << " ns/item)" << std::endl;
+}
@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QByteArray>
+
+#include "fileoperations/fileoperationutils/iouringcopier.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class TestIoUringCopier : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        if (!IoUringCopier::isSupported())
+            GTEST_SKIP() << "io_uring is not available";
+
+        ASSERT_TRUE(tempDir.isValid());
+        sourcePath = tempDir.filePath("source.bin");
+        targetPath = tempDir.filePath("target.bin");
+
+        // not a multiple of the chunk size, so the last chunk is partial
+        content.resize(5 * kChunkSize + 1234);
+        for (int i = 0; i < content.size(); ++i)
+            content[i] = static_cast<char>((i * 31 + i / 4096) & 0xff);
+
+        QFile source(sourcePath);
+        ASSERT_TRUE(source.open(QIODevice::WriteOnly));
+        ASSERT_EQ(source.write(content), content.size());
+        source.close();
+    }
+
+    QByteArray readTarget() const
+    {
+        QFile target(targetPath);
+        if (!target.open(QIODevice::ReadOnly))
+            return {};
+        return target.readAll();
+    }
+
+    static constexpr qint64 kChunkSize { 64 * 1024 };
+
+    QTemporaryDir tempDir;
+    QString sourcePath;
+    QString targetPath;
+    QByteArray content;
+};
+
+TEST_F(TestIoUringCopier, copy_WholeFile_TargetMatchesSource)
+{
+    IoUringCopier copier(4, kChunkSize);
+    ASSERT_TRUE(copier.init());
+
+    int src = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dst = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(src, 0);
+    ASSERT_GE(dst, 0);
+
+    qint64 offset = 0;
+    qint64 written = 0;
+    auto result = copier.copy(src, dst, offset, content.size(), true, [&written](qint64 size) {
+        written += size;
+        return true;
+    });
+    EXPECT_TRUE(copier.sync(dst));
+    close(src);
+    close(dst);
+
+    EXPECT_EQ(result, IoUringCopier::Result::kFinished);
+    EXPECT_EQ(offset, content.size());
+    EXPECT_EQ(written, content.size());
+    EXPECT_EQ(readTarget(), content);
+}
+
+TEST_F(TestIoUringCopier, copy_Interrupted_ResumesFromReturnedOffset)
+{
+    IoUringCopier copier(2, kChunkSize);
+    ASSERT_TRUE(copier.init());
+
+    int src = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dst = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(src, 0);
+    ASSERT_GE(dst, 0);
+
+    qint64 offset = 0;
+    qint64 written = 0;
+    int interruptions = 0;
+    auto result = IoUringCopier::Result::kInterrupted;
+    while (result == IoUringCopier::Result::kInterrupted) {
+        // stop after every second write
+        int calls = 0;
+        result = copier.copy(src, dst, offset, content.size(), false, [&](qint64 size) {
+            written += size;
+            return ++calls < 2;
+        });
+        if (result == IoUringCopier::Result::kInterrupted) {
+            ++interruptions;
+            // everything in flight completed, nothing behind offset is missing
+            EXPECT_EQ(offset, written);
+        }
+    }
+    close(src);
+    close(dst);
+
+    EXPECT_EQ(result, IoUringCopier::Result::kFinished);
+    EXPECT_GT(interruptions, 0);
+    EXPECT_EQ(readTarget(), content);
+}
+
+TEST_F(TestIoUringCopier, copy_WriteFails_ReportsWriteError)
+{
+    IoUringCopier copier(4, kChunkSize);
+    ASSERT_TRUE(copier.init());
+
+    int src = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    QFile(targetPath).open(QIODevice::WriteOnly);
+    // read only descriptor, every write fails with EBADF
+    int dst = open(targetPath.toLocal8Bit().constData(), O_RDONLY);
+    ASSERT_GE(src, 0);
+    ASSERT_GE(dst, 0);
+
+    qint64 offset = 0;
+    auto result = copier.copy(src, dst, offset, content.size(), false, nullptr);
+    close(src);
+    close(dst);
+
+    EXPECT_EQ(result, IoUringCopier::Result::kFailed);
+    EXPECT_EQ(copier.lastError(), EBADF);
+    EXPECT_FALSE(copier.lastErrorOnRead());
+    EXPECT_EQ(offset, 0);
+    EXPECT_TRUE(copier.isValid());
+}
+
+TEST_F(TestIoUringCopier, copy_SourceShorterThanSize_ReportsReadErrorAtEnd)
+{
+    IoUringCopier copier(4, kChunkSize);
+    ASSERT_TRUE(copier.init());
+
+    int src = open(sourcePath.toLocal8Bit().constData(), O_RDONLY);
+    int dst = open(targetPath.toLocal8Bit().constData(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+    ASSERT_GE(src, 0);
+    ASSERT_GE(dst, 0);
+
+    qint64 offset = 0;
+    auto result = copier.copy(src, dst, offset, content.size() + 3 * kChunkSize, false, nullptr);
+    close(src);
+    close(dst);
+
+    EXPECT_EQ(result, IoUringCopier::Result::kFailed);
+    EXPECT_TRUE(copier.lastErrorOnRead());
+    EXPECT_EQ(offset, content.size());
+    EXPECT_EQ(readTarget(), content);
+}
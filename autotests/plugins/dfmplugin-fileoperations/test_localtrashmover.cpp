@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+
+#include "fileoperations/trashfiles/localtrashmover.h"
+
+#include <cerrno>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class TestLocalTrashMover : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        trashPath = tempDir.filePath("Trash");
+        sourceDir = tempDir.filePath("source");
+        ASSERT_TRUE(QDir().mkpath(sourceDir));
+    }
+
+    QString createFile(const QString &name)
+    {
+        const QString path = sourceDir + "/" + name;
+        QFile file(path);
+        file.open(QIODevice::WriteOnly);
+        file.write("data");
+        return path;
+    }
+
+    QByteArray readTrashInfo(const QString &trashName)
+    {
+        QFile file(trashPath + "/info/" + trashName + ".trashinfo");
+        if (!file.open(QIODevice::ReadOnly))
+            return {};
+        return file.readAll();
+    }
+
+    QTemporaryDir tempDir;
+    QString trashPath;
+    QString sourceDir;
+};
+
+TEST_F(TestLocalTrashMover, moveToTrash_SameDevice_RenamesAndWritesInfo)
+{
+    const QString path = createFile("a b.txt");
+    LocalTrashMover mover(trashPath);
+
+    QString trashedPath;
+    bool inHomeTrash = false;
+    EXPECT_TRUE(mover.moveToTrash(path, &trashedPath, &inHomeTrash));
+    EXPECT_TRUE(inHomeTrash);
+    EXPECT_EQ(trashedPath, trashPath + "/files/a b.txt");
+    EXPECT_FALSE(QFileInfo::exists(path));
+    EXPECT_TRUE(QFileInfo::exists(trashedPath));
+
+    const QByteArray info = readTrashInfo("a b.txt");
+    EXPECT_TRUE(info.startsWith("[Trash Info]\nPath="));
+    EXPECT_TRUE(info.contains("Path=" + QFile::encodeName(sourceDir) + "/a%20b.txt\n"));
+    EXPECT_TRUE(info.contains("DeletionDate="));
+}
+
+TEST_F(TestLocalTrashMover, moveToTrash_NameTaken_UsesNextFreeName)
+{
+    LocalTrashMover mover(trashPath);
+    QString trashedPath;
+    EXPECT_TRUE(mover.moveToTrash(createFile("doc.tar.gz"), &trashedPath));
+    EXPECT_TRUE(mover.moveToTrash(createFile("doc.tar.gz"), &trashedPath));
+    EXPECT_EQ(trashedPath, trashPath + "/files/doc.2.tar.gz");
+    EXPECT_TRUE(mover.moveToTrash(createFile("doc.tar.gz"), &trashedPath));
+    EXPECT_EQ(trashedPath, trashPath + "/files/doc.3.tar.gz");
+    EXPECT_FALSE(readTrashInfo("doc.3.tar.gz").isEmpty());
+}
+
+TEST_F(TestLocalTrashMover, moveToTrash_Directory_MovesWholeTree)
+{
+    QDir().mkpath(sourceDir + "/dir/sub");
+    LocalTrashMover mover(trashPath);
+
+    QString trashedPath;
+    EXPECT_TRUE(mover.moveToTrash(sourceDir + "/dir", &trashedPath));
+    EXPECT_TRUE(QFileInfo(trashedPath + "/sub").isDir());
+}
+
+TEST_F(TestLocalTrashMover, moveToTrash_MissingFile_FailsWithoutInfo)
+{
+    LocalTrashMover mover(trashPath);
+
+    QString trashedPath;
+    EXPECT_FALSE(mover.moveToTrash(sourceDir + "/missing", &trashedPath));
+    EXPECT_EQ(mover.lastError(), ENOENT);
+    EXPECT_TRUE(readTrashInfo("missing").isEmpty());
+}
+
+TEST_F(TestLocalTrashMover, moveToTrash_AncestorOfTrash_FailsOnlyThatItem)
+{
+    LocalTrashMover mover(trashPath);
+
+    // the trash lives in the temporary directory
+    QString trashedPath;
+    EXPECT_FALSE(mover.moveToTrash(tempDir.path(), &trashedPath));
+    EXPECT_EQ(mover.lastError(), EINVAL);
+    EXPECT_TRUE(QFileInfo(tempDir.path()).isDir());
+
+    // the rename is still used for the next item on the device
+    EXPECT_TRUE(mover.moveToTrash(createFile("a.txt"), &trashedPath));
+    EXPECT_EQ(trashedPath, trashPath + "/files/a.txt");
+}
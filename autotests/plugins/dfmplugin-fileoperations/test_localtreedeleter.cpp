@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "stubext.h"
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSet>
+#include <QThread>
+
+#include "fileoperations/deletefiles/localtreedeleter.h"
+
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+
+DFMBASE_USE_NAMESPACE
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class TestLocalTreeDeleter : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        rootPath = tempDir.filePath("tree");
+        entryCount = createTree(rootPath, 3) + 1;
+
+        callbacks.error = [this](const QString &, int) {
+            ++errorCount;
+            return AbstractJobHandler::SupportAction::kCancelAction;
+        };
+        callbacks.isRunning = [] { return true; };
+        callbacks.stateCheck = [] { return true; };
+        callbacks.progress = [this](qint64 count) { progress += count; };
+        callbacks.found = [this](qint64 count) { found += count; };
+        callbacks.removed = [this](const QString &path) {
+            QMutexLocker locker(&removedMutex);
+            removed.insert(path);
+        };
+    }
+
+    void TearDown() override
+    {
+        stub.clear();
+    }
+
+    // creates victim, unlinkat fails with EACCES for it failures times, or always when failures is negative
+    void failUnlink(const QString &victim, int failures)
+    {
+        QFile file(victim);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        ++entryCount;
+        victimName = QFile::encodeName(QFileInfo(victim).fileName());
+        victimFailures = failures;
+        stub.set_lamda(&unlinkat, [this](int dirFd, const char *name, int flags) -> int {
+            if (victimName == name && victimFailures != 0) {
+                --victimFailures;
+                errno = EACCES;
+                return -1;
+            }
+            return static_cast<int>(syscall(SYS_unlinkat, dirFd, name, flags));
+        });
+    }
+
+    // every level holds files, a symlink and subdirectories, returns the number of entries below path
+    int createTree(const QString &path, int depth)
+    {
+        QDir().mkpath(path);
+        int count = 0;
+        for (int i = 0; i < 20; ++i) {
+            QFile file(path + QString("/file%1").arg(i));
+            file.open(QIODevice::WriteOnly);
+            file.write("data");
+            ++count;
+        }
+        QFile::link(path + "/file0", path + "/link");
+        ++count;
+        if (depth > 0) {
+            for (int i = 0; i < 4; ++i)
+                count += createTree(path + QString("/dir%1").arg(i), depth - 1) + 1;
+        }
+        return count;
+    }
+
+    stub_ext::StubExt stub;
+    QTemporaryDir tempDir;
+    QString rootPath;
+    int entryCount { 0 };
+    LocalTreeDeleter::Callbacks callbacks;
+    std::atomic<qint64> progress { 0 };
+    std::atomic_int errorCount { 0 };
+    std::atomic<qint64> found { 0 };
+    QMutex removedMutex;
+    QSet<QString> removed;
+    QByteArray victimName;
+    std::atomic_int victimFailures { 0 };
+};
+
+TEST_F(TestLocalTreeDeleter, remove_TreeWithHelpers_RemovesEverything)
+{
+    LocalTreeDeleter deleter(4);
+    deleter.setCallbacks(callbacks);
+
+    EXPECT_EQ(deleter.remove(rootPath), LocalTreeDeleter::Result::kDeleted);
+    EXPECT_FALSE(QFileInfo::exists(rootPath));
+    EXPECT_EQ(progress, entryCount);
+    EXPECT_EQ(errorCount, 0);
+    EXPECT_EQ(found, entryCount);
+    EXPECT_EQ(removed.size(), entryCount);
+    EXPECT_TRUE(removed.contains(rootPath + "/dir3/dir1/dir0/file7"));
+    EXPECT_TRUE(removed.contains(rootPath));
+}
+
+TEST_F(TestLocalTreeDeleter, remove_SingleThread_RemovesEverything)
+{
+    LocalTreeDeleter deleter(1);
+    deleter.setCallbacks(callbacks);
+
+    EXPECT_EQ(deleter.remove(rootPath), LocalTreeDeleter::Result::kDeleted);
+    EXPECT_FALSE(QFileInfo::exists(rootPath));
+    EXPECT_EQ(progress, entryCount);
+}
+
+TEST_F(TestLocalTreeDeleter, remove_SingleFile_RemovesFile)
+{
+    const QString filePath = rootPath + "/file1";
+    LocalTreeDeleter deleter(4);
+    deleter.setCallbacks(callbacks);
+
+    EXPECT_EQ(deleter.remove(filePath), LocalTreeDeleter::Result::kDeleted);
+    EXPECT_FALSE(QFileInfo::exists(filePath));
+    EXPECT_TRUE(QFileInfo::exists(rootPath));
+    EXPECT_EQ(progress, 1);
+}
+
+TEST_F(TestLocalTreeDeleter, remove_MissingPath_ReportsErrorAndCancels)
+{
+    LocalTreeDeleter deleter(2);
+    deleter.setCallbacks(callbacks);
+
+    EXPECT_EQ(deleter.remove(tempDir.filePath("missing")), LocalTreeDeleter::Result::kCancelled);
+    EXPECT_EQ(errorCount, 1);
+}
+
+TEST_F(TestLocalTreeDeleter, remove_Stopped_CancelsAndKeepsRoot)
+{
+    callbacks.isRunning = [] { return false; };
+    callbacks.stateCheck = [] { return false; };
+    LocalTreeDeleter deleter(4);
+    deleter.setCallbacks(callbacks);
+
+    EXPECT_EQ(deleter.remove(rootPath), LocalTreeDeleter::Result::kCancelled);
+    EXPECT_TRUE(QFileInfo::exists(rootPath));
+}
+
+TEST_F(TestLocalTreeDeleter, remove_RetryOnHelper_RemovesEverything)
+{
+    // dir0 is always handed to a helper thread, its errors are relayed to this one
+    const QString victim = rootPath + "/dir0/victim";
+    failUnlink(victim, 1);
+    Qt::HANDLE errorThread = nullptr;
+    callbacks.error = [this, &errorThread](const QString &path, int errorCode) {
+        ++errorCount;
+        errorThread = QThread::currentThreadId();
+        EXPECT_EQ(path, rootPath + "/dir0/victim");
+        EXPECT_EQ(errorCode, EACCES);
+        return AbstractJobHandler::SupportAction::kRetryAction;
+    };
+    LocalTreeDeleter deleter(4);
+    deleter.setCallbacks(callbacks);
+
+    EXPECT_EQ(deleter.remove(rootPath), LocalTreeDeleter::Result::kDeleted);
+    EXPECT_FALSE(QFileInfo::exists(rootPath));
+    EXPECT_EQ(errorCount, 1);
+    EXPECT_EQ(errorThread, QThread::currentThreadId());
+    EXPECT_EQ(progress, entryCount);
+}
+
+TEST_F(TestLocalTreeDeleter, remove_SkipOnHelper_KeepsParents)
+{
+    const QString victim = rootPath + "/dir0/victim";
+    failUnlink(victim, -1);
+    callbacks.error = [this](const QString &, int) {
+        ++errorCount;
+        return AbstractJobHandler::SupportAction::kSkipAction;
+    };
+    LocalTreeDeleter deleter(4);
+    deleter.setCallbacks(callbacks);
+
+    EXPECT_EQ(deleter.remove(rootPath), LocalTreeDeleter::Result::kSkipped);
+    EXPECT_EQ(errorCount, 1);
+    EXPECT_TRUE(QFileInfo::exists(victim));
+    EXPECT_FALSE(QFileInfo::exists(rootPath + "/dir0/file4"));
+    EXPECT_FALSE(QFileInfo::exists(rootPath + "/dir0/dir1"));
+    EXPECT_FALSE(QFileInfo::exists(rootPath + "/dir1"));
+    EXPECT_FALSE(removed.contains(victim));
+    EXPECT_FALSE(removed.contains(rootPath + "/dir0"));
+    EXPECT_FALSE(removed.contains(rootPath));
+}
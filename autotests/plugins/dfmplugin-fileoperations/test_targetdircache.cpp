@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QFile>
+#include <QDir>
+
+#include "fileoperations/fileoperationutils/targetdircache.h"
+
+#include <sys/vfs.h>
+#include <linux/magic.h>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+class TestTargetDirCache : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        struct statfs fs;
+        ASSERT_EQ(statfs(QFile::encodeName(tempDir.path()).constData(), &fs), 0);
+        if (fs.f_type != EXT4_SUPER_MAGIC && fs.f_type != TMPFS_MAGIC
+            && fs.f_type != BTRFS_SUPER_MAGIC && fs.f_type != XFS_SUPER_MAGIC)
+            GTEST_SKIP() << "temporary directory is not on a cached filesystem";
+
+        QFile file(tempDir.filePath("exists.txt"));
+        file.open(QIODevice::WriteOnly);
+        QDir().mkpath(tempDir.filePath("dir"));
+    }
+
+    QUrl url(const QString &name) const
+    {
+        return QUrl::fromLocalFile(tempDir.filePath(name));
+    }
+
+    QTemporaryDir tempDir;
+    TargetDirCache cache;
+};
+
+TEST_F(TestTargetDirCache, entry_ReadsListingOnce)
+{
+    EXPECT_EQ(cache.entry(url("exists.txt")), TargetDirCache::Entry::kListed);
+    EXPECT_EQ(cache.entry(url("dir")), TargetDirCache::Entry::kListed);
+    EXPECT_EQ(cache.entry(url("missing.txt")), TargetDirCache::Entry::kMissing);
+    EXPECT_TRUE(cache.isKnownDir(QUrl::fromLocalFile(tempDir.path())));
+
+    // the listing is not read again, but a name missing from it is confirmed
+    QFile file(tempDir.filePath("later.txt"));
+    file.open(QIODevice::WriteOnly);
+    EXPECT_EQ(cache.entry(url("later.txt")), TargetDirCache::Entry::kListed);
+    EXPECT_EQ(cache.entry(url("later2.txt")), TargetDirCache::Entry::kMissing);
+}
+
+TEST_F(TestTargetDirCache, entry_CreatedAfterMissing_Listed)
+{
+    // another process creates the name after the job found it free
+    ASSERT_EQ(cache.entry(url("race.txt")), TargetDirCache::Entry::kMissing);
+    QFile file(tempDir.filePath("race.txt"));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    EXPECT_EQ(cache.entry(url("race.txt")), TargetDirCache::Entry::kListed);
+}
+
+TEST_F(TestTargetDirCache, addEntry_NameBecomesListed)
+{
+    EXPECT_EQ(cache.entry(url("new.txt")), TargetDirCache::Entry::kMissing);
+    cache.addEntry(url("new.txt"));
+    EXPECT_EQ(cache.entry(url("new.txt")), TargetDirCache::Entry::kListed);
+}
+
+TEST_F(TestTargetDirCache, addEmptyDir_ChildrenAreMissing)
+{
+    ASSERT_EQ(cache.entry(url("created")), TargetDirCache::Entry::kMissing);
+    QDir().mkpath(tempDir.filePath("created"));
+    cache.addEmptyDir(url("created"));
+
+    EXPECT_TRUE(cache.isKnownDir(url("created")));
+    EXPECT_EQ(cache.entry(url("created")), TargetDirCache::Entry::kListed);
+    EXPECT_EQ(cache.entry(url("created/a.txt")), TargetDirCache::Entry::kMissing);
+}
+
+TEST_F(TestTargetDirCache, entry_MissingDirOrOtherScheme_Unknown)
+{
+    EXPECT_EQ(cache.entry(url("nodir/a.txt")), TargetDirCache::Entry::kUnknown);
+    EXPECT_EQ(cache.entry(QUrl("smb://host/share/a.txt")), TargetDirCache::Entry::kUnknown);
+    EXPECT_FALSE(cache.isKnownDir(url("nodir")));
+}
@@ -21,26 +21,6 @@
 DPSEARCH_USE_NAMESPACE
 DFMBASE_USE_NAMESPACE
 
-class TestIteratorSearcherBridge : public testing::Test
-{
-public:
-    void SetUp() override
-    {
-        bridge = new IteratorSearcherBridge();
-    }
-
-    void TearDown() override
-    {
-        delete bridge;
-        bridge = nullptr;
-        stub.clear();
-    }
-
-protected:
-    stub_ext::StubExt stub;
-    IteratorSearcherBridge *bridge = nullptr;
-};
-
 class TestIteratorSearcher : public testing::Test
 {
 public:
@@ -65,62 +45,6 @@ protected:
     QString keyword;
 };
 
-// IteratorSearcherBridge Tests
-TEST_F(TestIteratorSearcherBridge, Constructor_CreatesValidInstance)
-{
-    EXPECT_NE(bridge, nullptr);
-}
-
-TEST_F(TestIteratorSearcherBridge, Constructor_WithParent_SetsParentCorrectly)
-{
-    QObject parent;
-    IteratorSearcherBridge bridgeWithParent(&parent);
-
-    EXPECT_EQ(bridgeWithParent.parent(), &parent);
-}
-
-TEST_F(TestIteratorSearcherBridge, SetSearcher_WithValidSearcher_SetsCorrectly)
-{
-    IteratorSearcher testSearcher(QUrl::fromLocalFile("/home/test"), "test");
-
-    bridge->setSearcher(&testSearcher);
-
-    EXPECT_TRUE(true);   // Test that method can be called without crash
-}
-
-TEST_F(TestIteratorSearcherBridge, SetSearcher_WithNullSearcher_HandlesCorrectly)
-{
-    bridge->setSearcher(nullptr);
-
-    EXPECT_TRUE(true);
-}
-
-TEST_F(TestIteratorSearcherBridge, CreateIterator_WithValidUrl_CallsCorrectly)
-{
-    QUrl testUrl = QUrl::fromLocalFile("/home/test");
-
-    EXPECT_NO_FATAL_FAILURE(bridge->createIterator(testUrl));
-}
-
-TEST_F(TestIteratorSearcherBridge, CreateIterator_WithInvalidUrl_HandlesCorrectly)
-{
-    QUrl invalidUrl;
-
-    EXPECT_NO_FATAL_FAILURE(bridge->createIterator(invalidUrl));
-}
-
-TEST_F(TestIteratorSearcherBridge, IteratorCreatedSignal_CanBeEmitted)
-{
-    QSignalSpy spy(bridge, &IteratorSearcherBridge::iteratorCreated);
-
-    QSharedPointer<AbstractDirIterator> mockIterator;
-
-    // Emit signal manually for testing
-    emit bridge->iteratorCreated(mockIterator);
-
-    EXPECT_EQ(spy.count(), 1);
-}
-
 // IteratorSearcher Tests
 TEST_F(TestIteratorSearcher, Constructor_WithValidParameters_CreatesInstance)
 {
@@ -211,46 +135,46 @@ TEST_F(TestIteratorSearcher, TakeAllUrls_WithResults_ReturnsUrlList)
     EXPECT_TRUE(true);
 }
 
-TEST_F(TestIteratorSearcher, RequestProcessNextDirectorySignal_CanBeEmitted)
+TEST_F(TestIteratorSearcher, ProcessDirectory_WithoutIterator_HandlesCorrectly)
 {
-    QSignalSpy spy(searcher, &IteratorSearcher::requestProcessNextDirectory);
-
-    // Emit signal manually for testing
-    emit searcher->requestProcessNextDirectory();
-
-    EXPECT_EQ(spy.count(), 1);
+    // No iterator is registered for this scheme
+    QUrl unknownUrl("unknown-scheme:///home/test");
+
+    QList<QUrl> subDirs;
+    DFMSearchResultMap results;
+    EXPECT_NO_FATAL_FAILURE(searcher->processDirectory(unknownUrl, subDirs, results));
+    EXPECT_TRUE(subDirs.isEmpty());
+    EXPECT_TRUE(results.isEmpty());
 }
 
-TEST_F(TestIteratorSearcher, RequestCreateIteratorSignal_CanBeEmitted)
+TEST_F(TestIteratorSearcher, MatchName_LiteralKeyword_IgnoresCase)
 {
-    QSignalSpy spy(searcher, &IteratorSearcher::requestCreateIterator);
-
-    QUrl testUrl = QUrl::fromLocalFile("/home/test");
-
-    // Emit signal manually for testing
-    emit searcher->requestCreateIterator(testUrl);
+    IteratorSearcher literalSearcher(searchUrl, "Report");
 
-    EXPECT_EQ(spy.count(), 1);
-    EXPECT_EQ(spy.at(0).at(0).value<QUrl>(), testUrl);
+    EXPECT_TRUE(literalSearcher.literalMatch);
+    EXPECT_TRUE(literalSearcher.matchName("annual_report.txt"));
+    EXPECT_TRUE(literalSearcher.matchName("REPORT"));
+    EXPECT_FALSE(literalSearcher.matchName("repo.txt"));
 }
 
-TEST_F(TestIteratorSearcher, OnIteratorCreated_WithValidIterator_CallsCorrectly)
+TEST_F(TestIteratorSearcher, MatchName_WildcardKeyword_UsesRegex)
 {
-    QSharedPointer<AbstractDirIterator> mockIterator;
+    IteratorSearcher wildcardSearcher(searchUrl, "*.txt");
 
-    EXPECT_NO_FATAL_FAILURE(searcher->onIteratorCreated(mockIterator));
+    EXPECT_FALSE(wildcardSearcher.literalMatch);
+    EXPECT_TRUE(wildcardSearcher.matchName("notes.TXT"));
+    EXPECT_FALSE(wildcardSearcher.matchName("notes.txt.bak"));
 }
 
-TEST_F(TestIteratorSearcher, OnIteratorCreated_WithNullIterator_HandlesCorrectly)
+TEST_F(TestIteratorSearcher, MatchName_BracketKeyword_MatchesCharacterClass)
 {
-    QSharedPointer<AbstractDirIterator> nullIterator;
+    IteratorSearcher bracketSearcher(searchUrl, "file[12]");
 
-    EXPECT_NO_FATAL_FAILURE(searcher->onIteratorCreated(nullIterator));
-}
-
-TEST_F(TestIteratorSearcher, ProcessDirectory_CallsCorrectly)
-{
-    EXPECT_NO_FATAL_FAILURE(searcher->processDirectory());
+    EXPECT_FALSE(bracketSearcher.literalMatch);
+    EXPECT_TRUE(bracketSearcher.matchName("my_file1.txt"));
+    EXPECT_TRUE(bracketSearcher.matchName("FILE2"));
+    EXPECT_FALSE(bracketSearcher.matchName("file3.txt"));
+    EXPECT_FALSE(bracketSearcher.matchName("file[12]"));
 }
 
 TEST_F(TestIteratorSearcher, CompleteWorkflow_SearchProcessTakeAllStop)
@@ -265,7 +189,6 @@ TEST_F(TestIteratorSearcher, CompleteWorkflow_SearchProcessTakeAllStop)
     });
 
     // Execute complete workflow
-    searcher->processDirectory();
     bool hasItems = searcher->hasItem();
     DFMSearchResultMap results = searcher->takeAll();
     QList<QUrl> urls = searcher->takeAllUrls();
@@ -304,17 +227,6 @@ TEST_F(TestIteratorSearcher, ThreadSafety_WithMutexProtection)
     EXPECT_TRUE(true);
 }
 
-TEST_F(TestIteratorSearcher, BridgeIntegration_WithIteratorSearcherBridge)
-{
-    // Test integration with IteratorSearcherBridge
-
-    IteratorSearcherBridge testBridge;
-    testBridge.setSearcher(searcher);
-
-    QUrl testUrl = QUrl::fromLocalFile("/home/test");
-    EXPECT_NO_FATAL_FAILURE(testBridge.createIterator(testUrl));
-}
-
 TEST_F(TestIteratorSearcher, Destructor_CleansUpResources)
 {
     // Mock cleanup operations
@@ -356,12 +268,11 @@ TEST_F(TestIteratorSearcher, StatusTransitions_FromReadyToRunningToCompleted)
     EXPECT_TRUE(true);
 }
 
-TEST_F(TestIteratorSearcher, PendingDirectoryQueue_ManagesDirectories)
+TEST_F(TestIteratorSearcher, PendingDirectoryQueue_ClearedOnStop)
 {
-    // Test that pending directory queue is properly managed
-
-    // Process directories
-    searcher->processDirectory();
+    // Test that pending directory queue is dropped when the search stops
+    searcher->pendingDirs.enqueue(searchUrl);
+    searcher->stop();
 
-    EXPECT_TRUE(true);
+    EXPECT_TRUE(searcher->pendingDirs.isEmpty());
 }
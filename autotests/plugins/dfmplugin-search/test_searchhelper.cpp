@@ -222,17 +222,15 @@ TEST_F(TestSearchHelper, AnchoredPattern_WrapsExpressionCorrectly)
 TEST_F(TestSearchHelper, IsHiddenFile_WithHiddenFile_ReturnsTrue)
 {
     QString path = QDir::homePath();
-    QHash<QString, QSet<QString>> filters;
-    EXPECT_NO_FATAL_FAILURE(SearchHelper::instance()->isHiddenFile(path, filters, "/"));
+    EXPECT_NO_FATAL_FAILURE(SearchHelper::instance()->isHiddenFile(path, "/"));
 }
 
 TEST_F(TestSearchHelper, IsHiddenFile_WithNormalFile_ReturnsFalse)
 {
     QString fileName = "normal_file.txt";
-    QHash<QString, QSet<QString>> filters;
     QString searchPath = "/home/test";
 
-    bool result = helper->isHiddenFile(fileName, filters, searchPath);
+    bool result = helper->isHiddenFile(fileName, searchPath);
 
     EXPECT_FALSE(result);
 }
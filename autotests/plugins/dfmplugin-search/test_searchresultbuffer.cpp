@@ -66,9 +66,9 @@ TEST_F(TestSearchResultBuffer, UpdateResults_WithValidResults_UpdatesBuffer)
     EXPECT_NO_FATAL_FAILURE(buffer->updateResults(testResults));
 }
 
-TEST_F(TestSearchResultBuffer, GetResults_WithNoResults_ReturnsEmptyMap)
+TEST_F(TestSearchResultBuffer, GetResults_WithNoResults_ReturnsEmptyList)
 {
-    DFMSearchResultMap results = buffer->getResults();
+    DFMSearchResultList results = buffer->getResults();
 
     EXPECT_TRUE(results.isEmpty());
 }
@@ -78,15 +78,15 @@ TEST_F(TestSearchResultBuffer, GetResults_AfterUpdate_ReturnsResults)
     DFMSearchResultMap testResults = createTestResults(2);
 
     buffer->updateResults(testResults);
-    DFMSearchResultMap retrievedResults = buffer->getResults();
+    DFMSearchResultList retrievedResults = buffer->getResults();
 
     // Results should be available (may be same or copy depending on implementation)
     EXPECT_TRUE(true); // Test that method can be called
 }
 
-TEST_F(TestSearchResultBuffer, ConsumeResults_WithNoResults_ReturnsEmptyMap)
+TEST_F(TestSearchResultBuffer, ConsumeResults_WithNoResults_ReturnsEmptyList)
 {
-    DFMSearchResultMap results = buffer->consumeResults();
+    DFMSearchResultList results = buffer->consumeResults();
 
     EXPECT_TRUE(results.isEmpty());
 }
@@ -97,10 +97,10 @@ TEST_F(TestSearchResultBuffer, ConsumeResults_AfterUpdate_ReturnsAndClearsResult
 
     buffer->updateResults(testResults);
 
-    DFMSearchResultMap consumedResults = buffer->consumeResults();
+    DFMSearchResultList consumedResults = buffer->consumeResults();
 
     // After consume, subsequent consume should return empty
-    DFMSearchResultMap secondConsume = buffer->consumeResults();
+    DFMSearchResultList secondConsume = buffer->consumeResults();
 
     EXPECT_TRUE(true); // Test that method sequence works
 }
@@ -147,7 +147,7 @@ TEST_F(TestSearchResultBuffer, DoubleBuffering_SwitchesBetweenBuffers)
     buffer->updateResults(secondResults);
 
     // Get results should return the latest
-    DFMSearchResultMap retrievedResults = buffer->getResults();
+    DFMSearchResultList retrievedResults = buffer->getResults();
 
     EXPECT_TRUE(true);
 }
@@ -160,8 +160,8 @@ TEST_F(TestSearchResultBuffer, ThreadSafety_ConcurrentReadWrite)
 
     // Simulate concurrent operations
     buffer->updateResults(testResults); // Write operation
-    DFMSearchResultMap readResults1 = buffer->getResults(); // Read operation
-    DFMSearchResultMap readResults2 = buffer->consumeResults(); // Read-modify operation
+    DFMSearchResultList readResults1 = buffer->getResults(); // Read operation
+    DFMSearchResultList readResults2 = buffer->consumeResults(); // Read-modify operation
     buffer->updateResults(testResults); // Another write operation
 
     EXPECT_TRUE(true);
@@ -186,12 +186,12 @@ TEST_F(TestSearchResultBuffer, GetAndConsume_DifferentBehavior)
     buffer->updateResults(testResults);
 
     // Get should not modify the buffer
-    DFMSearchResultMap getResult1 = buffer->getResults();
-    DFMSearchResultMap getResult2 = buffer->getResults();
+    DFMSearchResultList getResult1 = buffer->getResults();
+    DFMSearchResultList getResult2 = buffer->getResults();
 
     // Both gets should return same data (non-destructive)
     // Consume should modify the buffer
-    DFMSearchResultMap consumeResult = buffer->consumeResults();
+    DFMSearchResultList consumeResult = buffer->consumeResults();
 
     EXPECT_TRUE(true);
 }
@@ -205,10 +205,10 @@ TEST_F(TestSearchResultBuffer, LargeDataSet_HandlesEfficiently)
     EXPECT_NO_FATAL_FAILURE(buffer->updateResults(largeResults));
 
     // Read large dataset
-    DFMSearchResultMap retrievedResults = buffer->getResults();
+    DFMSearchResultList retrievedResults = buffer->getResults();
 
     // Consume large dataset
-    DFMSearchResultMap consumedResults = buffer->consumeResults();
+    DFMSearchResultList consumedResults = buffer->consumeResults();
 
     EXPECT_TRUE(true);
 }
@@ -245,13 +245,13 @@ TEST_F(TestSearchResultBuffer, AtomicOperations_UseBufferFlags)
     buffer->updateResults(results1);
 
     // Read operation - should read from current active buffer
-    DFMSearchResultMap read1 = buffer->getResults();
+    DFMSearchResultList read1 = buffer->getResults();
 
     // Second update - should switch buffer flag
     buffer->updateResults(results2);
 
     // Read operation - should read from new active buffer
-    DFMSearchResultMap read2 = buffer->getResults();
+    DFMSearchResultList read2 = buffer->getResults();
 
     EXPECT_TRUE(true);
 }
@@ -267,14 +267,14 @@ TEST_F(TestSearchResultBuffer, ComplexScenario_ProducerConsumerPattern)
 
         // Consumer: Read some results
         if (batch % 2 == 0) {
-            DFMSearchResultMap consumed = buffer->consumeResults();
+            DFMSearchResultList consumed = buffer->consumeResults();
         } else {
-            DFMSearchResultMap read = buffer->getResults();
+            DFMSearchResultList read = buffer->getResults();
         }
     }
 
     // Final consume to clear buffer
-    DFMSearchResultMap finalResults = buffer->consumeResults();
+    DFMSearchResultList finalResults = buffer->consumeResults();
     bool finalEmpty = buffer->isEmpty();
 
     EXPECT_TRUE(true);
@@ -319,3 +319,23 @@ TEST_F(TestSearchResultBuffer, MemoryManagement_HandlesLargeOperations)
 
     EXPECT_TRUE(true);
 }
+
+TEST_F(TestSearchResultBuffer, AppendResults_ConsumedInOrderOnce)
+{
+    DFMSearchResultMap first = createTestResults(2);
+    DFMSearchResultMap second;
+    const QUrl url = QUrl::fromLocalFile("/home/test/other.txt");
+    second[url] = DFMSearchResult(url);
+
+    buffer->appendResults(first);
+    buffer->appendResults(second);
+    EXPECT_FALSE(buffer->isEmpty());
+    EXPECT_EQ(buffer->getResults().size(), 3);
+
+    const DFMSearchResultList consumed = buffer->consumeResults();
+    ASSERT_EQ(consumed.size(), 3);
+    EXPECT_EQ(consumed.at(0).url(), first.firstKey());
+    EXPECT_EQ(consumed.at(2).url(), url);
+    EXPECT_TRUE(buffer->isEmpty());
+    EXPECT_TRUE(buffer->consumeResults().isEmpty());
+}
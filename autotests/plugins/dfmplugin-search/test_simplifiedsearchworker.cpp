@@ -464,3 +464,46 @@ TEST_F(TestSimplifiedSearchWorker, ResultMerging_HandlesScorePriority)
 
     EXPECT_TRUE(true);
 }
+
+TEST_F(TestSimplifiedSearchWorker, GetResultsSince_ReturnsOnlyNewAndBetterResults)
+{
+    IteratorSearcher searcher(searchUrl, searchKeyword);
+    const QUrl fileA = QUrl::fromLocalFile("/home/test/a.txt");
+    const QUrl fileB = QUrl::fromLocalFile("/home/test/b.txt");
+
+    DFMSearchResult resultA(fileA);
+    resultA.setMatchScore(0.5);
+    searcher.resultMap.insert(fileA, resultA);
+    worker->mergeResults(&searcher);
+
+    int cursor = 0;
+    DFMSearchResultMap delta = worker->getResultsSince(cursor);
+    EXPECT_EQ(delta.size(), 1);
+    EXPECT_TRUE(delta.contains(fileA));
+    EXPECT_TRUE(worker->getResultsSince(cursor).isEmpty());
+
+    // same url with a lower score is dropped, a higher score is delivered again
+    DFMSearchResult lowerA(fileA);
+    lowerA.setMatchScore(0.1);
+    searcher.resultMap.insert(fileA, lowerA);
+    searcher.resultMap.insert(fileB, DFMSearchResult(fileB));
+    worker->mergeResults(&searcher);
+
+    delta = worker->getResultsSince(cursor);
+    EXPECT_EQ(delta.size(), 1);
+    EXPECT_TRUE(delta.contains(fileB));
+
+    DFMSearchResult betterA(fileA);
+    betterA.setMatchScore(1.0);
+    searcher.resultMap.insert(fileA, betterA);
+    worker->mergeResults(&searcher);
+
+    delta = worker->getResultsSince(cursor);
+    EXPECT_EQ(delta.size(), 1);
+    EXPECT_DOUBLE_EQ(delta.value(fileA).matchScore(), 1.0);
+
+    // the full view keeps one entry per url
+    const DFMSearchResultMap all = worker->getResults();
+    EXPECT_EQ(all.size(), 2);
+    EXPECT_DOUBLE_EQ(all.value(fileA).matchScore(), 1.0);
+}
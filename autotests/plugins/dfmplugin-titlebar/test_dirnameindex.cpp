@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDir>
+
+#include "utils/dirnameindex.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <iostream>
+
+DPTITLEBAR_USE_NAMESPACE
+
+class TestDirNameIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(tempDir.isValid());
+        DirNameIndex::instance()->clear();
+
+        QDir dir(tempDir.path());
+        dir.mkpath("beta");
+        dir.mkpath("alpha");
+        dir.mkpath("alps");
+        dir.mkpath(".hidden");
+        QFile file(tempDir.filePath("alpha.txt"));
+        file.open(QIODevice::WriteOnly);
+        ASSERT_EQ(::symlink(QFile::encodeName(tempDir.filePath("beta")).constData(),
+                            QFile::encodeName(tempDir.filePath("link")).constData()),
+                  0);
+        age(tempDir.path());
+    }
+
+    // move the mtime of path out of the window in which the index does not trust it
+    void age(const QString &path)
+    {
+        struct timespec times[2];
+        clock_gettime(CLOCK_REALTIME, &times[0]);
+        times[0].tv_sec -= 60;
+        times[1] = times[0];
+        ASSERT_EQ(::utimensat(AT_FDCWD, QFile::encodeName(path).constData(), times, 0), 0);
+    }
+
+    QTemporaryDir tempDir;
+};
+
+TEST_F(TestDirNameIndex, dirNames_SortedDirectoriesOnly)
+{
+    QStringList names;
+    ASSERT_TRUE(DirNameIndex::instance()->dirNames(tempDir.path(), &names));
+    EXPECT_EQ(names, QStringList({ ".hidden", "alpha", "alps", "beta", "link" }));
+}
+
+TEST_F(TestDirNameIndex, complete_ByPrefix)
+{
+    EXPECT_EQ(DirNameIndex::instance()->complete(tempDir.path(), "al"), QStringList({ "alpha", "alps" }));
+    EXPECT_EQ(DirNameIndex::instance()->complete(tempDir.path(), "alpha"), QStringList({ "alpha" }));
+    EXPECT_TRUE(DirNameIndex::instance()->complete(tempDir.path(), "z").isEmpty());
+    EXPECT_EQ(DirNameIndex::instance()->complete(tempDir.path(), "").size(), 5);
+}
+
+TEST_F(TestDirNameIndex, cachedDirNames_DroppedWhenDirectoryChanges)
+{
+    QStringList names;
+    EXPECT_FALSE(DirNameIndex::instance()->cachedDirNames(tempDir.path(), &names));
+    ASSERT_TRUE(DirNameIndex::instance()->dirNames(tempDir.path(), &names));
+    EXPECT_TRUE(DirNameIndex::instance()->cachedDirNames(tempDir.path() + "/", &names));
+
+    QDir(tempDir.path()).mkpath("gamma");
+    EXPECT_FALSE(DirNameIndex::instance()->cachedDirNames(tempDir.path(), &names));
+    ASSERT_TRUE(DirNameIndex::instance()->dirNames(tempDir.path(), &names));
+    EXPECT_TRUE(names.contains("gamma"));
+}
+
+TEST_F(TestDirNameIndex, dirNames_MissingDirectory_Fails)
+{
+    QStringList names;
+    EXPECT_FALSE(DirNameIndex::instance()->dirNames(tempDir.filePath("missing"), &names));
+}
+
+// benchmark: first read and cached prefix lookups on a directory of 20k subdirectories
+TEST_F(TestDirNameIndex, Benchmark_CachedLookup)
+{
+    constexpr int kDirCount { 20000 };
+    QDir dir(tempDir.path());
+    dir.mkpath("big");
+    for (int i = 0; i < kDirCount; ++i)
+        ASSERT_TRUE(dir.mkdir(QString("big/d%1").arg(i)));
+
+    const QString bigPath = tempDir.filePath("big");
+    age(bigPath);
+    QElapsedTimer timer;
+    timer.start();
+    QStringList names;
+    ASSERT_TRUE(DirNameIndex::instance()->dirNames(bigPath, &names));
+    const qint64 readNs = timer.nsecsElapsed();
+    EXPECT_EQ(names.size(), kDirCount);
+
+    constexpr int kLookups { 100 };
+    timer.restart();
+    int found = 0;
+    for (int i = 0; i < kLookups; ++i)
+        found += DirNameIndex::instance()->complete(bigPath, QString("d1%1").arg(i % 10)).size();
+    const qint64 lookupNs = timer.nsecsElapsed() / kLookups;
+
+    EXPECT_GT(found, 0);
+    EXPECT_LT(lookupNs, 1000 * 1000);
+    std::cout << "[ BENCH    ] " << kDirCount << " subdirectories: first read " << readNs / 1000
+              << " us, cached prefix lookup " << lookupNs / 1000 << " us" << std::endl;
+}
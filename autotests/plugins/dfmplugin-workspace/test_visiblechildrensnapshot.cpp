@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "utils/filesortworker.h"
+
+#include <QUrl>
+
+using namespace dfmplugin_workspace;
+
+namespace {
+void expectRowsMatch(const VisibleRowIndex &index, const QList<QUrl> &urls)
+{
+    for (const QUrl &url : urls)
+        EXPECT_EQ(index.indexOf(url), urls.indexOf(url)) << url.toString().toStdString();
+}
+}   // namespace
+
+TEST(VisibleChildrenSnapshotTest, Snapshot_KeepsListAndVersion)
+{
+    const QList<QUrl> urls { QUrl::fromLocalFile("/tmp/a"),
+                             QUrl::fromLocalFile("/tmp/b") };
+    VisibleChildrenSnapshot snapshot(1, urls);
+
+    EXPECT_EQ(snapshot.version, 1u);
+    EXPECT_EQ(snapshot.urls, urls);
+}
+
+TEST(VisibleChildrenSnapshotTest, EmptySnapshot)
+{
+    VisibleChildrenSnapshot snapshot;
+
+    EXPECT_EQ(snapshot.version, 0u);
+    EXPECT_TRUE(snapshot.urls.isEmpty());
+}
+
+TEST(VisibleRowIndexTest, Reset_MatchesListOrder)
+{
+    const QUrl dup = QUrl::fromLocalFile("/tmp/dup");
+    const QList<QUrl> urls { QUrl::fromLocalFile("/tmp/a"), dup, QUrl::fromLocalFile("/tmp/c"), dup };
+    VisibleRowIndex index;
+    index.reset(urls);
+
+    expectRowsMatch(index, urls);
+    EXPECT_EQ(index.indexOf(dup), 1);
+    EXPECT_EQ(index.indexOf(QUrl::fromLocalFile("/tmp/d")), -1);
+}
+
+TEST(VisibleRowIndexTest, InsertAndRemove_UpdateFollowingRows)
+{
+    QList<QUrl> urls;
+    for (int i = 0; i < 6; ++i)
+        urls << QUrl::fromLocalFile(QString("/tmp/%1").arg(i));
+    VisibleRowIndex index;
+    index.reset(urls);
+
+    const QUrl added = QUrl::fromLocalFile("/tmp/added");
+    urls.insert(2, added);
+    index.inserted(urls, 2);
+    expectRowsMatch(index, urls);
+
+    urls.append(QUrl::fromLocalFile("/tmp/last"));
+    index.inserted(urls, urls.count() - 1);
+    expectRowsMatch(index, urls);
+
+    const QUrl removed = urls.takeAt(0);
+    index.removed(urls, 0, removed);
+    expectRowsMatch(index, urls);
+    EXPECT_EQ(index.indexOf(removed), -1);
+}
+
+TEST(VisibleRowIndexTest, Duplicates_KeepFirstRow)
+{
+    const QUrl dup = QUrl::fromLocalFile("/tmp/dup");
+    QList<QUrl> urls { QUrl::fromLocalFile("/tmp/a"), dup, QUrl::fromLocalFile("/tmp/b") };
+    VisibleRowIndex index;
+    index.reset(urls);
+
+    // a duplicate before the first one becomes the first
+    urls.insert(0, dup);
+    index.inserted(urls, 0);
+    EXPECT_EQ(index.indexOf(dup), 0);
+    expectRowsMatch(index, urls);
+
+    // removing the first one falls back to the next
+    urls.removeAt(0);
+    index.removed(urls, 0, dup);
+    EXPECT_EQ(index.indexOf(dup), 1);
+    expectRowsMatch(index, urls);
+
+    urls.removeAt(1);
+    index.removed(urls, 1, dup);
+    EXPECT_EQ(index.indexOf(dup), -1);
+    expectRowsMatch(index, urls);
+}
+
+TEST(VisibleRowIndexTest, InsertBeforeAdjacentDuplicates_ShiftsOnce)
+{
+    const QUrl dup = QUrl::fromLocalFile("/tmp/dup");
+    QList<QUrl> urls { QUrl::fromLocalFile("/tmp/a"), dup, dup, QUrl::fromLocalFile("/tmp/b") };
+    VisibleRowIndex index;
+    index.reset(urls);
+
+    urls.insert(1, QUrl::fromLocalFile("/tmp/added"));
+    index.inserted(urls, 1);
+    EXPECT_EQ(index.indexOf(dup), 2);
+    expectRowsMatch(index, urls);
+}
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// test_dialogfirstpaint.cpp - time from createDialog to the first paint, run with QT_QPA_PLATFORM=offscreen
+
+#include <gtest/gtest.h>
+#include <stub-ext/stubext.h>
+
+#include "dbus/filedialogmanagerdbus.h"
+#include "dbus/filedialoghandledbus.h"
+#include "utils/filedialogpool.h"
+#include "views/filedialog.h"
+
+#include <dfm-base/widgets/filemanagerwindowsmanager.h>
+
+#include <QApplication>
+#include <QDBusConnection>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEvent>
+
+#include <iostream>
+
+DFMBASE_USE_NAMESPACE
+using namespace filedialog_core;
+
+namespace {
+// sees the first paint of the dialog or of any of its children
+class FirstPaintWatcher : public QObject
+{
+public:
+    explicit FirstPaintWatcher(QWidget *widget)
+        : widget(widget)
+    {
+        qApp->installEventFilter(this);
+    }
+
+    ~FirstPaintWatcher() override
+    {
+        qApp->removeEventFilter(this);
+    }
+
+    bool painted() const { return isPainted; }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (!isPainted && event->type() == QEvent::Paint && watched->isWidgetType()) {
+            QWidget *target = static_cast<QWidget *>(watched);
+            isPainted = target == widget || widget->isAncestorOf(target);
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    QWidget *widget { nullptr };
+    bool isPainted { false };
+};
+
+constexpr qint64 kWaitMs { 10000 };
+}   // namespace
+
+class UT_DialogFirstPaint : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // the windows manager needs the url schemes of the loaded plugins, build the dialog directly
+        stub.set_lamda(&FileManagerWindowsManager::createWindow,
+                       [](FileManagerWindowsManager *, const QUrl &, bool, QString *) -> FileManagerWindow * {
+                           return new FileDialog(QUrl::fromLocalFile(QDir::homePath()));
+                       });
+        using RegisterObject = bool (QDBusConnection::*)(const QString &, QObject *, QDBusConnection::RegisterOptions);
+        stub.set_lamda(static_cast<RegisterObject>(&QDBusConnection::registerObject),
+                       [this](QDBusConnection *, const QString &, QObject *object, QDBusConnection::RegisterOptions) {
+                           registered = qobject_cast<FileDialogHandleDBus *>(object);
+                           return true;
+                       });
+        // keep dialogs in the pool whatever memory the test machine has
+        stub.set_lamda(&FileDialogPool::availableMemoryKiB, []() -> qint64 {
+            return 4 * 1024 * 1024;
+        });
+        manager = new FileDialogManagerDBus;
+    }
+
+    void TearDown() override
+    {
+        FileDialogPool::instance().drain();
+        delete manager;
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        stub.clear();
+    }
+
+    // milliseconds from createDialog to the first paint of the shown dialog, -1 if it is not painted
+    qint64 createAndPaint(const QString &key, int *idleAfter = nullptr)
+    {
+        registered = nullptr;
+        QElapsedTimer timer;
+        timer.start();
+        const QDBusObjectPath &path = manager->createDialog(key);
+        if (path.path().isEmpty() || !registered)
+            return -1;
+        if (idleAfter)
+            *idleAfter = FileDialogPool::instance().idleCount();
+
+        FirstPaintWatcher watcher(registered->widget());
+        registered->show();
+        while (!watcher.painted() && timer.elapsed() < kWaitMs)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        const qint64 elapsed = watcher.painted() ? timer.elapsed() : -1;
+
+        manager->destroyDialog(path);
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+        return elapsed;
+    }
+
+    bool waitForPool()
+    {
+        QElapsedTimer timer;
+        timer.start();
+        FileDialogPool::instance().scheduleRefill();
+        while (FileDialogPool::instance().idleCount() == 0 && timer.elapsed() < kWaitMs)
+            QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+        return FileDialogPool::instance().idleCount() > 0;
+    }
+
+    stub_ext::StubExt stub;
+    FileDialogManagerDBus *manager { nullptr };
+    FileDialogHandleDBus *registered { nullptr };
+};
+
+TEST_F(UT_DialogFirstPaint, Benchmark_PooledVersusBuilt)
+{
+    if (QGuiApplication::platformName() != "offscreen")
+        GTEST_SKIP() << "run with QT_QPA_PLATFORM=offscreen";
+
+    FileDialogPool::instance().drain();
+    const qint64 builtMs = createAndPaint("first-paint-built");
+    ASSERT_GE(builtMs, 0);
+
+    FileDialogPool::instance().drain();
+    ASSERT_TRUE(waitForPool());
+    const int idle = FileDialogPool::instance().idleCount();
+    int idleAfter = -1;
+    const qint64 pooledMs = createAndPaint("first-paint-pooled", &idleAfter);
+    ASSERT_GE(pooledMs, 0);
+    EXPECT_EQ(idleAfter, idle - 1);
+
+    std::cout << "[ BENCH    ] createDialog to first paint: built " << builtMs << " ms, pooled " << pooledMs
+              << " ms" << std::endl;
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include "utils/filedialogpool.h"
+
+using namespace filedialog_core;
+
+TEST(UT_FileDialogPool, capacityFor_DependsOnAvailableMemory)
+{
+    EXPECT_EQ(FileDialogPool::capacityFor(4 * 1024 * 1024), 2);
+    EXPECT_EQ(FileDialogPool::capacityFor(2 * 1024 * 1024), 2);
+    EXPECT_EQ(FileDialogPool::capacityFor(1024 * 1024), 1);
+    EXPECT_EQ(FileDialogPool::capacityFor(256 * 1024), 0);
+    // unknown memory keeps one dialog, as a plain desktop would
+    EXPECT_EQ(FileDialogPool::capacityFor(-1), 1);
+}
+
+TEST(UT_FileDialogPool, idleExitSecondsFor_ShorterWhenMemoryIsLow)
+{
+    EXPECT_EQ(FileDialogPool::idleExitSecondsFor(4 * 1024 * 1024), 600);
+    EXPECT_EQ(FileDialogPool::idleExitSecondsFor(1024 * 1024), 180);
+    EXPECT_EQ(FileDialogPool::idleExitSecondsFor(256 * 1024), 60);
+}
+
+TEST(UT_FileDialogPool, availableMemoryKiB_ReadsMeminfo)
+{
+    EXPECT_GT(FileDialogPool::availableMemoryKiB(), 0);
+}
@@ -494,6 +494,34 @@ TEST_F(UT_FSEventCollector, FlushEvents_EmitsCorrectSignals)
     EXPECT_EQ(flushSpy.count(), 1);
 }
 
+TEST_F(UT_FSEventCollector, FlushEvents_PrunesEntriesUnderCollectedDirectories)
+{
+    FSEventCollector collector(*mockMonitor);
+    collector.initialize({testPath});
+    collector.start();
+
+    QSignalSpy createdSpy(&collector, &FSEventCollector::filesCreated);
+    QSignalSpy deletedSpy(&collector, &FSEventCollector::filesDeleted);
+    QSignalSpy modifiedSpy(&collector, &FSEventCollector::filesModified);
+
+    // Children reported before their directory, the directory no longer exists on disk
+    simulateFileEvent(&collector, "fileDeleted", testPath + "/gone/sub", "a.txt");
+    simulateFileEvent(&collector, "fileModified", testPath + "/gone", "b.txt");
+    simulateFileEvent(&collector, "directoryDeleted", testPath, "gone");
+
+    simulateFileEvent(&collector, "fileCreated", testPath + "/fresh", "c.txt");
+    simulateFileEvent(&collector, "directoryCreated", testPath, "fresh");
+    simulateFileEvent(&collector, "fileCreated", testPath + "/fresh/sub", "d.txt");
+
+    collector.flushEvents();
+
+    ASSERT_EQ(deletedSpy.count(), 1);
+    EXPECT_EQ(deletedSpy.first().first().toStringList(), QStringList { testPath + "/gone" });
+    ASSERT_EQ(createdSpy.count(), 1);
+    EXPECT_EQ(createdSpy.first().first().toStringList(), QStringList { testPath + "/fresh" });
+    EXPECT_EQ(modifiedSpy.count(), 0);
+}
+
 TEST_F(UT_FSEventCollector, MaxEventCount_TriggersAutoFlush)
 {
     FSEventCollector collector(*mockMonitor);
@@ -140,6 +140,12 @@ protected:
             return mockThreadStarted;
         });
 
+        // Use the inotify backend unless a test enables fanotify
+        stub.set_lamda(ADDR(FanotifyWatcher, init), [](FanotifyWatcher *) -> bool {
+            __DBG_STUB_INVOKE__
+            return false;
+        });
+
         // Mock FSMonitorWorker
         stub.set_lamda(ADDR(FSMonitorWorker, setExclusionChecker), [](FSMonitorWorker *, const std::function<bool(const QString &)> &) {
             __DBG_STUB_INVOKE__
@@ -278,6 +284,82 @@ TEST_F(UT_FSMonitor, Start_AfterInitialization_ShouldSucceed)
     EXPECT_TRUE(mockThreadStarted);
 }
 
+// Test fanotify backend selection
+TEST_F(UT_FSMonitor, Start_WithFanotifyAvailable_ShouldSkipDirectoryCrawl)
+{
+    mockMaxUserWatchesFile(8192);
+
+    stub.set_lamda(ADDR(FanotifyWatcher, init), [](FanotifyWatcher *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    stub.set_lamda(ADDR(FanotifyWatcher, addFilesystem), [](FanotifyWatcher *, const QString &) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+
+    FSMonitor &monitor = FSMonitor::instance();
+    monitor.stop();
+    monitor.initialize({ testPath });
+
+    EXPECT_TRUE(monitor.start());
+    EXPECT_TRUE(monitor.isActive());
+    EXPECT_FALSE(monitor.d_ptr->fanotifyWatcher.isNull());
+    EXPECT_FALSE(mockThreadStarted);
+    EXPECT_TRUE(mockWatchedPaths.isEmpty());
+
+    monitor.stop();
+    EXPECT_TRUE(monitor.d_ptr->fanotifyWatcher.isNull());
+}
+
+TEST_F(UT_FSMonitor, Start_WithFanotifyMarkFailure_ShouldFallBackToInotify)
+{
+    mockMaxUserWatchesFile(8192);
+
+    stub.set_lamda(ADDR(FanotifyWatcher, init), [](FanotifyWatcher *) -> bool {
+        __DBG_STUB_INVOKE__
+        return true;
+    });
+    stub.set_lamda(ADDR(FanotifyWatcher, addFilesystem), [](FanotifyWatcher *, const QString &) -> bool {
+        __DBG_STUB_INVOKE__
+        return false;
+    });
+
+    FSMonitor &monitor = FSMonitor::instance();
+    monitor.stop();
+    monitor.initialize({ testPath });
+
+    EXPECT_TRUE(monitor.start());
+    EXPECT_TRUE(monitor.d_ptr->fanotifyWatcher.isNull());
+    EXPECT_TRUE(mockThreadStarted);
+
+    monitor.stop();
+}
+
+TEST_F(UT_FSMonitor, IsFanotifyPathAccepted_ShouldFilterLikeInotify)
+{
+    FSMonitor &monitor = FSMonitor::instance();
+    monitor.initialize({ testPath });
+    auto d = monitor.d_ptr.data();
+
+    EXPECT_TRUE(d->isFanotifyPathAccepted(testPath, "file.txt"));
+    EXPECT_TRUE(d->isFanotifyPathAccepted(testPath + "/docs", "file.txt"));
+
+    // Outside the roots, even on the same filesystem
+    EXPECT_FALSE(d->isFanotifyPathAccepted(testPath + "-other", "file.txt"));
+    EXPECT_FALSE(d->isFanotifyPathAccepted("/var/log", "syslog"));
+
+    // Hidden entries and anything below them
+    mockIndexHiddenFiles = false;
+    EXPECT_FALSE(d->isFanotifyPathAccepted(testPath, ".secret.txt"));
+    EXPECT_FALSE(d->isFanotifyPathAccepted(testPath + "/.hidden/sub", "file.txt"));
+
+    // Blacklisted directories and anything below them
+    EXPECT_FALSE(d->isFanotifyPathAccepted(testPath + "/project/node_modules/pkg", "index.md"));
+
+    EXPECT_FALSE(d->isFanotifyPathAccepted(testPath, QString()));
+}
+
 // Test blacklisted paths management
 TEST_F(UT_FSMonitor, BlacklistedPaths_AddAndRemove_ShouldWork)
 {
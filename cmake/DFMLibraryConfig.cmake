@@ -54,7 +54,20 @@ function(dfm_configure_base_library target_name)
             devicemanager_interface)
         target_sources(${target_name} PRIVATE ${Qt5App_dbus})
     endif()
-    
+
+    # Compile the pinyin dictionary into a constexpr table (utils/chinese2pinyin.cpp)
+    set(DFM_PINYIN_DICT ${DFM_SOURCE_DIR}/dfm-base/qrc/chinese2pinyin/pinyin.dict)
+    set(DFM_PINYIN_TABLE ${CMAKE_CURRENT_BINARY_DIR}/pinyintable.h)
+    add_custom_command(
+        OUTPUT ${DFM_PINYIN_TABLE}
+        COMMAND ${CMAKE_COMMAND} -DPINYIN_DICT=${DFM_PINYIN_DICT} -DPINYIN_TABLE=${DFM_PINYIN_TABLE}
+                -P ${DFM_PROJECT_ROOT}/cmake/GeneratePinyinTable.cmake
+        DEPENDS ${DFM_PINYIN_DICT} ${DFM_PROJECT_ROOT}/cmake/GeneratePinyinTable.cmake
+        COMMENT "Generating pinyin table"
+    )
+    target_sources(${target_name} PRIVATE ${DFM_PINYIN_TABLE})
+    target_include_directories(${target_name} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
+
     # Link libraries
     target_link_libraries(${target_name} 
         PUBLIC
@@ -0,0 +1,112 @@
+# GeneratePinyinTable.cmake - Compile pinyin.dict into a constexpr lookup table
+#
+# Usage: cmake -DPINYIN_DICT=<pinyin.dict> -DPINYIN_TABLE=<output header> -P GeneratePinyinTable.cmake
+#
+# Every dictionary line is "0x<code point>:<syllable>", sorted by code point.
+# The distinct syllables are stored once in a string pool, and every code point
+# between the first and the last dictionary entry maps to a 1-based syllable
+# index (0 means "no pinyin"), so a lookup is one array access at runtime.
+
+cmake_minimum_required(VERSION 3.13)
+
+if(NOT PINYIN_DICT OR NOT PINYIN_TABLE)
+    message(FATAL_ERROR "PINYIN_DICT and PINYIN_TABLE must be set")
+endif()
+
+file(STRINGS "${PINYIN_DICT}" DICT_LINES REGEX "^0x[0-9a-fA-F]+:[a-z0-9]+$")
+
+set(POOL "")
+set(POOL_SIZE 0)
+set(SYLLABLE_COUNT 0)
+set(OFFSETS "")
+set(FIRST_CODE -1)
+set(NEXT_CODE -1)
+
+# two level buffers keep the appends short, cmake copies the whole value on every append
+set(INDEX_BODY "")
+set(INDEX_ROW "")
+set(ROW_SIZE 0)
+
+macro(_append_index value)
+    string(APPEND INDEX_ROW "${value},")
+    math(EXPR ROW_SIZE "${ROW_SIZE} + 1")
+    if(ROW_SIZE EQUAL 32)
+        string(APPEND INDEX_BODY "    ${INDEX_ROW}\n")
+        set(INDEX_ROW "")
+        set(ROW_SIZE 0)
+    endif()
+endmacro()
+
+foreach(LINE IN LISTS DICT_LINES)
+    string(REPLACE ":" ";" PARTS "${LINE}")
+    list(GET PARTS 0 HEX_CODE)
+    list(GET PARTS 1 SYLLABLE)
+    math(EXPR CODE "${HEX_CODE}")
+
+    if(FIRST_CODE LESS 0)
+        set(FIRST_CODE ${CODE})
+        set(NEXT_CODE ${CODE})
+    endif()
+
+    if(CODE LESS NEXT_CODE)
+        message(FATAL_ERROR "pinyin.dict is not sorted by code point at ${LINE}")
+    endif()
+
+    while(NEXT_CODE LESS CODE)
+        _append_index(0)
+        math(EXPR NEXT_CODE "${NEXT_CODE} + 1")
+    endwhile()
+
+    if(NOT DEFINED SYLLABLE_INDEX_${SYLLABLE})
+        math(EXPR SYLLABLE_COUNT "${SYLLABLE_COUNT} + 1")
+        set(SYLLABLE_INDEX_${SYLLABLE} ${SYLLABLE_COUNT})
+        string(APPEND OFFSETS "${POOL_SIZE},")
+        string(APPEND POOL "${SYLLABLE}\\0")
+        string(LENGTH "${SYLLABLE}" SYLLABLE_LENGTH)
+        math(EXPR POOL_SIZE "${POOL_SIZE} + ${SYLLABLE_LENGTH} + 1")
+    endif()
+
+    _append_index(${SYLLABLE_INDEX_${SYLLABLE}})
+    math(EXPR NEXT_CODE "${NEXT_CODE} + 1")
+endforeach()
+
+if(FIRST_CODE LESS 0)
+    message(FATAL_ERROR "No entries found in ${PINYIN_DICT}")
+endif()
+
+string(APPEND INDEX_BODY "    ${INDEX_ROW}\n")
+math(EXPR LAST_CODE "${NEXT_CODE} - 1")
+
+file(WRITE "${PINYIN_TABLE}.tmp"
+"// Generated from pinyin.dict by GeneratePinyinTable.cmake, do not edit.
+
+#ifndef PINYINTABLE_H
+#define PINYINTABLE_H
+
+#include <cstdint>
+
+namespace Pinyin {
+namespace Table {
+
+constexpr char16_t kFirstCode { ${FIRST_CODE} };
+constexpr char16_t kLastCode { ${LAST_CODE} };
+
+// distinct syllables, each one terminated by '\\0'
+constexpr char kSyllablePool[] = \"${POOL}\";
+
+// kSyllableOffsets[i - 1] is the offset of syllable i in kSyllablePool
+constexpr uint16_t kSyllableOffsets[] = { ${OFFSETS} };
+
+// syllable index of the code point kFirstCode + n, 0 if the code point has no pinyin
+constexpr uint16_t kCodeIndex[] = {
+${INDEX_BODY}};
+
+}   // namespace Table
+}   // namespace Pinyin
+
+#endif   // PINYINTABLE_H
+")
+
+# only touch the header when the content changed, avoids needless rebuilds
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different "${PINYIN_TABLE}.tmp" "${PINYIN_TABLE}")
+file(REMOVE "${PINYIN_TABLE}.tmp")
@@ -21,6 +21,9 @@ public:
     using IconsType = std::vector<std::string>;
     using EmblemIcons = std::function<IconsType(const std::string &)>;
     using LocationEmblemIcons = std::function<DFMExtEmblem(const std::string &, int)>;
+    using LocationEmblemIconsBatch = std::function<std::vector<DFMExtEmblem>(const std::string &,
+                                                                             const std::vector<std::string> &,
+                                                                             const std::vector<int> &)>;
 
 public:
     DFMExtEmblemIconPlugin();
@@ -31,8 +34,15 @@ public:
     DFM_FAKE_VIRTUAL [[deprecated]] IconsType emblemIcons(const std::string &filePath) const;
     DFM_FAKE_VIRTUAL DFMExtEmblem locationEmblemIcons(const std::string &filePath, int systemIconCount) const;
 
+    // Query the files of one directory at once, the result has one emblem per file in the order of filePaths.
+    // Without a registered batch function every file is passed to locationEmblemIcons
+    std::vector<DFMExtEmblem> locationEmblemIconsBatch(const std::string &dirPath,
+                                                       const std::vector<std::string> &filePaths,
+                                                       const std::vector<int> &systemIconCounts) const;
+
     void registerEmblemIcons(const EmblemIcons &func);
     void registerLocationEmblemIcons(const LocationEmblemIcons &func);
+    void registerLocationEmblemIconsBatch(const LocationEmblemIconsBatch &func);
 
 private:
     DFMExtEmblemIconPluginPrivate *d { nullptr };
@@ -336,6 +336,13 @@ void FilePreviewDialog::switchToPage(int index)
 
     qCDebug(logLibFilePreview) << "FilePreviewDialog: searching preview for MIME type:" << mimeType.name() << "with keys:" << keyList;
 
+    // 前后两个文件交给预览插件提前加载，翻页时可直接显示
+    QList<QUrl> neighbourUrls;
+    if (index < fileList.count() - 1)
+        neighbourUrls.append(fileList.at(index + 1));
+    if (index > 0)
+        neighbourUrls.append(fileList.at(index - 1));
+
     // TODO: change view select item
     // if (previewDir) {
     //     QList<QUrl> selectUrl { fileList.at(index) };
@@ -351,6 +358,7 @@ void FilePreviewDialog::switchToPage(int index)
 
         if (preview && (FilePreviewFactory::isSuitedWithKey(preview, key) || FilePreviewFactory::isSuitedWithKey(preview, gKey)) && !FileUtils::isDesktopFile(fileList.at(index))) {
             qCDebug(logLibFilePreview) << "FilePreviewDialog: reusing existing preview for key:" << key;
+            preview->setProperty("NeighbourUrls", QVariant::fromValue(neighbourUrls));
             if (preview->setFileUrl(fileList.at(index))) {
                 preview->contentWidget()->updateGeometry();
                 updateTitle();
@@ -375,6 +383,7 @@ void FilePreviewDialog::switchToPage(int index)
         if (view) {
             qCDebug(logLibFilePreview) << "FilePreviewDialog: created new preview for key:" << key;
             view->initialize(this, statusBar);
+            view->setProperty("NeighbourUrls", QVariant::fromValue(neighbourUrls));
 
             if (info->canAttributes(CanableInfoType::kCanRedirectionFileUrl) && view->setFileUrl(info->urlOf(UrlInfoType::kRedirectedFileUrl))) {
                 qCDebug(logLibFilePreview) << "FilePreviewDialog: using redirected URL for preview";
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "imagedecoder.h"
+
+#include <dfm-base/utils/fileutils.h>
+
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QtConcurrent>
+
+using namespace plugin_filepreview;
+
+ImageDecoder::ImageDecoder(QObject *parent)
+    : QObject(parent)
+{
+    // the shown file and one neighbour at a time
+    pool.setMaxThreadCount(2);
+}
+
+ImageDecoder::~ImageDecoder()
+{
+    pool.clear();
+    pool.waitForDone();
+}
+
+/*!
+ * \brief ImageDecoder::cachedImage Get fileName decoded for boxSize, if it is cached and the file did not change
+ */
+bool ImageDecoder::cachedImage(const QString &fileName, const QSize &boxSize, DecodedImage *decoded) const
+{
+    auto it = cache.constFind(fileName);
+    if (it == cache.constEnd() || it->boxSize != boxSize)
+        return false;
+    if (it->lastModified != QFileInfo(fileName).lastModified())
+        return false;
+
+    *decoded = it.value();
+    return true;
+}
+
+/*!
+ * \brief ImageDecoder::request Decode fileName for boxSize on a worker thread, imageDecoded is emitted when done
+ */
+void ImageDecoder::request(const QString &fileName, const QByteArray &format, const QSize &boxSize)
+{
+    if (pending.contains(fileName) && pending.value(fileName) == boxSize)
+        return;
+
+    startDecode(fileName, format, boxSize);
+}
+
+/*!
+ * \brief ImageDecoder::prefetch Decode the files likely to be shown next, the format is detected from content
+ */
+void ImageDecoder::prefetch(const QStringList &fileNames, const QSize &boxSize)
+{
+    DecodedImage decoded;
+    for (const QString &fileName : fileNames) {
+        if (fileName.isEmpty() || cachedImage(fileName, boxSize, &decoded))
+            continue;
+        if (pending.contains(fileName) && pending.value(fileName) == boxSize)
+            continue;
+        startDecode(fileName, QByteArray(), boxSize);
+    }
+}
+
+/*!
+ * \brief ImageDecoder::keepOnly Drop the cached images of other files, their running decodes are discarded when done
+ */
+void ImageDecoder::keepOnly(const QStringList &fileNames)
+{
+    for (auto it = cache.begin(); it != cache.end();) {
+        if (fileNames.contains(it.key()))
+            ++it;
+        else
+            it = cache.erase(it);
+    }
+
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (fileNames.contains(it.key()))
+            ++it;
+        else
+            it = pending.erase(it);
+    }
+}
+
+/*!
+ * \brief ImageDecoder::fittedSize The size sourceSize is shown at, scaled down to fit boxSize but never up
+ */
+QSize ImageDecoder::fittedSize(const QSize &sourceSize, const QSize &boxSize)
+{
+    if (!sourceSize.isValid() || !boxSize.isValid())
+        return sourceSize;
+
+    const QSize bound(qMin(boxSize.width(), sourceSize.width()), qMin(boxSize.height(), sourceSize.height()));
+    return sourceSize.scaled(bound, Qt::KeepAspectRatio);
+}
+
+DecodedImage ImageDecoder::decode(const QString &fileName, const QByteArray &format, const QSize &boxSize)
+{
+    DecodedImage decoded;
+    decoded.fileName = fileName;
+    decoded.boxSize = boxSize;
+    decoded.lastModified = QFileInfo(fileName).lastModified();
+
+    QImageReader reader(fileName, format);
+    decoded.sourceSize = reader.size();
+    if (decoded.sourceSize.isValid()) {
+        const QSize &showSize = fittedSize(decoded.sourceSize, boxSize);
+        if (showSize != decoded.sourceSize)
+            reader.setScaledSize(showSize);
+        decoded.image = reader.read();
+    } else {
+        // 文件头中没有尺寸的格式只能完整解码后再缩放
+        decoded.image = reader.read();
+        decoded.sourceSize = decoded.image.size();
+        const QSize &showSize = fittedSize(decoded.sourceSize, boxSize);
+        if (!decoded.image.isNull() && showSize != decoded.sourceSize)
+            decoded.image = decoded.image.scaled(showSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    // 应用颜色空间转换，解决CMYK等格式的颜色显示问题 (仅Qt6)
+    if (!decoded.image.isNull())
+        decoded.image = DFMBASE_NAMESPACE::FileUtils::convertToSRgbColorSpace(decoded.image);
+#endif
+    return decoded;
+}
+
+void ImageDecoder::startDecode(const QString &fileName, const QByteArray &format, const QSize &boxSize)
+{
+    pending.insert(fileName, boxSize);
+
+    auto watcher = new QFutureWatcher<DecodedImage>(this);
+    connect(watcher, &QFutureWatcher<DecodedImage>::finished, this, [this, watcher, fileName, boxSize]() {
+        watcher->deleteLater();
+        // dropped by keepOnly, or a newer request for another size is still running
+        auto it = pending.find(fileName);
+        if (it == pending.end() || it.value() != boxSize)
+            return;
+        pending.erase(it);
+
+        const DecodedImage &decoded = watcher->result();
+        if (!decoded.image.isNull())
+            cache.insert(fileName, decoded);
+        else
+            cache.remove(fileName);
+
+        Q_EMIT imageDecoded(fileName);
+    });
+    watcher->setFuture(QtConcurrent::run(&pool, &ImageDecoder::decode, fileName, format, boxSize));
+}
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IMAGEDECODER_H
+#define IMAGEDECODER_H
+
+#include "preview_plugin_global.h"
+
+#include <QObject>
+#include <QImage>
+#include <QDateTime>
+#include <QHash>
+#include <QThreadPool>
+
+namespace plugin_filepreview {
+
+struct DecodedImage
+{
+    QString fileName;
+    QDateTime lastModified;
+    QSize boxSize;   // the size the image was fitted into
+    QSize sourceSize;
+    QImage image;
+};
+
+/*!
+ * \brief ImageDecoder decodes preview images on worker threads, at the size they are shown.
+ *
+ * QImageReader::setScaledSize lets the jpeg reader decode at a reduced DCT scale and
+ * the other readers scale right after reading, so no full size pixmap is made on the
+ * GUI thread. The current file and its neighbours in the preview list are kept,
+ * paging to a neighbour is served from memory.
+ */
+class ImageDecoder : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ImageDecoder(QObject *parent = nullptr);
+    ~ImageDecoder() override;
+
+    bool cachedImage(const QString &fileName, const QSize &boxSize, DecodedImage *decoded) const;
+    void request(const QString &fileName, const QByteArray &format, const QSize &boxSize);
+    void prefetch(const QStringList &fileNames, const QSize &boxSize);
+    void keepOnly(const QStringList &fileNames);
+
+    static QSize fittedSize(const QSize &sourceSize, const QSize &boxSize);
+    static DecodedImage decode(const QString &fileName, const QByteArray &format, const QSize &boxSize);
+
+Q_SIGNALS:
+    void imageDecoded(const QString &fileName);
+
+private:
+    void startDecode(const QString &fileName, const QByteArray &format, const QSize &boxSize);
+
+    QThreadPool pool;
+    QHash<QString, DecodedImage> cache;
+    QHash<QString, QSize> pending;   // file name -> box size being decoded
+};
+
+}
+
+#endif   // IMAGEDECODER_H
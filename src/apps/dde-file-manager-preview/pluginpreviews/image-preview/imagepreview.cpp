@@ -97,18 +97,12 @@ bool ImagePreview::setFileUrl(const QUrl &url)
         return true;
     }
 
-    QUrl tmpUrl = UrlRoute::fromLocalFile(url.path());
-    FileInfoPointer info = InfoFactory::create<FileInfo>(url);
-    if (info.isNull()) {
+    QUrl tmpUrl;
+    if (!localFileUrl(url, &tmpUrl)) {
         fmWarning() << "Image preview: failed to create FileInfo for:" << url;
         return false;
     }
 
-    if (info->canAttributes(CanableInfoType::kCanRedirectionFileUrl)) {
-        tmpUrl = info->urlOf(UrlInfoType::kRedirectedFileUrl);
-        fmDebug() << "Image preview: using redirected URL:" << tmpUrl;
-    }
-
     if (!tmpUrl.isLocalFile()) {
         fmWarning() << "Image preview: URL is not a local file:" << tmpUrl;
         return false;
@@ -125,16 +119,14 @@ bool ImagePreview::setFileUrl(const QUrl &url)
     if (!imageView) {
         fmDebug() << "Image preview: creating new ImageView for:" << tmpUrl.toLocalFile() << "format:" << format;
         imageView = new ImageView(tmpUrl.toLocalFile(), format);
+        connect(imageView, &ImageView::sourceSizeChanged, this, &ImagePreview::updateSizeText);
     } else {
         fmDebug() << "Image preview: updating existing ImageView with:" << tmpUrl.toLocalFile() << "format:" << format;
         imageView->setFile(tmpUrl.toLocalFile(), format);
     }
 
-    const QSize &image_size = imageView->sourceSize();
-    fmDebug() << "Image preview: image size:" << image_size;
-
-    messageStatusBar->setText(QString("%1x%2").arg(image_size.width()).arg(image_size.height()));
-    messageStatusBar->adjustSize();
+    updateSizeText(imageView->sourceSize());
+    prefetchNeighbours();
 
     imageTitle = QFileInfo(tmpUrl.toLocalFile()).fileName();
 
@@ -144,6 +136,44 @@ bool ImagePreview::setFileUrl(const QUrl &url)
     return true;
 }
 
+void ImagePreview::updateSizeText(const QSize &imageSize)
+{
+    fmDebug() << "Image preview: image size:" << imageSize;
+
+    messageStatusBar->setText(QString("%1x%2").arg(imageSize.width()).arg(imageSize.height()));
+    messageStatusBar->adjustSize();
+}
+
+/*!
+ * \brief ImagePreview::prefetchNeighbours Decode the previous and next files of the preview list
+ * ahead, the dialog passes them in the NeighbourUrls property
+ */
+void ImagePreview::prefetchNeighbours()
+{
+    const QList<QUrl> &neighbours = property("NeighbourUrls").value<QList<QUrl>>();
+    QStringList fileNames;
+    for (const QUrl &neighbour : neighbours) {
+        QUrl localUrl;
+        if (localFileUrl(neighbour, &localUrl) && localUrl.isLocalFile())
+            fileNames.append(localUrl.toLocalFile());
+    }
+    imageView->prefetch(fileNames);
+}
+
+bool ImagePreview::localFileUrl(const QUrl &url, QUrl *localUrl) const
+{
+    FileInfoPointer info = InfoFactory::create<FileInfo>(url);
+    if (info.isNull())
+        return false;
+
+    *localUrl = UrlRoute::fromLocalFile(url.path());
+    if (info->canAttributes(CanableInfoType::kCanRedirectionFileUrl)) {
+        *localUrl = info->urlOf(UrlInfoType::kRedirectedFileUrl);
+        fmDebug() << "Image preview: using redirected URL:" << *localUrl;
+    }
+    return true;
+}
+
 QUrl ImagePreview::fileUrl() const
 {
     return currentFileUrl;
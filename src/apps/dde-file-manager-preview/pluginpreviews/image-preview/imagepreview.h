@@ -35,6 +35,10 @@ public:
     QString title() const override;
 
 private:
+    void updateSizeText(const QSize &imageSize);
+    void prefetchNeighbours();
+    bool localFileUrl(const QUrl &url, QUrl *localUrl) const;
+
     QUrl currentFileUrl;
     QPointer<QLabel> messageStatusBar;
     QPointer<ImageView> imageView;
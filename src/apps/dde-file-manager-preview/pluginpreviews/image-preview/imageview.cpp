@@ -3,9 +3,9 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "imageview.h"
+#include "imagedecoder.h"
 
 #include <dfm-base/utils/windowutils.h>
-#include <dfm-base/utils/fileutils.h>
 
 #include <QUrl>
 #include <QImageReader>
@@ -23,8 +23,10 @@ using namespace plugin_filepreview;
 #define MIN_SIZE QSize(400, 300)
 
 ImageView::ImageView(const QString &fileName, const QByteArray &format, QWidget *parent)
-    : QLabel(parent)
+    : QLabel(parent),
+      decoder(new ImageDecoder(this))
 {
+    connect(decoder, &ImageDecoder::imageDecoded, this, &ImageView::showDecodedImage);
     setFile(fileName, format);
     setMinimumSize(MIN_SIZE);
     setAlignment(Qt::AlignCenter);
@@ -32,7 +34,8 @@ ImageView::ImageView(const QString &fileName, const QByteArray &format, QWidget
 
 void ImageView::setFile(const QString &fileName, const QByteArray &format)
 {
-    const QSize &dsize = DFMBASE_NAMESPACE::WindowUtils::cursorScreen()->size();
+    currentFileName = fileName;
+    currentBoxSize = previewBoxSize();
 
     if (format == QByteArrayLiteral("gif")) {
         if (movie) {
@@ -44,8 +47,8 @@ void ImageView::setFile(const QString &fileName, const QByteArray &format)
         setMovie(movie);
         movie->start();
         sourceImageSize = movie->frameRect().size();
-        QSize showSize = QSize(qMin(static_cast<int>(dsize.width() * 0.7), sourceImageSize.width()),
-                               qMin(static_cast<int>(dsize.height() * 0.7), sourceImageSize.height()));
+        QSize showSize = QSize(qMin(currentBoxSize.width(), sourceImageSize.width()),
+                               qMin(currentBoxSize.height(), sourceImageSize.height()));
         setFixedSize(showSize);
         movie->setScaledSize(showSize);
         return;
@@ -61,23 +64,64 @@ void ImageView::setFile(const QString &fileName, const QByteArray &format)
         tmpMovie->deleteLater();
     }
 
-    QImage image(fileName, format);
-    sourceImageSize = image.size();
-    if (!sourceImageSize.isValid()) {
-        setPixmap(QPixmap());
+    DecodedImage decoded;
+    if (decoder->cachedImage(fileName, currentBoxSize, &decoded)) {
+        sourceImageSize = decoded.sourceSize;
+        setPixmap(QPixmap::fromImage(decoded.image));
         return;
     }
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        // 应用颜色空间转换，解决CMYK等格式的颜色显示问题 (仅Qt6)
-    image = DFMBASE_NAMESPACE::FileUtils::convertToSRgbColorSpace(image);
-#endif
-    QSize showSize = QSize(qMin(static_cast<int>(dsize.width() * 0.7), sourceImageSize.width()),
-                           qMin(static_cast<int>(dsize.height() * 0.7), sourceImageSize.height()));
-    QPixmap pixmap = QPixmap::fromImage(image).scaled(showSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    setPixmap(pixmap);
+
+    // 只读取文件头得到原始尺寸并占位，缩小后的图像在线程中解码
+    QImageReader reader(fileName, format);
+    sourceImageSize = reader.size();
+    if (sourceImageSize.isValid()) {
+        QPixmap placeholder(ImageDecoder::fittedSize(sourceImageSize, currentBoxSize));
+        placeholder.fill(Qt::transparent);
+        setPixmap(placeholder);
+    } else {
+        setPixmap(QPixmap());
+    }
+    decoder->request(fileName, format, currentBoxSize);
+}
+
+/*!
+ * \brief ImageView::prefetch Decode the files next to the current one in the preview list
+ */
+void ImageView::prefetch(const QStringList &fileNames)
+{
+    QStringList keep(fileNames);
+    keep.append(currentFileName);
+    decoder->keepOnly(keep);
+    decoder->prefetch(fileNames, currentBoxSize);
 }
 
 QSize ImageView::sourceSize() const
 {
     return sourceImageSize;
 }
+
+QSize ImageView::previewBoxSize() const
+{
+    const QSize &dsize = DFMBASE_NAMESPACE::WindowUtils::cursorScreen()->size();
+    return QSize(static_cast<int>(dsize.width() * 0.7), static_cast<int>(dsize.height() * 0.7));
+}
+
+void ImageView::showDecodedImage(const QString &fileName)
+{
+    if (fileName != currentFileName || movie)
+        return;
+
+    DecodedImage decoded;
+    if (!decoder->cachedImage(fileName, currentBoxSize, &decoded)) {
+        sourceImageSize = QSize();
+        setPixmap(QPixmap());
+        Q_EMIT sourceSizeChanged(sourceImageSize);
+        return;
+    }
+
+    const bool sizeChanged = decoded.sourceSize != sourceImageSize;
+    sourceImageSize = decoded.sourceSize;
+    setPixmap(QPixmap::fromImage(decoded.image));
+    if (sizeChanged)
+        Q_EMIT sourceSizeChanged(sourceImageSize);
+}
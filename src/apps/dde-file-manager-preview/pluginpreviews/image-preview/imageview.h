@@ -8,6 +8,7 @@
 #include "preview_plugin_global.h"
 #include <QLabel>
 namespace plugin_filepreview {
+class ImageDecoder;
 class ImageView : public QLabel
 {
     Q_OBJECT
@@ -15,11 +16,21 @@ public:
     explicit ImageView(const QString &fileName, const QByteArray &format, QWidget *parent = nullptr);
 
     void setFile(const QString &fileName, const QByteArray &format);
+    void prefetch(const QStringList &fileNames);
     QSize sourceSize() const;
 
+Q_SIGNALS:
+    void sourceSizeChanged(const QSize &size);
+
 private:
+    QSize previewBoxSize() const;
+    void showDecodedImage(const QString &fileName);
+
     QSize sourceImageSize;
     QMovie *movie { nullptr };
+    ImageDecoder *decoder { nullptr };
+    QString currentFileName;
+    QSize currentBoxSize;
 };
 }
 #endif   // IMAGEVIEW_H
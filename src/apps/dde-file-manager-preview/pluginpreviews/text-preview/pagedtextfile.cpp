@@ -0,0 +1,275 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "pagedtextfile.h"
+
+#include <DTextEncoding>
+
+#include <QFile>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace plugin_filepreview;
+DCORE_USE_NAMESPACE
+
+// 编码检测只看文件开头的这些字节
+static constexpr qint64 kDetectSize { 64 * 1024 };
+
+namespace {
+
+// 检查是否为合法的 UTF-8，truncated 为 true 时允许末尾的字符不完整
+bool isUtf8(const uchar *s, qint64 len, bool truncated)
+{
+    qint64 i = 0;
+    while (i < len) {
+        const uchar c = s[i];
+        if (c < 0x80) {
+            ++i;
+            continue;
+        }
+
+        int follow = 0;
+        if (c >= 0xC2 && c <= 0xDF)
+            follow = 1;
+        else if (c >= 0xE0 && c <= 0xEF)
+            follow = 2;
+        else if (c >= 0xF0 && c <= 0xF4)
+            follow = 3;
+        else
+            return false;
+
+        for (int k = 1; k <= follow; ++k) {
+            if (i + k >= len)
+                return truncated;
+            if ((s[i + k] & 0xC0) != 0x80)
+                return false;
+        }
+        i += follow + 1;
+    }
+    return true;
+}
+
+}   // namespace
+
+PagedTextFile::PagedTextFile()
+{
+}
+
+PagedTextFile::~PagedTextFile()
+{
+    close();
+}
+
+bool PagedTextFile::open(const QString &filePath)
+{
+    close();
+
+    fd = ::open(QFile::encodeName(filePath).constData(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+        close();
+        return false;
+    }
+    fileSize = st.st_size;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    QByteArray head(static_cast<int>(qMin(fileSize, kDetectSize)), Qt::Uninitialized);
+    const qint64 headSize = readAt(0, head.data(), head.size());
+    if (headSize <= 0) {
+        close();
+        return false;
+    }
+    encodingName = detectEncoding(head.constData(), headSize, headSize < fileSize);
+
+    // UTF 和系统编码由 Qt 有状态地解码，Qt 不支持的编码交给 iconv，页边界都可以落在字符中间
+    decoder = encodingName.isEmpty() ? QStringDecoder(QStringDecoder::System)
+                                     : QStringDecoder(encodingName.constData());
+    if (!decoder.isValid())
+        converter = iconv_open("UTF-8", encodingName.constData());
+    return true;
+}
+
+void PagedTextFile::close()
+{
+    if (fd >= 0)
+        ::close(fd);
+    if (converter != reinterpret_cast<iconv_t>(-1))
+        iconv_close(converter);
+
+    fd = -1;
+    fileSize = 0;
+    offset = 0;
+    encodingName.clear();
+    decoder = QStringDecoder();
+    converter = reinterpret_cast<iconv_t>(-1);
+    pendingBytes.clear();
+}
+
+qint64 PagedTextFile::size() const
+{
+    return fileSize;
+}
+
+qint64 PagedTextFile::position() const
+{
+    return offset;
+}
+
+bool PagedTextFile::atEnd() const
+{
+    return offset >= fileSize;
+}
+
+/*!
+ * \brief PagedTextFile::encoding 检测到的编码，为空表示按系统编码解码
+ */
+QByteArray PagedTextFile::encoding() const
+{
+    return encodingName;
+}
+
+/*!
+ * \brief PagedTextFile::readPage 从当前位置读取并解码最多 maxBytes 字节，尽量在换行处分页
+ */
+QString PagedTextFile::readPage(qint64 maxBytes)
+{
+    if (fd < 0 || offset >= fileSize) {
+        offset = fileSize;
+        return QString();
+    }
+
+    // 复制到缓冲区再解码，文件在预览期间被截断时只会读到更少的数据，不会像访问映射那样触发 SIGBUS
+    const qint64 wanted = qMin(qMax<qint64>(maxBytes, 1), fileSize - offset);
+    QByteArray page(static_cast<int>(wanted), Qt::Uninitialized);
+    const qint64 len = readAt(offset, page.data(), wanted);
+    if (len <= 0) {
+        offset = fileSize;
+        return decodePage(QByteArray(), true);
+    }
+    page.truncate(static_cast<int>(len));
+
+    const bool last = len < wanted || offset + len >= fileSize;
+    if (!last)
+        page.truncate(static_cast<int>(pageEnd(page)));
+    offset = last ? fileSize : offset + page.size();
+
+    return decodePage(page, last);
+}
+
+/*!
+ * \brief PagedTextFile::detectEncoding 根据 BOM 和一次 UTF-8 校验判断编码，
+ * 都不符合时才交给 DTextEncoding 检测
+ */
+QByteArray PagedTextFile::detectEncoding(const char *data, qint64 size, bool truncated)
+{
+    const uchar *s = reinterpret_cast<const uchar *>(data);
+    const qint64 len = qMin(size, kDetectSize);
+
+    if (len >= 3 && s[0] == 0xEF && s[1] == 0xBB && s[2] == 0xBF)
+        return "UTF-8";
+    if (len >= 4 && s[0] == 0xFF && s[1] == 0xFE && s[2] == 0 && s[3] == 0)
+        return "UTF-32LE";
+    if (len >= 4 && s[0] == 0 && s[1] == 0 && s[2] == 0xFE && s[3] == 0xFF)
+        return "UTF-32BE";
+    if (len >= 2 && s[0] == 0xFF && s[1] == 0xFE)
+        return "UTF-16LE";
+    if (len >= 2 && s[0] == 0xFE && s[1] == 0xFF)
+        return "UTF-16BE";
+
+    if (isUtf8(s, len, truncated || len < size))
+        return "UTF-8";
+
+    const QByteArray &detected = DTextEncoding::detectTextEncoding(QByteArray::fromRawData(data, static_cast<int>(len)));
+    return detected.isEmpty() ? QByteArray() : detected.toUpper();
+}
+
+qint64 PagedTextFile::readAt(qint64 pos, char *buffer, qint64 maxSize) const
+{
+    qint64 total = 0;
+    while (total < maxSize) {
+        const ssize_t ret = pread(fd, buffer + total, static_cast<size_t>(maxSize - total), pos + total);
+        if (ret == 0)
+            break;
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return total > 0 ? total : -1;
+        }
+        total += ret;
+    }
+    return total;
+}
+
+qint64 PagedTextFile::pageEnd(const QByteArray &page)
+{
+    // 在后半页中找最后一个换行
+    const qint64 from = page.size() / 2;
+    const void *newline = memrchr(page.constData() + from, '\n', static_cast<size_t>(page.size() - from));
+    if (newline)
+        return static_cast<const char *>(newline) - page.constData() + 1;
+    return page.size();
+}
+
+QString PagedTextFile::decodePage(const QByteArray &page, bool last)
+{
+    if (decoder.isValid())
+        return decoder.decode(page);
+    if (converter != reinterpret_cast<iconv_t>(-1))
+        return convertPage(page, last);
+    return QString::fromLocal8Bit(page);
+}
+
+/*!
+ * \brief PagedTextFile::convertPage 用 iconv 转换一页，末尾不完整的字符留到下一页，
+ * 无法转换的字节显示为替换字符
+ */
+QString PagedTextFile::convertPage(const QByteArray &page, bool last)
+{
+    QByteArray in = pendingBytes + page;
+    pendingBytes.clear();
+
+    QByteArray out(in.size() * 2 + 16, Qt::Uninitialized);
+    char *inPtr = in.data();
+    size_t inLeft = static_cast<size_t>(in.size());
+    char *outPtr = out.data();
+    size_t outLeft = static_cast<size_t>(out.size());
+    while (inLeft > 0) {
+        if (iconv(converter, &inPtr, &inLeft, &outPtr, &outLeft) != static_cast<size_t>(-1))
+            break;
+
+        if (errno == E2BIG) {
+            const qint64 used = outPtr - out.data();
+            out.resize(out.size() * 2);
+            outPtr = out.data() + used;
+            outLeft = static_cast<size_t>(out.size() - used);
+            continue;
+        }
+        if (errno == EINVAL && !last) {
+            pendingBytes = QByteArray(inPtr, static_cast<int>(inLeft));
+            break;
+        }
+
+        // 非法或文件末尾不完整的字节
+        if (outLeft < 3) {
+            const qint64 used = outPtr - out.data();
+            out.resize(out.size() + 16);
+            outPtr = out.data() + used;
+            outLeft = static_cast<size_t>(out.size() - used);
+        }
+        memcpy(outPtr, "\xEF\xBF\xBD", 3);
+        outPtr += 3;
+        outLeft -= 3;
+        ++inPtr;
+        --inLeft;
+    }
+
+    return QString::fromUtf8(out.constData(), static_cast<int>(outPtr - out.constData()));
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PAGEDTEXTFILE_H
+#define PAGEDTEXTFILE_H
+
+#include "preview_plugin_global.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringDecoder>
+
+#include <iconv.h>
+
+namespace plugin_filepreview {
+
+/*!
+ * \brief PagedTextFile 以只读方式打开文本文件，按页读取并解码给预览使用。
+ *
+ * 打开文件只做一次编码检测（检测只看文件开头的一段字节），
+ * 内容在滚动到末尾时才逐页用 pread 读取并解码，因此打开大文件的耗时和内存与文件大小无关。
+ * 解码状态跨页保留，页边界落在多字节字符中间时剩余的字节留给下一页。
+ */
+class PagedTextFile
+{
+    Q_DISABLE_COPY(PagedTextFile)
+public:
+    PagedTextFile();
+    ~PagedTextFile();
+
+    bool open(const QString &filePath);
+    void close();
+
+    qint64 size() const;
+    qint64 position() const;
+    bool atEnd() const;
+    QByteArray encoding() const;
+
+    QString readPage(qint64 maxBytes);
+
+    static QByteArray detectEncoding(const char *data, qint64 size, bool truncated = false);
+
+private:
+    qint64 readAt(qint64 pos, char *buffer, qint64 maxSize) const;
+    static qint64 pageEnd(const QByteArray &page);
+    QString decodePage(const QByteArray &page, bool last);
+    QString convertPage(const QByteArray &page, bool last);
+
+    int fd { -1 };
+    qint64 fileSize { 0 };
+    qint64 offset { 0 };
+    QByteArray encodingName;
+    QStringDecoder decoder;
+    iconv_t converter { reinterpret_cast<iconv_t>(-1) };   // Qt 不支持的编码
+    QByteArray pendingBytes;   // 上一页末尾不完整的字符
+};
+
+}
+
+#endif   // PAGEDTEXTFILE_H
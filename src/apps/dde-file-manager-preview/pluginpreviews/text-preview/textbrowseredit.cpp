@@ -3,14 +3,15 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "textbrowseredit.h"
+#include "pagedtextfile.h"
 
 #include <QScrollBar>
+#include <QTextCursor>
 #include <QDebug>
 
-#include <algorithm>
-
 using namespace plugin_filepreview;
-constexpr int kReadTextSize { 1024 * 1024 * 5 };
+// 每次滚动到底部时追加解码的字节数
+constexpr qint64 kPageSize { 1024 * 1024 };
 TextBrowserEdit::TextBrowserEdit(QWidget *parent)
     : QPlainTextEdit(parent)
 {
@@ -28,15 +29,13 @@ TextBrowserEdit::TextBrowserEdit(QWidget *parent)
 
 TextBrowserEdit::~TextBrowserEdit()
 {
-    filestr.clear();
 }
 
-void TextBrowserEdit::setFileData(std::string &data)
+void TextBrowserEdit::setTextFile(const QSharedPointer<PagedTextFile> &file)
 {
     clear();
-    filestr = data;
-    std::string::iterator temp = filestr.begin();
-    appendText(temp);
+    textFile = file;
+    appendText();
     this->moveCursor(QTextCursor::Start, QTextCursor::MoveAnchor);
     lastPosition = verticalScrollBar()->sliderPosition();
 }
@@ -47,10 +46,7 @@ void TextBrowserEdit::wheelEvent(QWheelEvent *e)
     if (numDegrees.y() < 0) {
         int sbValue = verticalScrollBar()->value();
         if (verticalScrollBar()->maximum() <= sbValue) {
-            if (!filestr.empty()) {
-                std::string::iterator data = filestr.begin();
-                appendText(data);
-            }
+            appendText();
         }
     }
     QPlainTextEdit::wheelEvent(e);
@@ -68,64 +64,23 @@ void TextBrowserEdit::sliderPositionValueChange(int position)
 {
     if (position > lastPosition) {
         if (verticalScrollBar()->maximum() <= position) {
-            if (!filestr.empty()) {
-                std::string::iterator data = filestr.begin();
-                appendText(data);
-            }
+            appendText();
         }
     }
     lastPosition = position;
 }
 
-int TextBrowserEdit::verifyEndOfStrIntegrity(const char *s, int l)
-{
-    int len = 0, i = 0;
-    if (s == nullptr || *s == 0 || l <= 0) {
-        return 0;
-    }
-    while (*s) {
-        if ((*s & 0x80) == 0) {
-            i++;
-            s++;
-            len++;
-        } else {
-            if (*(s + 1) == 0)
-                break;
-            i += 3;
-            s += 3;
-            len += 3;
-        }
-
-        if (i == l)
-            break;
-        else if (i > l) {
-            len -= 3;
-            break;
-        }
-    }
-    return len;
-}
-
-void TextBrowserEdit::appendText(std::string::iterator &data)
+void TextBrowserEdit::appendText()
 {
-    if (filestr.size() >= kReadTextSize) {
-        char temp[kReadTextSize] { 0 };
+    if (!textFile || textFile->atEnd())
+        return;
 
-        std::copy(data, data + kReadTextSize, temp);
+    const QString &textData = textFile->readPage(kPageSize);
+    if (textData.isEmpty())
+        return;
 
-        char ch = temp[kReadTextSize - 1];
-        int l = verifyEndOfStrIntegrity(temp, kReadTextSize);
-        if (!(0 <= ch && 127 >= static_cast<int>(ch))) {
-            temp[l] = '\0';
-        }
-
-        filestr.erase(std::begin(filestr), std::begin(filestr) + l);
-        QString textData = QString::fromLocal8Bit(temp, l);
-        appendPlainText(textData);
-    } else if (filestr.size() > 0) {
-        unsigned long len = static_cast<unsigned long>(filestr.size());
-        QString textData = QString::fromLocal8Bit(filestr.c_str(), static_cast<int>(len));
-        insertPlainText(textData);
-        filestr.clear();
-    }
+    // 接在文档末尾，不影响当前的光标和选中内容
+    QTextCursor cursor(document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.insertText(textData);
 }
@@ -7,10 +7,10 @@
 #include "preview_plugin_global.h"
 
 #include <QPlainTextEdit>
-
-#include <vector>
+#include <QSharedPointer>
 
 namespace plugin_filepreview {
+class PagedTextFile;
 class TextBrowserEdit : public QPlainTextEdit
 {
     Q_OBJECT
@@ -19,7 +19,7 @@ public:
 
     virtual ~TextBrowserEdit() override;
 
-    void setFileData(std::string &data);
+    void setTextFile(const QSharedPointer<PagedTextFile> &file);
 
 protected:
     void wheelEvent(QWheelEvent *e) override;
@@ -30,11 +30,9 @@ private slots:
     void sliderPositionValueChange(int position);
 
 private:
-    int verifyEndOfStrIntegrity(const char *s, int l);
-
-    void appendText(std::string::iterator &data);
+    void appendText();
 
-    std::string filestr;
+    QSharedPointer<PagedTextFile> textFile;
 
     int lastPosition { 0 };
 };
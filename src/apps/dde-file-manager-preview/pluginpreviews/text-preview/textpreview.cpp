@@ -5,20 +5,17 @@
 #include "textpreview.h"
 #include "textbrowseredit.h"
 #include "textcontextwidget.h"
+#include "pagedtextfile.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
 
-#include <DTextEncoding>
-
 #include <QProcess>
 #include <QUrl>
 #include <QFileInfo>
 #include <QDebug>
 
-using namespace std;
 DFMBASE_USE_NAMESPACE
 using namespace plugin_filepreview;
-static constexpr int kReadTextSize { 1024 * 1024 * 5 };
 
 TextPreview::TextPreview(QObject *parent)
     : AbstractBasePreview(parent)
@@ -57,15 +54,14 @@ bool TextPreview::setFileUrl(const QUrl &url)
         return false;
     }
 
-    selectUrl = url;
-
-    device.open(filePath.toLocal8Bit().data(), ios::binary);
-
-    if (!device.is_open()) {
-        fmWarning() << "Text preview: failed to open file:" << filePath;
+    QSharedPointer<PagedTextFile> textFile(new PagedTextFile);
+    if (!textFile->open(filePath)) {
+        fmWarning() << "Text preview: file is empty or cannot be opened:" << filePath;
         return false;
     }
 
+    selectUrl = url;
+
     if (!textBrowser) {
         fmDebug() << "Text preview: creating new TextContextWidget";
         textBrowser = new TextContextWidget;
@@ -73,44 +69,8 @@ bool TextPreview::setFileUrl(const QUrl &url)
 
     titleStr = QFileInfo(filePath).fileName();
 
-    long len = device.seekg(0, ios::end).tellg();
-    if (len <= 0) {
-        fmWarning() << "Text preview: file is empty or cannot determine size:" << filePath;
-        device.close();
-        return false;
-    }
-
-    fmDebug() << "Text preview: file size:" << len << "bytes, will read up to:" << kReadTextSize << "bytes";
-
-    if (len > kReadTextSize) {
-        fmDebug() << "Text preview: file size exceeds limit, truncating to:" << kReadTextSize << "bytes";
-        len = kReadTextSize;
-    }
-
-    char *buf = new char[static_cast<unsigned long>(len)];
-    device.seekg(0, ios::beg).read(buf, static_cast<streamsize>(len));
-    device.close();
-    
-    bool ok { false };
-    QString fileEncoding = DTK_NAMESPACE::DCORE_NAMESPACE::DTextEncoding::detectFileEncoding(filePath, &ok);
-    fmDebug() << "Text preview: detected file encoding:" << fileEncoding << "detection success:" << ok;
-    
-    std::string strBuf(buf, static_cast<unsigned long>(len));
-    if (ok && fileEncoding.toLower() != "utf-8") {
-        fmDebug() << "Text preview: converting from" << fileEncoding << "to UTF-8";
-        QByteArray out;
-        QByteArray in(buf, static_cast<int>(len));
-        if (DTK_NAMESPACE::DCORE_NAMESPACE::DTextEncoding::convertTextEncoding(in, out, "utf-8")) {
-            strBuf = out.toStdString();
-            fmDebug() << "Text preview: encoding conversion successful";
-        } else {
-            fmWarning() << "Text preview: encoding conversion failed, using original data";
-        }
-    }
-    
-    textBrowser->textBrowserEdit()->setFileData(strBuf);
-    delete[] buf;
-    buf = nullptr;
+    fmDebug() << "Text preview: file size:" << textFile->size() << "bytes, detected encoding:" << textFile->encoding();
+    textBrowser->textBrowserEdit()->setTextFile(textFile);
 
     fmInfo() << "Text preview: file loaded successfully:" << filePath << "title:" << titleStr;
     Q_EMIT titleChanged();
@@ -14,8 +14,6 @@
 #include <QTimer>
 #include <QString>
 
-#include <fstream>
-
 namespace plugin_filepreview {
 class TextContextWidget;
 class TextPreview : public DFMBASE_NAMESPACE::AbstractBasePreview
@@ -39,13 +37,6 @@ private:
     QString titleStr;
 
     TextContextWidget *textBrowser { nullptr };
-
-    //! 操作文件的对象
-    std::ifstream device;
-
-    int textSize = 0;
-
-    int readSize = 0;
 };
 }
 #endif   // TEXTPREVIEW_H
@@ -100,16 +100,27 @@ bool DeviceProxyManager::isDBusRuning()
     return d->isDBusRuning();
 }
 
+/*!
+ * \brief DeviceProxyManager::classifyPath Classify filePath by the gvfs layout and the known mounts in one lookup
+ */
+PathClassifier::PathTypes DeviceProxyManager::classifyPath(const QString &filePath)
+{
+    if (filePath.isEmpty())
+        return PathClassifier::kNone;
+
+    d->initMounts();
+    QReadLocker lk(&d->lock);
+    return d->classifier.classify(filePath);
+}
+
 bool DeviceProxyManager::isFileOfExternalMounts(const QString &filePath)
 {
     if (filePath.isEmpty())
         return false;
 
     d->initMounts();
-    const QStringList &&mpts = d->externalMounts.values();
-    QString path = filePath.endsWith("/") ? filePath : filePath + "/";
-    auto ret = std::find_if(mpts.cbegin(), mpts.cend(), [path](const QString &mpt) { return path.startsWith(mpt); });
-    return ret != mpts.cend();
+    QReadLocker lk(&d->lock);
+    return d->classifier.classifyMountPath(filePath).testFlag(PathClassifier::kExternalMount);
 }
 
 bool DeviceProxyManager::isFileOfProtocolMounts(const QString &filePath)
@@ -118,13 +129,8 @@ bool DeviceProxyManager::isFileOfProtocolMounts(const QString &filePath)
         return false;
 
     d->initMounts();
-    const QString &path = filePath.endsWith("/") ? filePath : filePath + "/";
     QReadLocker lk(&d->lock);
-    for (auto iter = d->allMounts.constKeyValueBegin(); iter != d->allMounts.constKeyValueEnd(); ++iter) {
-        if (!iter.base().key().startsWith(kBlockDeviceIdPrefix) && path.startsWith(iter.base().value()))
-            return true;
-    }
-    return false;
+    return d->classifier.classifyMountPath(filePath).testFlag(PathClassifier::kProtocolMount);
 }
 
 bool DeviceProxyManager::isFileOfExternalBlockMounts(const QString &filePath)
@@ -133,25 +139,15 @@ bool DeviceProxyManager::isFileOfExternalBlockMounts(const QString &filePath)
         return false;
 
     d->initMounts();
-    const QString &path = filePath.endsWith("/") ? filePath : filePath + "/";
     QReadLocker lk(&d->lock);
-    for (auto iter = d->externalMounts.constKeyValueBegin(); iter != d->externalMounts.constKeyValueEnd(); ++iter) {
-        if (iter.base().key().startsWith(kBlockDeviceIdPrefix) && path.startsWith(iter.base().value()))
-            return true;
-    }
-    return false;
+    return d->classifier.classifyMountPath(filePath).testFlag(PathClassifier::kExternalBlockMount);
 }
 
 bool DeviceProxyManager::isFileFromOptical(const QString &filePath)
 {
     d->initMounts();
-    const QString &path = filePath.endsWith("/") ? filePath : filePath + "/";
     QReadLocker lk(&d->lock);
-    for (auto iter = d->allMounts.constKeyValueBegin(); iter != d->allMounts.constKeyValueEnd(); ++iter) {
-        if (iter.base().key().startsWith(QString(kBlockDeviceIdPrefix) + "sr") && path.startsWith(iter.base().value()))
-            return true;
-    }
-    return false;
+    return d->classifier.classifyMountPath(filePath).testFlag(PathClassifier::kOpticalMount);
 }
 
 bool DeviceProxyManager::isMptOfDevice(const QString &filePath, QString &id)
@@ -263,6 +259,9 @@ void DeviceProxyManagerPrivate::initMounts()
         func(blks, &DeviceProxyManager::queryBlockInfo);
         // All protocol devices should be added to externalMounts
         func(protos, &DeviceProxyManager::queryProtocolInfo, true);
+
+        QWriteLocker lk(&lock);
+        classifier.setMounts(allMounts, externalMounts);
     });
 }
 
@@ -395,6 +394,7 @@ void DeviceProxyManagerPrivate::addMounts(const QString &id, const QString &mpt)
             externalMounts.insert(id, p);
         }
         allMounts.insert(id, p);
+        classifier.setMounts(allMounts, externalMounts);
     }
 
     Q_EMIT q->mountPointAdded(mpt);
@@ -414,6 +414,7 @@ void DeviceProxyManagerPrivate::removeMounts(const QString &id)
         QWriteLocker lk(&lock);
         externalMounts.remove(id);
         allMounts.remove(id);
+        classifier.setMounts(allMounts, externalMounts);
     }
     Q_EMIT q->mountPointRemoved(mpt);
 }
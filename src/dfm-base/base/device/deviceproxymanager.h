@@ -7,6 +7,7 @@
 
 #include <dfm-base/dfm_base_global.h>
 #include <dfm-base/dbusservice/global_server_defines.h>
+#include <dfm-base/utils/pathclassifier.h>
 
 #include <QObject>
 
@@ -45,6 +46,7 @@ public:
     bool initService();
     bool isDBusRuning();
 
+    PathClassifier::PathTypes classifyPath(const QString &filePath);
     bool isFileOfExternalMounts(const QString &filePath);
     bool isFileOfProtocolMounts(const QString &filePath);
     bool isFileOfExternalBlockMounts(const QString &filePath);
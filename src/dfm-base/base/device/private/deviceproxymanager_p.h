@@ -14,6 +14,7 @@
 #endif
 
 #include <dfm-base/dfm_base_global.h>
+#include <dfm-base/utils/pathclassifier.h>
 
 #include <QScopedPointer>
 #include <QList>
@@ -56,6 +57,7 @@ private:
     QReadWriteLock lock;
     QMap<QString, QString> externalMounts;
     QMap<QString, QString> allMounts;   // contain system disk
+    PathClassifier classifier;   // rebuilt from the two maps above, guarded by lock
 
     enum {
         kNoneConnection = -1,
@@ -4,6 +4,13 @@
 
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/utils/protocolutils.h>
+#include <dfm-base/utils/symlinkhintcache.h>
+
+#include <QFile>
+
+#include <climits>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace dfmbase {
 
@@ -22,12 +29,25 @@ QString InfoFactory::scheme(const QUrl &url)
     if (ProtocolUtils::isRemoteFile(url))
         return Global::Scheme::kAsyncFile;
 
-    dfmio::DFileInfo dinfo(url);
-    if (!dinfo.attribute(dfmio::DFileInfo::AttributeID::kStandardIsSymlink).toBool())
+    // 只有链接文件需要读取目标，判断依据来自目录的 d_type 缓存
+    const QString &path = url.path();
+    auto hint = SymlinkHintCache::instance().hint(path);
+    if (hint == SymlinkHintCache::Hint::kUnknown) {
+        struct stat st;
+        hint = lstat(QFile::encodeName(path).constData(), &st) == 0 && S_ISLNK(st.st_mode)
+                ? SymlinkHintCache::Hint::kSymlink
+                : SymlinkHintCache::Hint::kNotSymlink;
+    }
+    if (hint != SymlinkHintCache::Hint::kSymlink)
+        return scheme;
+
+    char target[PATH_MAX];
+    const ssize_t len = readlink(QFile::encodeName(path).constData(), target, sizeof(target) - 1);
+    if (len <= 0)
         return scheme;
 
-    auto targetPath = dinfo.attribute(dfmio::DFileInfo::AttributeID::kStandardSymlinkTarget).toString();
-    if (!targetPath.isEmpty() && ProtocolUtils::isRemoteFile(QUrl::fromLocalFile(targetPath)))
+    const QString &targetPath = QFile::decodeName(QByteArray(target, static_cast<int>(len)));
+    if (ProtocolUtils::isRemoteFile(QUrl::fromLocalFile(targetPath)))
         scheme = Global::Scheme::kAsyncFile;
 
     return scheme;
@@ -11,10 +11,12 @@
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/configs/dconfig/dconfigmanager.h>
 #include <dfm-base/utils/protocolutils.h>
+#include <dfm-base/utils/symlinkhintcache.h>
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
 
 #include <dfm-io/denumerator.h>
-#include <dfm-io/dfmio_utils.h>
+
+#include <QFile>
 
 #include <functional>
 
@@ -60,7 +62,7 @@ FileInfoPointer LocalDirIteratorPrivate::fileInfo(const QSharedPointer<DFileInfo
     if (fileName.startsWith(".")) {
         isHidden = true;
     } else {
-        isHidden = hideFileList.contains(fileName);
+        isHidden = hideFileList && hideFileList->contains(fileName);
     }
 
     auto targetPath = dfmInfo->attribute(dfmio::DFileInfo::AttributeID::kStandardSymlinkTarget).toString();
@@ -212,8 +214,7 @@ QUrl LocalDirIterator::url() const
 void LocalDirIterator::cacheBlockIOAttribute()
 {
     const QUrl &rootUrl = this->url();
-    const QUrl &url = DFMIO::DFMUtils::buildFilePath(rootUrl.toString().toStdString().c_str(), ".hidden", nullptr);
-    d->hideFileList = DFMIO::DFMUtils::hideListFromUrl(url);
+    d->hideFileList = HiddenListCache::instance().hiddenNames(rootUrl.path());
     d->isLocalDevice = ProtocolUtils::isLocalFile(rootUrl);
     d->isCdRomDevice = FileUtils::isCdRomDevice(rootUrl);
 }
@@ -238,7 +239,19 @@ QList<SortInfoPointer> LocalDirIterator::sortFileInfoList()
 
     auto sortlist = d->dfmioDirIterator->sortFileInfoList();
     QList<SortInfoPointer> wsortlist;
+    // 迭代时已知的链接类型交给 SymlinkHintCache，创建文件信息时无需再读取目录
+    const QString &dirPrefix = UrlRoute::urlToPath(url()) + '/';
+    QSet<QByteArray> names;
+    QSet<QByteArray> symlinks;
     for (const auto &sortInfo : sortlist) {
+        const QString &path = sortInfo->url.path();
+        if (path.startsWith(dirPrefix) && path.indexOf('/', dirPrefix.size()) < 0) {
+            const QByteArray &name = QFile::encodeName(path.mid(dirPrefix.size()));
+            names.insert(name);
+            if (sortInfo->isSymLink)
+                symlinks.insert(name);
+        }
+
         SortInfoPointer tmp(new SortFileInfo);
         tmp->setUrl(sortInfo->url);
         tmp->setSize(sortInfo->filesize);
@@ -257,6 +270,8 @@ QList<SortInfoPointer> LocalDirIterator::sortFileInfoList()
         tmp->setInfoCompleted(true);
         wsortlist.append(tmp);
     }
+    if (!names.isEmpty())
+        SymlinkHintCache::instance().setListing(dirPrefix, names, symlinks);
     return wsortlist;
 }
 
@@ -7,6 +7,7 @@
 
 #include "file/local/localdiriterator.h"
 #include <dfm-base/base/urlroute.h>
+#include <dfm-base/utils/hiddenlistcache.h>
 
 #include <QDirIterator>
 #include <QPointer>
@@ -43,7 +44,7 @@ public:
 private:
     QSharedPointer<dfmio::DEnumerator> dfmioDirIterator = nullptr;   // dfmio的文件迭代器
     QUrl currentUrl;   // 当前迭代器所在位置文件的url
-    QSet<QString> hideFileList;
+    HiddenListCache::HiddenNames hideFileList;
     bool isLocalDevice = false;
     bool isCdRomDevice = false;
     bool initQuerry = false;
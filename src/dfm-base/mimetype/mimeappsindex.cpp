@@ -0,0 +1,413 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimeappsindex.h"
+#include "mimesappsmanager.h"
+
+#include <dfm-base/base/standardpaths.h>
+#include <dfm-base/utils/mtimeutils.h>
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocale>
+#include <QSaveFile>
+#include <QTextStream>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+
+using namespace dfmbase;
+
+namespace {
+
+constexpr quint32 kIndexMagic { 0x444d4149 };   // "DMAI"
+constexpr quint32 kIndexVersion { 1 };
+
+inline bool statPath(const QString &path, struct stat *st)
+{
+    return ::stat(QFile::encodeName(path).constData(), st) == 0;
+}
+
+inline qint64 mtimeNsOf(const struct stat &st)
+{
+    return qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+inline QString parentPath(const QString &path)
+{
+    const int slash = path.lastIndexOf('/');
+    return slash <= 0 ? QString("/") : path.left(slash);
+}
+
+}   // namespace
+
+MimeAppsIndex &MimeAppsIndex::instance()
+{
+    static MimeAppsIndex ins(QString("%1/%2").arg(StandardPaths::location(StandardPaths::kCachePath), "MimeAppsIndex.cache"),
+                             MimesAppsManager::getApplicationsFolders(),
+                             MimesAppsManager::getDDEMimeTypeFile());
+    return ins;
+}
+
+MimeAppsIndex::MimeAppsIndex(const QString &cacheFile, const QStringList &folders, const QString &ddeMimeTypeFile)
+    : cacheFile(cacheFile),
+      roots(folders),
+      ddeMimeTypeFile(ddeMimeTypeFile),
+      localeName(QLocale::system().name())
+{
+}
+
+/*!
+ * \brief MimeAppsIndex::refresh Bring the index up to date with the applications folders
+ * \return true if desktop files or mime associations changed
+ */
+bool MimeAppsIndex::refresh()
+{
+    QMutexLocker locker(&mutex);
+    stats = Statistics();
+
+    bool changed = false;
+    if (!loaded) {
+        loaded = true;
+        stats.loaded = load();
+        changed = !stats.loaded;
+
+        // a file edited in place while no watcher ran leaves its folder mtime as it is
+        const QStringList &paths = entries.keys();
+        for (const QString &path : paths)
+            changed |= updateEntry(path);
+    }
+
+    for (const QString &root : roots) {
+        if (!dirs.contains(root))
+            dirs.insert(root, -1);
+    }
+
+    // files reported by the watcher, a folder is scanned again as a whole
+    for (const QString &path : std::as_const(dirtyPaths)) {
+        if (dirs.contains(path))
+            dirs[path] = -1;
+        else if (dirs.contains(parentPath(path)))
+            changed |= updateEntry(path);
+    }
+    dirtyPaths.clear();
+
+    QStringList pending = dirs.keys();
+    while (!pending.isEmpty()) {
+        const QString dirPath = pending.takeLast();
+        struct stat st;
+        if (!statPath(dirPath, &st) || !S_ISDIR(st.st_mode)) {
+            dirs.remove(dirPath);
+            for (auto it = entries.begin(); it != entries.end();) {
+                if (parentPath(it.key()) == dirPath) {
+                    it = entries.erase(it);
+                    changed = true;
+                } else {
+                    ++it;
+                }
+            }
+            continue;
+        }
+
+        const qint64 mtimeNs = mtimeNsOf(st);
+        if (dirs.value(dirPath) == mtimeNs)
+            continue;
+
+        QStringList newDirs;
+        changed |= scanDir(dirPath, &newDirs);
+        dirs[dirPath] = MtimeUtils::trustedMtime(mtimeNs);
+        pending.append(newDirs);
+    }
+
+    changed |= loadDDEMimeTypes();
+
+    if (changed) {
+        rebuildMimeApps();
+        save();
+    }
+    if (changed || currentGeneration == 0)
+        ++currentGeneration;
+    return changed;
+}
+
+/*!
+ * \brief MimeAppsIndex::invalidate A desktop file or a folder changed, it is checked on the next refresh()
+ */
+void MimeAppsIndex::invalidate(const QString &path)
+{
+    QString filePath = path;
+    while (filePath.size() > 1 && filePath.endsWith('/'))
+        filePath.chop(1);
+
+    QMutexLocker locker(&mutex);
+    dirtyPaths.insert(filePath);
+}
+
+quint64 MimeAppsIndex::generation() const
+{
+    QMutexLocker locker(&mutex);
+    return currentGeneration;
+}
+
+/*!
+ * \brief MimeAppsIndex::desktopFiles The desktop files to show, by path
+ */
+QMap<QString, DesktopFile> MimeAppsIndex::desktopFiles() const
+{
+    QMutexLocker locker(&mutex);
+    QMap<QString, DesktopFile> desktops;
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        if (!it->desktop.isNoShow())
+            desktops.insert(it.key(), it->desktop);
+    }
+    return desktops;
+}
+
+QMap<QString, QStringList> MimeAppsIndex::mimeApps() const
+{
+    QMutexLocker locker(&mutex);
+    return mimeAppsMap;
+}
+
+QMap<QString, QStringList> MimeAppsIndex::ddeMimeTypes() const
+{
+    QMutexLocker locker(&mutex);
+    return ddeMimes;
+}
+
+/*!
+ * \brief MimeAppsIndex::appsForMimeType The desktop files opening mimeType, the earliest installed first
+ */
+QStringList MimeAppsIndex::appsForMimeType(const QString &mimeType) const
+{
+    QMutexLocker locker(&mutex);
+    return mimeAppsMap.value(mimeType);
+}
+
+bool MimeAppsIndex::desktopFile(const QString &path, DesktopFile *desktop) const
+{
+    QMutexLocker locker(&mutex);
+    auto it = entries.constFind(path);
+    if (it == entries.constEnd())
+        return false;
+
+    *desktop = it->desktop;
+    return true;
+}
+
+MimeAppsIndex::Statistics MimeAppsIndex::statistics() const
+{
+    QMutexLocker locker(&mutex);
+    return stats;
+}
+
+bool MimeAppsIndex::load()
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // the index is read straight from the page cache
+    uchar *mapped = file.map(0, file.size());
+    const QByteArray &bytes = mapped ? QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), file.size())
+                                     : file.readAll();
+
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString locale;
+    QStringList savedRoots;
+    in >> magic >> version;
+    if (magic != kIndexMagic || version != kIndexVersion)
+        return false;
+
+    // localized names are stored, another locale needs them parsed again
+    in >> locale >> savedRoots;
+    if (locale != localeName || savedRoots != roots)
+        return false;
+
+    QHash<QString, qint64> savedDirs;
+    QHash<QString, Entry> savedEntries;
+    QMap<QString, QStringList> savedDDEMimes;
+    QMap<QString, QStringList> savedMimeApps;
+    qint64 savedDDEMtime = -1;
+    quint32 count = 0;
+
+    in >> savedDDEMtime >> savedDDEMimes >> savedDirs >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        in >> path >> entry.mtimeNs >> entry.size >> entry.birthMs >> entry.desktop;
+        savedEntries.insert(path, entry);
+    }
+    in >> savedMimeApps;
+
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    dirs = savedDirs;
+    entries = savedEntries;
+    ddeMimes = savedDDEMimes;
+    ddeMtimeNs = savedDDEMtime;
+    mimeAppsMap = savedMimeApps;
+    return true;
+}
+
+bool MimeAppsIndex::save() const
+{
+    if (cacheFile.isEmpty())
+        return false;
+
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(logDFMBase) << "MimeAppsIndex: cannot write" << cacheFile << file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kIndexMagic << kIndexVersion << localeName << roots << ddeMtimeNs << ddeMimes << dirs
+        << quint32(entries.size());
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it)
+        out << it.key() << it->mtimeNs << it->size << it->birthMs << it->desktop;
+    out << mimeAppsMap;
+
+    return file.commit();
+}
+
+/*!
+ * \brief MimeAppsIndex::scanDir List dirPath again, parse its new and changed desktop files
+ * and drop the removed ones. Sub folders not known yet are added to newDirs.
+ */
+bool MimeAppsIndex::scanDir(const QString &dirPath, QStringList *newDirs)
+{
+    ++stats.dirsScanned;
+    bool changed = false;
+
+    QDir dir(dirPath);
+    const QStringList &fileNames = dir.entryList(QStringList("*.desktop"), QDir::Files | QDir::NoDotAndDotDot);
+    QSet<QString> filePaths;
+    for (const QString &fileName : fileNames) {
+        const QString &filePath = dir.filePath(fileName);
+        filePaths.insert(filePath);
+        changed |= updateEntry(filePath);
+    }
+
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (parentPath(it.key()) == dirPath && !filePaths.contains(it.key())) {
+            it = entries.erase(it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+
+    const QStringList &subDirNames = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot | QDir::NoSymLinks);
+    for (const QString &subDirName : subDirNames) {
+        const QString &subDirPath = dir.filePath(subDirName);
+        if (!dirs.contains(subDirPath)) {
+            dirs.insert(subDirPath, -1);
+            newDirs->append(subDirPath);
+        }
+    }
+
+    return changed;
+}
+
+bool MimeAppsIndex::updateEntry(const QString &filePath)
+{
+    struct stat st;
+    if (!statPath(filePath, &st) || !S_ISREG(st.st_mode))
+        return entries.remove(filePath) > 0;
+
+    const qint64 mtimeNs = mtimeNsOf(st);
+    auto it = entries.find(filePath);
+    if (it != entries.end() && it->mtimeNs == mtimeNs && it->size == st.st_size)
+        return false;
+
+    Entry entry;
+    entry.mtimeNs = MtimeUtils::trustedMtime(mtimeNs);
+    entry.size = st.st_size;
+    entry.birthMs = QFileInfo(filePath).birthTime().toMSecsSinceEpoch();
+    entry.desktop = DesktopFile(filePath);
+    entries.insert(filePath, entry);
+    ++stats.filesParsed;
+    return true;
+}
+
+bool MimeAppsIndex::loadDDEMimeTypes()
+{
+    struct stat st;
+    const qint64 mtimeNs = statPath(ddeMimeTypeFile, &st) ? mtimeNsOf(st) : 0;
+    if (mtimeNs == ddeMtimeNs)
+        return false;
+
+    ddeMimes.clear();
+    ddeMtimeNs = MtimeUtils::trustedMtime(mtimeNs);
+    if (mtimeNs == 0)
+        return true;
+
+    QFile file(ddeMimeTypeFile);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return true;
+
+    // [desktop file name] followed by one MimeType=a;b; line
+    QTextStream in(&file);
+    QString desktopKey;
+    while (!in.atEnd()) {
+        const QString &line = in.readLine();
+        const QString &trimmed = line.trimmed();
+        if (trimmed.isEmpty())
+            continue;
+
+        if (trimmed.startsWith("[") && trimmed.endsWith("]")) {
+            desktopKey = QString(trimmed).replace("[", "").replace("]", "");
+            continue;
+        }
+
+        const int firstEqual = line.indexOf('=');
+        if (!desktopKey.isEmpty() && firstEqual >= 0) {
+            ddeMimes.insert(desktopKey, line.mid(firstEqual + 1).split(";"));
+            desktopKey.clear();
+        }
+    }
+    return true;
+}
+
+void MimeAppsIndex::rebuildMimeApps()
+{
+    QHash<QString, QList<QPair<qint64, QString>>> apps;
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it) {
+        if (it->desktop.isNoShow())
+            continue;
+
+        QStringList mimeTypes = it->desktop.desktopMimeType();
+        mimeTypes.append(ddeMimes.value(QFileInfo(it.key()).fileName()));
+        for (const QString &mimeType : std::as_const(mimeTypes)) {
+            if (mimeType.isEmpty())
+                continue;
+            auto &list = apps[mimeType];
+            const QPair<qint64, QString> app(it->birthMs, it.key());
+            if (!list.contains(app))
+                list.append(app);
+        }
+    }
+
+    mimeAppsMap.clear();
+    for (auto it = apps.begin(); it != apps.end(); ++it) {
+        std::sort(it->begin(), it->end());
+        QStringList paths;
+        paths.reserve(it->size());
+        for (const auto &app : std::as_const(*it))
+            paths.append(app.second);
+        mimeAppsMap.insert(it.key(), paths);
+    }
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMEAPPSINDEX_H
+#define MIMEAPPSINDEX_H
+
+#include <dfm-base/dfm_base_global.h>
+#include <dfm-base/utils/desktopfile.h>
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QSet>
+#include <QStringList>
+
+namespace dfmbase {
+
+/*!
+ * \brief MimeAppsIndex is a persistent index of the desktop files in the applications
+ * folders and of the mime types they open.
+ *
+ * The index is saved to a cache file and mapped back on the next start, where every
+ * desktop file is stat'ed once against its saved mtime and size. After that each folder
+ * is validated by its mtime, only the desktop files of changed folders are stat'ed, and
+ * only new or changed files are parsed again. Files reported by a watcher are checked on
+ * the next refresh(). Folders and files modified within the last seconds are checked again,
+ * their mtime can not tell a later change yet.
+ */
+class MimeAppsIndex
+{
+public:
+    struct Statistics
+    {
+        bool loaded { false };   // the cache file was used
+        int dirsScanned { 0 };
+        int filesParsed { 0 };
+    };
+
+    static MimeAppsIndex &instance();
+    MimeAppsIndex(const QString &cacheFile, const QStringList &folders, const QString &ddeMimeTypeFile);
+
+    bool refresh();
+    void invalidate(const QString &path);
+    quint64 generation() const;
+
+    QMap<QString, DesktopFile> desktopFiles() const;
+    QMap<QString, QStringList> mimeApps() const;
+    QMap<QString, QStringList> ddeMimeTypes() const;
+    QStringList appsForMimeType(const QString &mimeType) const;
+    bool desktopFile(const QString &path, DesktopFile *desktop) const;
+
+    Statistics statistics() const;
+
+private:
+    struct Entry
+    {
+        qint64 mtimeNs { -1 };
+        qint64 size { -1 };
+        qint64 birthMs { 0 };
+        DesktopFile desktop;
+    };
+
+    bool load();
+    bool save() const;
+    bool scanDir(const QString &dirPath, QStringList *newDirs);
+    bool updateEntry(const QString &filePath);
+    bool loadDDEMimeTypes();
+    void rebuildMimeApps();
+
+    const QString cacheFile;
+    const QStringList roots;
+    const QString ddeMimeTypeFile;
+    const QString localeName;
+
+    mutable QMutex mutex;
+    QHash<QString, qint64> dirs;   // dir path -> mtime in ns, -1 to scan again
+    QHash<QString, Entry> entries;
+    QMap<QString, QStringList> mimeAppsMap;
+    QMap<QString, QStringList> ddeMimes;
+    qint64 ddeMtimeNs { -1 };
+    QSet<QString> dirtyPaths;
+    bool loaded { false };
+    quint64 currentGeneration { 0 };
+    Statistics stats;
+};
+
+}
+
+#endif   // MIMEAPPSINDEX_H
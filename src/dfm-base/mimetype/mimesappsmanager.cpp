@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "mimesappsmanager.h"
+#include "mimeappsindex.h"
 
 #include <dfm-base/mimetype/dmimedatabase.h>
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
@@ -68,8 +69,17 @@ void MimeAppsWorker::startWatch()
         AbstractFileWatcherPointer watcher { WatcherFactory::create<AbstractFileWatcher>(QUrl::fromLocalFile(path)) };
         watcherGroup.append(watcher);
         if (watcher) {
-            connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, [this]() {
+            // the index checks the reported files and folders on the next refresh
+            auto invalidate = [this](const QUrl &url) {
+                MimeAppsIndex::instance().invalidate(url.toLocalFile());
                 updateCacheTimer->start();
+            };
+            connect(watcher.data(), &AbstractFileWatcher::fileAttributeChanged, this, invalidate);
+            connect(watcher.data(), &AbstractFileWatcher::subfileCreated, this, invalidate);
+            connect(watcher.data(), &AbstractFileWatcher::fileDeleted, this, invalidate);
+            connect(watcher.data(), &AbstractFileWatcher::fileRename, this, [invalidate](const QUrl &fromUrl, const QUrl &toUrl) {
+                invalidate(fromUrl);
+                invalidate(toUrl);
             });
             watcher->startWatcher();
         }
@@ -78,7 +88,8 @@ void MimeAppsWorker::startWatch()
 
 void MimeAppsWorker::updateCache()
 {
-    MimesAppsManager::initMimeTypeApps();
+    // only the index is refreshed here, the maps of MimesAppsManager belong to the main thread
+    MimeAppsIndex::instance().refresh();
 }
 
 void MimeAppsWorker::writeData(const QString &path, const QByteArray &content)
@@ -268,12 +279,21 @@ QStringList MimesAppsManager::getRecommendedApps(const QUrl &url)
     if (!url.isValid()) {
         return QStringList();
     }
-    QStringList recommendedApps;
-    QString mimeType;
 
     FileInfoPointer info = InfoFactory::create<FileInfo>(url);
-    mimeType = info->fileMimeType().name();
+    if (!info)
+        return QStringList();
+
+    return getRecommendedAppsByMimeType(info->fileMimeType().name());
+}
 
+/*!
+ * \brief MimesAppsManager::getRecommendedAppsByMimeType The apps to open a file of mimeType,
+ * the default app first. Callers holding a file info pass its mime type, no info is created again.
+ */
+QStringList MimesAppsManager::getRecommendedAppsByMimeType(const QString &mimeType)
+{
+    QStringList recommendedApps;
     DFMBASE_NAMESPACE::DMimeDatabase db;
 
     recommendedApps = getRecommendedAppsByQio(db.mimeTypeForName(mimeType));
@@ -285,7 +305,7 @@ QStringList MimesAppsManager::getRecommendedApps(const QUrl &url)
     QString customApp("%1/%2-custom-open-%3.desktop");
     QString defaultApp = getDefaultAppByMimeType(mimeType);
 
-    customApp = customApp.arg(QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)).arg(qApp->applicationName()).arg(mimeType.replace("/", "-"));
+    customApp = customApp.arg(QStandardPaths::writableLocation(QStandardPaths::ApplicationsLocation)).arg(qApp->applicationName()).arg(QString(mimeType).replace("/", "-"));
 
     if (QFile::exists(customApp)) {
         MimesAppsManager::removeOneDupFromList(recommendedApps, customApp);
@@ -479,79 +499,28 @@ QMap<QString, DesktopFile> MimesAppsManager::getDesktopObjs()
 
 void MimesAppsManager::initMimeTypeApps()
 {
-    qCInfo(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Initializing MIME type applications in thread:" 
-                       << QThread::currentThread();
-    DesktopFiles.clear();
-    DesktopObjs.clear();
-    DDE_MimeTypes.clear();
-
-    QMap<QString, QSet<QString>> mimeAppsSet;
-    loadDDEMimeTypes();
-    
-    const QStringList &appFolders = getApplicationsFolders();
-    qCDebug(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Scanning application folders:" << appFolders;
-    
-    int totalDesktopFiles = 0;
-    for (const QString &desktopFolder : appFolders) {
-        QDirIterator it(desktopFolder, QStringList("*.desktop"), QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
-        int folderCount = 0;
-        while (it.hasNext()) {
-            it.next();
-            const QString &filePath = it.filePath();
-            DesktopFile desktopFile(filePath);
-            if (desktopFile.isNoShow())
-                continue;
-
-            DesktopFiles.append(filePath);
-            DesktopObjs.insert(filePath, desktopFile);
-            QStringList mimeTypes = desktopFile.desktopMimeType();
-            QString fileName = QFileInfo(filePath).fileName();
-            if (DDE_MimeTypes.contains(fileName)) {
-                mimeTypes.append(DDE_MimeTypes.value(fileName));
-            }
+    // the maps are rebuilt only when the index changed since the last call
+    static quint64 appliedGeneration = 0;
 
-            for (const QString &mimeType : mimeTypes) {
-                if (!mimeType.isEmpty()) {
-                    QSet<QString> apps;
-                    if (mimeAppsSet.contains(mimeType)) {
-                        apps = mimeAppsSet.value(mimeType);
-                        apps.insert(filePath);
-                    } else {
-                        apps.insert(filePath);
-                    }
-                    mimeAppsSet.insert(mimeType, apps);
-                }
-            }
-            folderCount++;
-            totalDesktopFiles++;
-        }
-        qCDebug(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Found" << folderCount 
-                            << "desktop files in:" << desktopFolder;
-    }
+    MimeAppsIndex &index = MimeAppsIndex::instance();
+    index.refresh();
+    const quint64 generation = index.generation();
+    if (generation == appliedGeneration)
+        return;
+    appliedGeneration = generation;
 
-    qCInfo(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Loaded" << totalDesktopFiles 
-                       << "desktop files, processing" << mimeAppsSet.size() << "MIME types";
-
-    for (const QString &key : mimeAppsSet.keys()) {
-        QSet<QString> apps = mimeAppsSet.value(key);
-        QStringList orderApps;
-        if (apps.count() > 1) {
-            QFileInfoList fileInfos;
-            for (const QString &app : apps) {
-                QFileInfo info(app);
-                fileInfos.append(info);
-            }
+    const MimeAppsIndex::Statistics &stats = index.statistics();
+    qCInfo(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Index generation" << generation
+                       << "loaded from cache:" << stats.loaded << "folders scanned:" << stats.dirsScanned
+                       << "desktop files parsed:" << stats.filesParsed;
 
-            std::sort(fileInfos.begin(), fileInfos.end(), MimesAppsManager::lessByDateTime);
+    DesktopObjs = index.desktopFiles();
+    DesktopFiles = DesktopObjs.keys();
+    DDE_MimeTypes = index.ddeMimeTypes();
+    MimeApps = index.mimeApps();
 
-            for (const QFileInfo &info : fileInfos) {
-                orderApps.append(info.absoluteFilePath());
-            }
-        } else {
-            orderApps.append(apps.values());
-        }
-        MimeApps.insert(key, orderApps);
-    }
+    qCInfo(logDFMBase) << "MimesAppsManager::initMimeTypeApps: Loaded" << DesktopFiles.size()
+                       << "desktop files," << MimeApps.size() << "MIME types";
 
     //check mime apps from cache
     QFile f(getMimeInfoCacheFilePath());
@@ -600,11 +569,15 @@ void MimesAppsManager::initMimeTypeApps()
     // Process categorized applications
     auto processCategory = [&](const QStringList &desktopList, QMap<QString, DesktopFile> &targetMap, const QString &category) {
         int validCount = 0;
+        targetMap.clear();
         for (const QString &desktop : desktopList) {
             const QString path = QString("%1/%2").arg(mimeInfoCacheRootPath, desktop);
-            if (!QFile::exists(path))
-                continue;
-            DesktopFile df(path);
+            DesktopFile df;
+            if (!index.desktopFile(path, &df)) {
+                if (!QFile::exists(path))
+                    continue;
+                df = DesktopFile(path);
+            }
             targetMap.insert(path, df);
             validCount++;
         }
@@ -75,6 +75,7 @@ public:
     static bool setDefautlAppForTypeByGio(const QString &mimeType, const QString &appPath);
 
     static QStringList getRecommendedApps(const QUrl &url);
+    static QStringList getRecommendedAppsByMimeType(const QString &mimeType);
     static QStringList getRecommendedAppsByQio(const QMimeType &mimeType);
     static QStringList getRecommendedAppsByGio(const QString &mimeType);
     static QStringList getrecommendedAppsFromMimeWhiteList(const QUrl &url);
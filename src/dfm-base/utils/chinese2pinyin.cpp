@@ -4,55 +4,47 @@
 
 #include "chinese2pinyin.h"
 
-#include <QHash>
-#include <QTextStream>
-#include <QFile>
+// generated at build time from qrc/chinese2pinyin/pinyin.dict
+#include "pinyintable.h"
 
 namespace Pinyin {
 
-static QHash<uint, QString> dict = {};
+static_assert(sizeof(Table::kCodeIndex) / sizeof(Table::kCodeIndex[0]) == Table::kLastCode - Table::kFirstCode + 1,
+              "pinyin table does not cover its code point range");
 
-const char kDictFile[] = ":/misc/pinyin.dict";
+// the table is constant data, lookups need neither initialization nor locking
+static const char *syllableOf(char16_t code)
+{
+    if (code < Table::kFirstCode || code > Table::kLastCode)
+        return nullptr;
 
-void InitDict() {
-    if (!dict.isEmpty()) {
-        return;
-    }
-
-    dict.reserve(25333);
-
-    QFile file(kDictFile);
-
-    if (!file.open(QIODevice::ReadOnly))
-        return;
-
-    QByteArray content = file.readAll();
-
-    file.close();
-
-    QTextStream stream(&content, QIODevice::ReadOnly);
-
-    while (!stream.atEnd()) {
-        const QString line = stream.readLine();
-        const QStringList items = line.split(QChar(':'));
+    const uint16_t index = Table::kCodeIndex[code - Table::kFirstCode];
+    return index > 0 ? Table::kSyllablePool + Table::kSyllableOffsets[index - 1] : nullptr;
+}
 
-        if (items.size() == 2) {
-            dict.insert(static_cast<uint>(items[0].toInt(nullptr, 16)), items[1]);
-        }
-    }
+QLatin1String CharPinyin(const QChar& ch) {
+    const char *syllable = syllableOf(ch.unicode());
+    return syllable ? QLatin1String(syllable) : QLatin1String();
 }
 
 QString Chinese2Pinyin(const QString& words) {
-    InitDict();
+    int first = 0;
+    while (first < words.length() && !syllableOf(words.at(first).unicode()))
+        ++first;
+
+    // nothing to convert, share the source string
+    if (first == words.length())
+        return words;
 
     QString result;
+    result.reserve(words.length() * 4);
+    result.append(words.constData(), first);
 
-    for (int i = 0; i < words.length(); ++i) {
-        const uint key = words.at(i).unicode();
-        auto find_result = dict.find(key);
+    for (int i = first; i < words.length(); ++i) {
+        const char *syllable = syllableOf(words.at(i).unicode());
 
-        if (find_result != dict.end()) {
-            result.append(find_result.value());
+        if (syllable) {
+            result.append(QLatin1String(syllable));
         } else {
             result.append(words.at(i));
         }
@@ -9,6 +9,8 @@
 
 namespace Pinyin {
 QString Chinese2Pinyin(const QString& words);
+// pinyin (with tone digit) of a single character, empty if the character has none
+QLatin1String CharPinyin(const QChar& ch);
 };
 
 #endif  // CHINESE_2_PINYIN_H
@@ -6,6 +6,7 @@
 #include "properties.h"
 
 #include <QFile>
+#include <QDataStream>
 #include <QSettings>
 #include <QDebug>
 #include <QLocale>
@@ -163,3 +164,19 @@ QStringList DesktopFile::desktopMimeType() const
     return mimeType;
 }
 //---------------------------------------------------------------------------
+
+QDataStream &dfmbase::operator<<(QDataStream &out, const DesktopFile &desktop)
+{
+    out << desktop.fileName << desktop.name << desktop.genericName << desktop.localName
+        << desktop.exec << desktop.icon << desktop.type << desktop.categories << desktop.mimeType
+        << desktop.deepinId << desktop.deepinVendor << desktop.noDisplay << desktop.hidden;
+    return out;
+}
+
+QDataStream &dfmbase::operator>>(QDataStream &in, DesktopFile &desktop)
+{
+    in >> desktop.fileName >> desktop.name >> desktop.genericName >> desktop.localName
+            >> desktop.exec >> desktop.icon >> desktop.type >> desktop.categories >> desktop.mimeType
+            >> desktop.deepinId >> desktop.deepinVendor >> desktop.noDisplay >> desktop.hidden;
+    return in;
+}
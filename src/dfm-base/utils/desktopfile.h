@@ -9,6 +9,10 @@
 
 #include <QStringList>
 
+QT_BEGIN_NAMESPACE
+class QDataStream;
+QT_END_NAMESPACE
+
 /**
  * @class DesktopFile
  * @brief Represents a linux desktop file
@@ -36,6 +40,9 @@ public:
     QStringList desktopCategories() const;
     QStringList desktopMimeType() const;
 
+    friend QDataStream &operator<<(QDataStream &out, const DesktopFile &desktop);
+    friend QDataStream &operator>>(QDataStream &in, DesktopFile &desktop);
+
 private:
     QString fileName;
     QString name;
@@ -52,6 +59,9 @@ private:
     bool hidden = false;
 };
 
+QDataStream &operator<<(QDataStream &out, const DesktopFile &desktop);
+QDataStream &operator>>(QDataStream &in, DesktopFile &desktop);
+
 }
 
 #endif   // DESKTOPFILE_H
@@ -21,14 +21,19 @@
 #include <QElapsedTimer>
 #include <QDebug>
 #include <QApplication>
+#include <QThreadPool>
 
 #include <fts.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
 #include <dirent.h>
 
 namespace dfmbase {
 
 static constexpr uint16_t kSizeChangeinterval { 200 };
+static constexpr int kMaxWalkerCount { 8 };
+static constexpr int kWalkerWaitTimeout { 100 };
 
 FileStatisticsJobPrivate::FileStatisticsJobPrivate(FileStatisticsJob *qq)
     : QObject(nullptr), q(qq), notifyDataTimer(nullptr)
@@ -220,25 +225,30 @@ void FileStatisticsJobPrivate::processFile(const FileInfoPointer &fileInfo, cons
     }
 }
 
-void FileStatisticsJobPrivate::processFile(const QUrl &url, struct stat64 *statBuffer, const bool followLink, QQueue<QUrl> &directoryQueue)
+void FileStatisticsJobPrivate::processFile(const QString &path, struct stat64 *statBuffer, const bool isSymlink, const bool followLink, QStringList &directoryQueue)
 {
     if (!statBuffer)
         return;
     bool isDir = S_ISDIR(statBuffer->st_mode);
-    if (!checkInode(statBuffer->st_ino, url.path()))
+    if (!checkInode(statBuffer->st_dev, statBuffer->st_ino))
         return;
     if (isDir) {
-        processDirectory(url, followLink, directoryQueue);
+        processDirectory(path, isSymlink, followLink, directoryQueue);
     } else {
-        processRegularFile(url, statBuffer, followLink);
+        processRegularFile(path, statBuffer, isSymlink, followLink);
     }
 }
 
 void FileStatisticsJobPrivate::emitSizeChanged()
 {
-    if (elapsedTimer.elapsed() > kSizeChangeinterval) {
-        Q_EMIT q->sizeChanged(totalSize);
-        elapsedTimer.restart();
+    // called from all walkers, only the one winning the exchange emits,
+    // queued to the thread the job object lives in, receivers never run on a pool thread
+    const qint64 now = elapsedTimer.elapsed();
+    qint64 last = lastSizeNotifyTime.load(std::memory_order_relaxed);
+    if (now - last > kSizeChangeinterval && lastSizeNotifyTime.compare_exchange_strong(last, now)) {
+        const qint64 size = totalSize;
+        QMetaObject::invokeMethod(
+                q, [this, size]() { Q_EMIT q->sizeChanged(size); }, Qt::QueuedConnection);
     }
 }
 
@@ -309,14 +319,9 @@ bool FileStatisticsJobPrivate::checkInode(const FileInfoPointer info)
     return true;
 }
 
-bool FileStatisticsJobPrivate::checkInode(const __ino64_t innode, const QString &path)
+bool FileStatisticsJobPrivate::checkInode(const __dev_t device, const __ino64_t innode)
 {
-    QString key = innode > 0 ? QString::number(innode) : QString::number(innode) + ":" + path;
-    if (inodeAndPath.contains(key))
-        return false;
-
-    inodeAndPath.insert(key);
-    return true;
+    return inodeShards.insert(device, innode);
 }
 
 FileInfo::FileType FileStatisticsJobPrivate::fileType(const __mode_t fileMode)
@@ -338,10 +343,11 @@ FileInfo::FileType FileStatisticsJobPrivate::fileType(const __mode_t fileMode)
     return fileType;
 }
 
-void FileStatisticsJobPrivate::processDirectory(const QUrl &url, bool followLink, QQueue<QUrl> &directoryQueue)
+void FileStatisticsJobPrivate::processDirectory(const QString &path, bool isSymlink, bool followLink, QStringList &directoryQueue)
 {
     totalProgressSize += FileUtils::getMemoryPageSize();
-    QString target = FileUtils::resolveSymlink(url);
+    // only real symlinks pay for the readlink chain
+    const QString &target = isSymlink ? FileUtils::resolveSymlink(QUrl::fromLocalFile(path)) : QString();
     if (!target.isEmpty() && !followLink) {
         ++directoryCount;
         return;
@@ -355,21 +361,20 @@ void FileStatisticsJobPrivate::processDirectory(const QUrl &url, bool followLink
             return;
     }
     if (!fileHints.testFlag(FileStatisticsJob::kSingleDepth))
-        directoryQueue << url;
+        directoryQueue << path;
 }
 
-void FileStatisticsJobPrivate::processRegularFile(const QUrl &url, struct stat64 *statBuffer, bool followLink)
+void FileStatisticsJobPrivate::processRegularFile(const QString &path, struct stat64 *statBuffer, bool isSymlink, bool followLink)
 {
-    QString target = FileUtils::resolveSymlink(url);
-    bool isSymlink = !target.isEmpty();
+    const QString &target = isSymlink ? FileUtils::resolveSymlink(QUrl::fromLocalFile(path)) : QString();
+    isSymlink = !target.isEmpty();
     if (isSymlink && !followLink) {
         ++filesCount;
         return;
     }
     // Skip specific system files early
-    if (UniversalUtils::urlEquals(url, QUrl::fromLocalFile("/proc/kcore")) || UniversalUtils::urlEquals(url, QUrl::fromLocalFile("/dev/core")) || target == "/proc/kcore" || target == "/dev/core") {
+    if (skipPath.contains(path) || skipPath.contains(target))
         return;
-    }
     const FileInfo::FileType type = fileType(statBuffer->st_mode);
     if (!checkFileType(type))
         return;
@@ -383,6 +388,129 @@ void FileStatisticsJobPrivate::processRegularFile(const QUrl &url, struct stat64
     ++filesCount;
 }
 
+/*!
+ * \brief FileStatisticsJobPrivate::walkDirectories walk the local directory trees on several threads
+ * Every walker takes one directory from the shared queue, reads it relative to its
+ * directory fd and pushes the sub directories back, so a deep or wide tree keeps all cores busy.
+ * \param directories the directories to start from
+ * \param followLink follow symlinks to directories
+ */
+void FileStatisticsJobPrivate::walkDirectories(const QStringList &directories, bool followLink)
+{
+    if (directories.isEmpty())
+        return;
+
+    {
+        QMutexLocker locker(&walkMutex);
+        walkQueue.clear();
+        for (const QString &dir : directories)
+            walkQueue.enqueue(dir);
+        busyWalkers = 0;
+    }
+
+    const int walkerCount = qBound(1, QThread::idealThreadCount(), kMaxWalkerCount);
+    QThreadPool pool;
+    pool.setMaxThreadCount(walkerCount);
+    for (int i = 0; i < walkerCount; ++i)
+        pool.start([this, followLink] { walkWorker(followLink); });
+    pool.waitForDone();
+}
+
+void FileStatisticsJobPrivate::walkWorker(bool followLink)
+{
+    forever {
+        QString directory;
+        {
+            QMutexLocker locker(&walkMutex);
+            while (walkQueue.isEmpty() && busyWalkers > 0 && state != FileStatisticsJob::kStoppedState)
+                walkCondition.wait(&walkMutex, kWalkerWaitTimeout);
+
+            if (walkQueue.isEmpty() || state == FileStatisticsJob::kStoppedState) {
+                walkCondition.wakeAll();
+                return;
+            }
+
+            directory = walkQueue.dequeue();
+            ++busyWalkers;
+        }
+
+        QStringList subDirectories;
+        walkDirectory(directory, followLink, subDirectories);
+
+        QMutexLocker locker(&walkMutex);
+        for (const QString &dir : subDirectories)
+            walkQueue.enqueue(dir);
+        --busyWalkers;
+        walkCondition.wakeAll();
+    }
+}
+
+void FileStatisticsJobPrivate::walkDirectory(const QString &directory, bool followLink, QStringList &subDirectories)
+{
+    int dirFd = ::open(directory.toUtf8().constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0)
+        return;
+
+    DIR *dir = ::fdopendir(dirFd);
+    if (!dir) {
+        ::close(dirFd);
+        return;
+    }
+
+    const QString &prefix = directory.endsWith(QDir::separator()) ? directory : directory + QDir::separator();
+    QList<QUrl> files;
+    struct dirent64 *entry { nullptr };
+    while ((entry = ::readdir64(dir))) {
+        if (!stateCheck())
+            break;
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+
+        struct stat64 statBuffer;
+        if (::fstatat64(dirFd, entry->d_name, &statBuffer, 0) != 0)
+            continue;
+
+        bool isSymlink = entry->d_type == DT_LNK;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat64 linkBuffer;
+            isSymlink = ::fstatat64(dirFd, entry->d_name, &linkBuffer, AT_SYMLINK_NOFOLLOW) == 0
+                    && S_ISLNK(linkBuffer.st_mode);
+        }
+
+        const QString &currentPath = prefix + QString::fromUtf8(entry->d_name);
+        processFile(currentPath, &statBuffer, isSymlink, followLink, subDirectories);
+
+        if (!sizeInfo.isNull())
+            files << QUrl::fromLocalFile(currentPath);
+    }
+    ::closedir(dir);
+
+    if (!files.isEmpty()) {
+        QMutexLocker locker(&allFilesMutex);
+        sizeInfo->allFiles << files;
+    }
+}
+
+bool InodeShardSet::insert(quint64 device, quint64 inode)
+{
+    Shard &shard = shards[(inode ^ device) % kShardCount];
+    QMutexLocker locker(&shard.mutex);
+    const auto &key = qMakePair(device, inode);
+    if (shard.inodes.contains(key))
+        return false;
+
+    shard.inodes.insert(key);
+    return true;
+}
+
+void InodeShardSet::clear()
+{
+    for (Shard &shard : shards) {
+        QMutexLocker locker(&shard.mutex);
+        shard.inodes.clear();
+    }
+}
+
 FileStatisticsJob::FileStatisticsJob(QObject *parent)
     : QThread(parent), d(new FileStatisticsJobPrivate(this))
 {
@@ -515,7 +643,9 @@ void FileStatisticsJob::run()
     d->totalSize = 0;
     d->filesCount = 0;
     d->directoryCount = 0;
+    d->lastSizeNotifyTime = 0;
     d->inodelist.clear();
+    d->inodeShards.clear();
     if (d->sourceUrlList.isEmpty())
         return;
 
@@ -662,7 +792,7 @@ void FileStatisticsJob::statisticsRealPathSingle()
 
     const bool followLink = !d->fileHints.testFlag(kNoFollowSymlink);
 
-    QQueue<QUrl> directory_queue;
+    QStringList directory_queue;
     int fileCount = 0;
     if (d->fileHints.testFlag(kExcludeSourceFile)) {
         for (const QUrl &url : d->sourceUrlList) {
@@ -676,7 +806,7 @@ void FileStatisticsJob::statisticsRealPathSingle()
                 continue;
 
             bool isDir = S_ISDIR(statBuffer.st_mode);
-            if (!d->checkInode(statBuffer.st_ino, url.path()))
+            if (!d->checkInode(statBuffer.st_dev, statBuffer.st_ino))
                 continue;
 
             if (isDir && d->fileHints.testFlag(kSingleDepth)) {
@@ -701,18 +831,21 @@ void FileStatisticsJob::statisticsRealPathSingle()
             }
 
             if (isDir)
-                directory_queue << url;
+                directory_queue << url.path();
         }
     } else {
         for (const QUrl &url : d->sourceUrlList) {
             // 选择的列表中包含avfsd/proc挂载路径时禁用过滤
             FileHints save_file_hints = d->fileHints;
             d->fileHints = d->fileHints | kDontSkipAVFSDStorage | kDontSkipPROCStorage;
+            const QString &path = url.path();
             struct stat64 statBuffer;
-            if (::stat64(url.path().toStdString().data(), &statBuffer) != 0)
+            if (::stat64(path.toStdString().data(), &statBuffer) != 0)
                 continue;
 
-            d->processFile(url, &statBuffer, followLink, directory_queue);
+            struct stat64 linkBuffer;
+            const bool isSymlink = ::lstat64(path.toStdString().data(), &linkBuffer) == 0 && S_ISLNK(linkBuffer.st_mode);
+            d->processFile(path, &statBuffer, isSymlink, followLink, directory_queue);
 
             if (!d->sizeInfo.isNull())
                 d->sizeInfo->allFiles << url;
@@ -735,46 +868,8 @@ void FileStatisticsJob::statisticsRealPathSingle()
         return;
     }
 
-    while (!directory_queue.isEmpty()) {
-
-        if (!d->stateCheck()) {
-            d->setState(kStoppedState);
-            setSizeInfo();
-            return;
-        }
-
-        const QUrl &directory_url = directory_queue.dequeue();
-
-        DIR *dir { nullptr };
-        struct dirent *entry { nullptr };
-
-        if (!(dir = opendir(directory_url.path().toStdString().data())))
-            continue;
-
-        while ((entry = readdir(dir))) {
-            if (!d->stateCheck()) {
-                d->setState(kStoppedState);
-                setSizeInfo();
-                closedir(dir);
-                return;
-            }
-            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
-                continue;
-
-            struct stat64 statBuffer;
-            QString currentPath = directory_url.path() + QDir::separator() + entry->d_name;
-            if (::stat64(currentPath.toStdString().data(), &statBuffer) != 0)
-                continue;
-
-            QUrl currentFile = QUrl::fromLocalFile(currentPath);
-
-            d->processFile(currentFile, &statBuffer, followLink, directory_queue);
+    d->walkDirectories(directory_queue, followLink);
 
-            if (!d->sizeInfo.isNull())
-                d->sizeInfo->allFiles << currentFile;
-        }
-        closedir(dir);
-    }
     setSizeInfo();
     d->setState(kStoppedState);
 }
@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "hiddenlistcache.h"
+
+#include <dfm-base/utils/mtimeutils.h>
+
+#include <QFile>
+
+#include <sys/stat.h>
+#include <time.h>
+
+DFMBASE_BEGIN_NAMESPACE
+
+namespace {
+
+// an entry is used without looking at the file again for this long
+constexpr qint64 kRevalidateMs { 1000 };
+// searches visit many directories, they are cached again on the next visit
+constexpr int kMaxEntries { 4096 };
+
+inline qint64 monotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+inline QString normalizedPath(const QString &path)
+{
+    QString dirPath = path;
+    while (dirPath.size() > 1 && dirPath.endsWith('/'))
+        dirPath.chop(1);
+    return dirPath;
+}
+
+}   // namespace
+
+HiddenListCache &HiddenListCache::instance()
+{
+    static HiddenListCache ins;
+    return ins;
+}
+
+HiddenListCache::HiddenListCache()
+    : emptyNames(new QSet<QString>)
+{
+}
+
+/*!
+ * \brief HiddenListCache::hiddenNames Get the names listed in the ".hidden" file of dirPath
+ * \return a shared set that is never modified, empty if the directory has no ".hidden" file
+ */
+HiddenListCache::HiddenNames HiddenListCache::hiddenNames(const QString &dirPath)
+{
+    const QString path = normalizedPath(dirPath);
+    const qint64 now = monotonicMs();
+    {
+        QMutexLocker locker(&mutex);
+        auto it = entries.constFind(path);
+        if (it != entries.constEnd() && now - it->checkedAt < kRevalidateMs)
+            return it->names;
+    }
+
+    const QString filePath = path == "/" ? QString("/.hidden") : path + "/.hidden";
+    Entry entry;
+    entry.checkedAt = now;
+    entry.names = emptyNames;
+
+    struct stat st;
+    if (stat(QFile::encodeName(filePath).constData(), &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        entry.inode = st.st_ino;
+        entry.size = st.st_size;
+        entry.mtimeNs = qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+
+        QMutexLocker locker(&mutex);
+        auto it = entries.find(path);
+        if (it != entries.end() && it->inode == entry.inode && it->size == entry.size && it->mtimeNs == entry.mtimeNs) {
+            it->checkedAt = now;
+            return it->names;
+        }
+        locker.unlock();
+
+        entry.names = readHiddenFile(filePath);
+        // a file changed in the racy window is read again next time
+        if (MtimeUtils::isRacy(entry.mtimeNs))
+            return entry.names;
+    }
+
+    QMutexLocker locker(&mutex);
+    if (entries.size() >= kMaxEntries)
+        entries.clear();
+    entries.insert(path, entry);
+    return entry.names;
+}
+
+bool HiddenListCache::isHidden(const QString &dirPath, const QString &name)
+{
+    return hiddenNames(dirPath)->contains(name);
+}
+
+/*!
+ * \brief HiddenListCache::isHiddenBelow Whether path or any of its ancestors below rootPath is hidden,
+ * by a leading dot or by the ".hidden" file of its parent
+ */
+bool HiddenListCache::isHiddenBelow(const QString &path, const QString &rootPath)
+{
+    const QString root = normalizedPath(rootPath);
+    QString current = normalizedPath(path);
+    while (current.size() > root.size() && current.startsWith(root)) {
+        const int slash = current.lastIndexOf('/');
+        if (slash < 0)
+            break;
+
+        const QString name = current.mid(slash + 1);
+        const QString parent = slash == 0 ? QString("/") : current.left(slash);
+        if (name.startsWith('.') || isHidden(parent, name))
+            return true;
+        current = parent;
+    }
+    return false;
+}
+
+void HiddenListCache::invalidate(const QString &dirPath)
+{
+    QMutexLocker locker(&mutex);
+    entries.remove(normalizedPath(dirPath));
+}
+
+void HiddenListCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    entries.clear();
+}
+
+HiddenListCache::HiddenNames HiddenListCache::readHiddenFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return HiddenNames(new QSet<QString>);
+
+    const QStringList &names = QString::fromLocal8Bit(file.readAll()).split('\n', Qt::SkipEmptyParts);
+    return HiddenNames(new QSet<QString>(names.begin(), names.end()));
+}
+
+DFMBASE_END_NAMESPACE
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef HIDDENLISTCACHE_H
+#define HIDDENLISTCACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QString>
+
+DFMBASE_BEGIN_NAMESPACE
+
+/*!
+ * \brief HiddenListCache keeps the parsed ".hidden" file of each directory for the whole process.
+ *
+ * An entry is trusted for kRevalidateMs, then the ".hidden" file is stat'ed and read
+ * again only if its inode, size or mtime changed. A file modified within the last
+ * seconds is not kept, its mtime can not tell a later change yet. Writers of a
+ * ".hidden" file call invalidate() so readers see the change at once.
+ */
+class HiddenListCache
+{
+public:
+    using HiddenNames = QSharedPointer<const QSet<QString>>;
+
+    static HiddenListCache &instance();
+
+    HiddenNames hiddenNames(const QString &dirPath);
+    bool isHidden(const QString &dirPath, const QString &name);
+    bool isHiddenBelow(const QString &path, const QString &rootPath);
+    void invalidate(const QString &dirPath);
+    void clear();
+
+private:
+    struct Entry
+    {
+        quint64 inode { 0 };   // 0 if there is no ".hidden" file
+        qint64 size { -1 };
+        qint64 mtimeNs { -1 };
+        qint64 checkedAt { 0 };
+        HiddenNames names;
+    };
+
+    HiddenListCache();
+    static HiddenNames readHiddenFile(const QString &filePath);
+
+    QMutex mutex;
+    QHash<QString, Entry> entries;
+    const HiddenNames emptyNames;
+};
+
+DFMBASE_END_NAMESPACE
+
+#endif   // HIDDENLISTCACHE_H
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "hidefilehelper.h"
+#include "hiddenlistcache.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/base/schemefactory.h>
@@ -116,6 +117,8 @@ bool HideFileHelper::save() const
     if (d->dfile->open(DFMIO::DFile::OpenFlag::kWriteOnly | DFMIO::DFile::OpenFlag::kTruncate)) {
         d->dfile->write(data);
         d->dfile->close();
+        if (d->dirUrl.isLocalFile())
+            HiddenListCache::instance().invalidate(d->dirUrl.toLocalFile());
         d->updateAttribute();
         return true;
     }
@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "mtimeutils.h"
+
+#include <time.h>
+
+DFMBASE_BEGIN_NAMESPACE
+
+namespace MtimeUtils {
+
+static constexpr qint64 kRacyWindowNs { 2000000000 };
+
+bool isRacy(qint64 mtimeNs)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+    return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec - mtimeNs < kRacyWindowNs;
+}
+
+qint64 trustedMtime(qint64 mtimeNs)
+{
+    return isRacy(mtimeNs) ? -1 : mtimeNs;
+}
+
+}   // namespace MtimeUtils
+
+DFMBASE_END_NAMESPACE
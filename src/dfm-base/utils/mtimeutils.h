@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef MTIMEUTILS_H
+#define MTIMEUTILS_H
+
+#include <dfm-base/dfm_base_global.h>
+
+DFMBASE_BEGIN_NAMESPACE
+
+/*!
+ * Caches that compare mtimes to tell whether a file changed can not trust an mtime
+ * that is too recent: timestamps are taken from a coarse clock, or kept in seconds
+ * on some filesystems, so a file changed within the racy window may change again
+ * without getting a new mtime.
+ */
+namespace MtimeUtils {
+bool isRacy(qint64 mtimeNs);
+// mtimeNs, or -1 when it is in the racy window so that it never matches
+qint64 trustedMtime(qint64 mtimeNs);
+}   // namespace MtimeUtils
+
+DFMBASE_END_NAMESPACE
+
+#endif   // MTIMEUTILS_H
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "pathclassifier.h"
+
+#include <dfm-base/base/device/deviceutils.h>
+
+#include <QHash>
+
+DFMBASE_BEGIN_NAMESPACE
+
+struct PathClassifier::Node
+{
+    ~Node() { qDeleteAll(children); }
+
+    PathTypes types { kNone };   // of the mount on this node
+    QHash<QString, Node *> children;
+};
+
+namespace {
+
+inline constexpr QLatin1String kRunUserPrefix { "/run/user/" };
+inline constexpr QLatin1String kGvfsDir { "/gvfs/" };
+inline constexpr QLatin1String kRootGvfsPrefix { "/root/.gvfs/" };
+inline constexpr QLatin1String kMediaPrefix { "/media/" };
+inline constexpr QLatin1String kRunMediaPrefix { "/run/media/" };
+inline constexpr QLatin1String kSmbMounts { "/smbmounts" };
+
+// position of the gvfs mount name in path, -1 if path is not below a gvfs directory
+int gvfsMountPos(const QString &path)
+{
+    if (path.startsWith(kRootGvfsPrefix))
+        return kRootGvfsPrefix.size();
+
+    if (!path.startsWith(kRunUserPrefix))
+        return -1;
+
+    int pos = kRunUserPrefix.size();
+    const int uidStart = pos;
+    while (pos < path.size() && path.at(pos) >= QLatin1Char('0') && path.at(pos) <= QLatin1Char('9'))
+        ++pos;
+    if (pos == uidStart || QStringView(path).mid(pos, kGvfsDir.size()) != kGvfsDir)
+        return -1;
+    return pos + kGvfsDir.size();
+}
+
+// "/media/.../smbmounts" and "/run/media/.../smbmounts"
+bool isSmbMountsPath(const QString &path)
+{
+    int from = -1;
+    if (path.startsWith(kMediaPrefix))
+        from = kMediaPrefix.size();
+    else if (path.startsWith(kRunMediaPrefix))
+        from = kRunMediaPrefix.size();
+    return from > 0 && path.indexOf(kSmbMounts, from) >= 0;
+}
+
+}   // namespace
+
+PathClassifier::PathClassifier()
+    : mountRoot(new Node)
+{
+}
+
+PathClassifier::~PathClassifier() = default;
+
+/*!
+ * \brief PathClassifier::classifyGvfsPath Classify path by the gvfs and smbmounts layouts only,
+ * it does not depend on any mount table
+ */
+PathClassifier::PathTypes PathClassifier::classifyGvfsPath(const QString &path)
+{
+    PathTypes types { kNone };
+    if (isSmbMountsPath(path))
+        types |= kRemote | kSMB;
+
+    const int pos = gvfsMountPos(path);
+    if (pos < 0)
+        return types;
+
+    types |= kRemote;
+    const QStringView mount = QStringView(path).mid(pos);
+    if (mount.startsWith(QLatin1String("mtp:host")))
+        types |= kMTP;
+    else if (mount.startsWith(QLatin1String("gphoto2:host")))
+        types |= kGphoto;
+    else if (mount.startsWith(QLatin1String("ftp")))
+        types |= kFTP;
+    else if (mount.startsWith(QLatin1String("sftp")))
+        types |= kFTP | kSFTP;
+    else if (mount.startsWith(QLatin1String("smb")))
+        types |= kSMB;
+    else if (mount.startsWith(QLatin1String("nfs")))
+        types |= kNFS;
+    else if (mount.startsWith(QLatin1String("dav"))) {
+        // the ssl option may appear anywhere after "dav", as the expressions allowed
+        if (mount.indexOf(QLatin1String("ssl=false"), 3) >= 0)
+            types |= kDav;
+        if (mount.indexOf(QLatin1String("ssl=true"), 3) >= 0)
+            types |= kDavs;
+    }
+    return types;
+}
+
+/*!
+ * \brief PathClassifier::classifyMountPath Collect the types of every mount point path is below,
+ * walking the trie once along the components of path
+ */
+PathClassifier::PathTypes PathClassifier::classifyMountPath(const QString &path) const
+{
+    if (path.isEmpty())
+        return kNone;
+
+    const Node *node = mountRoot.data();
+    PathTypes types = node->types;
+    int start = 0;
+    while (start < path.size() && !node->children.isEmpty()) {
+        int end = path.indexOf(QLatin1Char('/'), start);
+        if (end < 0)
+            end = path.size();
+        if (end > start) {
+            node = node->children.value(path.mid(start, end - start));
+            if (!node)
+                break;
+            types |= node->types;
+        }
+        start = end + 1;
+    }
+    return types;
+}
+
+PathClassifier::PathTypes PathClassifier::classify(const QString &path) const
+{
+    return classifyGvfsPath(path) | classifyMountPath(path);
+}
+
+void PathClassifier::setMounts(const QMap<QString, QString> &allMounts, const QMap<QString, QString> &externalMounts)
+{
+    QSharedPointer<Node> root(new Node);
+    auto insert = [&root](const QString &mpt, PathTypes types) {
+        if (types == kNone || mpt.isEmpty())
+            return;
+        Node *node = root.data();
+        const auto &parts = QStringView(mpt).split(QLatin1Char('/'), Qt::SkipEmptyParts);
+        for (const auto &part : parts) {
+            Node *&child = node->children[part.toString()];
+            if (!child)
+                child = new Node;
+            node = child;
+        }
+        node->types |= types;
+    };
+
+    const QString opticalPrefix = QString(kBlockDeviceIdPrefix) + "sr";
+    for (auto it = allMounts.constBegin(); it != allMounts.constEnd(); ++it) {
+        PathTypes types { kNone };
+        if (!it.key().startsWith(kBlockDeviceIdPrefix))
+            types |= kProtocolMount;
+        else if (it.key().startsWith(opticalPrefix))
+            types |= kOpticalMount;
+        insert(it.value(), types);
+    }
+    for (auto it = externalMounts.constBegin(); it != externalMounts.constEnd(); ++it) {
+        PathTypes types { kExternalMount };
+        if (it.key().startsWith(kBlockDeviceIdPrefix))
+            types |= kExternalBlockMount;
+        insert(it.value(), types);
+    }
+
+    mountRoot = root;
+}
+
+DFMBASE_END_NAMESPACE
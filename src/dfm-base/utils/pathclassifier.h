@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef PATHCLASSIFIER_H
+#define PATHCLASSIFIER_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QMap>
+#include <QSharedPointer>
+#include <QString>
+
+DFMBASE_BEGIN_NAMESPACE
+
+/*!
+ * \brief PathClassifier tells what kind of location a local path is in with one lookup.
+ *
+ * The gvfs part replaces the ProtocolUtils regular expressions by a parser of
+ * "/run/user/<uid>/gvfs/<mount>" and "/root/.gvfs/<mount>", matching exactly what
+ * the expressions matched. The mount part is a trie of mount point components,
+ * built once from the device mount tables and replaced as a whole when they change,
+ * so lookups never scan the mount list.
+ *
+ * setMounts() must not run concurrently with the lookups, DeviceProxyManager
+ * guards its instance with the lock of its mount tables.
+ */
+class PathClassifier
+{
+public:
+    enum PathType {
+        kNone = 0,
+        kRemote = 1 << 0,   // gvfs mount or smbmounts
+        kMTP = 1 << 1,
+        kGphoto = 1 << 2,
+        kFTP = 1 << 3,   // ftp and sftp
+        kSFTP = 1 << 4,
+        kSMB = 1 << 5,
+        kNFS = 1 << 6,
+        kDav = 1 << 7,
+        kDavs = 1 << 8,
+        kProtocolMount = 1 << 9,   // below a mounted protocol device
+        kExternalMount = 1 << 10,   // below a removable block or protocol device
+        kExternalBlockMount = 1 << 11,
+        kOpticalMount = 1 << 12,
+    };
+    Q_DECLARE_FLAGS(PathTypes, PathType)
+
+    PathClassifier();
+    ~PathClassifier();
+
+    static PathTypes classifyGvfsPath(const QString &path);
+    PathTypes classifyMountPath(const QString &path) const;
+    PathTypes classify(const QString &path) const;
+
+    // device id -> mount point with a trailing slash, as DeviceProxyManager keeps them
+    void setMounts(const QMap<QString, QString> &allMounts, const QMap<QString, QString> &externalMounts);
+
+private:
+    struct Node;
+    QSharedPointer<const Node> mountRoot;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(PathClassifier::PathTypes)
+
+DFMBASE_END_NAMESPACE
+
+#endif   // PATHCLASSIFIER_H
@@ -9,10 +9,33 @@
 #include <dfm-base/interfaces/abstractdiriterator.h>
 
 #include <QObject>
+#include <QMutex>
+#include <QQueue>
+#include <QSet>
+#include <QWaitCondition>
 
+#include <array>
 #include <fts.h>
 
 namespace dfmbase {
+// Inode set split into independently locked shards, so that the parallel
+// directory walkers rarely contend on the same lock while deduplicating hard links.
+class InodeShardSet
+{
+public:
+    bool insert(quint64 device, quint64 inode);
+    void clear();
+
+private:
+    static constexpr int kShardCount { 32 };
+    struct Shard
+    {
+        QMutex mutex;
+        QSet<QPair<quint64, quint64>> inodes;
+    };
+    std::array<Shard, kShardCount> shards;
+};
+
 class FileStatisticsJobPrivate : public QObject
 {
 public:
@@ -26,15 +49,19 @@ public:
 
     void processFile(const QUrl &url, const bool followLink, QQueue<QUrl> &directoryQueue);
     void processFile(const FileInfoPointer &info, const bool followLink, QQueue<QUrl> &directoryQueue);
-    void processFile(const QUrl &url, struct stat64* statBuffer, const bool followLink, QQueue<QUrl> &directoryQueue);
+    void processFile(const QString &path, struct stat64 *statBuffer, const bool isSymlink, const bool followLink, QStringList &directoryQueue);
     void emitSizeChanged();
     int countFileCount(const char *name);
     bool checkFileType(const FileInfo::FileType &fileType);
     bool checkInode(const FileInfoPointer info);
-    bool checkInode(const __ino64_t innode, const QString &path);
+    bool checkInode(const __dev_t device, const __ino64_t innode);
     FileInfo::FileType fileType(const __mode_t fileMode);
-    void processDirectory(const QUrl &url, bool followLink, QQueue<QUrl> &directoryQueue);
-    void processRegularFile(const QUrl &url, struct stat64 *statBuffer, bool followLink);
+    void processDirectory(const QString &path, bool isSymlink, bool followLink, QStringList &directoryQueue);
+    void processRegularFile(const QString &path, struct stat64 *statBuffer, bool isSymlink, bool followLink);
+
+    void walkDirectories(const QStringList &directories, bool followLink);
+    void walkWorker(bool followLink);
+    void walkDirectory(const QString &directory, bool followLink, QStringList &subDirectories);
 
     FileStatisticsJob *q;
     QTimer *notifyDataTimer;
@@ -55,7 +82,15 @@ public:
     QSet<QUrl> allFiles;
     QSet<QString> skipPath;
     QSet<quint64> inodelist;
-    QSet<QString> inodeAndPath;
+    InodeShardSet inodeShards;
+    std::atomic<qint64> lastSizeNotifyTime { 0 };
+
+    // shared state of the parallel local walk
+    QMutex walkMutex;
+    QWaitCondition walkCondition;
+    QQueue<QString> walkQueue;
+    int busyWalkers { 0 };
+    QMutex allFilesMutex;
     AbstractDirIteratorPointer iterator { nullptr };
     std::atomic_bool iteratorCanStop { false };
 };
@@ -4,26 +4,19 @@
 
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/base/device/deviceproxymanager.h>
+#include <dfm-base/utils/pathclassifier.h>
 
 DFMBASE_BEGIN_NAMESPACE
 
 namespace ProtocolUtils {
 
-static bool hasMatch(const QString &txt, const QString &rex)
-{
-    QRegularExpression re(rex);
-    QRegularExpressionMatch match = re.match(txt);
-    return match.hasMatch();
-}
-
 bool isRemoteFile(const QUrl &url)
 {
     if (!url.isValid())
         return false;
 
     // TODO(xust) smbmounts path might be changed in the future.
-    static const QString gvfsMatch { R"((^/run/user/\d+/gvfs/|^/root/.gvfs/|^/(?:run/)?media/[\s\S]*/smbmounts))" };
-    return hasMatch(url.toLocalFile(), gvfsMatch);
+    return PathClassifier::classifyGvfsPath(url.toLocalFile()).testFlag(PathClassifier::kRemote);
 }
 
 bool isMTPFile(const QUrl &url)
@@ -31,8 +24,7 @@ bool isMTPFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    static const QString gvfsMatch { R"(^/run/user/\d+/gvfs/mtp:host|^/root/.gvfs/mtp:host)" };
-    return hasMatch(url.toLocalFile(), gvfsMatch);
+    return PathClassifier::classifyGvfsPath(url.toLocalFile()).testFlag(PathClassifier::kMTP);
 }
 
 bool isGphotoFile(const QUrl &url)
@@ -40,8 +32,7 @@ bool isGphotoFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    static const QString gvfsMatch { R"(^/run/user/\d+/gvfs/gphoto2:host|^/root/.gvfs/gphoto2:host)" };
-    return hasMatch(url.toLocalFile(), gvfsMatch);
+    return PathClassifier::classifyGvfsPath(url.toLocalFile()).testFlag(PathClassifier::kGphoto);
 }
 
 bool isFTPFile(const QUrl &url)
@@ -49,8 +40,7 @@ bool isFTPFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    static const QString smbMatch { R"((^/run/user/\d+/gvfs/s?ftp|^/root/.gvfs/s?ftp))" };
-    return hasMatch(url.path(), smbMatch);
+    return PathClassifier::classifyGvfsPath(url.path()).testFlag(PathClassifier::kFTP);
 }
 
 bool isSFTPFile(const QUrl &url)
@@ -58,8 +48,7 @@ bool isSFTPFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    static const QString smbMatch { R"((^/run/user/\d+/gvfs/sftp|^/root/.gvfs/sftp))" };
-    return hasMatch(url.path(), smbMatch);
+    return PathClassifier::classifyGvfsPath(url.path()).testFlag(PathClassifier::kSFTP);
 }
 
 bool isSMBFile(const QUrl &url)
@@ -69,8 +58,7 @@ bool isSMBFile(const QUrl &url)
     if (url.scheme() == Global::Scheme::kSmb)
         return true;
     // TODO(xust) smbmounts path might be changed in the future.
-    static const QString smbMatch { R"((^/run/user/\d+/gvfs/smb|^/root/.gvfs/smb|^/(?:run/)?media/[\s\S]*/smbmounts))" };
-    return hasMatch(url.path(), smbMatch);
+    return PathClassifier::classifyGvfsPath(url.path()).testFlag(PathClassifier::kSMB);
 }
 
 bool isLocalFile(const QUrl &url)
@@ -79,14 +67,10 @@ bool isLocalFile(const QUrl &url)
 
     if (!url.isLocalFile())
         return false;
-    if (isRemoteFile(url))
-        return false;
-    if (DevProxyMng->isFileOfExternalBlockMounts(url.path()))
-        return false;
-    if (DevProxyMng->isFileOfProtocolMounts(url.path()))
-        return false;
 
-    return true;
+    // gvfs, external block and protocol mounts in one lookup
+    const auto types = DevProxyMng->classifyPath(url.path());
+    return !(types & (PathClassifier::kRemote | PathClassifier::kExternalBlockMount | PathClassifier::kProtocolMount));
 }
 
 bool isNFSFile(const QUrl &url)
@@ -94,8 +78,7 @@ bool isNFSFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    static const QString nfsMatch { R"((^/run/user/\d+/gvfs/nfs|^/root/.gvfs/nfs))" };
-    return hasMatch(url.path(), nfsMatch);
+    return PathClassifier::classifyGvfsPath(url.path()).testFlag(PathClassifier::kNFS);
 }
 
 bool isDavFile(const QUrl &url)
@@ -103,8 +86,7 @@ bool isDavFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    static const QString davMatch { R"((^/run/user/\d+/gvfs/dav.*ssl=false|^/root/.gvfs/dav.*ssl=false))" };
-    return hasMatch(url.path(), davMatch);
+    return PathClassifier::classifyGvfsPath(url.path()).testFlag(PathClassifier::kDav);
 }
 
 bool isDavsFile(const QUrl &url)
@@ -112,8 +94,7 @@ bool isDavsFile(const QUrl &url)
     if (!url.isValid())
         return false;
 
-    static const QString davsMatch { R"((^/run/user/\d+/gvfs/dav.*ssl=true|^/root/.gvfs/dav.*ssl=true))" };
-    return hasMatch(url.path(), davsMatch);
+    return PathClassifier::classifyGvfsPath(url.path()).testFlag(PathClassifier::kDavs);
 }
 
 }   // namespace ProtocolUtils
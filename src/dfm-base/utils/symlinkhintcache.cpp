@@ -0,0 +1,261 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#include "symlinkhintcache.h"
+
+#include <dfm-base/utils/mtimeutils.h>
+
+#include <QFile>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <cerrno>
+
+DFMBASE_BEGIN_NAMESPACE
+
+namespace {
+
+// glibc only wraps getdents64 since 2.30
+struct LinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+constexpr int kDirentBufferSize { 64 * 1024 };
+// a listing is used without looking at the directory again for this long
+constexpr qint64 kRevalidateMs { 500 };
+// the views open few directories at a time
+constexpr int kMaxCachedDirs { 64 };
+// names kept over all listings, larger directories are left to per file queries
+constexpr int kMaxCachedNames { 256 * 1024 };
+
+inline qint64 mtimeNs(const struct stat &st)
+{
+    return qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+// coarse monotonic clock, served by the vdso
+inline qint64 nowMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+}   // namespace
+
+SymlinkHintCache &SymlinkHintCache::instance()
+{
+    static SymlinkHintCache ins;
+    return ins;
+}
+
+/*!
+ * \brief SymlinkHintCache::hint Look up whether path is a symlink in the listing of its parent directory
+ */
+SymlinkHintCache::Hint SymlinkHintCache::hint(const QString &path)
+{
+    QByteArray localPath = QFile::encodeName(path);
+    while (localPath.size() > 1 && localPath.endsWith('/'))
+        localPath.chop(1);
+
+    const int slash = localPath.lastIndexOf('/');
+    if (slash < 0 || slash == localPath.size() - 1)
+        return Hint::kUnknown;
+
+    const QByteArray dirPath = slash == 0 ? QByteArray("/") : localPath.left(slash);
+    const QByteArray name = localPath.mid(slash + 1);
+
+    const qint64 now = nowMs();
+    qint64 knownMtime = -1;
+    {
+        QMutexLocker locker(&mutex);
+        auto it = listings.find(dirPath);
+        if (it != listings.end()) {
+            it->lastUsed = ++useCounter;
+            if (now - it->checkedAt < kRevalidateMs)
+                return lookup(it.value(), name);
+            if (it->valid)
+                knownMtime = it->mtimeNs;
+        }
+    }
+
+    // the directory is looked at and read without the lock, the views ask from several threads
+    struct stat st;
+    if (stat(dirPath.constData(), &st) != 0) {
+        remove(dirPath);
+        return Hint::kUnknown;
+    }
+
+    if (knownMtime >= 0 && knownMtime == mtimeNs(st)) {
+        QMutexLocker locker(&mutex);
+        auto it = listings.find(dirPath);
+        if (it != listings.end() && it->mtimeNs == knownMtime) {
+            it->checkedAt = now;
+            return lookup(it.value(), name);
+        }
+    }
+
+    Listing fresh;
+    fresh.checkedAt = now;
+    readListing(dirPath, &fresh);
+    store(dirPath, fresh);
+    return lookup(fresh, name);
+}
+
+/*!
+ * \brief SymlinkHintCache::setListing Take the names of dirPath from a directory iterator.
+ * The directory mtime is not known, the listing is read again once it is no longer trusted.
+ * \param names the names seen, need not be all of them
+ * \param symlinks the names among them that are symlinks
+ */
+void SymlinkHintCache::setListing(const QString &dirPath, const QSet<QByteArray> &names, const QSet<QByteArray> &symlinks)
+{
+    QByteArray path = QFile::encodeName(dirPath);
+    while (path.size() > 1 && path.endsWith('/'))
+        path.chop(1);
+
+    Listing listing;
+    listing.valid = true;
+    listing.checkedAt = nowMs();
+    listing.names = names;
+    listing.symlinks = symlinks;
+    store(path, listing);
+}
+
+void SymlinkHintCache::invalidate(const QString &dirPath)
+{
+    QByteArray path = QFile::encodeName(dirPath);
+    while (path.size() > 1 && path.endsWith('/'))
+        path.chop(1);
+
+    remove(path);
+}
+
+void SymlinkHintCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    listings.clear();
+    cachedNames = 0;
+}
+
+bool SymlinkHintCache::readListing(const QByteArray &dirPath, Listing *listing)
+{
+    listing->valid = false;
+    listing->names.clear();
+    listing->symlinks.clear();
+
+    int fd = open(dirPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    // the mtime is taken before reading, a change during the read shows up at the next check;
+    // a racy one never matches, the directory may change again within the same tick
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    listing->mtimeNs = MtimeUtils::trustedMtime(mtimeNs(st));
+
+    bool ok = true;
+    QByteArray buffer(kDirentBufferSize, Qt::Uninitialized);
+    forever {
+        long size = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+        if (size == 0)
+            break;
+        if (size < 0) {
+            if (errno == EINTR)
+                continue;
+            ok = false;
+            break;
+        }
+
+        for (long pos = 0; pos < size;) {
+            auto entry = reinterpret_cast<const LinuxDirent64 *>(buffer.constData() + pos);
+            pos += entry->d_reclen;
+            const char *name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                continue;
+
+            bool isLink = entry->d_type == DT_LNK;
+            if (entry->d_type == DT_UNKNOWN) {
+                struct stat entrySt;
+                isLink = fstatat(fd, name, &entrySt, AT_SYMLINK_NOFOLLOW) == 0 && S_ISLNK(entrySt.st_mode);
+            }
+            const QByteArray entryName(name);
+            listing->names.insert(entryName);
+            if (isLink)
+                listing->symlinks.insert(entryName);
+        }
+
+        if (listing->names.size() > kMaxCachedNames) {
+            ok = false;
+            break;
+        }
+    }
+
+    close(fd);
+
+    listing->valid = ok;
+    if (!ok) {
+        listing->names.clear();
+        listing->symlinks.clear();
+    }
+    return ok;
+}
+
+SymlinkHintCache::Hint SymlinkHintCache::lookup(const Listing &listing, const QByteArray &name)
+{
+    if (!listing.valid || !listing.names.contains(name))
+        return Hint::kUnknown;
+    return listing.symlinks.contains(name) ? Hint::kSymlink : Hint::kNotSymlink;
+}
+
+/*!
+ * \brief SymlinkHintCache::store Keep listing for dirPath, dropping the least recently used
+ * listings beyond kMaxCachedDirs or kMaxCachedNames
+ */
+void SymlinkHintCache::store(const QByteArray &dirPath, const Listing &listing)
+{
+    QMutexLocker locker(&mutex);
+    auto it = listings.find(dirPath);
+    if (it != listings.end()) {
+        cachedNames -= it->names.size();
+        it.value() = listing;
+    } else {
+        it = listings.insert(dirPath, listing);
+    }
+    it->lastUsed = ++useCounter;
+    cachedNames += listing.names.size();
+
+    while (listings.size() > 1 && (listings.size() > kMaxCachedDirs || cachedNames > kMaxCachedNames)) {
+        auto oldest = listings.end();
+        for (auto cur = listings.begin(); cur != listings.end(); ++cur) {
+            if (cur.key() != dirPath && (oldest == listings.end() || cur->lastUsed < oldest->lastUsed))
+                oldest = cur;
+        }
+        cachedNames -= oldest->names.size();
+        listings.erase(oldest);
+    }
+}
+
+void SymlinkHintCache::remove(const QByteArray &dirPath)
+{
+    QMutexLocker locker(&mutex);
+    auto it = listings.find(dirPath);
+    if (it == listings.end())
+        return;
+
+    cachedNames -= it->names.size();
+    listings.erase(it);
+}
+
+DFMBASE_END_NAMESPACE
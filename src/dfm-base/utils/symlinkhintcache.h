@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: GPL-3.0-or-later
+#ifndef SYMLINKHINTCACHE_H
+#define SYMLINKHINTCACHE_H
+
+#include <dfm-base/dfm_base_global.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+DFMBASE_BEGIN_NAMESPACE
+
+/*!
+ * \brief SymlinkHintCache tells whether a local path is a symlink without querying the file.
+ *
+ * A directory is read once with getdents64, the names and the ones whose d_type is
+ * DT_LNK are kept. Filesystems reporting DT_UNKNOWN get one fstatat for those entries.
+ * Directory iterators that already know the types hand them over with setListing().
+ * A listing is trusted for kRevalidateMs, then the directory mtime is compared
+ * and the directory is read again only if it changed or was racy when listed. A name the listing does not
+ * hold is newer than the listing and reported as unknown, so the file is asked.
+ * Directories are read outside the lock and evicted least recently used first.
+ */
+class SymlinkHintCache
+{
+public:
+    enum class Hint {
+        kUnknown,   // the directory can not be listed or the name is not in the listing, ask the file itself
+        kNotSymlink,
+        kSymlink,
+    };
+
+    static SymlinkHintCache &instance();
+
+    Hint hint(const QString &path);
+    void setListing(const QString &dirPath, const QSet<QByteArray> &names, const QSet<QByteArray> &symlinks);
+    void invalidate(const QString &dirPath);
+    void clear();
+
+private:
+    struct Listing
+    {
+        bool valid { false };
+        qint64 mtimeNs { -1 };
+        qint64 checkedAt { 0 };
+        quint64 lastUsed { 0 };
+        QSet<QByteArray> names;
+        QSet<QByteArray> symlinks;
+    };
+
+    static bool readListing(const QByteArray &dirPath, Listing *listing);
+    static Hint lookup(const Listing &listing, const QByteArray &name);
+    void store(const QByteArray &dirPath, const Listing &listing);
+    void remove(const QByteArray &dirPath);
+
+    QMutex mutex;
+    QHash<QByteArray, Listing> listings;
+    int cachedNames { 0 };
+    quint64 useCounter { 0 };
+};
+
+DFMBASE_END_NAMESPACE
+
+#endif   // SYMLINKHINTCACHE_H
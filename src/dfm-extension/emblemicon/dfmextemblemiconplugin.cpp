@@ -12,6 +12,7 @@ class DFMExtEmblemIconPluginPrivate
 public:
     dfmext::DFMExtEmblemIconPlugin::EmblemIcons emblemIcons;
     dfmext::DFMExtEmblemIconPlugin::LocationEmblemIcons locationEmblemIcons;
+    dfmext::DFMExtEmblemIconPlugin::LocationEmblemIconsBatch locationEmblemIconsBatch;
 };
 END_DFMEXT_NAMESPACE
 
@@ -58,3 +59,29 @@ void DFMExtEmblemIconPlugin::registerLocationEmblemIcons(const DFMExtEmblemIconP
     if (!d->locationEmblemIcons)
         d->locationEmblemIcons = func;
 }
+
+std::vector<DFMExtEmblem> DFMExtEmblemIconPlugin::locationEmblemIconsBatch(const std::string &dirPath,
+                                                                          const std::vector<std::string> &filePaths,
+                                                                          const std::vector<int> &systemIconCounts) const
+{
+    std::vector<DFMExtEmblem> emblems;
+    if (d->locationEmblemIconsBatch) {
+        emblems = d->locationEmblemIconsBatch(dirPath, filePaths, systemIconCounts);
+        // keep one emblem per file whatever the plugin returns
+        emblems.resize(filePaths.size());
+        return emblems;
+    }
+
+    emblems.reserve(filePaths.size());
+    for (size_t i = 0; i < filePaths.size(); ++i) {
+        int count = i < systemIconCounts.size() ? systemIconCounts[i] : 0;
+        emblems.push_back(locationEmblemIcons(filePaths[i], count));
+    }
+    return emblems;
+}
+
+void DFMExtEmblemIconPlugin::registerLocationEmblemIconsBatch(const DFMExtEmblemIconPlugin::LocationEmblemIconsBatch &func)
+{
+    if (!d->locationEmblemIconsBatch)
+        d->locationEmblemIconsBatch = func;
+}
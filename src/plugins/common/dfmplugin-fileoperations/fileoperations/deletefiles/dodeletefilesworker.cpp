@@ -4,8 +4,16 @@
 
 #include "dodeletefilesworker.h"
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/utils/fileutils.h>
+
+#include <dfm-io/dfmio_utils.h>
 
 #include <QUrl>
+#include <QThread>
+
+#include <cstring>
+
+static constexpr int kMaxDeleteThreads { 8 };
 
 
 DPFILEOPERATIONS_USE_NAMESPACE
@@ -48,6 +56,29 @@ void DoDeleteFilesWorker::onUpdateProgress()
 {
     emitProgressChangedNotify(deleteFilesCount);
 }
+/*!
+ * \brief DoDeleteFilesWorker::statisticsFilesSize Local sources are not walked in advance,
+ * LocalTreeDeleter counts their entries while deleting them
+ * \return
+ */
+bool DoDeleteFilesWorker::statisticsFilesSize()
+{
+    if (sourceUrls.isEmpty()) {
+        fmWarning() << "Source files list is empty, cannot calculate statistics";
+        return false;
+    }
+
+    const QUrl &firstUrl = sourceUrls.first();
+    isSourceFileLocal = FileOperationsUtils::isFileOnDisk(firstUrl)
+            && DFMIO::DFMUtils::fsTypeFromUrl(firstUrl).startsWith("ext");
+    if (!isSourceFileLocal)
+        return AbstractWorker::statisticsFilesSize();
+
+    workData->isSourceFileLocal = isSourceFileLocal;
+    sourceFilesCount = 0;
+    fmDebug() << "Local sources are counted while deleting";
+    return true;
+}
 
 /*!
  * \brief DoDeleteFilesWorker::deleteAllFiles delete All files
@@ -65,58 +96,38 @@ bool DoDeleteFilesWorker::deleteAllFiles()
 }
 /*!
  * \brief DoDeleteFilesWorker::deleteFilesOnCanNotRemoveDevice Delete files on non removable devices
+ * Subtrees are deleted in parallel by LocalTreeDeleter
  * \return delete file success
  */
 bool DoDeleteFilesWorker::deleteFilesOnCanNotRemoveDevice()
 {
-    fmDebug() << "Deleting files on non-removable device - file count:" << allFilesList.count();
-    
-    if (allFilesList.count() == 1 && isConvert) {
-        auto info = InfoFactory::create<FileInfo>(allFilesList.first(), Global::CreateFileInfoType::kCreateFileInfoSync);
-        if (info) {
+    fmDebug() << "Deleting files on non-removable device - source count:" << sourceUrls.count();
+
+    if (sourceUrls.count() == 1 && isConvert) {
+        auto info = InfoFactory::create<FileInfo>(sourceUrls.first(), Global::CreateFileInfoType::kCreateFileInfoSync);
+        if (info && (info->isAttributes(OptInfoType::kIsSymLink) || info->isAttributes(OptInfoType::kIsFile))) {
             deleteFirstFileSize = info->size();
             fmDebug() << "Single file deletion, size:" << deleteFirstFileSize;
         }
     }
 
-    AbstractJobHandler::SupportAction action { AbstractJobHandler::SupportAction::kNoAction };
-    for (QList<QUrl>::iterator it = --allFilesList.end(); it != --allFilesList.begin(); --it) {
+    LocalTreeDeleter deleter(qBound(1, QThread::idealThreadCount(), kMaxDeleteThreads));
+    for (const QUrl &url : std::as_const(sourceUrls)) {
         if (!stateCheck())
             return false;
-        const QUrl &url = *it;
-        auto info = InfoFactory::create<FileInfo>(url, Global::CreateFileInfoType::kCreateFileInfoSync);
-        emitCurrentTaskNotify(url, QUrl());
-        do {
-            action = AbstractJobHandler::SupportAction::kNoAction;
-            if (!localFileHandler->deleteFile(url)) {
-                fmWarning() << "Delete file failed - file:" << url << "error:" << localFileHandler->errorString();
-                action = doHandleErrorAndWait(url, AbstractJobHandler::JobErrorType::kDeleteFileError,
-                                              localFileHandler->errorString());
-            } else {
-                fmDebug() << "Successfully deleted file:" << url;
-            }
-        } while (!isStopped() && action == AbstractJobHandler::SupportAction::kRetryAction);
-
-        if (sourceUrls.contains(url)) {
-            if (action == AbstractJobHandler::SupportAction::kNoAction) {
-                completeSourceFiles.append(url);
-                completeTargetFiles.append(url);
-            }
-        }
 
-        deleteFilesCount++;
-
-        if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+        const auto result = deleteLocalTree(deleter, url);
+        if (result == LocalTreeDeleter::Result::kCancelled)
+            return false;
+        if (result == LocalTreeDeleter::Result::kSkipped) {
             fmInfo() << "Skipped deleting file:" << url;
             continue;
         }
 
-        if (action != AbstractJobHandler::SupportAction::kNoAction)
-            return false;
-
-        emit fileDeleted(url);
+        completeSourceFiles.append(url);
+        completeTargetFiles.append(url);
     }
-    
+
     fmInfo() << "Completed deletion on non-removable device - deleted count:" << deleteFilesCount;
     return true;
 }
@@ -131,13 +142,32 @@ bool DoDeleteFilesWorker::deleteFilesOnOtherDevice()
     bool ok = true;
     if (sourceUrls.count() == 1 && isConvert) {
         auto info = InfoFactory::create<FileInfo>(sourceUrls.first(), Global::CreateFileInfoType::kCreateFileInfoSync);
-        if (info) {
+        if (info && (info->isAttributes(OptInfoType::kIsSymLink) || info->isAttributes(OptInfoType::kIsFile))) {
             deleteFirstFileSize = info->size();
             fmDebug() << "Single file deletion on other device - size:" << deleteFirstFileSize;
         }
     }
     
+    // removable disks gain nothing from parallel deletion, local paths still skip FileInfo creation
+    LocalTreeDeleter deleter(1);
     for (auto &url : sourceUrls) {
+        if (url.isLocalFile()) {
+            if (!stateCheck())
+                return false;
+
+            const auto result = deleteLocalTree(deleter, url);
+            if (result == LocalTreeDeleter::Result::kCancelled)
+                return false;
+            if (result == LocalTreeDeleter::Result::kSkipped) {
+                fmInfo() << "Skipped deleting item:" << url;
+                continue;
+            }
+
+            completeTargetFiles.append(url);
+            completeSourceFiles.append(url);
+            continue;
+        }
+
         const auto &info = InfoFactory::create<FileInfo>(url, Global::CreateFileInfoType::kCreateFileInfoSync);
         if (!info) {
             fmCritical() << "Failed to create file info for deletion - URL:" << url;
@@ -164,7 +194,6 @@ bool DoDeleteFilesWorker::deleteFilesOnOtherDevice()
         
         completeTargetFiles.append(url);
         completeSourceFiles.append(url);
-        emit fileDeleted(url);
         fmDebug() << "Successfully deleted item:" << url;
     }
     
@@ -192,6 +221,7 @@ bool DoDeleteFilesWorker::deleteFileOnOtherDevice(const QUrl &url)
                                           localFileHandler->errorString());
         } else {
             fmDebug() << "Successfully deleted file on other device:" << url;
+            emit fileDeleted(url);
         }
     } while (!isStopped() && action == AbstractJobHandler::SupportAction::kRetryAction);
 
@@ -276,6 +306,46 @@ bool DoDeleteFilesWorker::deleteDirOnOtherDevice(const FileInfoPointer &dir)
     // delete self dir
     return deleteFileOnOtherDevice(dir->urlOf(UrlInfoType::kUrl));
 }
+/*!
+ * \brief DoDeleteFilesWorker::deleteLocalTree Delete a local file or directory tree with deleter
+ * Errors go through the same dialogs as the other delete paths
+ * \param deleter deleter to use
+ * \param url delete url
+ * \return deleter result
+ */
+LocalTreeDeleter::Result DoDeleteFilesWorker::deleteLocalTree(LocalTreeDeleter &deleter, const QUrl &url)
+{
+    emitCurrentTaskNotify(url, QUrl());
+
+    LocalTreeDeleter::Callbacks callbacks;
+    callbacks.error = [this](const QString &path, int errorCode) {
+        return doHandleErrorAndWait(QUrl::fromLocalFile(path), AbstractJobHandler::JobErrorType::kDeleteFileError,
+                                    QString::fromLocal8Bit(strerror(errorCode)));
+    };
+    callbacks.isRunning = [this] {
+        return currentState == AbstractJobHandler::JobState::kRunningState;
+    };
+    callbacks.stateCheck = [this] {
+        return stateCheck();
+    };
+    callbacks.progress = [this](qint64 count) {
+        deleteFilesCount += count;
+    };
+    callbacks.found = [this](qint64 count) {
+        if (isSourceFileLocal)
+            sourceFilesCount += count;
+    };
+    callbacks.removed = [this](const QString &path) {
+        emit fileDeleted(QUrl::fromLocalFile(path));
+    };
+    deleter.setCallbacks(callbacks);
+
+    const auto result = deleter.remove(url.path());
+    if (result != LocalTreeDeleter::Result::kCancelled)
+        FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileDeleted, url);
+
+    return result;
+}
 /*!
  * \brief DoCopyFilesWorker::doHandleErrorAndWait Blocking handles errors and returns
  * actions supported by the operation
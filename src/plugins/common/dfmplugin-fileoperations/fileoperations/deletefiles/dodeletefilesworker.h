@@ -7,6 +7,7 @@
 
 #include "dfmplugin_fileoperations_global.h"
 #include "fileoperations/fileoperationutils/abstractworker.h"
+#include "localtreedeleter.h"
 
 #include <dfm-base/interfaces/abstractjobhandler.h>
 #include <dfm-base/interfaces/fileinfo.h>
@@ -28,6 +29,7 @@ protected:
     bool doWork() override;
     void stop() override;
     void onUpdateProgress() override;
+    bool statisticsFilesSize() override;
 
 protected:
     bool deleteAllFiles();
@@ -35,6 +37,7 @@ protected:
     bool deleteFilesOnOtherDevice();
     bool deleteFileOnOtherDevice(const QUrl &url);
     bool deleteDirOnOtherDevice(const FileInfoPointer &dir);
+    LocalTreeDeleter::Result deleteLocalTree(LocalTreeDeleter &deleter, const QUrl &url);
     AbstractJobHandler::SupportAction doHandleErrorAndWait(const QUrl &from,
                                                            const AbstractJobHandler::JobErrorType &error,
                                                            const QString &errorMsg = QString());
@@ -0,0 +1,451 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localtreedeleter.h"
+
+#include <QFile>
+#include <QThread>
+#include <QVector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+
+DFMBASE_USE_NAMESPACE
+DPFILEOPERATIONS_USE_NAMESPACE
+
+namespace {
+
+// glibc only wraps getdents64 since 2.30
+struct LinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+constexpr int kDirentBufferSize { 64 * 1024 };
+// entries removed between two state checks and progress reports
+constexpr int kCheckInterval { 256 };
+
+}   // namespace
+
+struct LocalTreeDeleter::DirNode
+{
+    DirNode(const QByteArray &path, const QByteArray &name, const DirNodePointer &parent)
+        : path(path), name(name), parent(parent) { }
+    ~DirNode()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+
+    QByteArray path;   // for errors and reports only
+    QByteArray name;   // relative to the fd of parent
+    DirNodePointer parent;
+    int fd { -1 };   // kept open until every subdirectory is finished
+    std::atomic_int pending { 1 };   // its own scan plus every subdirectory not finished yet
+    std::atomic_bool keep { false };   // something below was skipped
+};
+
+LocalTreeDeleter::LocalTreeDeleter(int threadCount)
+    : maxHelpers(qMax(0, threadCount - 1))
+{
+    pool.setMaxThreadCount(qMax(1, maxHelpers));
+}
+
+LocalTreeDeleter::~LocalTreeDeleter()
+{
+    aborted = true;
+    pool.waitForDone();
+}
+
+void LocalTreeDeleter::setCallbacks(const Callbacks &callbacks)
+{
+    this->callbacks = callbacks;
+}
+
+/*!
+ * \brief LocalTreeDeleter::remove Remove path and everything below it
+ * \param path local path
+ * \return kDeleted when path is gone, kSkipped when an entry was skipped,
+ * kCancelled when the job was stopped or an error was not retried or skipped
+ */
+LocalTreeDeleter::Result LocalTreeDeleter::remove(const QString &path)
+{
+    jobThread = QThread::currentThreadId();
+    aborted = false;
+    rootFinished = false;
+    rootKept = false;
+
+    const QByteArray localPath = QFile::encodeName(path);
+    reportFound(1);
+    struct stat st;
+    forever {
+        if (lstat(localPath.constData(), &st) == 0)
+            break;
+        if (errno == EINTR)
+            continue;
+
+        auto action = handleError(localPath, errno);
+        if (action == AbstractJobHandler::SupportAction::kRetryAction)
+            continue;
+        if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+            reportProgress(1);
+            return Result::kSkipped;
+        }
+        return Result::kCancelled;
+    }
+
+    if (!S_ISDIR(st.st_mode)) {
+        forever {
+            if (unlink(localPath.constData()) == 0) {
+                reportProgress(1);
+                reportRemoved(localPath);
+                return Result::kDeleted;
+            }
+            if (errno == EINTR)
+                continue;
+
+            auto action = handleError(localPath, errno);
+            if (action == AbstractJobHandler::SupportAction::kRetryAction)
+                continue;
+            if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+                reportProgress(1);
+                return Result::kSkipped;
+            }
+            return Result::kCancelled;
+        }
+    }
+
+    processDir(std::make_shared<DirNode>(localPath, localPath, nullptr));
+
+    // wait for the helpers, their errors are reported from here
+    forever {
+        checkState();
+        QMutexLocker locker(&mutex);
+        if ((rootFinished || aborted) && activeHelpers == 0)
+            break;
+        if (failures.isEmpty())
+            condition.wait(&mutex, 100);
+    }
+    pool.waitForDone();
+
+    if (aborted)
+        return Result::kCancelled;
+    return rootKept ? Result::kSkipped : Result::kDeleted;
+}
+
+void LocalTreeDeleter::processDir(const DirNodePointer &node)
+{
+    if (!checkState())
+        return;
+
+    constexpr int kOpenFlags { O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC };
+    int fd = -1;
+    forever {
+        fd = node->parent ? openat(node->parent->fd, node->name.constData(), kOpenFlags)
+                          : open(node->path.constData(), kOpenFlags);
+        if (fd >= 0 || errno == ENOENT)
+            break;
+        if (errno == EINTR)
+            continue;
+
+        auto action = handleError(node->path, errno);
+        if (action == AbstractJobHandler::SupportAction::kRetryAction)
+            continue;
+        if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+            node->keep = true;
+            break;
+        }
+        aborted = true;
+        return;
+    }
+
+    node->fd = fd;
+    QVector<QByteArray> subdirs;
+    if (fd >= 0) {
+        // read the whole directory first, unlinking while reading may skip entries on some filesystems
+        QVector<QPair<QByteArray, unsigned char>> entries;
+        QByteArray buffer(kDirentBufferSize, Qt::Uninitialized);
+        forever {
+            long size = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+            if (size == 0)
+                break;
+            if (size < 0) {
+                if (errno == EINTR)
+                    continue;
+                auto action = handleError(node->path, errno);
+                if (action == AbstractJobHandler::SupportAction::kRetryAction)
+                    continue;
+                if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+                    node->keep = true;
+                    break;
+                }
+                aborted = true;
+                break;
+            }
+
+            for (long pos = 0; pos < size;) {
+                auto entry = reinterpret_cast<const LinuxDirent64 *>(buffer.constData() + pos);
+                pos += entry->d_reclen;
+                const char *name = entry->d_name;
+                if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                    continue;
+                entries.append({ QByteArray(name), entry->d_type });
+            }
+        }
+        reportFound(entries.size());
+
+        qint64 removed = 0;
+        int sinceCheck = 0;
+        for (const auto &entry : std::as_const(entries)) {
+            if (aborted)
+                break;
+            if (++sinceCheck >= kCheckInterval) {
+                sinceCheck = 0;
+                reportProgress(removed);
+                removed = 0;
+                if (!checkState())
+                    break;
+            }
+
+            unsigned char type = entry.second;
+            if (type == DT_UNKNOWN) {
+                struct stat st;
+                if (fstatat(fd, entry.first.constData(), &st, AT_SYMLINK_NOFOLLOW) == 0)
+                    type = S_ISDIR(st.st_mode) ? DT_DIR : DT_REG;
+            }
+            if (type == DT_DIR) {
+                subdirs.append(entry.first);
+                continue;
+            }
+
+            bool isDir = false;
+            if (!removeEntry(fd, node, entry.first, &isDir))
+                break;
+            if (isDir)
+                subdirs.append(entry.first);
+            else
+                ++removed;
+        }
+        reportProgress(removed);
+    }
+
+    if (aborted)
+        return;
+
+    for (const QByteArray &name : std::as_const(subdirs)) {
+        ++node->pending;
+        scheduleDir(std::make_shared<DirNode>(node->path + '/' + name, name, node));
+        if (aborted)
+            return;
+    }
+
+    finishDir(node);
+}
+
+/*!
+ * \brief LocalTreeDeleter::finishDir Drop one pending reference of node,
+ * the last one removes the directory and finishes its parent
+ */
+void LocalTreeDeleter::finishDir(const DirNodePointer &node)
+{
+    if (node->pending.fetch_sub(1) > 1 || aborted)
+        return;
+
+    // every subdirectory is finished, nothing opens below it any more
+    if (node->fd >= 0) {
+        close(node->fd);
+        node->fd = -1;
+    }
+
+    if (!node->keep) {
+        forever {
+            const int ret = node->parent ? unlinkat(node->parent->fd, node->name.constData(), AT_REMOVEDIR)
+                                         : rmdir(node->path.constData());
+            if (ret == 0) {
+                reportProgress(1);
+                reportRemoved(node->path);
+                break;
+            }
+            if (errno == ENOENT) {
+                reportProgress(1);
+                break;
+            }
+            if (errno == EINTR)
+                continue;
+
+            auto action = handleError(node->path, errno);
+            if (action == AbstractJobHandler::SupportAction::kRetryAction)
+                continue;
+            if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+                node->keep = true;
+                reportProgress(1);
+                break;
+            }
+            aborted = true;
+            return;
+        }
+    }
+
+    if (node->parent) {
+        if (node->keep)
+            node->parent->keep = true;
+        finishDir(node->parent);
+        return;
+    }
+
+    QMutexLocker locker(&mutex);
+    rootFinished = true;
+    rootKept = node->keep;
+    condition.wakeAll();
+}
+
+void LocalTreeDeleter::scheduleDir(const DirNodePointer &node)
+{
+    int current = activeHelpers;
+    while (current < maxHelpers) {
+        if (activeHelpers.compare_exchange_weak(current, current + 1)) {
+            pool.start([this, node] {
+                processDir(node);
+                QMutexLocker locker(&mutex);
+                --activeHelpers;
+                condition.wakeAll();
+            });
+            return;
+        }
+    }
+
+    // every helper is busy, walk the subtree on this thread
+    processDir(node);
+}
+
+/*!
+ * \brief LocalTreeDeleter::removeEntry Unlink a non directory entry of node
+ * \param isDir set when the entry turned out to be a directory
+ * \return false if the deletion was cancelled
+ */
+bool LocalTreeDeleter::removeEntry(int dirFd, const DirNodePointer &node, const QByteArray &name, bool *isDir)
+{
+    forever {
+        if (unlinkat(dirFd, name.constData(), 0) == 0) {
+            reportRemoved(node->path + '/' + name);
+            return true;
+        }
+        if (errno == ENOENT)
+            return true;
+        if (errno == EINTR)
+            continue;
+        if (errno == EISDIR) {
+            *isDir = true;
+            return true;
+        }
+
+        auto action = handleError(node->path + '/' + name, errno);
+        if (action == AbstractJobHandler::SupportAction::kRetryAction)
+            continue;
+        if (action == AbstractJobHandler::SupportAction::kSkipAction) {
+            node->keep = true;
+            return true;
+        }
+        aborted = true;
+        return false;
+    }
+}
+
+AbstractJobHandler::SupportAction LocalTreeDeleter::handleError(const QByteArray &path, int errorCode)
+{
+    if (isJobThread()) {
+        serveFailures();
+        if (aborted || !callbacks.error)
+            return AbstractJobHandler::SupportAction::kCancelAction;
+        return callbacks.error(QFile::decodeName(path), errorCode);
+    }
+
+    Failure failure;
+    failure.path = path;
+    failure.errorCode = errorCode;
+
+    QMutexLocker locker(&mutex);
+    failures.enqueue(&failure);
+    ++pendingFailures;
+    condition.wakeAll();
+    while (!failure.handled)
+        condition.wait(&mutex);
+
+    return failure.action;
+}
+
+void LocalTreeDeleter::serveFailures()
+{
+    while (pendingFailures > 0) {
+        Failure *failure = nullptr;
+        {
+            QMutexLocker locker(&mutex);
+            if (failures.isEmpty())
+                return;
+            failure = failures.dequeue();
+        }
+
+        auto action = AbstractJobHandler::SupportAction::kCancelAction;
+        if (!aborted && callbacks.error)
+            action = callbacks.error(QFile::decodeName(failure->path), failure->errorCode);
+
+        QMutexLocker locker(&mutex);
+        failure->action = action;
+        failure->handled = true;
+        --pendingFailures;
+        condition.wakeAll();
+    }
+}
+
+bool LocalTreeDeleter::checkState()
+{
+    if (isJobThread()) {
+        serveFailures();
+        if (aborted)
+            return false;
+        if (callbacks.isRunning && callbacks.isRunning())
+            return true;
+        if (callbacks.stateCheck && !callbacks.stateCheck())
+            aborted = true;
+        return !aborted;
+    }
+
+    // helpers hold still while the job is paused, also during an error dialog
+    while (!aborted && callbacks.isRunning && !callbacks.isRunning()) {
+        QMutexLocker locker(&mutex);
+        condition.wait(&mutex, 50);
+    }
+    return !aborted;
+}
+
+void LocalTreeDeleter::reportProgress(qint64 count)
+{
+    if (count > 0 && callbacks.progress)
+        callbacks.progress(count);
+}
+
+void LocalTreeDeleter::reportFound(qint64 count)
+{
+    if (count > 0 && callbacks.found)
+        callbacks.found(count);
+}
+
+void LocalTreeDeleter::reportRemoved(const QByteArray &path)
+{
+    if (callbacks.removed)
+        callbacks.removed(QFile::decodeName(path));
+}
+
+bool LocalTreeDeleter::isJobThread() const
+{
+    return QThread::currentThreadId() == jobThread;
+}
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALTREEDELETER_H
+#define LOCALTREEDELETER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <dfm-base/interfaces/abstractjobhandler.h>
+
+#include <QMutex>
+#include <QQueue>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief LocalTreeDeleter removes a local file tree with plain syscalls.
+ *
+ * Directories are read with getdents64 and their entries removed with unlinkat
+ * relative to the directory fd, no FileInfo or QUrl is created per entry.
+ * Subdirectories are opened with openat relative to their parent's fd, which stays
+ * open until the subdirectories are gone, so renamed or replaced path components
+ * are not followed.
+ * With more than one thread, subdirectories are handed to idle helper threads;
+ * a directory is removed once its own entries and all its subdirectories are gone.
+ *
+ * remove() must be called on the job thread. Errors of helper threads are queued
+ * and reported from the job thread, the helper waits for the chosen action.
+ * A skipped entry keeps its parent directories, they are not reported again.
+ */
+class LocalTreeDeleter
+{
+    Q_DISABLE_COPY(LocalTreeDeleter)
+
+public:
+    enum class Result {
+        kDeleted,
+        kSkipped,   // something was skipped, the path still exists
+        kCancelled,
+    };
+
+    struct Callbacks
+    {
+        // job thread only, blocks for the error dialog
+        std::function<DFMBASE_NAMESPACE::AbstractJobHandler::SupportAction(const QString &path, int errorCode)> error;
+        // any thread, must not block
+        std::function<bool()> isRunning;
+        // job thread only, blocks while paused, false once stopped
+        std::function<bool()> stateCheck;
+        // any thread, number of removed entries since the last call
+        std::function<void(qint64)> progress;
+        // any thread, number of entries found since the last call, the total grows while walking
+        std::function<void(qint64)> found;
+        // any thread, path of every removed entry
+        std::function<void(const QString &path)> removed;
+    };
+
+    explicit LocalTreeDeleter(int threadCount = 1);
+    ~LocalTreeDeleter();
+
+    void setCallbacks(const Callbacks &callbacks);
+    Result remove(const QString &path);
+
+private:
+    struct DirNode;
+    using DirNodePointer = std::shared_ptr<DirNode>;
+
+    struct Failure
+    {
+        QByteArray path;
+        int errorCode { 0 };
+        DFMBASE_NAMESPACE::AbstractJobHandler::SupportAction action { DFMBASE_NAMESPACE::AbstractJobHandler::SupportAction::kNoAction };
+        bool handled { false };
+    };
+
+    void processDir(const DirNodePointer &node);
+    void finishDir(const DirNodePointer &node);
+    void scheduleDir(const DirNodePointer &node);
+    bool removeEntry(int dirFd, const DirNodePointer &node, const QByteArray &name, bool *isDir);
+
+    DFMBASE_NAMESPACE::AbstractJobHandler::SupportAction handleError(const QByteArray &path, int errorCode);
+    void serveFailures();
+    bool checkState();
+    void reportProgress(qint64 count);
+    void reportFound(qint64 count);
+    void reportRemoved(const QByteArray &path);
+    bool isJobThread() const;
+
+    Callbacks callbacks;
+    QThreadPool pool;
+    int maxHelpers { 0 };
+    std::atomic_int activeHelpers { 0 };
+    std::atomic_bool aborted { false };
+    std::atomic_int pendingFailures { 0 };
+    Qt::HANDLE jobThread { nullptr };
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QQueue<Failure *> failures;
+    bool rootFinished { false };
+    bool rootKept { false };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // LOCALTREEDELETER_H
@@ -318,6 +318,7 @@ bool AbstractWorker::initArgs()
     completeTargetFiles.clear();
     completeCustomInfos.clear();
     bigFileSize = FileOperationsUtils::bigFileSize();
+    workData->ioUringQueueDepth = FileOperationsUtils::ioUringQueueDepth();
 
     return true;
 }
@@ -390,6 +391,9 @@ void AbstractWorker::emitProgressChangedNotify(const qint64 &writSize)
     } else if (AbstractJobHandler::JobType::kMoveToTrashType == jobType
                || AbstractJobHandler::JobType::kRestoreType == jobType) {
         info->insert(AbstractJobHandler::NotifyInfoKey::kTotalSizeKey, QVariant::fromValue(qint64(sourceUrls.count())));
+    } else if (AbstractJobHandler::JobType::kDeleteType == jobType && isSourceFileLocal) {
+        // local trees are counted while they are deleted
+        info->insert(AbstractJobHandler::NotifyInfoKey::kTotalSizeKey, QVariant::fromValue(qint64(sourceFilesCount)));
     } else {
         info->insert(AbstractJobHandler::NotifyInfoKey::kTotalSizeKey, QVariant::fromValue(qint64(allFilesList.count())));
     }
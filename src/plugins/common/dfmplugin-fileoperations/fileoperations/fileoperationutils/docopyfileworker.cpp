@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "docopyfileworker.h"
+#include "iouringcopier.h"
 
 #include <dfm-base/utils/fileutils.h>
 #include <dfm-base/base/device/deviceutils.h>
@@ -14,6 +15,7 @@
 #include <dfm-io/dfmio_utils.h>
 
 #include <QDebug>
+#include <QFileInfo>
 #include <QTime>
 #include <QWaitCondition>
 #include <QMutex>
@@ -216,6 +218,19 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFilePractically(const DFileInfo
     // read ahead source file
     readAheadSourceFile(fromInfo);
 
+    // io_uring keeps several reads and writes in flight, the paths below are the fallback
+    if (canCopyByIoUring(fromInfo, toInfo)) {
+        switch (doCopyFileByIoUring(fromInfo, toInfo, skip)) {
+        case NextDo::kDoCopyNext:
+            return NextDo::kDoCopyNext;
+        case NextDo::kDoCopyFallback:
+            // the ring broke before the file was copied, nothing of it is counted
+            break;
+        default:
+            return NextDo::kDoCopyErrorAddCancel;
+        }
+    }
+
     // Check if we should use O_DIRECT mode (safe sync mode for local to external device)
     // Use the existing isSourceFileLocal and isTargetFileLocal from base worker
     bool useDirectMode = workData->exBlockSyncEveryWrite && !workData->isTargetFileLocal;
@@ -450,6 +465,104 @@ DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileTraditional(const DFileInfo
     return NextDo::kDoCopyNext;
 }
 
+/*!
+ * \brief DoCopyFileWorker::doCopyFileByIoUring Copy file through io_uring
+ * Up to ioUringQueueDepth chunks are read and written at the same time with registered buffers.
+ * In safe sync mode every write is linked to a sync of its range, so the progress follows the device.
+ * \param fromInfo Source file info
+ * \param toInfo Target file info
+ * \param skip Skip flag
+ * \return NextDo status, kDoCopyFallback if the ring broke and another method has to copy the file
+ */
+DoCopyFileWorker::NextDo DoCopyFileWorker::doCopyFileByIoUring(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo, bool *skip)
+{
+    int sourceFd = openFileBySys(fromInfo, toInfo, O_RDONLY, skip);
+    if (sourceFd < 0)
+        return NextDo::kDoCopyErrorAddCancel;
+    FinallyUtil releaseSc([&] {
+        close(sourceFd);
+    });
+    int targetFd = openFileBySys(fromInfo, toInfo, O_CREAT | O_WRONLY | O_TRUNC, skip, false);
+    if (targetFd < 0)
+        return NextDo::kDoCopyErrorAddCancel;
+    FinallyUtil releaseTg([&] {
+        close(targetFd);
+    });
+
+    const qint64 fromSize = fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong();
+
+    // chunks complete out of order, preallocating keeps the extents together
+    if (workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyResizeDestinationFile)
+        && fallocate(targetFd, 0, 0, fromSize) != 0)
+        fmDebug() << "fallocate failed for:" << toInfo->uri() << strerror(errno);
+
+    const bool syncEachWrite = workData->exBlockSyncEveryWrite && !workData->isTargetFileLocal;
+    qint64 offset = 0;
+    qint64 reported = 0;
+    const QUrl &fromUrl = fromInfo->uri();
+    const QUrl &toUrl = toInfo->uri();
+    auto onWritten = [&](qint64 written) {
+        reported += written;
+        workData->currentWriteSize += written;
+        // report every completed chunk, the ring may run long without returning
+        emit currentTask(fromUrl, toUrl);
+        return state == kNormal;
+    };
+
+    while (offset < fromSize) {
+        auto result = ioUringCopier->copy(sourceFd, targetFd, offset, fromSize, syncEachWrite, onWritten);
+        // chunks behind a failed one may have completed, they are written again from offset
+        workData->currentWriteSize -= reported - offset;
+        reported = offset;
+
+        if (result == IoUringCopier::Result::kFinished)
+            break;
+
+        if (result == IoUringCopier::Result::kInterrupted) {
+            if (!handleIoUringPause(targetFd, toInfo->uri().path()))
+                return NextDo::kDoCopyErrorAddCancel;
+            continue;
+        }
+
+        if (!ioUringCopier->isValid()) {
+            // the ring itself failed, copy the file again with the other methods
+            fmWarning() << "io_uring copy aborted, falling back - from:" << fromInfo->uri()
+                        << "error:" << strerror(ioUringCopier->lastError());
+            ioUringUnavailable = true;
+            workData->currentWriteSize -= offset;
+            return NextDo::kDoCopyFallback;
+        }
+
+        const bool onRead = ioUringCopier->lastErrorOnRead();
+        auto lastError = strerror(ioUringCopier->lastError());
+        fmWarning() << "io_uring copy error - from:" << fromInfo->uri() << "to:" << toInfo->uri() << "error:" << lastError;
+        auto action = doHandleErrorAndWait(fromInfo->uri(), toInfo->uri(),
+                                           onRead ? AbstractJobHandler::JobErrorType::kReadError
+                                                  : AbstractJobHandler::JobErrorType::kWriteError,
+                                           !onRead, lastError);
+        if (action == AbstractJobHandler::SupportAction::kRetryAction) {
+            checkRetry();
+            continue;
+        }
+        if (!actionOperating(action, fromSize - offset, skip))
+            return NextDo::kDoCopyErrorAddCancel;
+    }
+
+    // metadata is not covered by the synced ranges
+    if (syncEachWrite && !ioUringCopier->sync(targetFd))
+        fmWarning() << "fsync failed for file:" << toInfo->uri() << "error:" << strerror(errno);
+
+    // 对文件加权
+    setTargetPermissions(fromInfo->uri(), toInfo->uri());
+    if (!stateCheck())
+        return NextDo::kDoCopyErrorAddCancel;
+
+    toInfo->refresh();
+    FileUtils::notifyFileChangeManual(DFMBASE_NAMESPACE::Global::FileNotifyType::kFileAdded, toInfo->uri());
+
+    return NextDo::kDoCopyNext;
+}
+
 /*!
  * \brief DoCopyFileWorker::actionToNextDo Convert action to NextDo enum
  * \param action Support action
@@ -1185,6 +1298,71 @@ bool DoCopyFileWorker::handlePauseResume(FileWriter &writer, const QString &dest
     return true;
 }
 
+/*!
+ * \brief DoCopyFileWorker::canCopyByIoUring Check if the file can be copied through io_uring
+ * The ring and its buffers are created on first use and kept for the following files.
+ * \param fromInfo Source file info
+ * \param toInfo Target file info
+ * \return true if doCopyFileByIoUring should be tried
+ */
+bool DoCopyFileWorker::canCopyByIoUring(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo)
+{
+    const int queueDepth = workData->ioUringQueueDepth;
+    if (ioUringUnavailable || queueDepth <= 0)
+        return false;
+
+    // integrity checking reads the data back through DFile, keep it on the traditional path
+    if (workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyIntegrityChecking))
+        return false;
+
+    if (!fromInfo->uri().isLocalFile() || !toInfo->uri().isLocalFile())
+        return false;
+
+    if (fromInfo->attribute(DFileInfo::AttributeID::kStandardSize).toLongLong() <= 0)
+        return false;
+
+    // fuse daemons such as gvfs handle out of order writes poorly
+    const QUrl &parentUrl = QUrl::fromLocalFile(QFileInfo(toInfo->uri().path()).absolutePath());
+    if (dfmio::DFMUtils::fsTypeFromUrl(parentUrl).toLower().contains("fuse"))
+        return false;
+
+    if (!IoUringCopier::isSupported()) {
+        ioUringUnavailable = true;
+        return false;
+    }
+
+    if (ioUringCopier && ioUringCopier->queueDepth() != queueDepth)
+        ioUringCopier.reset();
+    if (!ioUringCopier)
+        ioUringCopier.reset(new IoUringCopier(queueDepth, kMaxBufferLength));
+
+    if (!ioUringCopier->init()) {
+        ioUringUnavailable = true;
+        ioUringCopier.reset();
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief DoCopyFileWorker::handleIoUringPause Handle pause and stop during io_uring copy
+ * All chunks in flight have completed when this is called, the files stay open.
+ * \param targetFd Destination file descriptor
+ * \param dest Destination file path
+ * \return true to continue copying, false if stopped
+ */
+bool DoCopyFileWorker::handleIoUringPause(int targetFd, const QString &dest)
+{
+    if (state == kPaused) {
+        // make the written data reach the device before pausing, same as handlePauseResume
+        if (!ioUringCopier->sync(targetFd))
+            fmWarning() << "fsync failed for file:" << dest << "error:" << strerror(errno);
+    }
+
+    return stateCheck();
+}
+
 /*!
  * \brief DoCopyFileWorker::shouldFallbackFromCopyFileRange Check if copy_file_range error should trigger fallback
  * \param errorCode errno from copy_file_range
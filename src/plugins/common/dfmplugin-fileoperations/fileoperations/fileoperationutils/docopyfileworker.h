@@ -16,6 +16,7 @@
 #include <dfm-io/doperator.h>
 
 #include <QObject>
+#include <QScopedPointer>
 
 #include <fcntl.h>
 
@@ -24,6 +25,7 @@ class QMutex;
 USING_IO_NAMESPACE
 DPFILEOPERATIONS_BEGIN_NAMESPACE
 DFMBASE_USE_NAMESPACE
+class IoUringCopier;
 class DoCopyFileWorker : public QObject
 {
     Q_OBJECT
@@ -82,6 +84,9 @@ public:
     // Traditional DFMIO copy
     NextDo doCopyFileTraditional(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                                  bool *skip);
+    // io_uring copy with several reads and writes in flight, kDoCopyFallback when unavailable
+    NextDo doCopyFileByIoUring(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
+                               bool *skip);
     // normal copy
     NextDo doCopyFileByRange(const DFileInfoPointer fromInfo, const DFileInfoPointer toInfo,
                              bool *skip);
@@ -151,6 +156,10 @@ private:   // file copy
     NextDo actionToNextDo(AbstractJobHandler::SupportAction action, qint64 size, bool *skip);
     bool shouldFallbackFromCopyFileRange(int errorCode) const;
 
+    // io_uring support methods
+    bool canCopyByIoUring(const DFileInfoPointer &fromInfo, const DFileInfoPointer &toInfo);
+    bool handleIoUringPause(int targetFd, const QString &dest);
+
 public:
     static void progressCallback(int64_t current, int64_t total, void *progressData);
 
@@ -166,6 +175,8 @@ private:
     QList<QUrl> skipUrls;
     QUrl memcpySkipUrl;
     DThreadList<QSharedPointer<dfmio::DOperator>> fileOps;
+    QScopedPointer<IoUringCopier> ioUringCopier;   // reused for every file of the job
+    bool ioUringUnavailable { false };
 };
 DPFILEOPERATIONS_END_NAMESPACE
 #endif   // DOCOPYFILEWORKER_H
@@ -429,9 +429,11 @@ DFileInfoPointer FileOperateBaseWorker::doCheckFile(const DFileInfoPointer &from
         setSkipValue(skip, action);
         return nullptr;
     }
-    // 检查目标文件是否存在
-    toInfo->initQuerier();
-    if (!toInfo->exists()) {
+    // 检查目标文件是否存在，已列出或本任务创建的目录不再查询
+    const bool isKnownTargetDir = targetDirCache.isKnownDir(toInfo->uri());
+    if (!isKnownTargetDir)
+        toInfo->initQuerier();
+    if (!isKnownTargetDir && !toInfo->exists()) {
         fmCritical() << " check file to file perant file is  not exists !!!!!!!";
         AbstractJobHandler::JobErrorType errortype = (fromInfo->attribute(DFileInfo::AttributeID::kStandardFilePath).toString().startsWith("/root/")
                                                       && !toInfo->attribute(DFileInfo::AttributeID::kStandardFilePath).toString().startsWith("/root/"))
@@ -565,9 +567,16 @@ DFileInfoPointer FileOperateBaseWorker::doCheckNewFile(const DFileInfoPointer &f
 {
     auto newTargetUrl = createNewTargetUrl(toInfo, fileNewName);
     DFileInfoPointer newTargetInfo { new DFileInfo(newTargetUrl) };
+    // 目标目录的列表里没有这个名称且 fstatat 确认不存在时不用再查询，记下名称以便后续同名文件仍能检查到冲突
+    if (targetDirCache.entry(newTargetUrl) == TargetDirCache::Entry::kMissing) {
+        targetDirCache.addEntry(newTargetUrl);
+        return newTargetInfo;
+    }
     newTargetInfo->initQuerier();
-    if (!newTargetInfo->exists())
+    if (!newTargetInfo->exists()) {
+        targetDirCache.addEntry(newTargetUrl);
         return newTargetInfo;
+    }
 
     if (!workData->jobFlags.testFlag(AbstractJobHandler::JobFlag::kCopyToSelf) && FileOperationsUtils::isAncestorUrl(fromInfo->uri(), newTargetUrl)) {
         AbstractJobHandler::SupportAction action = doHandleErrorAndWait(fromInfo->uri(),
@@ -635,7 +644,10 @@ DFileInfoPointer FileOperateBaseWorker::doCheckNewFile(const DFileInfoPointer &f
         auto newTargetUrl = createNewTargetUrl(toInfo, fileNewName);
         newTargetInfo.reset(new DFileInfo(newTargetUrl));
         newTargetInfo->initQuerier();
-        return !newTargetInfo->exists() ? newTargetInfo : nullptr;
+        if (newTargetInfo->exists())
+            return nullptr;
+        targetDirCache.addEntry(newTargetUrl);
+        return newTargetInfo;
     }
     case AbstractJobHandler::SupportAction::kCancelAction: {
         stopWork.store(true);
@@ -671,8 +683,10 @@ bool FileOperateBaseWorker::checkAndCopyDir(const DFileInfoPointer &fromInfo, co
     if (!toInfo->exists()) {
         do {
             action = AbstractJobHandler::SupportAction::kNoAction;
-            if (localFileHandler->mkdir(toInfo->uri()))
+            if (localFileHandler->mkdir(toInfo->uri())) {
+                targetDirCache.addEmptyDir(toInfo->uri());
                 break;
+            }
             // 特殊处理
             auto errstr = localFileHandler->errorString();
             auto fileUrl = toInfo->uri();
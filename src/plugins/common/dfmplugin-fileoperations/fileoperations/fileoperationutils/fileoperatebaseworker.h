@@ -6,6 +6,7 @@
 #define FILEOPERATEBASEWORKER_H
 
 #include "fileoperations/fileoperationutils/abstractworker.h"
+#include "fileoperations/fileoperationutils/targetdircache.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
 #include <dfm-base/utils/threadcontainer.h>
@@ -131,6 +132,7 @@ protected:
     QString blocakTargetRootPath;
 
     QList<DFileInfoPointer> cutAndDeleteFiles;
+    TargetDirCache targetDirCache;   // target directory listings for the conflict checks
 };
 DPFILEOPERATIONS_END_NAMESPACE
 
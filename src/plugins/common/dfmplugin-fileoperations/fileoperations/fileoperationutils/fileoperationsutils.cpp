@@ -31,6 +31,7 @@ inline constexpr char kFileOperations[] { "org.deepin.dde.file-manager.operation
 inline constexpr char kFileBigSize[] { "file.operation.bigfilesize" };
 inline constexpr char kBlockEverySync[] { "file.operation.blockeverysync" };
 inline constexpr char kBroadcastPaste[] { "file.operation.broadcastpastevent" };
+inline constexpr char kIoUringQueueDepth[] { "file.operation.iouringqueuedepth" };
 
 /*!
  * \brief FileOperationsUtils::statisticsFilesSize 使用c库统计文件大小
@@ -167,6 +168,13 @@ bool FileOperationsUtils::blockSync()
     return sync;
 }
 
+int FileOperationsUtils::ioUringQueueDepth()
+{
+    // 0 关闭 io_uring 拷贝，上限避免占用过多锁定内存
+    int depth = DConfigManager::instance()->value(kFileOperations, kIoUringQueueDepth, 8).toInt();
+    return qBound(0, depth, 64);
+}
+
 QUrl FileOperationsUtils::parentUrl(const QUrl &url)
 {
     auto parent = url.adjusted(QUrl::StripTrailingSlash);
@@ -73,6 +73,7 @@ private:
     static bool isFileOnDisk(const QUrl &url);
     static qint64 bigFileSize();
     static bool blockSync();
+    static int ioUringQueueDepth();
     static QUrl parentUrl(const QUrl &url);
     static bool canBroadcastPaste();
 };
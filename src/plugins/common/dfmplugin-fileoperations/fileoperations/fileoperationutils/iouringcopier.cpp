@@ -0,0 +1,523 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iouringcopier.h"
+
+#include <QByteArray>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+namespace {
+
+int ioUringSetup(unsigned int entries, io_uring_params *params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int fd, unsigned int toSubmit, unsigned int minComplete, unsigned int flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int ioUringRegister(int fd, unsigned int opcode, void *arg, unsigned int count)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+quint64 userData(int index, quint64 op)
+{
+    return (static_cast<quint64>(index) << 8) | op;
+}
+
+}   // namespace
+
+IoUringCopier::IoUringCopier(int queueDepth, qint64 chunkSize)
+    : chunkSize(chunkSize)
+{
+    slots.resize(qMax(1, queueDepth));
+}
+
+IoUringCopier::~IoUringCopier()
+{
+    releaseRing();
+}
+
+bool IoUringCopier::isSupported()
+{
+    static const bool supported = [] {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        int fd = ioUringSetup(4, &params);
+        if (fd < 0) {
+            // ENOSYS: old kernel, EPERM: disabled by sysctl or seccomp
+            fmInfo() << "io_uring is not available:" << strerror(errno);
+            return false;
+        }
+
+        // IORING_REGISTER_PROBE and plain READ / WRITE need 5.6+
+        QByteArray probeData(static_cast<int>(sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op)), '\0');
+        auto probe = reinterpret_cast<io_uring_probe *>(probeData.data());
+        bool ok = ioUringRegister(fd, IORING_REGISTER_PROBE, probe, IORING_OP_LAST) == 0;
+        for (int op : { IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED, IORING_OP_READ, IORING_OP_WRITE,
+                        IORING_OP_SYNC_FILE_RANGE, IORING_OP_FSYNC }) {
+            if (!ok)
+                break;
+            ok = op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+        }
+        close(fd);
+
+        if (!ok)
+            fmInfo() << "io_uring lacks the opcodes needed for copying";
+        return ok;
+    }();
+
+    return supported;
+}
+
+bool IoUringCopier::init()
+{
+    if (ringFd >= 0)
+        return true;
+
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    // a write and its linked sync per slot, plus the final fsync
+    const unsigned int entries = static_cast<unsigned int>(slots.size()) * 2 + 1;
+    int fd = ioUringSetup(entries, &params);
+    if (fd < 0) {
+        error = errno;
+        fmInfo() << "io_uring setup failed:" << strerror(errno);
+        return false;
+    }
+    ringFd = fd;
+    sqEntries = params.sq_entries;
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        sqRing = nullptr;
+        error = errno;
+        releaseRing();
+        return false;
+    }
+
+    if (singleMmap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            cqRing = nullptr;
+            error = errno;
+            releaseRing();
+            return false;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void *sqesMem = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sqesMem == MAP_FAILED) {
+        error = errno;
+        releaseRing();
+        return false;
+    }
+    sqes = static_cast<io_uring_sqe *>(sqesMem);
+
+    char *sq = static_cast<char *>(sqRing);
+    sqHead = reinterpret_cast<unsigned int *>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned int *>(sq + params.sq_off.tail);
+    sqMask = reinterpret_cast<unsigned int *>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned int *>(sq + params.sq_off.array);
+    char *cq = static_cast<char *>(cqRing);
+    cqHead = reinterpret_cast<unsigned int *>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned int *>(cq + params.cq_off.tail);
+    cqMask = reinterpret_cast<unsigned int *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    localSqTail = *sqTail;
+    toSubmit = 0;
+
+    // page aligned, so the buffers also suit O_DIRECT targets
+    bufferPoolSize = static_cast<size_t>(slots.size()) * static_cast<size_t>(chunkSize);
+    void *pool = mmap(nullptr, bufferPoolSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pool == MAP_FAILED) {
+        error = errno;
+        releaseRing();
+        return false;
+    }
+    bufferPool = static_cast<char *>(pool);
+
+    QVector<iovec> iovecs(slots.size());
+    for (int i = 0; i < slots.size(); ++i) {
+        slots[i].buffer = bufferPool + static_cast<size_t>(i) * static_cast<size_t>(chunkSize);
+        iovecs[i].iov_base = slots[i].buffer;
+        iovecs[i].iov_len = static_cast<size_t>(chunkSize);
+    }
+
+    // registration pins the pages, it may exceed RLIMIT_MEMLOCK on older kernels
+    fixedBuffers = ioUringRegister(fd, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned int>(iovecs.size())) == 0;
+    if (!fixedBuffers)
+        fmDebug() << "io_uring buffer registration failed, using unregistered buffers:" << strerror(errno);
+
+    fmDebug() << "io_uring copier ready, queue depth:" << slots.size() << "chunk size:" << chunkSize;
+    return true;
+}
+
+IoUringCopier::Result IoUringCopier::copy(int src, int dst, qint64 &offset, qint64 size, bool syncEachWrite,
+                                          const WrittenCallback &onWritten)
+{
+    error = 0;
+    errorOnRead = false;
+    if (!isValid()) {
+        error = EBADF;
+        return Result::kFailed;
+    }
+
+    srcFd = src;
+    dstFd = dst;
+    syncEach = syncEachWrite;
+    writtenCallback = onWritten;
+    stopIssuing = false;
+    failedOffset = -1;
+    nextOffset = offset;
+    copySize = size;
+
+    for (int i = 0; i < slots.size() && nextOffset < copySize; ++i) {
+        const qint64 length = qMin(chunkSize, copySize - nextOffset);
+        startChunk(i, nextOffset, length);
+        nextOffset += length;
+    }
+
+    auto hasActiveSlot = [this] {
+        return std::any_of(slots.cbegin(), slots.cend(), [](const Slot &slot) { return slot.active; });
+    };
+
+    while (hasActiveSlot()) {
+        if (submitAndWait(1) < 0) {
+            // the ring can not be trusted any more, restart from the oldest unfinished chunk
+            error = errno;
+            for (const Slot &slot : std::as_const(slots)) {
+                if (slot.active)
+                    nextOffset = qMin(nextOffset, slot.chunkOffset + slot.done);
+            }
+            if (failedOffset >= 0)
+                nextOffset = qMin(nextOffset, failedOffset);
+            offset = nextOffset;
+            fmWarning() << "io_uring_enter failed:" << strerror(error);
+            releaseRing();
+            return Result::kFailed;
+        }
+        reapCompletions();
+    }
+
+    writtenCallback = nullptr;
+    if (failedOffset >= 0) {
+        offset = failedOffset;
+        return Result::kFailed;
+    }
+
+    offset = nextOffset;
+    return offset >= copySize ? Result::kFinished : Result::kInterrupted;
+}
+
+bool IoUringCopier::sync(int fd)
+{
+    io_uring_sqe *sqe = isValid() ? nextSqe() : nullptr;
+    if (!sqe)
+        return ::fsync(fd) == 0;
+
+    sqe->opcode = IORING_OP_FSYNC;
+    sqe->fd = fd;
+    sqe->flags = IOSQE_IO_DRAIN;
+    sqe->user_data = userData(0, kOpFsync);
+
+    fsyncDone = false;
+    fsyncResult = 0;
+    while (!fsyncDone) {
+        if (submitAndWait(1) < 0) {
+            releaseRing();
+            return ::fsync(fd) == 0;
+        }
+        reapCompletions();
+    }
+
+    if (fsyncResult < 0) {
+        errno = -fsyncResult;
+        return false;
+    }
+    return true;
+}
+
+io_uring_sqe *IoUringCopier::nextSqe()
+{
+    const unsigned int head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+    if (localSqTail - head >= sqEntries)
+        return nullptr;
+
+    const unsigned int index = localSqTail & *sqMask;
+    io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqArray[index] = index;
+    ++localSqTail;
+    ++toSubmit;
+    return sqe;
+}
+
+int IoUringCopier::submitAndWait(unsigned int waitCount)
+{
+    __atomic_store_n(sqTail, localSqTail, __ATOMIC_RELEASE);
+
+    int ret = -1;
+    do {
+        ret = ioUringEnter(ringFd, toSubmit, waitCount, IORING_ENTER_GETEVENTS);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret < 0) {
+        // the completion queue is full, reaping it lets the next call go on
+        if (errno == EAGAIN || errno == EBUSY)
+            return 0;
+        return -1;
+    }
+
+    toSubmit -= qMin(toSubmit, static_cast<unsigned int>(ret));
+    return 0;
+}
+
+void IoUringCopier::reapCompletions()
+{
+    unsigned int head = *cqHead;
+    const unsigned int tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    while (head != tail) {
+        // copy the entry, handling it may queue new requests
+        const io_uring_cqe cqe = cqes[head & *cqMask];
+        ++head;
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        handleCompletion(&cqe);
+    }
+}
+
+void IoUringCopier::releaseRing()
+{
+    if (bufferPool) {
+        munmap(bufferPool, bufferPoolSize);
+        bufferPool = nullptr;
+        for (Slot &slot : slots)
+            slot = Slot();
+    }
+    fixedBuffers = false;
+
+    if (sqes) {
+        munmap(sqes, sqesSize);
+        sqes = nullptr;
+    }
+    if (cqRing && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    cqRing = nullptr;
+    if (sqRing) {
+        munmap(sqRing, sqRingSize);
+        sqRing = nullptr;
+    }
+
+    // closing the ring also unregisters the buffers
+    if (ringFd >= 0) {
+        close(ringFd);
+        ringFd = -1;
+    }
+}
+
+void IoUringCopier::queueRead(int index)
+{
+    Slot &slot = slots[index];
+    io_uring_sqe *sqe = nextSqe();
+    if (!sqe) {
+        failSlot(index, EAGAIN, true);
+        return;
+    }
+
+    sqe->opcode = fixedBuffers ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    sqe->fd = srcFd;
+    sqe->off = static_cast<quint64>(slot.chunkOffset + slot.done);
+    sqe->addr = reinterpret_cast<quint64>(slot.buffer);
+    sqe->len = static_cast<quint32>(slot.chunkLength - slot.done);
+    if (fixedBuffers)
+        sqe->buf_index = static_cast<quint16>(index);
+    sqe->user_data = userData(index, kOpRead);
+
+    slot.inflight = 1;
+}
+
+void IoUringCopier::queueWrite(int index)
+{
+    Slot &slot = slots[index];
+    io_uring_sqe *sqe = nextSqe();
+    if (!sqe) {
+        failSlot(index, EAGAIN, false);
+        return;
+    }
+
+    const qint64 position = slot.chunkOffset + slot.done + slot.pendingWritten;
+    const quint32 length = static_cast<quint32>(slot.pending - slot.pendingWritten);
+    sqe->opcode = fixedBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+    sqe->fd = dstFd;
+    sqe->off = static_cast<quint64>(position);
+    sqe->addr = reinterpret_cast<quint64>(slot.buffer + slot.pendingWritten);
+    sqe->len = length;
+    if (fixedBuffers)
+        sqe->buf_index = static_cast<quint16>(index);
+    sqe->user_data = userData(index, kOpWrite);
+
+    slot.inflight = 1;
+    slot.writeResult = 0;
+    slot.syncResult = 0;
+
+    if (!syncEach)
+        return;
+
+    // the sync only starts once the write succeeded completely, a short write cancels it
+    io_uring_sqe *syncSqe = nextSqe();
+    if (!syncSqe)
+        return;
+    sqe->flags |= IOSQE_IO_LINK;
+    syncSqe->opcode = IORING_OP_SYNC_FILE_RANGE;
+    syncSqe->fd = dstFd;
+    syncSqe->off = static_cast<quint64>(position);
+    syncSqe->len = length;
+    syncSqe->sync_range_flags = SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER;
+    syncSqe->user_data = userData(index, kOpSync);
+    slot.inflight = 2;
+}
+
+void IoUringCopier::startChunk(int index, qint64 chunkOffset, qint64 chunkLength)
+{
+    Slot &slot = slots[index];
+    slot.chunkOffset = chunkOffset;
+    slot.chunkLength = chunkLength;
+    slot.done = 0;
+    slot.pending = 0;
+    slot.pendingWritten = 0;
+    slot.active = true;
+    queueRead(index);
+}
+
+void IoUringCopier::failSlot(int index, int err, bool onRead)
+{
+    Slot &slot = slots[index];
+    slot.active = false;
+    slot.inflight = 0;
+    stopIssuing = true;
+
+    const qint64 position = slot.chunkOffset + slot.done;
+    if (failedOffset < 0 || position < failedOffset) {
+        failedOffset = position;
+        error = err;
+        errorOnRead = onRead;
+    }
+    fmWarning() << "io_uring" << (onRead ? "read" : "write") << "failed at" << position << strerror(err);
+}
+
+void IoUringCopier::handleCompletion(const io_uring_cqe *cqe)
+{
+    const int index = static_cast<int>(cqe->user_data >> 8);
+    const quint64 op = cqe->user_data & 0xff;
+
+    if (op == kOpFsync) {
+        fsyncResult = cqe->res;
+        fsyncDone = true;
+        return;
+    }
+
+    if (index < 0 || index >= slots.size() || !slots[index].active)
+        return;
+
+    Slot &slot = slots[index];
+    if (op == kOpRead) {
+        slot.inflight = 0;
+        if (cqe->res == -EINTR || cqe->res == -EAGAIN) {
+            queueRead(index);
+        } else if (cqe->res < 0) {
+            failSlot(index, -cqe->res, true);
+        } else if (cqe->res == 0) {
+            // the source became shorter than its size when the copy started
+            failSlot(index, ENODATA, true);
+        } else {
+            slot.pending = cqe->res;
+            slot.pendingWritten = 0;
+            queueWrite(index);
+        }
+        return;
+    }
+
+    if (op == kOpWrite)
+        slot.writeResult = cqe->res;
+    else
+        slot.syncResult = cqe->res;
+
+    if (--slot.inflight > 0)
+        return;
+
+    handleWriteDone(index);
+}
+
+void IoUringCopier::handleWriteDone(int index)
+{
+    Slot &slot = slots[index];
+    const int result = slot.writeResult;
+    if (result == -EINTR || result == -EAGAIN) {
+        queueWrite(index);
+        return;
+    }
+    if (result < 0) {
+        failSlot(index, -result, false);
+        return;
+    }
+    if (result == 0) {
+        failSlot(index, EIO, false);
+        return;
+    }
+
+    slot.pendingWritten += result;
+    if (slot.pendingWritten < slot.pending) {
+        queueWrite(index);
+        return;
+    }
+
+    // EINVAL: the filesystem can not sync a range, the final fsync still covers the data
+    if (slot.syncResult < 0 && slot.syncResult != -EINVAL) {
+        failSlot(index, -slot.syncResult, false);
+        return;
+    }
+
+    const qint64 written = slot.pending;
+    slot.done += written;
+    slot.pending = 0;
+    slot.pendingWritten = 0;
+    if (writtenCallback && !writtenCallback(written))
+        stopIssuing = true;
+
+    // a short read leaves the rest of the chunk, finish it even when interrupted
+    if (slot.done < slot.chunkLength) {
+        queueRead(index);
+        return;
+    }
+
+    slot.active = false;
+    if (!stopIssuing && nextOffset < copySize) {
+        const qint64 length = qMin(chunkSize, copySize - nextOffset);
+        startChunk(index, nextOffset, length);
+        nextOffset += length;
+    }
+}
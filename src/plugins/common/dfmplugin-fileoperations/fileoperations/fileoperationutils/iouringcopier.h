@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IOURINGCOPIER_H
+#define IOURINGCOPIER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QVector>
+
+#include <functional>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief IoUringCopier copies a file with several reads and writes in flight.
+ *
+ * Every slot owns one registered buffer and moves its chunk through
+ * READ_FIXED -> WRITE_FIXED, in sync mode the write is linked to a
+ * SYNC_FILE_RANGE of the same range so progress follows the device.
+ * All slots share one ring, so up to queueDepth chunks are in flight.
+ * The ring is driven by the raw syscalls, there is no liburing dependency.
+ *
+ * Only used on the copy thread, one instance is reused for every file.
+ */
+class IoUringCopier
+{
+    Q_DISABLE_COPY(IoUringCopier)
+
+public:
+    enum class Result {
+        kFinished,   // the whole range was written
+        kInterrupted,   // onWritten asked to stop, everything in flight was completed first
+        kFailed,   // a read or write failed, see lastError()
+    };
+
+    // Called for every completed write with the number of bytes, return false to interrupt
+    using WrittenCallback = std::function<bool(qint64)>;
+
+    explicit IoUringCopier(int queueDepth, qint64 chunkSize = 1024 * 1024);
+    ~IoUringCopier();
+
+    // Whether the running kernel offers the opcodes used here, probed once per process
+    static bool isSupported();
+
+    // Set up the ring and the buffers, false if io_uring can not be used
+    bool init();
+    bool isValid() const { return ringFd >= 0; }
+
+    // Copy [offset, size) from srcFd to the same offsets of dstFd.
+    // On return offset is the point before which everything has been written.
+    Result copy(int srcFd, int dstFd, qint64 &offset, qint64 size, bool syncEachWrite,
+                const WrittenCallback &onWritten);
+
+    // fsync through the ring, ordered after all previous writes
+    bool sync(int fd);
+
+    int lastError() const { return error; }
+    bool lastErrorOnRead() const { return errorOnRead; }
+    int queueDepth() const { return slots.size(); }
+
+private:
+    enum Op : quint64 {
+        kOpRead,
+        kOpWrite,
+        kOpSync,
+        kOpFsync,
+    };
+
+    struct Slot
+    {
+        char *buffer { nullptr };
+        qint64 chunkOffset { 0 };
+        qint64 chunkLength { 0 };
+        qint64 done { 0 };   // bytes of the chunk written
+        qint64 pending { 0 };   // bytes read into buffer and not yet written
+        qint64 pendingWritten { 0 };
+        int inflight { 0 };
+        int writeResult { 0 };
+        int syncResult { 0 };
+        bool active { false };
+    };
+
+    io_uring_sqe *nextSqe();
+    int submitAndWait(unsigned int waitCount);
+    void reapCompletions();
+    void releaseRing();
+
+    void queueRead(int index);
+    void queueWrite(int index);
+    void startChunk(int index, qint64 chunkOffset, qint64 chunkLength);
+    void failSlot(int index, int err, bool onRead);
+    void handleCompletion(const io_uring_cqe *cqe);
+    void handleWriteDone(int index);
+
+    int ringFd { -1 };
+    unsigned int sqEntries { 0 };
+
+    // ring memory shared with the kernel
+    void *sqRing { nullptr };
+    void *cqRing { nullptr };
+    size_t sqRingSize { 0 };
+    size_t cqRingSize { 0 };
+    io_uring_sqe *sqes { nullptr };
+    size_t sqesSize { 0 };
+    unsigned int *sqHead { nullptr };
+    unsigned int *sqTail { nullptr };
+    unsigned int *sqMask { nullptr };
+    unsigned int *sqArray { nullptr };
+    unsigned int *cqHead { nullptr };
+    unsigned int *cqTail { nullptr };
+    unsigned int *cqMask { nullptr };
+    io_uring_cqe *cqes { nullptr };
+    unsigned int localSqTail { 0 };
+    unsigned int toSubmit { 0 };
+
+    char *bufferPool { nullptr };
+    size_t bufferPoolSize { 0 };
+    bool fixedBuffers { false };
+    QVector<Slot> slots;
+    qint64 chunkSize { 0 };
+
+    // state of the running copy()
+    int srcFd { -1 };
+    int dstFd { -1 };
+    bool syncEach { false };
+    bool stopIssuing { false };
+    qint64 nextOffset { 0 };
+    qint64 copySize { 0 };
+    qint64 failedOffset { -1 };
+    int fsyncResult { 0 };
+    bool fsyncDone { false };
+    WrittenCallback writtenCallback;
+
+    int error { 0 };
+    bool errorOnRead { false };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // IOURINGCOPIER_H
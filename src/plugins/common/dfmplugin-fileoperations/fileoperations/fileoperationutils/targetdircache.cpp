@@ -0,0 +1,212 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "targetdircache.h"
+
+#include <QFile>
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <linux/magic.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
+#ifndef FS_CASEFOLD_FL
+#    define FS_CASEFOLD_FL 0x40000000
+#endif
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+namespace {
+
+// drop all listings beyond this, a job walks its target tree once
+constexpr int kMaxCachedDirs { 4096 };
+// larger directories are left to per file queries
+constexpr int kMaxCachedEntries { 256 * 1024 };
+
+// filesystems whose lookups match names byte for byte
+bool isCaseSensitiveFs(int fd)
+{
+    struct statfs fs;
+    if (fstatfs(fd, &fs) != 0)
+        return false;
+
+    switch (static_cast<unsigned long>(fs.f_type)) {
+    case EXT4_SUPER_MAGIC:
+    case BTRFS_SUPER_MAGIC:
+    case XFS_SUPER_MAGIC:
+    case F2FS_SUPER_MAGIC:
+    case TMPFS_MAGIC:
+        break;
+    default:
+        return false;
+    }
+
+    // ext4, f2fs and tmpfs can fold case per directory
+    int flags = 0;
+    if (ioctl(fd, FS_IOC_GETFLAGS, &flags) == 0 && (flags & FS_CASEFOLD_FL))
+        return false;
+    return true;
+}
+
+}   // namespace
+
+/*!
+ * \brief TargetDirCache::entry Look up url in the listing of its parent directory.
+ * A name not in the listing is confirmed with one fstatat, other jobs or processes
+ * may have created it after the listing was read.
+ * \return kMissing if the name is not there, kListed if it is, kUnknown if the directory can not be cached
+ */
+TargetDirCache::Entry TargetDirCache::entry(const QUrl &url)
+{
+    QByteArray dirPath;
+    QByteArray name;
+    if (!splitPath(url, &dirPath, &name))
+        return Entry::kUnknown;
+
+    {
+        QMutexLocker locker(&mutex);
+        const Listing names = listing(dirPath);
+        if (!names)
+            return Entry::kUnknown;
+        if (names->contains(name))
+            return Entry::kListed;
+    }
+
+    struct stat st;
+    const QByteArray &path = dirPath.endsWith('/') ? dirPath + name : dirPath + '/' + name;
+    if (fstatat(AT_FDCWD, path.constData(), &st, AT_SYMLINK_NOFOLLOW) == 0) {
+        addEntry(url);
+        return Entry::kListed;
+    }
+    return errno == ENOENT ? Entry::kMissing : Entry::kUnknown;
+}
+
+/*!
+ * \brief TargetDirCache::isKnownDir Whether url is a directory already listed or created by the job
+ */
+bool TargetDirCache::isKnownDir(const QUrl &url)
+{
+    if (!url.isLocalFile())
+        return false;
+
+    QByteArray path = QFile::encodeName(url.path());
+    while (path.size() > 1 && path.endsWith('/'))
+        path.chop(1);
+
+    QMutexLocker locker(&mutex);
+    return !listings.value(path).isNull();
+}
+
+void TargetDirCache::addEntry(const QUrl &url)
+{
+    QByteArray dirPath;
+    QByteArray name;
+    if (!splitPath(url, &dirPath, &name))
+        return;
+
+    QMutexLocker locker(&mutex);
+    const Listing names = listings.value(dirPath);
+    if (names)
+        names->insert(name);
+}
+
+/*!
+ * \brief TargetDirCache::addEmptyDir Register a directory the job just created
+ */
+void TargetDirCache::addEmptyDir(const QUrl &url)
+{
+    QByteArray dirPath;
+    QByteArray name;
+    if (!splitPath(url, &dirPath, &name))
+        return;
+
+    QMutexLocker locker(&mutex);
+    const Listing names = listings.value(dirPath);
+    if (!names)
+        return;
+
+    // a child of a cacheable directory lives on the same filesystem
+    names->insert(name);
+    insertListing(dirPath + '/' + name, Listing(new QSet<QByteArray>));
+}
+
+void TargetDirCache::clear()
+{
+    QMutexLocker locker(&mutex);
+    listings.clear();
+}
+
+bool TargetDirCache::splitPath(const QUrl &url, QByteArray *dirPath, QByteArray *name)
+{
+    if (!url.isLocalFile())
+        return false;
+
+    QByteArray path = QFile::encodeName(url.path());
+    while (path.size() > 1 && path.endsWith('/'))
+        path.chop(1);
+
+    const int slash = path.lastIndexOf('/');
+    if (slash < 0 || slash == path.size() - 1)
+        return false;
+
+    *dirPath = slash == 0 ? QByteArray("/") : path.left(slash);
+    *name = path.mid(slash + 1);
+    return true;
+}
+
+TargetDirCache::Listing TargetDirCache::readListing(const QByteArray &dirPath)
+{
+    int fd = open(dirPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return {};
+
+    if (!isCaseSensitiveFs(fd)) {
+        close(fd);
+        return {};
+    }
+
+    DIR *dir = fdopendir(fd);
+    if (!dir) {
+        close(fd);
+        return {};
+    }
+
+    Listing names(new QSet<QByteArray>);
+    while (struct dirent *ent = readdir(dir)) {
+        const char *name = ent->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+        if (names->size() >= kMaxCachedEntries) {
+            names.reset();
+            break;
+        }
+        names->insert(QByteArray(name));
+    }
+    closedir(dir);
+
+    return names;
+}
+
+TargetDirCache::Listing TargetDirCache::listing(const QByteArray &dirPath)
+{
+    auto it = listings.constFind(dirPath);
+    if (it != listings.constEnd())
+        return it.value();
+
+    const Listing names = readListing(dirPath);
+    insertListing(dirPath, names);
+    return names;
+}
+
+void TargetDirCache::insertListing(const QByteArray &dirPath, const Listing &names)
+{
+    if (listings.size() >= kMaxCachedDirs)
+        listings.clear();
+    listings.insert(dirPath, names);
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TARGETDIRCACHE_H
+#define TARGETDIRCACHE_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+#include <QSharedPointer>
+#include <QUrl>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief TargetDirCache answers "does the target name exist" from directory listings.
+ *
+ * A target directory is read once with readdir the first time one of its names is
+ * asked for, directories created by the job are registered empty. Names the job
+ * decides to create are added, so a listing stays current while the job runs.
+ *
+ * A name missing from the listing is confirmed with one fstatat before kMissing is
+ * answered, so files created by others since the listing was read still conflict.
+ * A name that is listed still needs a real query since the job may have replaced or
+ * failed to create it. Listings are only kept on case sensitive local filesystems,
+ * everything else answers kUnknown.
+ */
+class TargetDirCache
+{
+    Q_DISABLE_COPY(TargetDirCache)
+
+public:
+    enum class Entry {
+        kUnknown,
+        kMissing,
+        kListed,
+    };
+
+    TargetDirCache() = default;
+
+    Entry entry(const QUrl &url);
+    bool isKnownDir(const QUrl &url);
+    void addEntry(const QUrl &url);
+    void addEmptyDir(const QUrl &url);
+    void clear();
+
+private:
+    using Listing = QSharedPointer<QSet<QByteArray>>;
+
+    static bool splitPath(const QUrl &url, QByteArray *dirPath, QByteArray *name);
+    static Listing readListing(const QByteArray &dirPath);
+    Listing listing(const QByteArray &dirPath);
+    void insertListing(const QByteArray &dirPath, const Listing &names);
+
+    QMutex mutex;
+    QHash<QByteArray, Listing> listings;   // null listing: the directory can not be cached
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // TARGETDIRCACHE_H
@@ -59,6 +59,7 @@ public:
     std::atomic_bool isBlockDevice { false };
     std::atomic_bool isSourceFileLocal { false };   // source file on local device
     std::atomic_bool isTargetFileLocal { false };   // target file on local device
+    std::atomic_int ioUringQueueDepth { 0 };   // reads and writes in flight for io_uring copy, 0 disables it
     std::atomic_int64_t currentWriteSize { 0 };
     QAtomicInteger<qint64> zeroOrlinkOrDirWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
     QAtomicInteger<qint64> blockRenameWriteSize { 0 };   // The copy size is 0. The write statistics size of the linked file and directory
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "domovetotrashfilesworker.h"
+#include "localtrashmover.h"
 
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/base/standardpaths.h>
@@ -16,6 +17,8 @@
 
 #include <QtGlobal>
 #include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
 #include <QStorageInfo>
 
 #include <unistd.h>
@@ -24,6 +27,12 @@
 
 USING_IO_NAMESPACE
 DPFILEOPERATIONS_USE_NAMESPACE
+
+namespace {
+// files moved by rename between two current task notifications
+constexpr int kTaskNotifyInterval { 64 };
+}   // namespace
+
 DoMoveToTrashFilesWorker::DoMoveToTrashFilesWorker(QObject *parent)
     : FileOperateBaseWorker(parent)
 {
@@ -74,6 +83,7 @@ bool DoMoveToTrashFilesWorker::doMoveToTrash()
     bool result = false;
     DFMBASE_NAMESPACE::LocalFileHandler fileHandler;
     static QString homeTrashFileDir = dfmbase::StandardPaths::location(StandardPaths::StandardLocation::kTrashLocalFilesPath);
+    LocalTrashMover trashMover(dfmbase::StandardPaths::location(StandardPaths::StandardLocation::kTrashLocalPath));
     // 总大小使用源文件个数
     for (const auto &url : sourceUrls) {
         QUrl urlSource = url;
@@ -95,6 +105,10 @@ bool DoMoveToTrashFilesWorker::doMoveToTrash()
             continue;
         }
 
+        // 同设备的本地文件直接rename到回收站，失败时再走下面gio的流程并由它报错
+        if (urlSource.isLocalFile() && moveToTrashByRename(&trashMover, urlSource))
+            continue;
+
         // url是否可以删除 canrename
         if (!isCanMoveToTrash(urlSource, &result)) {
             if (result) {
@@ -172,6 +186,48 @@ bool DoMoveToTrashFilesWorker::doMoveToTrash()
     return true;
 }
 
+/*!
+ * \brief DoMoveToTrashFilesWorker::moveToTrashByRename move a local file into the trash of its device
+ * with a plain rename, no file info is created and the trash url is built directly.
+ * Progress is left to the update timer and the current task is only notified now and then.
+ * \param mover the mover kept for the whole job, it holds the trash directories open
+ * \param url the source file url
+ * \return false if the file was not moved, it is still in place
+ */
+bool DoMoveToTrashFilesWorker::moveToTrashByRename(LocalTrashMover *mover, const QUrl &url)
+{
+    const qint64 startTime = QDateTime::currentSecsSinceEpoch();
+    QString trashedPath;
+    bool inHomeTrash = false;
+    if (!mover->moveToTrash(url.path(), &trashedPath, &inHomeTrash)) {
+        fmDebug() << "move to trash by rename not used for" << url << ", errno:" << mover->lastError();
+        return false;
+    }
+
+    if (completeFilesCount % kTaskNotifyInterval == 0)
+        emitCurrentTaskNotify(url, targetUrl);
+
+    // the same time window as gio gives, undo finds the trash item with it
+    QUrl trashUrl = url;
+    trashUrl.setUserInfo(QString("%1-%2").arg(startTime).arg(QDateTime::currentSecsSinceEpoch()));
+    completeTargetFiles.append(trashUrl);
+    completeSourceFiles.append(url);
+    completeFilesCount++;
+
+    // gvfs escapes these characters in trash item names, let TrashHelper resolve them
+    QUrl trashItemUrl;
+    if (trashedPath.contains('\\') || trashedPath.contains('`')) {
+        trashItemUrl = trashTargetUrl(trashUrl);
+    } else {
+        trashItemUrl = FileUtils::trashRootUrl();
+        trashItemUrl.setPath(inHomeTrash ? "/" + QFileInfo(trashedPath).fileName() : FileUtils::normalPathToTrash(trashedPath));
+    }
+    if (trashItemUrl.isValid())
+        emit fileRenamed(url, trashItemUrl);
+
+    return true;
+}
+
 /*!
  * \brief DoMoveToTrashFilesWorker::isCanMoveToTrash loop to check the source file can move to trash
  * \param url the source file url
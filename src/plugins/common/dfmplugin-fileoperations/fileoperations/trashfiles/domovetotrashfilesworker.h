@@ -19,6 +19,7 @@ USING_IO_NAMESPACE
 DFMBASE_USE_NAMESPACE
 DPFILEOPERATIONS_BEGIN_NAMESPACE
 class StorageInfo;
+class LocalTrashMover;
 class DoMoveToTrashFilesWorker : public FileOperateBaseWorker
 {
     friend class MoveToTrashFiles;
@@ -35,6 +36,7 @@ protected:
 
 protected:
     bool doMoveToTrash();
+    bool moveToTrashByRename(LocalTrashMover *mover, const QUrl &url);
     bool isCanMoveToTrash(const QUrl &url, bool *result);
     QUrl trashTargetUrl(const QUrl &url);
     AbstractJobHandler::SupportAction doHandleErrorNoSpace(const QUrl &url);
@@ -0,0 +1,297 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "localtrashmover.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QUrl>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+
+#ifndef RENAME_NOREPLACE
+#    define RENAME_NOREPLACE (1 << 0)
+#endif
+
+DPFILEOPERATIONS_USE_NAMESPACE
+
+namespace {
+
+// give up and let gio handle names with that many twins in the trash
+constexpr int kMaxNameAttempts { 1000 };
+
+// glibc only wraps renameat2 since 2.28
+int renameNoReplace(int fromDirFd, const char *from, int toDirFd, const char *to)
+{
+    return static_cast<int>(syscall(SYS_renameat2, fromDirFd, from, toDirFd, to, RENAME_NOREPLACE));
+}
+
+// same naming as gio: name, name.2, name.3 ... inserted before the first dot
+QByteArray uniqueName(const QByteArray &name, int id)
+{
+    if (id == 1)
+        return name;
+
+    const int dot = name.indexOf('.');
+    if (dot < 0)
+        return name + '.' + QByteArray::number(id);
+    return name.left(dot) + '.' + QByteArray::number(id) + name.mid(dot);
+}
+
+// the shared $topdir/.Trash must be sticky, a private trash directory must be ours, neither a symlink
+bool isTrashDir(const QByteArray &path, bool shared)
+{
+    struct stat st;
+    if (lstat(path.constData(), &st) != 0 || !S_ISDIR(st.st_mode))
+        return false;
+    if (shared)
+        return st.st_mode & S_ISVTX;
+    return st.st_uid == getuid();
+}
+
+// whether the directory name in dirFd is path or one of its ancestors, it can not be renamed into itself
+bool holdsPath(int dirFd, const char *name, QByteArray path)
+{
+    struct stat item;
+    if (fstatat(dirFd, name, &item, AT_SYMLINK_NOFOLLOW) != 0 || !S_ISDIR(item.st_mode))
+        return false;
+
+    while (!path.isEmpty()) {
+        struct stat st;
+        if (stat(path.constData(), &st) == 0 && st.st_dev == item.st_dev && st.st_ino == item.st_ino)
+            return true;
+        const int slash = path.lastIndexOf('/');
+        if (slash <= 0)
+            break;
+        path.truncate(slash);
+    }
+    return false;
+}
+
+}   // namespace
+
+LocalTrashMover::LocalTrashMover(const QString &homeTrashPath)
+    : homeTrashPath(QFile::encodeName(homeTrashPath))
+{
+}
+
+LocalTrashMover::~LocalTrashMover()
+{
+    for (TrashDir *trash : std::as_const(trashDirs)) {
+        if (!trash)
+            continue;
+        close(trash->filesFd);
+        close(trash->infoFd);
+        delete trash;
+    }
+    if (sourceDirFd >= 0)
+        close(sourceDirFd);
+}
+
+/*!
+ * \brief LocalTrashMover::moveToTrash Rename path into the trash of its device
+ * \param path absolute local path
+ * \param trashedPath the new path under the files directory of the trash
+ * \param inHomeTrash set when the home trash was used
+ * \return false if nothing was moved, lastError() tells why
+ */
+bool LocalTrashMover::moveToTrash(const QString &path, QString *trashedPath, bool *inHomeTrash)
+{
+    errorCode = 0;
+    const QByteArray localPath = QFile::encodeName(QDir::cleanPath(path));
+    const int slash = localPath.lastIndexOf('/');
+    if (slash < 0 || slash == localPath.size() - 1) {
+        errorCode = EINVAL;
+        return false;
+    }
+
+    const QByteArray dirPath = slash == 0 ? QByteArray("/") : localPath.left(slash);
+    const QByteArray name = localPath.mid(slash + 1);
+    if (!openSourceDir(dirPath))
+        return false;
+
+    TrashDir *trash = trashDirFor(sourceDevice, dirPath);
+    if (!trash) {
+        errorCode = EXDEV;
+        return false;
+    }
+
+    // relative to the top directory for a per-mount trash, like gio
+    QByteArray originalPath = localPath;
+    if (!trash->topDir.isEmpty())
+        originalPath = localPath.mid(trash->topDir == "/" ? 1 : trash->topDir.size() + 1);
+
+    const QByteArray content = "[Trash Info]\nPath=" + QUrl::toPercentEncoding(QFile::decodeName(originalPath), "/")
+            + "\nDeletionDate=" + QDateTime::currentDateTime().toString("yyyy-MM-ddThh:mm:ss").toLatin1() + "\n";
+
+    for (int id = 1; id <= kMaxNameAttempts; ++id) {
+        const QByteArray trashName = uniqueName(name, id);
+        const QByteArray infoName = trashName + ".trashinfo";
+
+        // reserving the .trashinfo first makes the name ours, as gio does
+        if (!writeTrashInfo(trash, infoName, content)) {
+            if (errorCode == EEXIST)
+                continue;
+            return false;
+        }
+
+        int ret = -1;
+        do {
+            ret = renameNoReplace(sourceDirFd, name.constData(), trash->filesFd, trashName.constData());
+        } while (ret != 0 && errno == EINTR);
+
+        if (ret == 0) {
+            if (trashedPath)
+                *trashedPath = QFile::decodeName(trash->filesPath + '/' + trashName);
+            if (inHomeTrash)
+                *inHomeTrash = trash->topDir.isEmpty();
+            return true;
+        }
+
+        errorCode = errno;
+        unlinkat(trash->infoFd, infoName.constData(), 0);
+        if (errorCode == EEXIST)
+            continue;
+
+        // trashing the trash or one of its ancestors, only this item is left to gio
+        if (errorCode == EINVAL && holdsPath(sourceDirFd, name.constData(), trash->filesPath))
+            return false;
+
+        // no RENAME_NOREPLACE on this filesystem or not really the same device, stop trying it here
+        if (errorCode == EINVAL || errorCode == ENOSYS || errorCode == EXDEV) {
+            close(trash->filesFd);
+            close(trash->infoFd);
+            delete trash;
+            trashDirs.insert(sourceDevice, nullptr);
+        }
+        return false;
+    }
+
+    errorCode = EEXIST;
+    return false;
+}
+
+int LocalTrashMover::lastError() const
+{
+    return errorCode;
+}
+
+LocalTrashMover::TrashDir *LocalTrashMover::trashDirFor(dev_t device, const QByteArray &dirPath)
+{
+    auto it = trashDirs.constFind(device);
+    if (it != trashDirs.constEnd())
+        return it.value();
+
+    TrashDir *trash = nullptr;
+    struct stat st;
+    if (QDir().mkpath(QFile::decodeName(homeTrashPath + "/files")) && QDir().mkpath(QFile::decodeName(homeTrashPath + "/info"))
+        && stat(homeTrashPath.constData(), &st) == 0 && st.st_dev == device) {
+        trash = openTrashDir(homeTrashPath, device, QByteArray());
+        trashDirs.insert(device, trash);
+        return trash;
+    }
+
+    // the top directory is the highest ancestor still on the same device
+    QByteArray topDir = dirPath;
+    while (topDir != "/") {
+        const int slash = topDir.lastIndexOf('/');
+        const QByteArray parent = slash <= 0 ? QByteArray("/") : topDir.left(slash);
+        if (stat(parent.constData(), &st) != 0 || st.st_dev != device)
+            break;
+        topDir = parent;
+    }
+
+    const QByteArray base = topDir == "/" ? QByteArray() : topDir;
+    const QByteArray uid = QByteArray::number(getuid());
+    if (isTrashDir(base + "/.Trash", true) && isTrashDir(base + "/.Trash/" + uid, false))
+        trash = openTrashDir(base + "/.Trash/" + uid, device, topDir);
+    else if (isTrashDir(base + "/.Trash-" + uid, false))
+        trash = openTrashDir(base + "/.Trash-" + uid, device, topDir);
+
+    trashDirs.insert(device, trash);
+    return trash;
+}
+
+LocalTrashMover::TrashDir *LocalTrashMover::openTrashDir(const QByteArray &trashPath, dev_t device, const QByteArray &topDir)
+{
+    mkdir((trashPath + "/files").constData(), 0700);
+    mkdir((trashPath + "/info").constData(), 0700);
+
+    int filesFd = open((trashPath + "/files").constData(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    int infoFd = open((trashPath + "/info").constData(), O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+    struct stat st;
+    if (filesFd < 0 || infoFd < 0 || fstat(filesFd, &st) != 0 || st.st_dev != device) {
+        if (filesFd >= 0)
+            close(filesFd);
+        if (infoFd >= 0)
+            close(infoFd);
+        return nullptr;
+    }
+
+    TrashDir *trash = new TrashDir;
+    trash->topDir = topDir;
+    trash->filesPath = trashPath + "/files";
+    trash->filesFd = filesFd;
+    trash->infoFd = infoFd;
+    return trash;
+}
+
+bool LocalTrashMover::openSourceDir(const QByteArray &dirPath)
+{
+    if (sourceDirFd >= 0 && dirPath == sourceDirPath)
+        return true;
+
+    if (sourceDirFd >= 0)
+        close(sourceDirFd);
+    sourceDirPath.clear();
+
+    sourceDirFd = open(dirPath.constData(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+    struct stat st;
+    if (sourceDirFd < 0 || fstat(sourceDirFd, &st) != 0) {
+        errorCode = errno;
+        if (sourceDirFd >= 0)
+            close(sourceDirFd);
+        sourceDirFd = -1;
+        return false;
+    }
+
+    sourceDirPath = dirPath;
+    sourceDevice = st.st_dev;
+    return true;
+}
+
+bool LocalTrashMover::writeTrashInfo(TrashDir *trash, const QByteArray &infoName, const QByteArray &content)
+{
+    int fd = -1;
+    do {
+        fd = openat(trash->infoFd, infoName.constData(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0600);
+    } while (fd < 0 && errno == EINTR);
+
+    if (fd < 0) {
+        errorCode = errno;
+        return false;
+    }
+
+    qint64 written = 0;
+    while (written < content.size()) {
+        ssize_t ret = write(fd, content.constData() + written, static_cast<size_t>(content.size() - written));
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0) {
+            errorCode = ret < 0 ? errno : EIO;
+            close(fd);
+            unlinkat(trash->infoFd, infoName.constData(), 0);
+            return false;
+        }
+        written += ret;
+    }
+
+    close(fd);
+    return true;
+}
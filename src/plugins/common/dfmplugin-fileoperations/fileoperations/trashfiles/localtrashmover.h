@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LOCALTRASHMOVER_H
+#define LOCALTRASHMOVER_H
+
+#include "dfmplugin_fileoperations_global.h"
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include <sys/types.h>
+
+DPFILEOPERATIONS_BEGIN_NAMESPACE
+
+/*!
+ * \brief LocalTrashMover moves local files into a trash on the same device by renaming them.
+ *
+ * It follows the freedesktop.org trash layout the way gio does: the home trash for
+ * files on its device, otherwise an existing $topdir/.Trash/$uid or $topdir/.Trash-$uid.
+ * The trash directories and the last source directory stay open, so each entry costs
+ * one openat for its .trashinfo and one renameat2(RENAME_NOREPLACE).
+ *
+ * A per-mount trash is only used once gio created it, the first file trashed on such
+ * a device goes through gio. Any failure leaves the source untouched, the caller is
+ * expected to retry the entry with gio which also reports the error.
+ */
+class LocalTrashMover
+{
+    Q_DISABLE_COPY(LocalTrashMover)
+
+public:
+    explicit LocalTrashMover(const QString &homeTrashPath);
+    ~LocalTrashMover();
+
+    bool moveToTrash(const QString &path, QString *trashedPath, bool *inHomeTrash = nullptr);
+    int lastError() const;
+
+private:
+    struct TrashDir
+    {
+        QByteArray topDir;   // empty for the home trash
+        QByteArray filesPath;
+        int filesFd { -1 };
+        int infoFd { -1 };
+    };
+
+    TrashDir *trashDirFor(dev_t device, const QByteArray &dirPath);
+    TrashDir *openTrashDir(const QByteArray &trashPath, dev_t device, const QByteArray &topDir);
+    bool openSourceDir(const QByteArray &dirPath);
+    bool writeTrashInfo(TrashDir *trash, const QByteArray &infoName, const QByteArray &content);
+
+    QByteArray homeTrashPath;
+    QHash<dev_t, TrashDir *> trashDirs;   // nullptr when the device has no usable trash
+    QByteArray sourceDirPath;
+    int sourceDirFd { -1 };
+    dev_t sourceDevice { 0 };
+    int errorCode { 0 };
+};
+
+DPFILEOPERATIONS_END_NAMESPACE
+
+#endif   // LOCALTRASHMOVER_H
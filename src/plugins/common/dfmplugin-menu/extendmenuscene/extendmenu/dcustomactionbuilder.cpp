@@ -3,9 +3,11 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dcustomactionbuilder.h"
+#include "utils/mimeactionmatcher.h"
 #include <dfm-base/base/schemefactory.h>
 
 #include <QDir>
+#include <QSet>
 
 using namespace dfmplugin_menu;
 DFMBASE_USE_NAMESPACE
@@ -212,9 +214,20 @@ QList<DCustomActionEntry> DCustomActionBuilder::matchActions(const QList<QUrl> &
      *action支持类型过滤(类型过滤要加上父类型一起过滤)
      */
 
-    //具体配置过滤
+    //类型规则只依赖菜单项，按顺序编入索引，每种文件类型只展开一次父类型
+    MimeActionMatcher matcher;
+    for (const DCustomActionEntry &action : oriActions) {
+        // MimeType在原有oem中，未指明或Mimetype=*都作为支持所有类型
+        QStringList supportMimeTypes = action.mimeTypes();
+        const bool matchAll = supportMimeTypes.isEmpty();
+        supportMimeTypes.removeAll({});
+        matcher.addRule(supportMimeTypes, action.excludeMimeTypes(), matchAll);
+    }
+
+    //具体配置过滤：协议、后缀、类型都相同的文件结果一致，只计算一次
+    QBitArray remaining(oriActions.size(), true);
+    QSet<QString> checkedKeys;
     for (auto &singleUrl : selects) {
-        //协议、后缀
         QString errString;
         const FileInfoPointer &fileInfo = DFMBASE_NAMESPACE::InfoFactory::create<FileInfo>(singleUrl, Global::CreateFileInfoType::kCreateFileInfoAuto, &errString);
         if (fileInfo.isNull()) {
@@ -222,65 +235,41 @@ QList<DCustomActionEntry> DCustomActionBuilder::matchActions(const QList<QUrl> &
             continue;
         }
 
+        const QMimeType &mt = fileInfo->fileMimeType();
+        const bool isDir = fileInfo->isAttributes(OptInfoType::kIsDir);
+        const QString &key = QString("%1|%2|%3|%4").arg(singleUrl.scheme(), isDir ? "d" : "f",
+                                                         isDir ? QString() : fileInfo->nameOf(NameInfoType::kCompleteSuffix),
+                                                         mt.name());
+        if (checkedKeys.contains(key))
+            continue;
+        checkedKeys.insert(key);
+
         /*
          * 选中文件类型过滤：
-         * fileMimeTypes:包括所有父类型的全量类型集合
-         * fileMimeTypesNoParent:不包含父类mimetype的集合
+         * 不支持的类型只与文件类型本身比较，支持的类型要加上父类型一起比较
          * 目的是在一些应用对文件的识别支持上有差异：比如xlsx的 parentMimeTypes 是application/zip
          * 归档管理器打开则会被作为解压
          */
+        remaining &= matcher.matchedRules(mt);
 
-        QStringList fileMimeTypes;
-        QStringList fileMimeTypesNoParent;
-        //        fileMimeTypes.append(fileInfo->mimeType().name());
-        //        fileMimeTypes.append(fileInfo->mimeType().aliases());
-        //        const QMimeType &mt = fileInfo->mimeType();
-        //        fileMimeTypesNoParent = fileMimeTypes;
-        //        appendParentMimeType(mt.parentMimeTypes(), fileMimeTypes);
-        //        fileMimeTypes.removeAll({});
-        //        fileMimeTypesNoParent.removeAll({});
-
-        appendAllMimeTypes(fileInfo, fileMimeTypesNoParent, fileMimeTypes);
-        for (auto it = oriActions.begin(); it != oriActions.end();) {
-            DCustomActionEntry &tempAction = *it;
-            //协议，后缀
-            if (!isSchemeSupport(tempAction, singleUrl) || !isSuffixSupport(tempAction, fileInfo)) {
-                it = oriActions.erase(it);   //不支持的action移除
-                continue;
-            }
-
-            //不支持的mimetypes,使用不包含父类型的mimetype集合过滤
-            if (isMimeTypeMatch(fileMimeTypesNoParent, tempAction.excludeMimeTypes())) {
-                it = oriActions.erase(it);
-                continue;
-            }
-
-            // MimeType在原有oem中，未指明或Mimetype=*都作为支持所有类型
-            if (tempAction.mimeTypes().isEmpty()) {
-                ++it;
-                continue;
-            }
+        //协议，后缀
+        for (int i = 0; i < oriActions.size(); ++i) {
+            if (remaining.testBit(i)
+                && (!isSchemeSupport(oriActions.at(i), singleUrl) || !isSuffixSupport(oriActions.at(i), fileInfo)))
+                remaining.clearBit(i);
+        }
 
-            //支持的mimetype,使用包含父类型的mimetype集合过滤
-            QStringList supportMimeTypes = tempAction.mimeTypes();
-            supportMimeTypes.removeAll({});
-            auto match = isMimeTypeMatch(fileMimeTypes, supportMimeTypes);
+        if (remaining.count(true) == 0)
+            return {};
+    }
 
-//在自定义右键菜中有作用域限制，此类情况不显示自定义菜单，故可屏蔽，若后续有作用域的调整再考虑是否开放
-#if 0
-            //部分mtp挂载设备目录下文件属性不符合规范(普通目录mimetype被认为是octet-stream)，暂时做特殊处理-
-            if (singleUrl.path().contains("/mtp:host") && supportMimeTypes.contains("application/octet-stream") && fileMimeTypes.contains("application/octet-stream"))
-                match = false;
-#endif
-            if (!match) {
-                it = oriActions.erase(it);
-                continue;
-            }
-            ++it;
-        }
+    QList<DCustomActionEntry> actions;
+    for (int i = 0; i < oriActions.size(); ++i) {
+        if (remaining.testBit(i))
+            actions.append(oriActions.at(i));
     }
 
-    return oriActions;
+    return actions;
 }
 
 /*!
@@ -421,34 +410,6 @@ QStringList DCustomActionBuilder::splitCommand(const QString &cmd)
     return args;
 }
 
-bool DCustomActionBuilder::isMimeTypeSupport(const QString &mt, const QStringList &fileMimeTypes)
-{
-    foreach (const QString &fmt, fileMimeTypes) {
-        if (fmt.contains(mt, Qt::CaseInsensitive)) {
-            return true;
-        }
-    }
-    return false;
-}
-
-bool DCustomActionBuilder::isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &supportMimeTypes)
-{
-    bool match = false;
-    for (const QString &mt : supportMimeTypes) {
-        if (fileMimeTypes.contains(mt, Qt::CaseInsensitive)) {
-            match = true;
-            break;
-        }
-
-        int starPos = mt.indexOf("*");
-        if (starPos >= 0 && isMimeTypeSupport(mt.left(starPos), fileMimeTypes)) {
-            match = true;
-            break;
-        }
-    }
-    return match;
-}
-
 bool DCustomActionBuilder::isSchemeSupport(const DCustomActionEntry &action, const QUrl &url)
 {
     // X-DFM-SupportSchemes not exist
@@ -484,32 +445,6 @@ bool DCustomActionBuilder::isSuffixSupport(const DCustomActionEntry &action, Fil
     return match;
 }
 
-void DCustomActionBuilder::appendAllMimeTypes(const FileInfoPointer &fileInfo, QStringList &noParentmimeTypes, QStringList &allMimeTypes)
-{
-    noParentmimeTypes.append(fileInfo->fileMimeType().name());
-    noParentmimeTypes.append(fileInfo->fileMimeType().aliases());
-    const QMimeType &mt = fileInfo->fileMimeType();
-    allMimeTypes = noParentmimeTypes;
-    appendParentMimeType(mt.parentMimeTypes(), allMimeTypes);
-    noParentmimeTypes.removeAll({});
-    allMimeTypes.removeAll({});
-}
-
-void DCustomActionBuilder::appendParentMimeType(const QStringList &parentmimeTypes, QStringList &mimeTypes)
-{
-    if (parentmimeTypes.size() == 0)
-        return;
-
-    for (const QString &mtName : parentmimeTypes) {
-        DFMBASE_NAMESPACE::DMimeDatabase db;
-        QMimeType mt = db.mimeTypeForName(mtName);
-        mimeTypes.append(mt.name());
-        mimeTypes.append(mt.aliases());
-        QStringList pmts = mt.parentMimeTypes();
-        appendParentMimeType(pmts, mimeTypes);
-    }
-}
-
 /*!
     创建菜单项，\a parentForSubmenu 用于指定菜单的父对象，用于自动释放
     通过获取 \a actionData 中的标题，图标等信息创建菜单项，并遍历创建子项和分割符号。
@@ -39,12 +39,8 @@ public:
     static QStringList splitCommand(const QString &cmd);
 
 private:
-    static bool isMimeTypeSupport(const QString &mt, const QStringList &fileMimeTypes);
-    static bool isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &supportMimeTypes);
     static bool isSchemeSupport(const DCustomActionEntry &action, const QUrl &url);
     static bool isSuffixSupport(const DCustomActionEntry &action, FileInfoPointer fileInfo);
-    static void appendAllMimeTypes(const FileInfoPointer &fileInfo, QStringList &noParentmimeTypes, QStringList &allMimeTypes);
-    static void appendParentMimeType(const QStringList &parentmimeTypes, QStringList &mimeTypes);
 
 protected:
     QAction *createMenu(const DCustomActionData &actionData, QWidget *parentForSubmenu) const;
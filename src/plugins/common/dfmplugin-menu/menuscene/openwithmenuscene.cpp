@@ -77,7 +77,7 @@ bool OpenWithMenuScene::initialize(const QVariantHash &params)
     }
 
     MimesAppsManager::instance()->initMimeTypeApps();
-    d->recommendApps = MimesAppsManager::instance()->getRecommendedApps(d->focusFileInfo->urlOf(UrlInfoType::kRedirectedFileUrl));
+    d->recommendApps = MimesAppsManager::instance()->getRecommendedAppsByMimeType(d->focusFileInfo->fileMimeType().name());
 
     // why?
     d->recommendApps.removeAll("/usr/share/applications/dde-open.desktop");
@@ -4,12 +4,12 @@
 
 #include "private/oemmenu_p.h"
 #include "oemmenu.h"
+#include "utils/mimeactionmatcher.h"
 
 #include <dfm-base/file/local/localfilewatcher.h>
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/base/device/deviceutils.h>
 #include <dfm-base/utils/fileutils.h>
-#include <dfm-base/mimetype/dmimedatabase.h>
 #include <dfm-base/utils/protocolutils.h>
 
 #include <QDir>
@@ -17,6 +17,7 @@
 #include <QIcon>
 #include <QMenu>
 #include <QDebug>
+#include <QSet>
 
 using namespace dfmplugin_menu;
 DFMBASE_USE_NAMESPACE
@@ -127,30 +128,6 @@ QStringList OemMenuPrivate::getValues(const DDesktopEntry &entry, const QString
     return values;
 }
 
-bool OemMenuPrivate::isMimeTypeSupport(const QString &mt, const QStringList &fileMimeTypes) const
-{
-    for (auto fmt : fileMimeTypes) {
-        if (fmt.contains(mt, Qt::CaseInsensitive))
-            return true;
-    }
-
-    return false;
-}
-
-bool OemMenuPrivate::isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &supportMimeTypes) const
-{
-    for (auto mt : supportMimeTypes) {
-        if (fileMimeTypes.contains(mt, Qt::CaseInsensitive))
-            return true;
-
-        int index = mt.indexOf("*");
-        if (index >= 0 && isMimeTypeSupport(mt.left(index), fileMimeTypes))
-            return true;
-    }
-
-    return false;
-}
-
 bool OemMenuPrivate::isActionShouldShow(const QAction *action, bool onDesktop) const
 {
     if (!action)
@@ -379,19 +356,64 @@ QStringList OemMenuPrivate::urlListToString(const QList<QUrl> &files) const
     return rets;
 }
 
-void OemMenuPrivate::appendParentMineType(const QStringList &parentmimeTypes, QStringList &mimeTypes) const
+QList<QAction *> OemMenuPrivate::matchActions(const QString &menuType, const QList<QUrl> &files, bool onDesktop, bool allEx7z)
 {
-    if (parentmimeTypes.isEmpty())
-        return;
+    const QList<QAction *> &actions = actionListByType.value(menuType);
+    if (actions.isEmpty())
+        return {};
+
+    MimeActionMatcher &matcher = matcherByType[menuType];
+    QBitArray remaining(actions.size(), true);
+    QSet<QString> checkedKeys;
+    QString errString;
+    for (const QUrl &file : files) {
+        auto fileInfo = DFMBASE_NAMESPACE::InfoFactory::create<FileInfo>(file, Global::CreateFileInfoType::kCreateFileInfoAuto, &errString);
+        if (!fileInfo) {
+            fmWarning() << "createFileInfo failed: " << file;
+            continue;
+        }
+
+        // files with the same scheme, suffix and mime type get the same result
+        const QMimeType &mt = fileInfo->fileMimeType();
+        const bool isDir = fileInfo->isAttributes(OptInfoType::kIsDir);
+        const bool isMtp = file.path().contains("/mtp:host");
+        const bool isFtp = ProtocolUtils::isFTPFile(file);
+        const QString &key = QString("%1|%2|%3|%4|%5|%6").arg(file.scheme(), isDir ? "d" : "f",
+                                                               isDir ? QString() : fileInfo->nameOf(NameInfoType::kCompleteSuffix),
+                                                               mt.name(), isMtp ? "m" : "", isFtp ? "f" : "");
+        if (checkedKeys.contains(key))
+            continue;
+        checkedKeys.insert(key);
+
+        // exclude mime types only match the type itself, e.g. xlsx parentMimeTypes is application/zip
+        remaining &= matcher.matchedRules(mt);
+
+        // The file attributes of some MTP mounted device directories do not meet the specifications
+        //(the ordinary directory mimeType is considered octet stream), so special treatment is required
+        if (isMtp && matcher.mimeTypeClosure(mt).contains("application/octet-stream"))
+            remaining &= ~matcher.rulesSupporting("application/octet-stream");
 
-    DFMBASE_NAMESPACE::DMimeDatabase db;
-    for (const QString &mtName : parentmimeTypes) {
-        QMimeType mt = db.mimeTypeForName(mtName);
-        mimeTypes.append(mt.name());
-        mimeTypes.append(mt.aliases());
-        QStringList pmts = mt.parentMimeTypes();
-        appendParentMineType(pmts, mimeTypes);
+        for (int i = 0; i < actions.size(); ++i) {
+            if (!remaining.testBit(i))
+                continue;
+
+            QAction *action = actions.at(i);
+            // compression is not supported on FTP
+            if (!isValid(action, fileInfo, onDesktop, allEx7z)
+                || (isFtp && action->text() == QObject::tr("Compress")))
+                remaining.clearBit(i);
+        }
+
+        if (remaining.count(true) == 0)
+            return {};
+    }
+
+    QList<QAction *> rets;
+    for (int i = 0; i < actions.size(); ++i) {
+        if (remaining.testBit(i))
+            rets.append(actions.at(i));
     }
+    return rets;
 }
 
 OemMenu::OemMenu(QObject *parent)
@@ -408,6 +430,7 @@ void OemMenu::loadDesktopFile()
 {
     d->menuActionHolder.reset(new QObject(this));
     d->actionListByType.clear();
+    d->matcherByType.clear();
     d->clearSubMenus();
 
     for (auto path : d->oemMenuPath) {
@@ -439,8 +462,17 @@ void OemMenu::loadDesktopFile()
                 d->setActionProperty(action, entry, propery, kDesktopEntryGroup);
             }
 
+            // MimeType not exist == MimeType=*
+            QStringList supportMimeTypes = action->property(kMimeType).toStringList();
+            supportMimeTypes.removeAll({});
+            QStringList excludeMimeTypes = action->property(kMimeTypeExcludeKey).toStringList();
+            excludeMimeTypes << action->property(kMimeTypeExcludeAliasKey).toStringList();
+            excludeMimeTypes.removeAll({});
+            const bool matchAll = !action->property(kMimeType).isValid();
+
             for (const QString &type : menuTypes) {
                 d->actionListByType[type].append(action);
+                d->matcherByType[type].addRule(supportMimeTypes, excludeMimeTypes, matchAll);
             }
 
             // sub action
@@ -505,83 +537,7 @@ QList<QAction *> OemMenu::normalActions(const QList<QUrl> &files, bool onDesktop
         menuType = kMultiFileDirs;
     }
 
-    QList<QAction *> actions = d->actionListByType[menuType];
-    if (actions.isEmpty())
-        return actions;
-
-    QStringList filePaths;
-    bool bex7z = d->isAllEx7zFile(files);
-    for (const QUrl &file : files) {
-
-        auto fileInfo = DFMBASE_NAMESPACE::InfoFactory::create<FileInfo>(file, Global::CreateFileInfoType::kCreateFileInfoAuto, &errString);
-
-        if (!fileInfo) {
-            fmWarning() << "createFileInfo failed: " << file;
-            continue;
-        }
-        filePaths << file.path();
-
-        QStringList fileMimeTypes, fmts;
-        fileMimeTypes.append(fileInfo->fileMimeType().name());
-        fileMimeTypes.append(fileInfo->fileMimeType().aliases());
-        const QMimeType &mt = fileInfo->fileMimeType();
-        fmts = fileMimeTypes;
-        d->appendParentMineType(mt.parentMimeTypes(), fileMimeTypes);
-        fileMimeTypes.removeAll({});
-        fmts.removeAll({});
-
-        for (auto it = actions.begin(); it != actions.end();) {
-            QAction *action = *it;
-            if (!d->isValid(action, fileInfo, onDesktop, bex7z)) {
-                it = actions.erase(it);
-                continue;
-            }
-
-            // compression is not supported on FTP
-            if (action->text() == QObject::tr("Compress") && ProtocolUtils::isFTPFile(file)) {
-                it = actions.erase(it);
-                continue;
-            }
-
-            // match exclude mime types
-            QStringList excludeMimeTypes = action->property(kMimeTypeExcludeKey).toStringList();
-            excludeMimeTypes << action->property(kMimeTypeExcludeAliasKey).toStringList();
-
-            excludeMimeTypes.removeAll({});
-            // e.g. xlsx parentMimeTypes is application/zip
-            bool match = d->isMimeTypeMatch(fmts, excludeMimeTypes);
-            if (match) {
-                it = actions.erase(it);
-                continue;
-            }
-
-            // MimeType not exist == MimeType=*
-            if (!action->property(kMimeType).isValid()) {
-                ++it;
-                continue;
-            }
-
-            // match support mime types
-            QStringList supportMimeTypes = action->property(kMimeType).toStringList();
-            supportMimeTypes.removeAll({});
-            match = d->isMimeTypeMatch(fileMimeTypes, supportMimeTypes);
-
-            // The file attributes of some MTP mounted device directories do not meet the specifications
-            //(the ordinary directory mimeType is considered octet stream), so special treatment is required
-            if (file.path().contains("/mtp:host") && supportMimeTypes.contains("application/octet-stream") && fileMimeTypes.contains("application/octet-stream")) {
-                match = false;
-            }
-
-            if (!match) {
-                it = actions.erase(it);
-                continue;
-            }
-
-            ++it;
-        }
-    }
-
-    return actions;
+    return d->matchActions(menuType, files, onDesktop, d->isAllEx7zFile(files));
 }
 
 QList<QAction *> OemMenu::focusNormalActions(const QUrl &foucs, const QList<QUrl> &files, bool onDesktop)
@@ -601,81 +557,7 @@ QList<QAction *> OemMenu::focusNormalActions(const QUrl &foucs, const QList<QUrl
     else
         menuType = kMultiFileDirs;
 
-    // get actions surported menutype
-    actions = d->actionListByType[menuType];
-    if (actions.isEmpty())
-        return actions;
-
-    // get foucs file mimetype
-    QStringList mimeTypes;
-    QStringList siblingMimeTypes;
-    {
-        // get normal mimetype
-        mimeTypes.append(fileInfo->fileMimeType().name());
-        mimeTypes.append(fileInfo->fileMimeType().aliases());
-        mimeTypes.removeAll(QString(""));
-
-        // get parent mimetype
-        const QMimeType &mt = fileInfo->fileMimeType();
-        siblingMimeTypes = mimeTypes;
-        d->appendParentMineType(mt.parentMimeTypes(), siblingMimeTypes);
-        siblingMimeTypes.removeAll(QString(""));
-    }
-
-    // check each actons
-    for (auto it = actions.begin(); it != actions.end();) {
-        QAction *action = *it;
-        // check Desktop, Scheme, Suffix
-        if (!d->isValid(action, fileInfo, onDesktop, false)) {
-            it = actions.erase(it);
-            continue;
-        }
-
-        // compression is not supported on FTP
-        if (action->text() == QObject::tr("Compress") && ProtocolUtils::isFTPFile(foucs)) {
-            it = actions.erase(it);
-            continue;
-        }
-
-        // match exclude mime types
-        QStringList excludeMimeTypes = action->property(kMimeTypeExcludeKey).toStringList();
-        excludeMimeTypes << action->property(kMimeTypeExcludeAliasKey).toStringList();
-
-        excludeMimeTypes.removeAll({});
-        // e.g. xlsx parentMimeTypes is application/zip
-        bool match = d->isMimeTypeMatch(mimeTypes, excludeMimeTypes);
-        if (match) {
-            it = actions.erase(it);
-            continue;
-        }
-
-        // MimeType not exist == MimeType=*
-        if (!action->property(kMimeType).isValid()) {
-            ++it;
-            continue;
-        }
-
-        // match support mime types
-        QStringList supportMimeTypes = action->property(kMimeType).toStringList();
-        supportMimeTypes.removeAll({});
-        match = d->isMimeTypeMatch(siblingMimeTypes, supportMimeTypes);
-
-        // The file attributes of some MTP mounted device directories do not meet the specifications
-        //(the ordinary directory mimeType is considered octet stream), so special treatment is required
-        if (foucs.path().contains("/mtp:host") && supportMimeTypes.contains("application/octet-stream")
-            && siblingMimeTypes.contains("application/octet-stream")) {
-            match = false;
-        }
-
-        if (!match) {
-            it = actions.erase(it);
-            continue;
-        }
-
-        ++it;
-    }
-
-    return actions;
+    return d->matchActions(menuType, { foucs }, onDesktop, false);
 }
 
 QPair<QString, QStringList> OemMenu::makeCommand(const QAction *action, const QUrl &dir, const QUrl &foucs, const QList<QUrl> &files)
@@ -6,6 +6,7 @@
 #define OEMMENU_P_H
 
 #include "dfmplugin_menu_global.h"
+#include "utils/mimeactionmatcher.h"
 
 #include <dfm-base/interfaces/fileinfo.h>
 
@@ -37,8 +38,6 @@ public:
 
     QStringList getValues(const Dtk::Core::DDesktopEntry &entry, const QString &key, const QString &aliasKey, const QString &section = "Desktop Entry", const QStringList &whiteList = {}) const;
 
-    bool isMimeTypeSupport(const QString &mt, const QStringList &fileMimeTypes) const;
-    bool isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &supportMimeTypes) const;
     bool isActionShouldShow(const QAction *action, bool onDesktop) const;
     bool isSchemeSupport(const QAction *action, const QUrl &url) const;
     bool isSuffixSupport(const QAction *action, FileInfoPointer fileInfo, const bool allEx7z = false) const;
@@ -54,12 +53,13 @@ public:
     QStringList urlListToLocalFile(const QList<QUrl> &files) const;
     QString urlToString(const QUrl &file) const;
     QStringList urlListToString(const QList<QUrl> &files) const;
-    void appendParentMineType(const QStringList &parentmimeTypes, QStringList &mimeTypes) const;
+    QList<QAction *> matchActions(const QString &menuType, const QList<QUrl> &files, bool onDesktop, bool allEx7z);
 
 public:
     QSharedPointer<QTimer> delayedLoadFileTimer;
     QSharedPointer<QObject> menuActionHolder;
     QMap<QString, QList<QAction *>> actionListByType;
+    QMap<QString, MimeActionMatcher> matcherByType;   // same order as actionListByType
     QList<QMenu *> subMenus;
 
     QStringList oemMenuPath;
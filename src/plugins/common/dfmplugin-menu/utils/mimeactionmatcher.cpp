@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimeactionmatcher.h"
+
+#include <dfm-base/mimetype/dmimedatabase.h>
+
+using namespace dfmplugin_menu;
+
+int MimeActionMatcher::addRule(const QStringList &supportMimeTypes, const QStringList &excludeMimeTypes, bool matchAll)
+{
+    rules.append({ supportMimeTypes, excludeMimeTypes, matchAll });
+
+    // 已缓存的匹配结果不包含新规则
+    for (MimeEntry &entry : entries)
+        entry.matchedValid = false;
+
+    return rules.size() - 1;
+}
+
+void MimeActionMatcher::clear()
+{
+    rules.clear();
+    mimeIds.clear();
+    entries.clear();
+}
+
+QBitArray MimeActionMatcher::matchedRules(const QMimeType &mt)
+{
+    MimeEntry &entry = entries[mimeIdOf(mt)];
+    if (entry.matchedValid)
+        return entry.matched;
+
+    entry.matched = QBitArray(rules.size());
+    for (int i = 0; i < rules.size(); ++i) {
+        const Rule &rule = rules.at(i);
+        // 不支持的类型只比较文件类型本身，e.g. xlsx 的父类型是 application/zip
+        if (isMimeTypeMatch(entry.names, rule.excludeMimeTypes))
+            continue;
+
+        if (rule.matchAll || isMimeTypeMatch(entry.closure, rule.supportMimeTypes))
+            entry.matched.setBit(i);
+    }
+    entry.matchedValid = true;
+
+    return entry.matched;
+}
+
+QStringList MimeActionMatcher::mimeTypeClosure(const QMimeType &mt)
+{
+    return entries.at(mimeIdOf(mt)).closure;
+}
+
+QBitArray MimeActionMatcher::rulesSupporting(const QString &mimeType) const
+{
+    QBitArray bits(rules.size());
+    for (int i = 0; i < rules.size(); ++i) {
+        if (rules.at(i).supportMimeTypes.contains(mimeType))
+            bits.setBit(i);
+    }
+    return bits;
+}
+
+bool MimeActionMatcher::isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &patterns)
+{
+    for (const QString &mt : patterns) {
+        if (fileMimeTypes.contains(mt, Qt::CaseInsensitive))
+            return true;
+
+        int starPos = mt.indexOf("*");
+        if (starPos < 0)
+            continue;
+
+        const QString &prefix = mt.left(starPos);
+        for (const QString &fmt : fileMimeTypes) {
+            if (fmt.contains(prefix, Qt::CaseInsensitive))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+int MimeActionMatcher::mimeIdOf(const QMimeType &mt)
+{
+    const QString &name = mt.name();
+    auto it = mimeIds.constFind(name);
+    if (it != mimeIds.constEnd())
+        return it.value();
+
+    // 先登记再展开父类型，entries 可能在递归中扩容，之后只通过下标访问
+    const int id = entries.size();
+    mimeIds.insert(name, id);
+    entries.append(MimeEntry());
+
+    QStringList names { name };
+    names.append(mt.aliases());
+    names.removeAll({});
+
+    QStringList closure = names;
+    DFMBASE_NAMESPACE::DMimeDatabase db;
+    const QStringList &parents = mt.parentMimeTypes();
+    for (const QString &parentName : parents) {
+        const int parentId = mimeIdOf(db.mimeTypeForName(parentName));
+        closure.append(entries.at(parentId).closure);
+    }
+
+    entries[id].names = names;
+    entries[id].closure = closure;
+    return id;
+}
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMEACTIONMATCHER_H
+#define MIMEACTIONMATCHER_H
+
+#include "dfmplugin_menu_global.h"
+
+#include <QBitArray>
+#include <QHash>
+#include <QMimeType>
+#include <QStringList>
+#include <QVector>
+
+namespace dfmplugin_menu {
+
+/*!
+ * 自定义菜单/OEM 菜单项的 MimeType 匹配索引。
+ * 按菜单项顺序添加规则，之后每种文件类型只计算一次能匹配的菜单项集合（位图），
+ * 多选时按文件类型分组，对各组的位图求交即可，不再对每个文件逐项比较。
+ * 只在主线程使用。
+ */
+class MimeActionMatcher
+{
+public:
+    /*!
+     * 添加一个菜单项的类型规则，返回其序号。
+     * \a supportMimeTypes 与文件类型及其所有父类型比较，\a matchAll 为 true 时不检查；
+     * \a excludeMimeTypes 只与文件类型本身（含别名）比较。
+     * 规则中带 '*' 的项按 '*' 之前的部分做包含匹配。
+     */
+    int addRule(const QStringList &supportMimeTypes, const QStringList &excludeMimeTypes, bool matchAll);
+    int ruleCount() const { return rules.size(); }
+    void clear();
+
+    // 类型为 mt 的文件能匹配的规则集合，结果按类型缓存
+    QBitArray matchedRules(const QMimeType &mt);
+
+    // mt 及其所有父类型（含别名）
+    QStringList mimeTypeClosure(const QMimeType &mt);
+
+    // supportMimeTypes 中明确列出 mimeType 的规则集合
+    QBitArray rulesSupporting(const QString &mimeType) const;
+
+    static bool isMimeTypeMatch(const QStringList &fileMimeTypes, const QStringList &patterns);
+
+private:
+    struct Rule
+    {
+        QStringList supportMimeTypes;
+        QStringList excludeMimeTypes;
+        bool matchAll { false };
+    };
+
+    struct MimeEntry
+    {
+        QStringList names;   // 类型名及别名
+        QStringList closure;   // names 加上所有父类型
+        QBitArray matched;
+        bool matchedValid { false };
+    };
+
+    // 类型的内部编号，首次遇到时展开其父类型，父类型的结果同样被缓存
+    int mimeIdOf(const QMimeType &mt);
+
+    QVector<Rule> rules;
+    QHash<QString, int> mimeIds;   // 类型名 -> entries 下标
+    QVector<MimeEntry> entries;
+};
+
+}
+
+#endif   // MIMEACTIONMATCHER_H
@@ -18,6 +18,15 @@ DFMBASE_USE_NAMESPACE
 
 static constexpr int kMaxEmblemCount { 4 };
 static constexpr int kRequestReadyPathsTimeInterval { 500 };
+static constexpr int kMaxReadyPathCount { 1000 };
+static constexpr int kMaxCachedDirectoryCount { 32 };
+static constexpr int kMaxCachedFileCount { 50000 };
+
+static QString parentPath(const QString &path)
+{
+    int pos = path.lastIndexOf('/');
+    return pos <= 0 ? QStringLiteral("/") : path.left(pos);
+}
 
 ExtensionEmblemManagerPrivate::ExtensionEmblemManagerPrivate(ExtensionEmblemManager *qq)
     : q_ptr(qq)
@@ -30,18 +39,40 @@ ExtensionEmblemManagerPrivate::~ExtensionEmblemManagerPrivate()
 
 void ExtensionEmblemManagerPrivate::addReadyLocalPath(const QPair<QString, int> &path)
 {
-    if (!readyLocalPaths.contains(path)) {
-        readyLocalPaths.push_back(path);
-        readyFlag = true;
+    auto it = readyIconCounts.find(path.first);
+    if (it != readyIconCounts.end()) {
+        it.value() = path.second;
+        return;
     }
+
+    readyIconCounts.insert(path.first, path.second);
+    readyLocalPaths.push_back(path.first);
+    readyFlag = true;
+
+    // the oldest paths have been scrolled out of the view
+    while (readyLocalPaths.size() > kMaxReadyPathCount)
+        readyIconCounts.remove(readyLocalPaths.takeFirst());
 }
 
 void ExtensionEmblemManagerPrivate::clearReadyLocalPath()
 {
     readyLocalPaths.clear();
+    readyIconCounts.clear();
     readyFlag = false;
 }
 
+QList<QPair<QString, int>> ExtensionEmblemManagerPrivate::takeReadyLocalPaths()
+{
+    // the most recently painted paths first
+    QList<QPair<QString, int>> paths;
+    paths.reserve(readyLocalPaths.size());
+    for (auto it = readyLocalPaths.crbegin(); it != readyLocalPaths.crend(); ++it)
+        paths.push_back({ *it, readyIconCounts.value(*it) });
+
+    clearReadyLocalPath();
+    return paths;
+}
+
 QIcon ExtensionEmblemManagerPrivate::makeIcon(const QString &path)
 {
     const QIcon &icon { QIcon::fromTheme(path) };
@@ -54,37 +85,64 @@ QIcon ExtensionEmblemManagerPrivate::makeIcon(const QString &path)
 void EmblemIconWorker::onFetchEmblemIcons(const QList<QPair<QString, int>> &localPaths)
 {
     Q_ASSERT(qApp->thread() != QThread::currentThread());
-    if (localPaths.isEmpty())
+    if (localPaths.isEmpty()) {
+        emit fetchFinished();
         return;
+    }
 
-    const auto &emblemPlugins = ExtensionPluginManager::instance().emblemPlugins();
-    std::for_each(emblemPlugins.begin(), emblemPlugins.end(), [&localPaths, this](DFMEXT::DFMExtEmblemIconPlugin *plugin) {
-        Q_ASSERT(plugin);
-        for (const auto &path : localPaths) {
-            if (this->parseLocationEmblemIcons(path.first, path.second, plugin))
-                continue;
-            parseEmblemIcons(path.first, path.second, plugin);
+    // plugins answer for all requested files of a directory at once
+    QList<QString> dirPaths;
+    QHash<QString, QPair<std::vector<std::string>, std::vector<int>>> dirRequests;
+    for (const auto &path : localPaths) {
+        const QString &dirPath { parentPath(path.first) };
+        auto it = dirRequests.find(dirPath);
+        if (it == dirRequests.end()) {
+            dirPaths.push_back(dirPath);
+            it = dirRequests.insert(dirPath, {});
         }
-    });
+        it.value().first.push_back(path.first.toStdString());
+        it.value().second.push_back(path.second);
+    }
+
+    const auto &emblemPlugins = ExtensionPluginManager::instance().emblemPlugins();
+    for (const QString &dirPath : std::as_const(dirPaths)) {
+        const auto &request { dirRequests.value(dirPath) };
+        DirectoryCache *dirCache { touchDirectoryCache(dirPath) };
+        std::for_each(emblemPlugins.begin(), emblemPlugins.end(), [&, this](DFMEXT::DFMExtEmblemIconPlugin *plugin) {
+            Q_ASSERT(plugin);
+            quint64 pluginAddr { reinterpret_cast<quint64>(plugin) };
+            const auto &emblems { plugin->locationEmblemIconsBatch(dirPath.toStdString(), request.first, request.second) };
+            for (size_t i = 0; i < request.first.size(); ++i) {
+                const QString &path { QString::fromStdString(request.first[i]) };
+                if (this->parseLocationEmblemIcons(path, emblems[i], pluginAddr, dirCache))
+                    continue;
+                parseEmblemIcons(path, request.second[i], plugin, dirCache);
+            }
+        });
+    }
+
+    evictDirectoryCaches(dirPaths);
+    emit fetchFinished();
 }
 
 void EmblemIconWorker::onClearCache()
 {
-    embelmCaches.clear();
-    pluginCaches.clear();
+    dirCaches.clear();
+    QMutexLocker lk(&orderMutex);
+    dirCacheOrder.clear();
 }
 
-bool EmblemIconWorker::parseLocationEmblemIcons(const QString &path, int count, dfmext::DFMExtEmblemIconPlugin *plugin)
+bool EmblemIconWorker::parseLocationEmblemIcons(const QString &path, const DFMEXT::DFMExtEmblem &emblem, quint64 pluginAddr, DirectoryCache *dirCache)
 {
-    const auto &emblem { plugin->locationEmblemIcons(path.toStdString(), count) };
+    Q_ASSERT(dirCache);
     const std::vector<DFMEXT::DFMExtEmblemIconLayout> &layouts { emblem.emblems() };
     // why add `pluginCaches` ?
     // To clear the emblem icon when a plugin returns an empty `DFMExtEmblemIconLayout`.
-    quint64 pluginAddr { reinterpret_cast<quint64>(plugin) };
-    const CacheType &curPluginCache { pluginCaches.value(pluginAddr) };
+    const CacheType &curPluginCache { dirCache->pluginCaches.value(pluginAddr) };
     if (layouts.empty() && curPluginCache.value(path).isEmpty())
         return false;
 
+    CacheType &embelmCaches { dirCache->embelmCaches };
     if (embelmCaches.contains(path)) {   // check changed
         const QList<QPair<QString, int>> &oldGroup { embelmCaches[path] };
         QList<QPair<QString, int>> newGroup;
@@ -94,7 +152,7 @@ bool EmblemIconWorker::parseLocationEmblemIcons(const QString &path, int count,
         mergeGroup(oldGroup, newGroup, &mergedGroup);
         if (mergedGroup != oldGroup) {
             embelmCaches[path] = mergedGroup;
-            saveToPluginCache(pluginAddr, path, newGroup);
+            saveToPluginCache(dirCache, pluginAddr, path, newGroup);
             emit emblemIconChanged(path, mergedGroup);
         }
     } else {   // save to cache
@@ -102,22 +160,24 @@ bool EmblemIconWorker::parseLocationEmblemIcons(const QString &path, int count,
         makeLayoutGroup(layouts, &group);
         emit emblemIconChanged(path, group);
         embelmCaches.insert(path, group);
-        saveToPluginCache(pluginAddr, path, group);
+        saveToPluginCache(dirCache, pluginAddr, path, group);
     }
 
     return true;
 }
 
-void EmblemIconWorker::parseEmblemIcons(const QString &path, int count, dfmext::DFMExtEmblemIconPlugin *plugin)
+void EmblemIconWorker::parseEmblemIcons(const QString &path, int count, dfmext::DFMExtEmblemIconPlugin *plugin, DirectoryCache *dirCache)
 {
+    Q_ASSERT(dirCache);
     quint64 pluginAddr { reinterpret_cast<quint64>(plugin) };
-    if (hasCachedByOtherLocationEmblem(path, pluginAddr))
+    if (hasCachedByOtherLocationEmblem(*dirCache, path, pluginAddr))
         return;
     const std::vector<std::string> &icons { plugin->emblemIcons(path.toStdString()) };
 
     if (icons.empty())
         return;
 
+    CacheType &embelmCaches { dirCache->embelmCaches };
     if (embelmCaches.contains(path)) {   // check changed
         const QList<QPair<QString, int>> &oldGroup { embelmCaches[path] };
         QList<QPair<QString, int>> newGroup;
@@ -221,9 +281,9 @@ void EmblemIconWorker::mergeGroup(const QList<QPair<QString, int>> &oldGroup,
     }
 }
 
-bool EmblemIconWorker::hasCachedByOtherLocationEmblem(const QString &path, quint64 addr)
+bool EmblemIconWorker::hasCachedByOtherLocationEmblem(const DirectoryCache &dirCache, const QString &path, quint64 addr)
 {
-    for (auto iter = pluginCaches.begin(); iter != pluginCaches.end(); ++iter) {
+    for (auto iter = dirCache.pluginCaches.begin(); iter != dirCache.pluginCaches.end(); ++iter) {
         const CacheType &cache { iter.value() };
         if (iter.key() != addr && cache.contains(path))
             return true;
@@ -231,15 +291,56 @@ bool EmblemIconWorker::hasCachedByOtherLocationEmblem(const QString &path, quint
     return false;
 }
 
-void EmblemIconWorker::saveToPluginCache(quint64 addr, const QString &path, const QList<QPair<QString, int>> &group)
+void EmblemIconWorker::saveToPluginCache(DirectoryCache *dirCache, quint64 addr, const QString &path, const QList<QPair<QString, int>> &group)
 {
-    if (pluginCaches.contains(addr)) {
-        CacheType &cache = pluginCaches[addr];
+    if (dirCache->pluginCaches.contains(addr)) {
+        CacheType &cache = dirCache->pluginCaches[addr];
         cache.insert(path, group);
         return;
     }
 
-    pluginCaches.insert(addr, makeCache(path, group));
+    dirCache->pluginCaches.insert(addr, makeCache(path, group));
+}
+
+void EmblemIconWorker::touchDirectory(const QString &dirPath)
+{
+    QMutexLocker lk(&orderMutex);
+    if (!dirCacheOrder.isEmpty() && dirCacheOrder.last() == dirPath)
+        return;
+
+    // only cached directories are ordered, the worker may have evicted it already
+    if (dirCacheOrder.removeOne(dirPath))
+        dirCacheOrder.push_back(dirPath);
+}
+
+EmblemIconWorker::DirectoryCache *EmblemIconWorker::touchDirectoryCache(const QString &dirPath)
+{
+    QMutexLocker lk(&orderMutex);
+    dirCacheOrder.removeOne(dirPath);
+    dirCacheOrder.push_back(dirPath);
+    return &dirCaches[dirPath];
+}
+
+void EmblemIconWorker::evictDirectoryCaches(const QList<QString> &inUse)
+{
+    auto cachedFileCount = [this]() {
+        int count { 0 };
+        for (const DirectoryCache &cache : std::as_const(dirCaches))
+            count += cache.embelmCaches.size();
+        return count;
+    };
+
+    QMutexLocker lk(&orderMutex);
+    while (!dirCacheOrder.isEmpty()
+           && (dirCacheOrder.size() > kMaxCachedDirectoryCount || cachedFileCount() > kMaxCachedFileCount)) {
+        const QString dirPath { dirCacheOrder.first() };
+        if (inUse.contains(dirPath))
+            break;
+
+        dirCacheOrder.removeFirst();
+        dirCaches.remove(dirPath);
+        emit directoryCacheRemoved(dirPath);
+    }
 }
 
 ExtensionEmblemManager &ExtensionEmblemManager::instance()
@@ -257,9 +358,10 @@ void ExtensionEmblemManager::initialize()
 
     connect(&ExtensionPluginManager::instance(), &ExtensionPluginManager::allPluginsInitialized, this, &ExtensionEmblemManager::onAllPluginsInitialized);
     connect(&d->readyTimer, &QTimer::timeout, this, [this, d]() {
-        if (d->readyFlag) {
-            emit requestFetchEmblemIcon(d->readyLocalPaths);
-            d->clearReadyLocalPath();   // for update
+        // while the worker is busy keep collecting, the next batch only has the latest paths
+        if (d->readyFlag && !d->fetching) {
+            d->fetching = true;
+            emit requestFetchEmblemIcon(d->takeReadyLocalPaths());   // for update
         }
     });
 }
@@ -294,8 +396,13 @@ bool ExtensionEmblemManager::onFetchCustomEmblems(const QUrl &url, QList<QIcon>
         d->addReadyLocalPath({ localPath, currentCount });
 
         // consume
-        if (d->positionEmbelmCaches.contains(localPath)) {
-            const QList<QPair<QString, int>> &group { d->positionEmbelmCaches.value(localPath) };
+        const QString &dirPath { parentPath(localPath) };
+        const auto &dirCache { d->positionEmbelmCaches.value(dirPath) };
+        if (dirCache.contains(localPath)) {
+            // a painted hit keeps its directory from being evicted
+            if (d->worker)
+                d->worker->touchDirectory(dirPath);
+            const QList<QPair<QString, int>> &group { dirCache.value(localPath) };
             int lastSapce { kMaxEmblemCount - currentCount };
             // full
             for (int i = 0; i < lastSapce; ++i)
@@ -323,7 +430,7 @@ bool ExtensionEmblemManager::onFetchCustomEmblems(const QUrl &url, QList<QIcon>
 void ExtensionEmblemManager::onEmblemIconChanged(const QString &path, const QList<QPair<QString, int>> &group)
 {
     Q_D(ExtensionEmblemManager);
-    d->positionEmbelmCaches[path] = group;
+    d->positionEmbelmCaches[parentPath(path)][path] = group;
     auto eventID { DPF_NAMESPACE::Event::instance()->eventType("ddplugin_canvas", "slot_FileInfoModel_UpdateFile") };
     if (eventID != DPF_NAMESPACE::EventTypeScope::kInValid)
         dpfSlotChannel->push("ddplugin_canvas", "slot_FileInfoModel_UpdateFile", QUrl::fromLocalFile(path));
@@ -338,11 +445,18 @@ void ExtensionEmblemManager::onAllPluginsInitialized()
         Q_D(ExtensionEmblemManager);
 
         EmblemIconWorker *worker { new EmblemIconWorker };
+        d->worker = worker;
         worker->moveToThread(&d->workerThread);
         connect(&d->workerThread, &QThread::finished, worker, &QObject::deleteLater);
         connect(this, &ExtensionEmblemManager::requestFetchEmblemIcon, worker, &EmblemIconWorker::onFetchEmblemIcons);
         connect(this, &ExtensionEmblemManager::requestClearCache, worker, &EmblemIconWorker::onClearCache);
         connect(worker, &EmblemIconWorker::emblemIconChanged, this, &ExtensionEmblemManager::onEmblemIconChanged);
+        connect(worker, &EmblemIconWorker::directoryCacheRemoved, this, [d](const QString &dirPath) {
+            d->positionEmbelmCaches.remove(dirPath);
+        });
+        connect(worker, &EmblemIconWorker::fetchFinished, this, [d]() {
+            d->fetching = false;
+        });
 
         d->workerThread.start();
         d->readyTimer.start(kRequestReadyPathsTimeInterval);
@@ -374,6 +488,7 @@ ExtensionEmblemManager::~ExtensionEmblemManager()
 
     // 停止定时器
     d->readyTimer.stop();
+    d->worker = nullptr;   // deleted with the worker thread
     
     // 确保工作线程正确退出
     if (d->workerThread.isRunning()) {
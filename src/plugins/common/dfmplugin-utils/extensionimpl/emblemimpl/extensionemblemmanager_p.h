@@ -11,8 +11,10 @@
 
 #include <QThread>
 #include <QMap>
+#include <QHash>
 #include <QSet>
 #include <QTimer>
+#include <QMutex>
 
 DPUTILS_BEGIN_NAMESPACE
 
@@ -20,8 +22,21 @@ class EmblemIconWorker : public QObject
 {
     Q_OBJECT
     using CacheType = QMap<QString, QList<QPair<QString, int>>>;
+
+    struct DirectoryCache
+    {
+        CacheType embelmCaches;   // filePath -> pair<iconPath, iconCount>
+        QMap<quint64, CacheType> pluginCaches;   // plugin -> filePath -> pair<iconPath, iconCount>
+    };
+
+public:
+    // called by the GUI thread for every painted cache hit
+    void touchDirectory(const QString &dirPath);
+
 Q_SIGNALS:
     void emblemIconChanged(const QString &path, const QList<QPair<QString, int>> &emblemGroup);
+    void directoryCacheRemoved(const QString &dirPath);
+    void fetchFinished();
 
 public Q_SLOTS:
     void onFetchEmblemIcons(const QList<QPair<QString, int>> &localPaths);
@@ -29,9 +44,9 @@ public Q_SLOTS:
 
 private:
     // method 2
-    bool parseLocationEmblemIcons(const QString &path, int count, DFMEXT::DFMExtEmblemIconPlugin *plugin);
+    bool parseLocationEmblemIcons(const QString &path, const DFMEXT::DFMExtEmblem &emblem, quint64 pluginAddr, DirectoryCache *dirCache);
     // method 1
-    void parseEmblemIcons(const QString &path, int count, DFMEXT::DFMExtEmblemIconPlugin *plugin);
+    void parseEmblemIcons(const QString &path, int count, DFMEXT::DFMExtEmblemIconPlugin *plugin, DirectoryCache *dirCache);
 
     CacheType makeCache(const QString &path, const QList<QPair<QString, int>> &group);
     void makeLayoutGroup(const std::vector<DFMEXT::DFMExtEmblemIconLayout> &layouts, QList<QPair<QString, int>> *group);
@@ -40,12 +55,16 @@ private:
     void mergeGroup(const QList<QPair<QString, int>> &oldGroup,
                     const QList<QPair<QString, int>> &newGroup,
                     QList<QPair<QString, int>> *group);
-    bool hasCachedByOtherLocationEmblem(const QString &path, quint64 addr);
-    void saveToPluginCache(quint64 addr, const QString &path, const QList<QPair<QString, int>> &group);
+    bool hasCachedByOtherLocationEmblem(const DirectoryCache &dirCache, const QString &path, quint64 addr);
+    void saveToPluginCache(DirectoryCache *dirCache, quint64 addr, const QString &path, const QList<QPair<QString, int>> &group);
+
+    DirectoryCache *touchDirectoryCache(const QString &dirPath);
+    void evictDirectoryCaches(const QList<QString> &inUse);
 
 private:
-    CacheType embelmCaches;   // filePath -> pair<iconPath, iconCount>
-    QMap<quint64, CacheType> pluginCaches;   // plugin -> filePath -> pair<iconPath, iconCount>
+    QHash<QString, DirectoryCache> dirCaches;   // dirPath -> caches of its files
+    QList<QString> dirCacheOrder;   // least recently used first
+    QMutex orderMutex;   // guards dirCacheOrder, touched from the GUI thread
 };
 
 class ExtensionEmblemManagerPrivate : public QObject
@@ -59,17 +78,21 @@ public:
 
     void addReadyLocalPath(const QPair<QString, int> &path);
     void clearReadyLocalPath();
+    QList<QPair<QString, int>> takeReadyLocalPaths();
     QIcon makeIcon(const QString &path);
 
 public:
     ExtensionEmblemManager *q_ptr { nullptr };
 
     QThread workerThread;
+    EmblemIconWorker *worker { nullptr };
 
     QTimer readyTimer;
     bool readyFlag { false };
-    QList<QPair<QString, int>> readyLocalPaths;
-    QMap<QString, QList<QPair<QString, int>>> positionEmbelmCaches;   // file path ->  { pairs { emblem icon path, pos }}
+    bool fetching { false };   // the worker has not finished the last batch
+    QList<QString> readyLocalPaths;   // in painting order, the last ones are visible
+    QHash<QString, int> readyIconCounts;   // file path -> system emblem count
+    QHash<QString, QHash<QString, QList<QPair<QString, int>>>> positionEmbelmCaches;   // dir path -> file path ->  { pairs { emblem icon path, pos }}
 };
 
 DPUTILS_END_NAMESPACE
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundimageloader.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMutex>
+#include <QSaveFile>
+#include <QScopeGuard>
+#include <QSet>
+#include <QStandardPaths>
+#include <QtMath>
+
+DDP_BACKGROUND_USE_NAMESPACE
+
+static constexpr char kSourceKey[] = "dfm-wallpaper-source";
+
+// cache files being written, a second request for the same entry does not write it again
+Q_GLOBAL_STATIC(QSet<QString>, savingFiles)
+static QMutex savingMutex;
+
+static QString sourceStamp(const QString &localPath)
+{
+    QFileInfo info(localPath);
+    if (!info.exists())
+        return {};
+
+    return QString("%1:%2").arg(info.lastModified().toMSecsSinceEpoch()).arg(info.size());
+}
+
+BackgroundImageLoader::BackgroundImageLoader(const QString &cacheDir, qint64 maxCacheBytes)
+    : cacheDir(cacheDir),
+      maxCacheBytes(maxCacheBytes)
+{
+}
+
+QList<QImage> BackgroundImageLoader::loadCached(const QString &localPath, const QList<QSize> &sizes) const
+{
+    QList<QImage> images;
+    const QString &stamp = sourceStamp(localPath);
+    for (const QSize &size : sizes) {
+        if (stamp.isEmpty() || size.isEmpty()) {
+            images.append(QImage());
+            continue;
+        }
+
+        // the stamp is stored in a text chunk, a stale file is detected without decoding it
+        const QString &file = cacheFile(localPath, size);
+        QImageReader reader(file, "png");
+        if (reader.text(kSourceKey) != stamp || reader.size() != size) {
+            images.append(QImage());
+            continue;
+        }
+
+        images.append(reader.read());
+
+        // the modification time orders the entries for eviction
+        QFile hit(file);
+        if (hit.open(QIODevice::ReadWrite))
+            hit.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    }
+
+    return images;
+}
+
+QList<QImage> BackgroundImageLoader::decode(const QString &localPath, const QList<QSize> &sizes) const
+{
+    QList<QSize> targets;
+    for (const QSize &size : sizes) {
+        if (!size.isEmpty())
+            targets.append(size);
+    }
+
+    auto read = [&localPath, &targets](bool fromContent) {
+        QImageReader reader(localPath);
+        // fix whiteboard shows when a jpeg file with filename xxx.png
+        // content format not equal to extension
+        reader.setDecideFormatFromContent(fromContent);
+
+        const QSize &source = reader.size();
+        if (source.isValid() && targets.size() == 1) {
+            // only one screen, decode the visible part directly at the target size
+            const QSize &target = targets.first();
+            const QRect &clip = centeredCrop(source, target);
+            reader.setClipRect(clip);
+            if (clip.width() > target.width())
+                reader.setScaledSize(target);
+        } else if (source.isValid() && !targets.isEmpty()) {
+            // the smallest size still covering all screens, never upscale while decoding
+            qreal scale = 0;
+            for (const QSize &target : std::as_const(targets)) {
+                scale = qMax(scale, qMax(qreal(target.width()) / source.width(),
+                                         qreal(target.height()) / source.height()));
+            }
+            if (scale < 1)
+                reader.setScaledSize(QSize(qCeil(source.width() * scale), qCeil(source.height() * scale)));
+        }
+
+        return reader.read();
+    };
+
+    QImage image = read(true);
+    if (image.isNull())
+        image = read(false);
+
+    QList<QImage> images;
+    for (const QSize &size : sizes)
+        images.append(image.isNull() ? QImage() : fitToSize(image, size));
+
+    return images;
+}
+
+bool BackgroundImageLoader::save(const QString &localPath, const QImage &image) const
+{
+    const QString &stamp = sourceStamp(localPath);
+    if (image.isNull() || stamp.isEmpty())
+        return false;
+
+    if (!QDir().mkpath(cacheDir))
+        return false;
+
+    const QString &path = cacheFile(localPath, image.size());
+    {
+        QMutexLocker lk(&savingMutex);
+        if (savingFiles->contains(path))
+            return false;
+        savingFiles->insert(path);
+    }
+    auto done = qScopeGuard([&path]() {
+        QMutexLocker lk(&savingMutex);
+        savingFiles->remove(path);
+    });
+
+    // written by an earlier request already
+    QImageReader reader(path, "png");
+    if (reader.text(kSourceKey) == stamp && reader.size() == image.size())
+        return true;
+
+    QImage stamped(image);
+    stamped.setText(kSourceKey, stamp);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !stamped.save(&file, "png") || !file.commit()) {
+        fmWarning() << "Failed to write wallpaper cache for" << localPath << file.errorString();
+        return false;
+    }
+
+    prune();
+    return true;
+}
+
+QString BackgroundImageLoader::defaultCacheDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/wallpaper";
+}
+
+QRect BackgroundImageLoader::centeredCrop(const QSize &source, const QSize &target)
+{
+    if (source.isEmpty() || target.isEmpty())
+        return QRect(QPoint(0, 0), source);
+
+    // the largest centered rect of source with the aspect ratio of target
+    QSize crop = source;
+    if (qint64(source.width()) * target.height() > qint64(source.height()) * target.width())
+        crop.setWidth(qMax(1, qRound(qreal(source.height()) * target.width() / target.height())));
+    else
+        crop.setHeight(qMax(1, qRound(qreal(source.width()) * target.height() / target.width())));
+
+    return QRect(QPoint((source.width() - crop.width()) / 2, (source.height() - crop.height()) / 2), crop);
+}
+
+QImage BackgroundImageLoader::fitToSize(const QImage &image, const QSize &size)
+{
+    if (image.isNull() || size.isEmpty() || image.size() == size)
+        return image;
+
+    QImage scaled = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    if (scaled.width() > size.width() || scaled.height() > size.height()) {
+        scaled = scaled.copy(QRect(static_cast<int>((scaled.width() - size.width()) / 2.0),
+                                   static_cast<int>((scaled.height() - size.height()) / 2.0),
+                                   size.width(),
+                                   size.height()));
+    }
+
+    return scaled;
+}
+
+QString BackgroundImageLoader::cacheFile(const QString &localPath, const QSize &size) const
+{
+    const QByteArray &hash = QCryptographicHash::hash(localPath.toUtf8(), QCryptographicHash::Md5).toHex();
+    return QDir(cacheDir).absoluteFilePath(QString("%1_%2x%3.png").arg(QString::fromLatin1(hash)).arg(size.width()).arg(size.height()));
+}
+
+void BackgroundImageLoader::prune() const
+{
+    // entries of old wallpapers and resolutions, evict the least recently used ones
+    // beyond the budget, the newest entry is always kept
+    const QFileInfoList &files = QDir(cacheDir).entryInfoList({ "*.png" }, QDir::Files, QDir::Time);
+    qint64 total = 0;
+    for (int i = 0; i < files.size(); ++i) {
+        total += files.at(i).size();
+        if (i > 0 && total > maxCacheBytes)
+            QFile::remove(files.at(i).absoluteFilePath());
+    }
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BACKGROUNDIMAGELOADER_H
+#define BACKGROUNDIMAGELOADER_H
+
+#include "ddplugin_background_global.h"
+
+#include <QImage>
+#include <QList>
+#include <QSize>
+
+DDP_BACKGROUND_BEGIN_NAMESPACE
+
+/*!
+ * Decode a wallpaper for one or more screens.
+ * A file is decoded once at the smallest size that still covers every target,
+ * each screen gets a centered crop of it. Results are kept in a disk cache keyed
+ * by path, modification time, file size and target size, so the next start
+ * only loads screen-sized images. The least recently used entries are evicted
+ * once the cache outgrows its byte budget.
+ * Target sizes are in device pixels, the device pixel ratio is applied by the caller.
+ */
+class BackgroundImageLoader
+{
+public:
+    static constexpr qint64 kDefaultCacheBytes = 64 * 1024 * 1024;
+
+    explicit BackgroundImageLoader(const QString &cacheDir = defaultCacheDir(),
+                                   qint64 maxCacheBytes = kDefaultCacheBytes);
+
+    // cached images for sizes, null where missing or stale
+    QList<QImage> loadCached(const QString &localPath, const QList<QSize> &sizes) const;
+    // decode localPath once and crop for each size, null images on failure
+    QList<QImage> decode(const QString &localPath, const QList<QSize> &sizes) const;
+    bool save(const QString &localPath, const QImage &image) const;
+
+    static QString defaultCacheDir();
+    static QRect centeredCrop(const QSize &source, const QSize &target);
+    static QImage fitToSize(const QImage &image, const QSize &size);
+
+private:
+    QString cacheFile(const QString &localPath, const QSize &size) const;
+    void prune() const;
+
+    QString cacheDir;
+    qint64 maxCacheBytes = kDefaultCacheBytes;
+};
+
+DDP_BACKGROUND_END_NAMESPACE
+
+#endif   // BACKGROUNDIMAGELOADER_H
@@ -6,6 +6,7 @@
 #include "backgroundmanager.h"
 #include "backgroundmanager_p.h"
 #include "backgrounddefault.h"
+#include "backgroundimageloader.h"
 #include "desktoputils/ddplugin_eventinterface_helper.h"
 
 #include <dfm-base/dfm_desktop_defines.h>
@@ -414,6 +415,8 @@ void BackgroundBridge::onFinished(void *pData)
         for (auto it = d->backgroundWidgets.begin(); it != d->backgroundWidgets.end(); ++it) {
             if (it.key() == req.screen) {
                 BackgroundWidgetPointer bw = it.value();
+                if (req.pixmap.isNull())
+                    req.pixmap = QPixmap::fromImage(req.image);
                 req.pixmap.setDevicePixelRatio(bw->devicePixelRatioF());
                 bw->setPixmap(req.pixmap);
                 d->backgroundPaths.insert(req.screen, req.path);
@@ -438,50 +441,63 @@ void BackgroundBridge::runUpdate(BackgroundBridge *self, QList<Requestion> reqs)
     fmInfo() << "Starting background update in worker thread - thread ID:" << QThread::currentThreadId()
              << "processing" << reqs.size() << "requests";
 
-    QList<Requestion> recorder;
-    for (Requestion &req : reqs) {
-        // check stop
-        if (!self->getting) {
-            fmInfo() << "Background update cancelled during processing";
-            return;
-        }
-
+    // screens showing the same wallpaper share one decode
+    QMap<QString, QList<int>> groups;
+    for (int i = 0; i < reqs.size(); ++i) {
+        Requestion &req = reqs[i];
         if (req.path.isEmpty())
             req.path = self->d->service->background(req.screen);
+        groups[req.path].append(i);
+    }
 
-        QPixmap backgroundPixmap = BackgroundBridge::getPixmap(req.path);
-        if (backgroundPixmap.isNull()) {
-            fmCritical() << "Failed to read background for screen:" << req.screen << "path:" << req.path;
-            continue;
-        }
-
+    BackgroundImageLoader loader;
+    QList<QPair<QString, QImage>> decoded;
+    for (auto group = groups.cbegin(); group != groups.cend(); ++group) {
         // check stop
         if (!self->getting) {
-            fmInfo() << "Background update cancelled after pixmap loading";
+            fmInfo() << "Background update cancelled during processing";
             return;
         }
 
-        QSize trueSize = req.size;
-        auto pix = backgroundPixmap.scaled(trueSize,
-                                           Qt::KeepAspectRatioByExpanding,
-                                           Qt::SmoothTransformation);
+        const QString &path = group.key();
+        const QString &localPath = path.startsWith("file:") ? QUrl(path).toLocalFile() : path;
+        QList<QSize> sizes;
+        for (int idx : group.value())
+            sizes.append(reqs.at(idx).size);
+
+        QList<QImage> images = localPath.isEmpty() ? QList<QImage>() : loader.loadCached(localPath, sizes);
+        QList<QSize> missing;
+        for (int i = 0; i < images.size(); ++i) {
+            if (images.at(i).isNull())
+                missing.append(sizes.at(i));
+        }
 
-        // check stop
-        if (!self->getting) {
-            fmInfo() << "Background update cancelled after scaling";
-            return;
+        if (!localPath.isEmpty() && !missing.isEmpty()) {
+            fmInfo() << "Decoding background" << localPath << "for sizes:" << missing;
+            QList<QImage> fresh = loader.decode(localPath, missing);
+            for (int i = 0, next = 0; i < images.size(); ++i) {
+                if (!images.at(i).isNull())
+                    continue;
+                images[i] = fresh.at(next++);
+                if (!images.at(i).isNull())
+                    decoded.append({ localPath, images.at(i) });
+            }
         }
 
-        if (pix.width() > trueSize.width() || pix.height() > trueSize.height()) {
-            pix = pix.copy(QRect(static_cast<int>((pix.width() - trueSize.width()) / 2.0),
-                                 static_cast<int>((pix.height() - trueSize.height()) / 2.0),
-                                 trueSize.width(),
-                                 trueSize.height()));
+        for (int i = 0; i < group.value().size(); ++i) {
+            Requestion &req = reqs[group.value().at(i)];
+            req.image = images.value(i);
+            if (req.image.isNull())
+                fmCritical() << "Failed to read background for screen:" << req.screen << "path:" << req.path;
+            else
+                fmInfo() << "Successfully processed background for screen:" << req.screen << "path:" << req.path << "size:" << req.size;
         }
+    }
 
-        fmInfo() << "Successfully processed background for screen:" << req.screen << "path:" << req.path << "size:" << trueSize;
-        req.pixmap = pix;
-        recorder.append(req);
+    QList<Requestion> recorder;
+    for (const Requestion &req : std::as_const(reqs)) {
+        if (!req.image.isNull())
+            recorder.append(req);
     }
 
     // check stop
@@ -493,5 +509,15 @@ void BackgroundBridge::runUpdate(BackgroundBridge *self, QList<Requestion> reqs)
     QList<Requestion> *pRecorder = new QList<Requestion>;
     *pRecorder = std::move(recorder);
     QMetaObject::invokeMethod(self, "onFinished", Qt::QueuedConnection, Q_ARG(void *, pRecorder));
+
+    // fill the cache in a task of its own, the request is done once the screens got their images
+    if (!decoded.isEmpty()) {
+        QtConcurrent::run([decoded]() {
+            BackgroundImageLoader cache;
+            for (const auto &entry : decoded)
+                cache.save(entry.first, entry.second);
+        });
+    }
+
     self->getting = false;
 }
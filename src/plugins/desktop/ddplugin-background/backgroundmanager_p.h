@@ -22,6 +22,7 @@ public:
         QString path;
         QSize size;
         QPixmap pixmap;
+        QImage image;   // decoded in the worker, converted to pixmap in the main thread
     };
 
 public:
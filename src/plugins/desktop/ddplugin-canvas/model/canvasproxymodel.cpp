@@ -73,9 +73,8 @@ void CanvasProxyModelPrivate::sourceRowsInserted(const QModelIndex &sourceParent
     int row = fileList.count();
     q->beginInsertRows(q->rootIndex(), row, row + files.count() - 1);
 
-    fileList.append(files);
     for (const QUrl &url : files)
-        fileMap.insert(url, srcModel->fileInfo(srcModel->index(url)));
+        appendFile(url, srcModel->fileInfo(srcModel->index(url)));
 
     q->endInsertRows();
 }
@@ -103,13 +102,12 @@ void CanvasProxyModelPrivate::sourceRowsAboutToBeRemoved(const QModelIndex &sour
 
     // remove one by one
     for (const QUrl &url : files) {
-        int row = fileList.indexOf(url);
+        int row = rowOf(url);
         if (row < 0)
             continue;
 
         q->beginRemoveRows(q->rootIndex(), row, row);
-        fileList.removeAt(row);
-        fileMap.remove(url);
+        removeFile(row);
         q->endRemoveRows();
     }
 }
@@ -119,12 +117,11 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
     // canvas filter
     bool ignore = renameFilter(oldUrl, newUrl);
 
-    int row = fileList.indexOf(oldUrl);
+    int row = rowOf(oldUrl);
     if (ignore) {
         if (row >= 0) {
             q->beginRemoveRows(q->rootIndex(), row, row);
-            fileList.removeAt(row);
-            fileMap.remove(oldUrl);
+            removeFile(row);
             q->endRemoveRows();
         }
         return;
@@ -135,8 +132,7 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
         if (!fileMap.contains(newUrl)) {   // insert it if it does not exist.
             row = fileList.count();
             q->beginInsertRows(q->rootIndex(), row, row);
-            fileList.append(newUrl);
-            fileMap.insert(newUrl, newInfo);
+            appendFile(newUrl, newInfo);
             q->endInsertRows();
             return;
         }
@@ -145,15 +141,12 @@ void CanvasProxyModelPrivate::sourceDataRenamed(const QUrl &oldUrl, const QUrl &
         if (fileMap.contains(newUrl)) {
             //! treat as removing if newurl is existed in canvas.
             q->beginRemoveRows(q->rootIndex(), row, row);
-            fileList.removeAt(row);
-            fileMap.remove(oldUrl);
+            removeFile(row);
             q->endRemoveRows();
 
-            row = fileList.indexOf(newUrl);
+            row = rowOf(newUrl);
         } else {
-            fileList.replace(row, newUrl);
-            fileMap.remove(oldUrl);
-            fileMap.insert(newUrl, newInfo);
+            replaceFile(row, newUrl, newInfo);
             emit q->dataReplaced(oldUrl, newUrl);
         }
 
@@ -273,52 +266,52 @@ bool CanvasProxyModelPrivate::renameFilter(const QUrl &oldUrl, const QUrl &newUr
 
 bool CanvasProxyModelPrivate::lessThan(const QUrl &left, const QUrl &right) const
 {
-    QModelIndex leftIdx = q->index(left);
-    QModelIndex rightIdx = q->index(right);
+    return lessThan(sortKey(left), sortKey(right));
+}
 
-    if (!leftIdx.isValid() || !rightIdx.isValid()) {
-        fmWarning() << "Invalid model indices for comparison:" << left << right;
-        return false;
+CanvasProxyModelPrivate::SortKey CanvasProxyModelPrivate::sortKey(const QUrl &url) const
+{
+    SortKey key;
+    QModelIndex idx = q->index(url);
+    if (!idx.isValid()) {
+        fmWarning() << "Invalid model index for comparison:" << url;
+        return key;
     }
 
-    FileInfoPointer leftInfo = fileMap.value(left);
-    FileInfoPointer rightInfo = fileMap.value(right);
-
-    // The folder is fixed in the front position
-    if (isNotMixDirAndFile) {
-        if (leftInfo->isAttributes(OptInfoType::kIsDir)) {
-            if (!rightInfo->isAttributes(OptInfoType::kIsDir))
-                return true;
-        } else {
-            if (rightInfo->isAttributes(OptInfoType::kIsDir))
-                return false;
-        }
-    }
+    key.valid = true;
+    if (FileInfoPointer info = fileMap.value(url))
+        key.isDir = info->isAttributes(OptInfoType::kIsDir);
 
-    QVariant leftData = q->data(leftIdx, fileSortRole);
-    QVariant rightData = q->data(rightIdx, fileSortRole);
+    const QVariant &data = q->data(idx, fileSortRole);
+    if (fileSortRole == kItemFileSizeRole)
+        key.size = data.toLongLong();
+    else
+        key.text = data.toString();
 
     // When the selected sort attribute value is the same, sort by file name
-    auto compareByName = [this, leftIdx, rightIdx]() {
-        QString leftName = q->data(leftIdx, kItemFileDisplayNameRole).toString();
-        QString rightName = q->data(rightIdx, kItemFileDisplayNameRole).toString();
-        return SortUtils::compareString(leftName, rightName, fileSortOrder);
-    };
+    key.name = fileSortRole == kItemFileDisplayNameRole ? key.text : q->data(idx, kItemFileDisplayNameRole).toString();
+    return key;
+}
+
+bool CanvasProxyModelPrivate::lessThan(const SortKey &left, const SortKey &right) const
+{
+    if (!left.valid || !right.valid)
+        return false;
+
+    // The folder is fixed in the front position
+    if (isNotMixDirAndFile && left.isDir != right.isDir)
+        return left.isDir;
 
     switch (fileSortRole) {
     case kItemFileCreatedRole:
     case kItemFileLastModifiedRole:
     case kItemFileMimeTypeRole:
-    case kItemFileDisplayNameRole: {
-        QString leftString = leftData.toString();
-        QString rightString = rightData.toString();
-        return leftString == rightString ? compareByName() : SortUtils::compareString(leftString, rightString, fileSortOrder);
-    }
-    case kItemFileSizeRole: {
-        qint64 leftSize = leftData.toLongLong();
-        qint64 rightSize = rightData.toLongLong();
-        return leftSize == rightSize ? compareByName() : ((fileSortOrder == Qt::DescendingOrder) ^ (leftSize < rightSize)) == 0x01;
-    }
+    case kItemFileDisplayNameRole:
+        return left.text == right.text ? SortUtils::compareString(left.name, right.name, fileSortOrder)
+                                       : SortUtils::compareString(left.text, right.text, fileSortOrder);
+    case kItemFileSizeRole:
+        return left.size == right.size ? SortUtils::compareString(left.name, right.name, fileSortOrder)
+                                       : ((fileSortOrder == Qt::DescendingOrder) ^ (left.size < right.size)) == 0x01;
     default:
         return false;
     }
@@ -329,17 +322,62 @@ void CanvasProxyModelPrivate::standardSort(QList<QUrl> &files) const
     if (files.isEmpty())
         return;
 
-    std::stable_sort(files.begin(), files.end(), [this](const QUrl &left, const QUrl &right) {
-        return lessThan(left, right);
+    // read the sort data once per file instead of once per comparison
+    QList<QPair<SortKey, QUrl>> keyed;
+    keyed.reserve(files.size());
+    for (const QUrl &url : files)
+        keyed.append({ sortKey(url), url });
+
+    std::stable_sort(keyed.begin(), keyed.end(), [this](const QPair<SortKey, QUrl> &left, const QPair<SortKey, QUrl> &right) {
+        return lessThan(left.first, right.first);
     });
 
-    return;
+    for (int i = 0; i < keyed.size(); ++i)
+        files[i] = keyed.at(i).second;
+}
+
+void CanvasProxyModelPrivate::setFiles(const QList<QUrl> &urls, const QMap<QUrl, FileInfoPointer> &infos)
+{
+    fileList = urls;
+    fileMap = infos;
+    fileRows.clear();
+    fileRows.reserve(fileList.size());
+    for (int i = 0; i < fileList.size(); ++i)
+        fileRows.insert(fileList.at(i), i);
+}
+
+void CanvasProxyModelPrivate::appendFile(const QUrl &url, const FileInfoPointer &info)
+{
+    fileRows.insert(url, fileList.size());
+    fileList.append(url);
+    fileMap.insert(url, info);
+}
+
+void CanvasProxyModelPrivate::removeFile(int row)
+{
+    const QUrl url = fileList.takeAt(row);
+    fileMap.remove(url);
+    fileRows.remove(url);
+    for (int i = row; i < fileList.size(); ++i)
+        fileRows[fileList.at(i)] = i;
+}
+
+void CanvasProxyModelPrivate::replaceFile(int row, const QUrl &url, const FileInfoPointer &info)
+{
+    const QUrl oldUrl = fileList.at(row);
+    fileMap.remove(oldUrl);
+    fileRows.remove(oldUrl);
+
+    fileList.replace(row, url);
+    fileMap.insert(url, info);
+    fileRows.insert(url, row);
 }
 
 void CanvasProxyModelPrivate::clearMapping()
 {
     fileList.clear();
     fileMap.clear();
+    fileRows.clear();
 }
 
 void CanvasProxyModelPrivate::createMapping()
@@ -360,8 +398,7 @@ void CanvasProxyModelPrivate::createMapping()
         maps.insert(url, srcModel->fileInfo(srcModel->index(url)));
 
     // set unsorted files into model to enable create module index that doSort will used.
-    fileList = urls;
-    fileMap = maps;
+    setFiles(urls, maps);
 
     doSort(urls);
 
@@ -372,8 +409,7 @@ void CanvasProxyModelPrivate::createMapping()
             maps.insert(url, fileMap.value(url));
     }
 
-    fileList = urls;
-    fileMap = maps;
+    setFiles(urls, maps);
 }
 
 QModelIndexList CanvasProxyModelPrivate::indexs() const
@@ -482,10 +518,9 @@ QModelIndex CanvasProxyModel::index(const QUrl &url, int column) const
     if (!url.isValid())
         return QModelIndex();
 
-    if (d->fileMap.contains(url)) {
-        int row = d->fileList.indexOf(url);
+    int row = d->rowOf(url);
+    if (row >= 0)
         return createIndex(row, column);
-    }
 
     return QModelIndex();
 }
@@ -835,8 +870,7 @@ bool CanvasProxyModel::sort()
         QModelIndexList from = d->indexs();
         auto fromUlrs = d->fileList;
 
-        d->fileList = orderFiles;
-        d->fileMap = tempFileMap;
+        d->setFiles(orderFiles, tempFileMap);
 
         // get the indexs of fromUlrs after sorting
         QModelIndexList to = d->indexs(fromUlrs);
@@ -907,8 +941,7 @@ bool CanvasProxyModel::fetch(const QUrl &url)
         int row = d->fileList.count();
         beginInsertRows(rootIndex(), row, row);
 
-        d->fileList.append(url);
-        d->fileMap.insert(url, info);
+        d->appendFile(url, info);
 
         endInsertRows();
         return true;
@@ -928,15 +961,14 @@ bool CanvasProxyModel::take(const QUrl &url)
     // canvas filter
     d->removeFilter(url);
 
-    int row = d->fileList.indexOf(url);
+    int row = d->rowOf(url);
     if (Q_UNLIKELY(row < 0)) {
         fmCritical() << "Invalid index for file in take operation:" << url;
         return false;
     }
 
     beginRemoveRows(rootIndex(), row, row);
-    d->fileList.removeAt(row);
-    d->fileMap.remove(url);
+    d->removeFile(row);
     endRemoveRows();
     return true;
 }
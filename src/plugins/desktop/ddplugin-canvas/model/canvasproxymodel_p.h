@@ -13,6 +13,7 @@
 #include <dfm-base/dfm_global_defines.h>
 
 #include <QTimer>
+#include <QHash>
 
 namespace ddplugin_canvas {
 
@@ -27,6 +28,15 @@ public:
     QModelIndexList indexs(const QList<QUrl> &files) const;
     bool doSort(QList<QUrl> &files) const;
     bool lessThan(const QUrl &left, const QUrl &right) const;
+
+    inline int rowOf(const QUrl &url) const
+    {
+        return fileRows.value(url, -1);
+    }
+    void setFiles(const QList<QUrl> &urls, const QMap<QUrl, FileInfoPointer> &infos);
+    void appendFile(const QUrl &url, const FileInfoPointer &info);
+    void removeFile(int row);
+    void replaceFile(int row, const QUrl &url, const FileInfoPointer &info);
 public slots:
     void doRefresh(bool global, bool updateFile);
     void sourceDataChanged(const QModelIndex &sourceTopleft,
@@ -53,6 +63,16 @@ protected:
     void specialSort(QList<QUrl> &files) const;
 
 private:
+    struct SortKey
+    {
+        bool valid = false;
+        bool isDir = false;
+        QString text;
+        qint64 size = 0;
+        QString name;
+    };
+    SortKey sortKey(const QUrl &url) const;
+    bool lessThan(const SortKey &left, const SortKey &right) const;
     void sortMainDesktopFile(QList<QUrl> &files, Qt::SortOrder order) const;
     void sendLoadReport();
 
@@ -60,6 +80,7 @@ public:
     QDir::Filters filters = QDir::AllEntries | QDir::NoDotAndDotDot | QDir::System;
     QList<QUrl> fileList;
     QMap<QUrl, FileInfoPointer> fileMap;
+    QHash<QUrl, int> fileRows;   // url -> row in fileList, kept in step with fileList
     FileInfoModel *srcModel = nullptr;
     QSharedPointer<QTimer> refreshTimer;
     int fileSortRole = DFMGLOBAL_NAMESPACE::ItemRoles::kItemFileMimeTypeRole;
@@ -0,0 +1,406 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "collectionlayoutstore.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QSet>
+#include <QUrl>
+#include <QDebug>
+
+#include <unistd.h>
+
+#include <algorithm>
+
+using namespace ddplugin_organizer;
+
+namespace {
+inline constexpr char kLayoutHeader[] { "#ddplugin-organizer layout 1" };
+// the journal is compacted when it has more lines than this and than the items
+inline constexpr int kCompactRecords { 512 };
+
+// records, one per line, keys and names percent encoded:
+//   C <key> <name>          create or reset a collection
+//   A <key> <url>           append an item
+//   I <key> <index> <url>   insert an item at index
+//   R <key> <url>           remove an item
+//   N <key> <name>          rename a collection
+//   D <key>                 drop a collection
+inline QByteArray encode(const QString &text)
+{
+    return QUrl::toPercentEncoding(text);
+}
+
+inline QString decode(const QByteArray &text)
+{
+    return QUrl::fromPercentEncoding(text);
+}
+
+// indexes in seq of a longest strictly increasing subsequence
+QList<int> longestIncreasing(const QList<int> &seq)
+{
+    QList<int> tails;   // for each length, index of the smallest tail
+    QList<int> prev(seq.size(), -1);
+    for (int i = 0; i < seq.size(); ++i) {
+        auto it = std::lower_bound(tails.begin(), tails.end(), seq.at(i), [&seq](int idx, int value) {
+            return seq.at(idx) < value;
+        });
+        if (it != tails.begin())
+            prev[i] = *(it - 1);
+        if (it == tails.end())
+            tails.append(i);
+        else
+            *it = i;
+    }
+
+    QList<int> ret(tails.size());
+    int k = tails.size() - 1;
+    for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = prev.at(i))
+        ret[k--] = i;
+    return ret;
+}
+}   // namespace
+
+CollectionLayoutStore::CollectionLayoutStore(const QString &filePath)
+    : filePath(filePath)
+{
+}
+
+CollectionLayoutStore::~CollectionLayoutStore()
+{
+    flush();
+}
+
+bool CollectionLayoutStore::exists() const
+{
+    return QFile::exists(filePath);
+}
+
+QList<CollectionBaseDataPtr> CollectionLayoutStore::collections()
+{
+    load();
+
+    QList<CollectionBaseDataPtr> ret;
+    for (const CollectionBaseDataPtr &base : std::as_const(layouts)) {
+        if (base->key.isEmpty() || base->name.isEmpty()) {
+            fmWarning() << "Invalid collection base data - key:" << base->key << "name:" << base->name;
+            continue;
+        }
+        ret.append(CollectionBaseDataPtr(new CollectionBaseData(*base)));
+    }
+    return ret;
+}
+
+CollectionBaseDataPtr CollectionLayoutStore::collection(const QString &key)
+{
+    load();
+
+    auto base = find(key);
+    if (!base || base->name.isEmpty())
+        return nullptr;
+
+    return CollectionBaseDataPtr(new CollectionBaseData(*base));
+}
+
+/*!
+ * \brief CollectionLayoutStore::write Replace all collections, only the differences are recorded
+ */
+void CollectionLayoutStore::write(const QList<CollectionBaseDataPtr> &bases)
+{
+    load();
+
+    QSet<QString> keys;
+    for (const CollectionBaseDataPtr &base : bases)
+        keys.insert(base->key);
+
+    for (const CollectionBaseDataPtr &old : std::as_const(layouts)) {
+        if (!keys.contains(old->key)) {
+            pending += "D " + encode(old->key) + '\n';
+            ++pendingLines;
+            ++journalLines;
+        }
+    }
+
+    QList<CollectionBaseDataPtr> next;
+    keys.clear();
+    for (const CollectionBaseDataPtr &base : bases) {
+        if (base->key.isEmpty() || keys.contains(base->key))
+            continue;
+        keys.insert(base->key);
+
+        appendRecords(find(base->key), base);
+        next.append(CollectionBaseDataPtr(new CollectionBaseData(*base)));
+    }
+    layouts = next;
+}
+
+void CollectionLayoutStore::update(const CollectionBaseDataPtr &base)
+{
+    if (!base || base->key.isEmpty())
+        return;
+
+    load();
+
+    auto old = find(base->key);
+    appendRecords(old, base);
+
+    CollectionBaseDataPtr copy(new CollectionBaseData(*base));
+    int idx = layouts.indexOf(old);
+    if (idx >= 0)
+        layouts.replace(idx, copy);
+    else
+        layouts.append(copy);
+}
+
+/*!
+ * \brief CollectionLayoutStore::flush Append the pending records and sync them to disk,
+ * or rewrite the file as a snapshot when the journal grew too long.
+ */
+bool CollectionLayoutStore::flush()
+{
+    if (pendingLines == 0 && !needCompact)
+        return true;
+
+    if (needCompact || !exists() || (journalLines > kCompactRecords && journalLines > itemCount()))
+        return compact();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        fmWarning() << "Failed to open collection layout file:" << filePath << file.errorString();
+        return false;
+    }
+
+    if (file.write(pending) != pending.size() || !file.flush()) {
+        fmWarning() << "Failed to append collection layout records:" << filePath << file.errorString();
+        // the file may end with a part of a record now
+        needCompact = true;
+        return false;
+    }
+
+    ::fdatasync(file.handle());
+    pending.clear();
+    pendingLines = 0;
+    return true;
+}
+
+void CollectionLayoutStore::load()
+{
+    if (loaded)
+        return;
+    loaded = true;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QByteArray &data = file.readAll();
+    bool header = false;
+    int lines = 0;
+    int from = 0;
+    while (from < data.size()) {
+        const int end = data.indexOf('\n', from);
+        if (end < 0) {
+            fmWarning() << "Collection layout file ends with an incomplete record:" << filePath;
+            needCompact = true;
+            break;
+        }
+
+        const QByteArray &line = data.mid(from, end - from);
+        from = end + 1;
+        if (!header) {
+            if (line != kLayoutHeader) {
+                fmWarning() << "Unknown collection layout file format:" << filePath;
+                needCompact = true;
+                return;
+            }
+            header = true;
+            continue;
+        }
+
+        apply(line);
+        ++lines;
+    }
+
+    journalLines = qMax(0, lines - layouts.size() - itemCount());
+    fmDebug() << "Loaded collection layouts:" << layouts.size() << "items:" << itemCount()
+              << "journal records:" << journalLines;
+}
+
+bool CollectionLayoutStore::compact()
+{
+    QByteArray data(kLayoutHeader);
+    data += '\n';
+    for (const CollectionBaseDataPtr &base : std::as_const(layouts))
+        appendSnapshot(*base, &data);
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QSaveFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        fmWarning() << "Failed to write collection layout file:" << filePath << file.errorString();
+        return false;
+    }
+
+    file.write(data);
+    if (!file.commit()) {
+        fmWarning() << "Failed to commit collection layout file:" << filePath << file.errorString();
+        return false;
+    }
+
+    pending.clear();
+    pendingLines = 0;
+    journalLines = 0;
+    needCompact = false;
+    return true;
+}
+
+void CollectionLayoutStore::apply(const QByteArray &line)
+{
+    const QList<QByteArray> &fields = line.split(' ');
+    if (fields.size() < 2 || fields.first().size() != 1) {
+        fmWarning() << "Invalid collection layout record:" << line;
+        return;
+    }
+
+    const QString &key = decode(fields.at(1));
+    auto base = find(key);
+    switch (fields.first().at(0)) {
+    case 'C':
+        if (fields.size() < 3)
+            break;
+        if (!base) {
+            base.reset(new CollectionBaseData);
+            base->key = key;
+            layouts.append(base);
+        }
+        base->name = decode(fields.at(2));
+        base->items.clear();
+        break;
+    case 'A':
+        if (base && fields.size() >= 3)
+            base->items.append(QUrl::fromEncoded(fields.at(2)));
+        break;
+    case 'I':
+        if (base && fields.size() >= 4)
+            base->items.insert(qBound(0, fields.at(2).toInt(), int(base->items.size())), QUrl::fromEncoded(fields.at(3)));
+        break;
+    case 'R':
+        if (base && fields.size() >= 3)
+            base->items.removeOne(QUrl::fromEncoded(fields.at(2)));
+        break;
+    case 'N':
+        if (base && fields.size() >= 3)
+            base->name = decode(fields.at(2));
+        break;
+    case 'D':
+        if (base)
+            layouts.removeOne(base);
+        break;
+    default:
+        fmWarning() << "Unknown collection layout record:" << line;
+        break;
+    }
+}
+
+/*!
+ * \brief CollectionLayoutStore::appendRecords Record the changes from old to base.
+ * Removed items and the items out of order are removed, then inserted at their new index;
+ * the longest run of items keeping their order is left alone. Moving one icon costs two records.
+ */
+void CollectionLayoutStore::appendRecords(const CollectionBaseDataPtr &old, const CollectionBaseDataPtr &base)
+{
+    const QByteArray &key = encode(base->key);
+    QByteArray records;
+    int lines = 0;
+
+    QHash<QUrl, int> oldPos;
+    QSet<QUrl> newUrls;
+    if (old) {
+        for (int i = 0; i < old->items.size(); ++i)
+            oldPos.insert(old->items.at(i), i);
+        for (const QUrl &url : base->items)
+            newUrls.insert(url);
+    }
+
+    // duplicated items can not be told apart by records
+    if (old && oldPos.size() == old->items.size() && newUrls.size() == base->items.size()) {
+        if (old->name != base->name) {
+            records += "N " + key + ' ' + encode(base->name) + '\n';
+            ++lines;
+        }
+
+        for (const QUrl &url : old->items) {
+            if (!newUrls.contains(url)) {
+                records += "R " + key + ' ' + url.toEncoded() + '\n';
+                ++lines;
+            }
+        }
+
+        QList<int> seq;
+        QList<int> seqIndex;
+        for (int j = 0; j < base->items.size(); ++j) {
+            const int pos = oldPos.value(base->items.at(j), -1);
+            if (pos >= 0) {
+                seq.append(pos);
+                seqIndex.append(j);
+            }
+        }
+
+        QList<bool> stays(base->items.size(), false);
+        for (int idx : longestIncreasing(seq))
+            stays[seqIndex.at(idx)] = true;
+
+        for (int j = 0; j < base->items.size(); ++j) {
+            if (!stays.at(j) && oldPos.contains(base->items.at(j))) {
+                records += "R " + key + ' ' + base->items.at(j).toEncoded() + '\n';
+                ++lines;
+            }
+        }
+
+        for (int j = 0; j < base->items.size(); ++j) {
+            if (!stays.at(j)) {
+                records += "I " + key + ' ' + QByteArray::number(j) + ' ' + base->items.at(j).toEncoded() + '\n';
+                ++lines;
+            }
+        }
+    }
+
+    // a new collection, or more changes than items: record it as a whole
+    if (!old || lines > base->items.size() + 1 || oldPos.size() != old->items.size() || newUrls.size() != base->items.size()) {
+        records.clear();
+        appendSnapshot(*base, &records);
+        lines = base->items.size() + 1;
+    }
+
+    pending += records;
+    pendingLines += lines;
+    journalLines += lines;
+}
+
+void CollectionLayoutStore::appendSnapshot(const CollectionBaseData &base, QByteArray *out) const
+{
+    const QByteArray &key = encode(base.key);
+    *out += "C " + key + ' ' + encode(base.name) + '\n';
+    for (const QUrl &url : base.items)
+        *out += "A " + key + ' ' + url.toEncoded() + '\n';
+}
+
+CollectionBaseDataPtr CollectionLayoutStore::find(const QString &key) const
+{
+    auto it = std::find_if(layouts.begin(), layouts.end(), [&key](const CollectionBaseDataPtr &base) {
+        return base->key == key;
+    });
+    return it == layouts.end() ? nullptr : *it;
+}
+
+int CollectionLayoutStore::itemCount() const
+{
+    int count = 0;
+    for (const CollectionBaseDataPtr &base : layouts)
+        count += base->items.size();
+    return count;
+}
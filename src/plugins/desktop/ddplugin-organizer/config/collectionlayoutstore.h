@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef COLLECTIONLAYOUTSTORE_H
+#define COLLECTIONLAYOUTSTORE_H
+
+#include "ddplugin_organizer_global.h"
+#include "organizer_defines.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+namespace ddplugin_organizer {
+
+/*!
+ * \brief CollectionLayoutStore keeps the items of the collections in a line based journal.
+ *
+ * The file starts with a snapshot, one line per collection and per item, followed by
+ * the changes made since: an icon moved within or between collections costs two short
+ * lines instead of rewriting every collection. Changes are buffered until flush(),
+ * appended and synced to disk. The file is rewritten as a snapshot once the journal
+ * outgrows the items. Loading replays the file line by line, no sorting is needed.
+ */
+class CollectionLayoutStore
+{
+public:
+    explicit CollectionLayoutStore(const QString &filePath);
+    ~CollectionLayoutStore();
+
+    bool exists() const;
+    QList<CollectionBaseDataPtr> collections();
+    CollectionBaseDataPtr collection(const QString &key);
+    void write(const QList<CollectionBaseDataPtr> &bases);
+    void update(const CollectionBaseDataPtr &base);
+    bool flush();
+
+    int journalRecords() const { return journalLines; }
+    int pendingRecords() const { return pendingLines; }
+
+private:
+    void load();
+    bool compact();
+    void apply(const QByteArray &line);
+    void appendRecords(const CollectionBaseDataPtr &old, const CollectionBaseDataPtr &base);
+    void appendSnapshot(const CollectionBaseData &base, QByteArray *out) const;
+    CollectionBaseDataPtr find(const QString &key) const;
+    int itemCount() const;
+
+    const QString filePath;
+    bool loaded = false;
+    bool needCompact = false;
+    QList<CollectionBaseDataPtr> layouts;
+    QByteArray pending;
+    int pendingLines = 0;
+    int journalLines = 0;   // lines after the snapshot, in the file and pending
+};
+
+}
+
+#endif   // COLLECTIONLAYOUTSTORE_H
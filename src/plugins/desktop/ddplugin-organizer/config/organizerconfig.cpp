@@ -47,6 +47,9 @@ inline constexpr char kKeyEnabledItems[] { "EnabledItems" };
 
 inline constexpr char kKeyLastStyleConfigId[] { "LastStyleConfigId" };
 
+inline constexpr char kLayoutFileNormalized[] { "ddplugin-organizer-normalized.layout" };
+inline constexpr char kLayoutFileCustomed[] { "ddplugin-organizer-customed.layout" };
+
 }   // namepace
 
 OrganizerConfigPrivate::OrganizerConfigPrivate(OrganizerConfig *qq)
@@ -56,6 +59,12 @@ OrganizerConfigPrivate::OrganizerConfigPrivate(OrganizerConfig *qq)
 
 OrganizerConfigPrivate::~OrganizerConfigPrivate()
 {
+    // the stores flush their pending records
+    delete normalLayouts;
+    normalLayouts = nullptr;
+    delete customLayouts;
+    customLayouts = nullptr;
+
     delete settings;
     settings = nullptr;
 }
@@ -84,6 +93,88 @@ void OrganizerConfigPrivate::setValue(const QString &group, const QString &key,
     settings->endGroup();
 }
 
+CollectionLayoutStore *OrganizerConfigPrivate::layoutStore(bool custom)
+{
+    CollectionLayoutStore *&store = custom ? customLayouts : normalLayouts;
+    if (store)
+        return store;
+
+    // the items of the collections are kept beside the config file
+    const QString &fileName = custom ? kLayoutFileCustomed : kLayoutFileNormalized;
+    store = new CollectionLayoutStore(QFileInfo(q->path()).absoluteDir().filePath(fileName));
+    if (!store->exists()) {
+        // move the collections saved in the config file by the previous versions
+        const auto &bases = legacyCollectionBase(custom);
+        if (!bases.isEmpty()) {
+            fmInfo() << "Moving" << bases.size() << "collections to the layout store, custom:" << custom;
+            store->write(bases);
+            if (store->flush()) {
+                // the layout store owns them now, drop the copy in the config file
+                settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
+                settings->remove(kGroupCollectionBase);
+                settings->endGroup();
+                settings->sync();
+            }
+        }
+    }
+    return store;
+}
+
+QList<CollectionBaseDataPtr> OrganizerConfigPrivate::legacyCollectionBase(bool custom) const
+{
+    QStringList profileKeys;
+    settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
+    settings->beginGroup(kGroupCollectionBase);
+    profileKeys = settings->childGroups();
+
+    QList<CollectionBaseDataPtr> ret;
+    for (const QString &key : profileKeys) {
+        settings->beginGroup(key);
+
+        CollectionBaseDataPtr base(new CollectionBaseData);
+        base->name = settings->value(kKeyName, "").toString();
+        base->key = settings->value(kKeyKey, "").toString();
+
+        {
+            settings->beginGroup(kGroupItems);
+            auto keys = settings->childKeys();
+            // must be sorted by int value
+            std::sort(keys.begin(), keys.end(), [](const QString &t1, const QString &t2) {
+                return t1.toInt() < t2.toInt();
+            });
+
+            for (const QString &index : keys) {
+                QUrl url = settings->value(index).toString();
+                if (url.isValid())
+                    base->items.append(url);
+            }
+
+            settings->endGroup();
+        }
+
+        settings->endGroup();
+
+        if (key != base->key || base->key.isEmpty() || base->name.isEmpty()) {
+            fmWarning() << "Invalid collection base data - expected key:" << key
+                        << "actual key:" << base->key << "name:" << base->name;
+            continue;
+        }
+        ret.append(base);
+    }
+
+    settings->endGroup();
+    settings->endGroup();
+    return ret;
+}
+
+void OrganizerConfigPrivate::flushLayouts()
+{
+    if (normalLayouts)
+        normalLayouts->flush();
+    if (customLayouts)
+        customLayouts->flush();
+}
+
 OrganizerConfig::OrganizerConfig(QObject *parent)
     : QObject(parent), d(new OrganizerConfigPrivate(this))
 {
@@ -108,6 +199,7 @@ OrganizerConfig::OrganizerConfig(QObject *parent)
     connect(
             &d->syncTimer, &QTimer::timeout, this, [this]() {
                 d->settings->sync();
+                d->flushLayouts();
             },
             Qt::QueuedConnection);
 }
@@ -169,9 +261,10 @@ void OrganizerConfig::setScreenInfo(const QMap<QString, QString> info)
 
 void OrganizerConfig::sync(int ms)
 {
-    if (ms < 1)
+    if (ms < 1) {
         d->settings->sync();
-    else
+        d->flushLayouts();
+    } else
         d->syncTimer.start(ms);
 }
 
@@ -187,121 +280,25 @@ void OrganizerConfig::setClassification(int cf)
 
 QList<CollectionBaseDataPtr> OrganizerConfig::collectionBase(bool custom) const
 {
-    QStringList profileKeys;
-    d->settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
-    d->settings->beginGroup(kGroupCollectionBase);
-    profileKeys = d->settings->childGroups();
-    d->settings->endGroup();
-    d->settings->endGroup();
-
-    QList<CollectionBaseDataPtr> ret;
-    for (const QString &key : profileKeys)
-        if (auto base = collectionBase(custom, key))
-            ret.append(base);
-
-    return ret;
+    return d->layoutStore(custom)->collections();
 }
 
 CollectionBaseDataPtr OrganizerConfig::collectionBase(bool custom, const QString &key) const
 {
-    d->settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
-    d->settings->beginGroup(kGroupCollectionBase);
-    d->settings->beginGroup(key);
-
-    CollectionBaseDataPtr base(new CollectionBaseData);
-    base->name = d->settings->value(kKeyName, "").toString();
-    base->key = d->settings->value(kKeyKey, "").toString();
-
-    {
-        d->settings->beginGroup(kGroupItems);
-        auto keys = d->settings->childKeys();
-        // must be sorted by int value
-        std::sort(keys.begin(), keys.end(), [](const QString &t1, const QString &t2) {
-            return t1.toInt() < t2.toInt();
-        });
-
-        for (const QString &index : keys) {
-            QUrl url = d->settings->value(index).toString();
-            if (url.isValid())
-                base->items.append(url);
-        }
-
-        d->settings->endGroup();
-    }
-
-    d->settings->endGroup();
-    d->settings->endGroup();
-    d->settings->endGroup();
-
-    if (key != base->key || base->key.isEmpty() || base->name.isEmpty()) {
-        fmWarning() << "Invalid collection base data - expected key:" << key
-                    << "actual key:" << base->key << "name:" << base->name;
-        base.clear();
-    } else {
+    auto base = d->layoutStore(custom)->collection(key);
+    if (base)
         fmDebug() << "Loaded collection base:" << base->name << "with" << base->items.size() << "items";
-    }
     return base;
 }
 
 void OrganizerConfig::updateCollectionBase(bool custom, const CollectionBaseDataPtr &base)
 {
-    d->settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
-    d->settings->beginGroup(kGroupCollectionBase);
-    // delete old datas
-    d->settings->remove(base->key);
-
-    d->settings->beginGroup(base->key);
-    d->settings->setValue(kKeyName, base->name);
-    d->settings->setValue(kKeyKey, base->key);
-
-    {
-        d->settings->beginGroup(kGroupItems);
-
-        int index = 0;
-        for (auto iter = base->items.begin(); iter != base->items.end();) {
-            d->settings->setValue(QString::number(index), iter->toString());
-            ++index;
-            ++iter;
-        }
-
-        d->settings->endGroup();
-    }
-
-    d->settings->endGroup();
-    d->settings->endGroup();
-    d->settings->endGroup();
+    d->layoutStore(custom)->update(base);
 }
 
 void OrganizerConfig::writeCollectionBase(bool custom, const QList<CollectionBaseDataPtr> &base)
 {
-    d->settings->beginGroup(custom ? kGroupCollectionCustomed : kGroupCollectionNormalized);
-    // delete all old datas
-    d->settings->remove(kGroupCollectionBase);
-    d->settings->beginGroup(kGroupCollectionBase);
-
-    for (auto iter = base.begin(); iter != base.end(); ++iter) {
-        d->settings->beginGroup((*iter)->key);
-        d->settings->setValue(kKeyName, (*iter)->name);
-        d->settings->setValue(kKeyKey, (*iter)->key);
-
-        {
-            d->settings->beginGroup(kGroupItems);
-
-            int index = 0;
-            for (auto it = (*iter)->items.begin(); it != (*iter)->items.end();) {
-                d->settings->setValue(QString::number(index), it->toString());
-                ++index;
-                ++it;
-            }
-
-            d->settings->endGroup();
-        }
-
-        d->settings->endGroup();
-    }
-
-    d->settings->endGroup();
-    d->settings->endGroup();
+    d->layoutStore(custom)->write(base);
 }
 
 CollectionStyle OrganizerConfig::collectionStyle(const QString &styleId, const QString &key) const
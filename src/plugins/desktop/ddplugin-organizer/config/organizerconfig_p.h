@@ -6,6 +6,7 @@
 #define ORGANIZERCONFIG_P_H
 
 #include "organizerconfig.h"
+#include "collectionlayoutstore.h"
 
 #include <QSettings>
 #include <QTimer>
@@ -19,8 +20,13 @@ public:
     ~OrganizerConfigPrivate();
     QVariant value(const QString &group, const QString &key, const QVariant &defaultVar);
     void setValue(const QString &group, const QString &key, const QVariant &var);
+    CollectionLayoutStore *layoutStore(bool custom);
+    QList<CollectionBaseDataPtr> legacyCollectionBase(bool custom) const;
+    void flushLayouts();
     QSettings *settings = nullptr;
     QTimer syncTimer;
+    CollectionLayoutStore *normalLayouts = nullptr;
+    CollectionLayoutStore *customLayouts = nullptr;
 private:
     OrganizerConfig *q;
 };
@@ -32,9 +32,19 @@ FileClassifier::FileClassifier(QObject *parent)
     });
 }
 
+QStringList FileClassifier::classifyAll(const QList<QUrl> &urls) const
+{
+    QStringList types;
+    types.reserve(urls.size());
+    for (const QUrl &url : urls)
+        types.append(classify(url));
+    return types;
+}
+
 void FileClassifier::reset(const QList<QUrl> &urls)
 {
     collections.clear();
+    itemKeys.clear();
     for (const QString &id : classes()) {
         CollectionBaseDataPtr dp(new CollectionBaseData);
         dp->name = className(id);
@@ -43,18 +53,26 @@ void FileClassifier::reset(const QList<QUrl> &urls)
         collections.insert(id, dp);
     }
 
-    for (const QUrl &url : urls) {
-        auto type = classify(url);
+    // classify all urls in one go, the classifier may decide many of them without file info.
+    const QStringList &types = classifyAll(urls);
+    for (int i = 0; i < urls.size(); ++i) {
+        const QUrl &url = urls.at(i);
+        const QString &type = types.at(i);
         if (type.isEmpty()) {
             fmWarning() << "can not find file:" << url;
             continue;
         }
 
+        if (itemKeys.contains(url))
+            continue;
+
         auto it = collections.find(type);
-        if (it != collections.end())
+        if (it != collections.end()) {
             it.value()->items.append(url);
-        else
+            itemKeys.insert(url, type);
+        } else {
             Q_ASSERT_X(it == collections.end(), "TypeClassifier", QString("unrecognized type %0").arg(type).toStdString().c_str());
+        }
     }
 }
 
@@ -68,6 +86,100 @@ CollectionBaseDataPtr FileClassifier::baseData(const QString &key) const
     return collections.value(key);
 }
 
+void FileClassifier::setItems(const QString &key, const QList<QUrl> &urls)
+{
+    auto base = collections.value(key);
+    if (!base)
+        return;
+
+    for (const QUrl &url : std::as_const(base->items))
+        itemKeys.remove(url);
+
+    base->items = urls;
+    for (const QUrl &url : urls)
+        itemKeys.insert(url, key);
+}
+
+bool FileClassifier::replaceItem(const QString &key, const QUrl &oldUrl, const QUrl &newUrl)
+{
+    auto base = collections.value(key);
+    if (!base || itemKeys.value(oldUrl) != key)
+        return false;
+
+    int idx = base->items.indexOf(oldUrl);
+    if (idx < 0)
+        return false;
+
+    base->items.replace(idx, newUrl);
+    itemKeys.remove(oldUrl);
+    itemKeys.insert(newUrl, key);
+    return true;
+}
+
+QString FileClassifier::removeItem(const QUrl &url)
+{
+    // only the list holding the url is searched
+    const QString ret = itemKeys.take(url);
+    if (auto base = collections.value(ret))
+        base->items.removeOne(url);
+
+    return ret;
+}
+
+bool FileClassifier::appendItem(const QString &key, const QUrl &url)
+{
+    auto base = collections.value(key);
+    if (!base)
+        return false;
+
+    base->items.append(url);
+    itemKeys.insert(url, key);
+    return true;
+}
+
+bool FileClassifier::prependItem(const QString &key, const QUrl &url)
+{
+    auto base = collections.value(key);
+    if (!base)
+        return false;
+
+    base->items.prepend(url);
+    itemKeys.insert(url, key);
+    return true;
+}
+
+QString FileClassifier::key(const QUrl &url) const
+{
+    return itemKeys.value(url);
+}
+
+bool FileClassifier::contains(const QString &key, const QUrl &url) const
+{
+    if (!collections.contains(key)) {
+        fmDebug() << "Collection not found:" << key;
+        return false;
+    }
+
+    auto it = itemKeys.constFind(url);
+    return it != itemKeys.constEnd() && it.value() == key;
+}
+
+void FileClassifier::moveUrls(const QList<QUrl> &urls, const QString &targetKey, int targetIndex)
+{
+    const QString &sourceKey = urls.isEmpty() ? QString() : key(urls.first());
+    CollectionDataProvider::moveUrls(urls, targetKey, targetIndex);
+    if (sourceKey.isEmpty() || sourceKey == targetKey)
+        return;
+
+    const bool moved = collections.contains(targetKey);
+    for (const QUrl &url : urls) {
+        if (moved)
+            itemKeys.insert(url, targetKey);
+        else
+            itemKeys.remove(url);
+    }
+}
+
 QString FileClassifier::replace(const QUrl &oldUrl, const QUrl &newUrl)
 {
     QString oldType = key(oldUrl);
@@ -82,19 +194,18 @@ QString FileClassifier::replace(const QUrl &oldUrl, const QUrl &newUrl)
 
     if (Q_UNLIKELY(newType.isEmpty())) {
         fmWarning() << "can not find file:" << newUrl;
-        collections[oldType]->items.removeOne(oldUrl);
+        removeItem(oldUrl);
         return newType;
     }
 
     if (oldType == newType) {
-        int idx = collections[newType]->items.indexOf(oldUrl);
-        collections[newType]->items.replace(idx, newUrl);
+        replaceItem(newType, oldUrl, newUrl);
         emit itemsChanged(newType);
     } else {
-        collections[oldType]->items.removeOne(oldUrl);
+        removeItem(oldUrl);
         emit itemsChanged(oldType);
 
-        collections[newType]->items.append(newUrl);
+        appendItem(newType, newUrl);
         emit itemsChanged(newType);
     }
 #else
@@ -154,19 +265,16 @@ QString FileClassifier::append(const QUrl &url)
 
     // do not exist
     if (cur.isEmpty()) {
-        auto it = collections.find(ret);
-        if (it != collections.end()) {
-            it.value()->items.append(url);
+        if (appendItem(ret, url))
             emit itemsChanged(ret);
-        } else {
-            Q_ASSERT_X(it == collections.end(), "TypeClassifier", QString("unrecognized type %0").arg(ret).toStdString().c_str());
-        }
+        else
+            fmWarning() << "unrecognized type" << ret;
     } else {   // existed
         if (cur != ret) {
-            collections[cur]->items.removeOne(url);
+            removeItem(url);
             emit itemsChanged(cur);
 
-            collections[ret]->items.append(url);
+            appendItem(ret, url);
             emit itemsChanged(ret);
         }
     }
@@ -186,19 +294,16 @@ QString FileClassifier::prepend(const QUrl &url)
 
     // do not exist
     if (cur.isEmpty()) {
-        auto it = collections.find(ret);
-        if (it != collections.end()) {
-            it.value()->items.prepend(url);
+        if (prependItem(ret, url))
             emit itemsChanged(ret);
-        } else {
-            Q_ASSERT_X(it == collections.end(), "TypeClassifier", QString("unrecognized type %0").arg(ret).toStdString().c_str());
-        }
+        else
+            fmWarning() << "unrecognized type" << ret;
     } else {   // existed
         if (cur != ret) {
-            collections[cur]->items.removeOne(url);
+            removeItem(url);
             emit itemsChanged(cur);
 
-            collections[ret]->items.prepend(url);
+            prependItem(ret, url);
             emit itemsChanged(ret);
         }
     }
@@ -213,15 +318,9 @@ void FileClassifier::insert(const QUrl &, const QString &, const int)
 
 QString FileClassifier::remove(const QUrl &url)
 {
-    QString ret;
-    for (auto itor = collections.begin(); itor != collections.end(); ++itor) {
-        if (itor.value()->items.contains(url)) {
-            itor.value()->items.removeOne(url);
-            ret = itor.key();
-            emit itemsChanged(ret);
-            break;
-        }
-    }
+    QString ret = removeItem(url);
+    if (!ret.isEmpty())
+        emit itemsChanged(ret);
 
     return ret;
 }
@@ -236,10 +335,10 @@ QString FileClassifier::change(const QUrl &url)
 
     QString ret = classify(url);
     if (ret != cur) {
-        collections[cur]->items.removeOne(url);
+        removeItem(url);
         emit itemsChanged(cur);
 
-        collections[ret]->items.append(url);
+        appendItem(ret, url);
         emit itemsChanged(ret);
 
         return ret;
@@ -32,6 +32,7 @@ public:
     virtual ModelDataHandler *dataHandler() const = 0;
     virtual QStringList classes() const = 0;
     virtual QString classify(const QUrl &) const = 0;
+    virtual QStringList classifyAll(const QList<QUrl> &urls) const;
     virtual QString className(const QString &) const = 0;
     virtual void reset(const QList<QUrl> &);
     virtual bool updateClassifier() = 0;   // return true if changed
@@ -41,6 +42,15 @@ public:
     QList<CollectionBaseDataPtr> baseData() const;
 
 public:
+    // the item lists and the url -> key index are changed together
+    void setItems(const QString &key, const QList<QUrl> &urls);
+    bool replaceItem(const QString &key, const QUrl &oldUrl, const QUrl &newUrl);
+    QString removeItem(const QUrl &url);
+
+public:
+    QString key(const QUrl &url) const override;
+    bool contains(const QString &key, const QUrl &url) const override;
+    void moveUrls(const QList<QUrl> &urls, const QString &targetKey, int targetIndex) override;
     QString replace(const QUrl &oldUrl, const QUrl &newUrl) override;
     QString append(const QUrl &) override;
     QString prepend(const QUrl &) override;
@@ -51,6 +61,13 @@ public:
 public:
     bool acceptInsert(const QUrl &url) override;
     bool acceptRename(const QUrl &oldUrl, const QUrl &newUrl) override;
+
+protected:
+    bool appendItem(const QString &key, const QUrl &url);
+    bool prependItem(const QString &key, const QUrl &url);
+
+protected:
+    QHash<QUrl, QString> itemKeys;   // url -> key of the collection holding it
 };
 
 }
@@ -9,6 +9,11 @@
 #include <dfm-base/file/local/syncfileinfo.h>
 #include <dfm-base/base/schemefactory.h>
 
+#include <QFile>
+
+#include <dirent.h>
+#include <string.h>
+
 using namespace ddplugin_organizer;
 DFMBASE_USE_NAMESPACE
 
@@ -59,6 +64,71 @@ TypeClassifierPrivate::~TypeClassifierPrivate()
 {
 }
 
+QString TypeClassifierPrivate::keyOfSuffix(const QString &suffix) const
+{
+    if (docSuffix.contains(suffix))
+        return kTypeKeyDoc;
+    else if (appSuffix.contains(suffix))
+        return kTypeKeyApp;
+    else if (vidSuffix.contains(suffix))
+        return kTypeKeyVid;
+    else if (picSuffix.contains(suffix))
+        return kTypeKeyPic;
+    else if (muzSuffix.contains(suffix))
+        return kTypeKeyMuz;
+
+    return QString();
+}
+
+/*!
+ * \brief TypeClassifierPrivate::keyOfDirent Classify a file by its dirent type and name,
+ * an empty string is returned for the types that need the file info (symlinks and unknown types).
+ */
+QString TypeClassifierPrivate::keyOfDirent(const QString &fileName, unsigned char type) const
+{
+    if (type == DT_DIR)
+        return kTypeKeyFld;
+    if (type != DT_REG)
+        return QString();
+
+    const QString &key = keyOfSuffix(suffixOf(fileName).toLower());
+    return key.isEmpty() ? QString(kTypeKeyOth) : key;
+}
+
+/*!
+ * \brief TypeClassifierPrivate::suffixOf The suffix as FileInfo gives it: everything after the
+ * last dot followed by a non-empty part, so "a.pdf." gives "pdf.", none for names starting
+ * with that dot.
+ */
+QString TypeClassifierPrivate::suffixOf(const QString &fileName)
+{
+    QString name = fileName;
+    while (true) {
+        const int idx = name.lastIndexOf('.');
+        if (idx <= 0)
+            return QString();
+        if (idx + 1 < name.size())
+            return fileName.mid(idx + 1);
+        name.truncate(idx);
+    }
+}
+
+QHash<QString, unsigned char> TypeClassifierPrivate::direntTypes(const QString &dirPath)
+{
+    QHash<QString, unsigned char> types;
+    DIR *dir = opendir(QFile::encodeName(dirPath).constData());
+    if (!dir)
+        return types;
+
+    while (struct dirent *entry = readdir(dir)) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+            continue;
+        types.insert(QFile::decodeName(entry->d_name), entry->d_type);
+    }
+    closedir(dir);
+    return types;
+}
+
 TypeClassifier::TypeClassifier(QObject *parent)
     : FileClassifier(parent), d(new TypeClassifierPrivate(this))
 {
@@ -160,17 +230,7 @@ QString TypeClassifier::classify(const QUrl &url) const
         key = kTypeKeyFld;
     } else {
         // classified by suffix.
-        const QString &suffix = itemInfo->nameOf(NameInfoType::kSuffix).toLower();
-        if (d->docSuffix.contains(suffix))
-            key = kTypeKeyDoc;
-        else if (d->appSuffix.contains(suffix))
-            key = kTypeKeyApp;
-        else if (d->vidSuffix.contains(suffix))
-            key = kTypeKeyVid;
-        else if (d->picSuffix.contains(suffix))
-            key = kTypeKeyPic;
-        else if (d->muzSuffix.contains(suffix))
-            key = kTypeKeyMuz;
+        key = d->keyOfSuffix(itemInfo->nameOf(NameInfoType::kSuffix).toLower());
     }
 
     // set it to other if it not belong to any category
@@ -180,6 +240,40 @@ QString TypeClassifier::classify(const QUrl &url) const
     return key;
 }
 
+/*!
+ * \brief TypeClassifier::classifyAll Classify the local files from the dirent types of their folders,
+ * each folder is read once. Only symlinks and the files not found there are classified by file info.
+ */
+QStringList TypeClassifier::classifyAll(const QList<QUrl> &urls) const
+{
+    QStringList keys;
+    keys.reserve(urls.size());
+
+    QHash<QString, QHash<QString, unsigned char>> dirs;
+    for (const QUrl &url : urls) {
+        QString key;
+        if (url.isLocalFile()) {
+            const QString &path = url.toLocalFile();
+            const int slash = path.lastIndexOf('/');
+            if (slash >= 0 && slash + 1 < path.size()) {
+                const QString &dirPath = slash == 0 ? QString("/") : path.left(slash);
+                auto dir = dirs.find(dirPath);
+                if (dir == dirs.end())
+                    dir = dirs.insert(dirPath, TypeClassifierPrivate::direntTypes(dirPath));
+
+                const QString &fileName = path.mid(slash + 1);
+                auto type = dir->constFind(fileName);
+                if (type != dir->constEnd())
+                    key = d->keyOfDirent(fileName, type.value());
+            }
+        }
+
+        keys.append(key.isEmpty() ? classify(url) : key);
+    }
+
+    return keys;
+}
+
 QString TypeClassifier::className(const QString &key) const
 {
     return d->keyNames.value(key);
@@ -232,15 +326,12 @@ bool TypeClassifier::acceptRename(const QUrl &oldUrl, const QUrl &newUrl)
     if (!CfgPresenter->organizeOnTriggered())
         return FileClassifier::acceptRename(oldUrl, newUrl);
 
-    QList<QUrl> collected;
-    for (auto base : baseData())
-        collected.append(base->items);
-    if (collected.contains(newUrl)) {
+    if (!key(newUrl).isEmpty()) {
         // if the newUrl existed in collections, means new file replaced the old file.
         // remove it from collection
         remove(newUrl);
         return true;
-    } else if (collected.contains(oldUrl)) {
+    } else if (!key(oldUrl).isEmpty()) {
         return true;
     }
     return false;
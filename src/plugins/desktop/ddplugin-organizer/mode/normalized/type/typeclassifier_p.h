@@ -14,6 +14,10 @@ class TypeClassifierPrivate
 public:
     explicit TypeClassifierPrivate(TypeClassifier *qq);
     ~TypeClassifierPrivate();
+    QString keyOfSuffix(const QString &suffix) const;
+    QString keyOfDirent(const QString &fileName, unsigned char type) const;
+    static QString suffixOf(const QString &fileName);
+    static QHash<QString, unsigned char> direntTypes(const QString &dirPath);
 
 public:
     ItemCategories categories;
@@ -25,6 +25,7 @@
 #include <QScrollBar>
 #include <QDebug>
 #include <QTime>
+#include <QSet>
 
 #include <DGuiApplicationHelper>
 
@@ -434,15 +435,21 @@ void NormalizedModePrivate::restore(const QList<CollectionBaseDataPtr> &cfgs, bo
     // order by config
     for (const CollectionBaseDataPtr &cfg : cfgs) {
         if (auto base = classifier->baseData(cfg->key)) {
-            QList<QUrl> org = base->items;
             QList<QUrl> ordered;
+            QSet<QUrl> taken;
             for (const QUrl &old : cfg->items) {
-                if (org.contains(old)) {
+                if (classifier->contains(cfg->key, old) && !taken.contains(old)) {
                     ordered << old;
-                    org.removeOne(old);
+                    taken.insert(old);
                 }
             }
 
+            QList<QUrl> org;
+            for (const QUrl &url : std::as_const(base->items)) {
+                if (!taken.contains(url))
+                    org << url;
+            }
+
             // those are not in config files should not be organized.
             if (reorganized || !CfgPresenter->organizeOnTriggered())
                 ordered.append(org);
@@ -451,7 +458,7 @@ void NormalizedModePrivate::restore(const QList<CollectionBaseDataPtr> &cfgs, bo
                 relayoutedCollectionIDs.insert(cfg->key);
             }
 
-            base->items = ordered;
+            classifier->setItems(cfg->key, ordered);
         }
     }
 }
@@ -783,10 +790,9 @@ void NormalizedMode::onFileRenamed(const QUrl &oldUrl, const QUrl &newUrl)
         }
         QString newType = d->classifier->classify(newUrl);
         if (newType == oldType) {
-            auto idx = d->classifier->baseData(oldType)->items.indexOf(oldUrl);
-            d->classifier->baseData(oldType)->items.replace(idx, newUrl);
+            d->classifier->replaceItem(oldType, oldUrl, newUrl);
         } else {
-            d->classifier->baseData(oldType)->items.removeAll(oldUrl);
+            d->classifier->removeItem(oldUrl);
             dpfSlotChannel->push("ddplugin_canvas", "slot_CanvasView_Select", QList<QUrl> { newUrl });
         }
 
@@ -82,6 +82,22 @@ FileDialogHandle::~FileDialogHandle()
 {
 }
 
+/*!
+ * \brief FileDialogHandle::resetState 预创建的对话框交给应用前，清除未生效的设置并恢复默认状态
+ */
+void FileDialogHandle::resetState()
+{
+    D_D(FileDialogHandle);
+
+    d->lastFilterGroup.clear();
+    d->lastFilter.clear();
+    isSetAcceptMode = false;
+    isSetNameFilters = false;
+
+    if (d->dialog)
+        d->dialog->restoreDefaultState();
+}
+
 void FileDialogHandle::setParent(QWidget *parent)
 {
     D_D(FileDialogHandle);
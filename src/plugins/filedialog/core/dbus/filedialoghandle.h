@@ -20,6 +20,8 @@ public:
     explicit FileDialogHandle(QWidget *parent = nullptr);
     ~FileDialogHandle();
 
+    void resetState();
+
 public Q_SLOTS:
     void setParent(QWidget *parent);
     QWidget *widget() const;
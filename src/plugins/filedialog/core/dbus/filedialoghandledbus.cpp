@@ -32,6 +32,15 @@ FileDialogHandleDBus::~FileDialogHandleDBus()
         widget()->close();
 }
 
+/*!
+ * \brief FileDialogHandleDBus::suspendHeartbeat 预创建的对话框还没有应用持有，不能因为没有心跳被销毁，
+ * 取出时由 makeHeartbeat 重新开始计时
+ */
+void FileDialogHandleDBus::suspendHeartbeat()
+{
+    curHeartbeatTimer.stop();
+}
+
 QString FileDialogHandleDBus::directory() const
 {
     return FileDialogHandle::directory().absolutePath();
@@ -28,6 +28,8 @@ public:
     explicit FileDialogHandleDBus(QWidget *parent = nullptr);
     virtual ~FileDialogHandleDBus();
 
+    void suspendHeartbeat();
+
 public slots:
     QString directory() const;
 
@@ -6,6 +6,7 @@
 #include "dbus/filedialoghandledbus.h"
 #include "filedialogadaptor.h"
 #include "utils/appexitcontroller.h"
+#include "utils/filedialogpool.h"
 
 #include <dfm-base/dfm_event_defines.h>
 #include <dfm-base/base/application/application.h>
@@ -29,6 +30,9 @@ FileDialogManagerDBus::FileDialogManagerDBus(QObject *parent)
         lastWindowClosed = true;
         onAppExit();
     });
+
+    // the process is usually started by the first request, prebuild for the next one
+    DIALOGCORE_NAMESPACE::FileDialogPool::instance().scheduleRefill();
 }
 
 QDBusObjectPath FileDialogManagerDBus::createDialog(QString key)
@@ -36,15 +40,17 @@ QDBusObjectPath FileDialogManagerDBus::createDialog(QString key)
     if (key.isEmpty())
         key = QUuid::createUuid().toRfc4122().toHex();
 
-    FileDialogHandleDBus *handle = new FileDialogHandleDBus();
-    Q_UNUSED(new FiledialogAdaptor(handle));
-
     const QDBusObjectPath path("/com/deepin/filemanager/filedialog/" + key);
 
     if (curDialogObjectMap.contains(path)) {
         return path;
     }
 
+    FileDialogHandleDBus *handle = DIALOGCORE_NAMESPACE::FileDialogPool::instance().take();
+    if (!handle)
+        handle = new FileDialogHandleDBus();
+    Q_UNUSED(new FiledialogAdaptor(handle));
+
     if (!QDBusConnection::sessionBus().registerObject(path.path(), handle)) {
         fmCritical("File Dialog: Cannot register to the D-Bus object.\n");
         handle->deleteLater();
@@ -133,8 +139,10 @@ void FileDialogManagerDBus::onDialogDestroy()
 void FileDialogManagerDBus::onAppExit()
 {
     if (lastWindowClosed && curDialogObjectMap.size() == 0) {
-        // after 1 minutes app exit if don't use filedialog
-        DIALOGCORE_NAMESPACE::AppExitController::instance().readyToExit(60, [this]() {
+        // stay longer with prebuilt dialogs when memory allows, the pool shrinks when it is low
+        auto &pool = DIALOGCORE_NAMESPACE::FileDialogPool::instance();
+        pool.scheduleRefill();
+        DIALOGCORE_NAMESPACE::AppExitController::instance().readyToExit(pool.idleExitSeconds(), [this]() {
             // last confirm exit
             if (lastWindowClosed && curDialogObjectMap.size() == 0)
                 return true;
@@ -0,0 +1,148 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "filedialogpool.h"
+#include "dbus/filedialoghandledbus.h"
+
+#include <QApplication>
+#include <QFile>
+
+using namespace filedialog_core;
+
+// wait for the dialog just handed out to be shown before building another one
+static constexpr int kRefillDelayMs { 2000 };
+static constexpr qint64 kPlentyMemoryKiB { 2 * 1024 * 1024 };
+static constexpr qint64 kLowMemoryKiB { 512 * 1024 };
+
+FileDialogPool::FileDialogPool(QObject *parent)
+    : QObject(parent)
+{
+    refillTimer.setSingleShot(true);
+    connect(&refillTimer, &QTimer::timeout, this, &FileDialogPool::refillOne);
+    connect(qApp, &QApplication::aboutToQuit, this, &FileDialogPool::drain);
+}
+
+FileDialogPool &FileDialogPool::instance()
+{
+    static FileDialogPool ins;
+    return ins;
+}
+
+/*!
+ * \brief FileDialogPool::take Check out a prebuilt dialog, reset to the state of a new one
+ * \return nullptr if the pool is empty, the caller creates the dialog itself
+ */
+FileDialogHandleDBus *FileDialogPool::take()
+{
+    FileDialogHandleDBus *handle { nullptr };
+    while (!handle && !idleHandles.isEmpty())
+        handle = idleHandles.takeFirst();
+
+    scheduleRefill();
+    if (!handle)
+        return nullptr;
+
+    handle->resetState();
+    handle->makeHeartbeat();
+    fmInfo() << "File Dialog: take a prebuilt dialog, idle:" << idleHandles.size();
+    return handle;
+}
+
+void FileDialogPool::scheduleRefill()
+{
+    refillTimer.start(kRefillDelayMs);
+}
+
+void FileDialogPool::drain()
+{
+    refillTimer.stop();
+    for (const QPointer<FileDialogHandleDBus> &handle : std::as_const(idleHandles)) {
+        if (handle)
+            handle->deleteLater();
+    }
+    idleHandles.clear();
+}
+
+int FileDialogPool::idleCount() const
+{
+    int count = 0;
+    for (const QPointer<FileDialogHandleDBus> &handle : idleHandles)
+        count += handle ? 1 : 0;
+    return count;
+}
+
+int FileDialogPool::idleExitSeconds() const
+{
+    return idleExitSecondsFor(availableMemoryKiB());
+}
+
+/*!
+ * \brief FileDialogPool::availableMemoryKiB MemAvailable of /proc/meminfo, -1 if unknown
+ */
+qint64 FileDialogPool::availableMemoryKiB()
+{
+    QFile file("/proc/meminfo");
+    if (!file.open(QIODevice::ReadOnly))
+        return -1;
+
+    while (!file.atEnd()) {
+        const QByteArray &line = file.readLine();
+        if (!line.startsWith("MemAvailable:"))
+            continue;
+        bool ok = false;
+        const qint64 kib = line.mid(13).trimmed().split(' ').first().toLongLong(&ok);
+        return ok ? kib : -1;
+    }
+    return -1;
+}
+
+int FileDialogPool::capacityFor(qint64 availableKiB)
+{
+    if (availableKiB < 0)
+        return 1;
+    if (availableKiB >= kPlentyMemoryKiB)
+        return 2;
+    if (availableKiB >= kLowMemoryKiB)
+        return 1;
+    return 0;
+}
+
+/*!
+ * \brief FileDialogPool::idleExitSecondsFor How long the process stays alive without dialogs,
+ * kept longer while the prebuilt dialogs are cheap to hold
+ */
+int FileDialogPool::idleExitSecondsFor(qint64 availableKiB)
+{
+    switch (capacityFor(availableKiB)) {
+    case 2:
+        return 600;
+    case 1:
+        return 180;
+    default:
+        return 60;
+    }
+}
+
+void FileDialogPool::refillOne()
+{
+    idleHandles.removeIf([](const QPointer<FileDialogHandleDBus> &handle) { return handle.isNull(); });
+
+    const int capacity = capacityFor(availableMemoryKiB());
+    while (idleHandles.size() > capacity) {
+        QPointer<FileDialogHandleDBus> handle = idleHandles.takeLast();
+        if (handle)
+            handle->deleteLater();
+    }
+    if (idleHandles.size() >= capacity)
+        return;
+
+    FileDialogHandleDBus *handle = new FileDialogHandleDBus();
+    handle->suspendHeartbeat();
+    idleHandles.append(handle);
+    fmDebug() << "File Dialog: prebuilt a dialog, idle:" << idleHandles.size() << "capacity:" << capacity;
+
+    // one dialog per event loop turn, requests in between are not held up
+    if (idleHandles.size() < capacity)
+        refillTimer.start(0);
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FILEDIALOGPOOL_H
+#define FILEDIALOGPOOL_H
+
+#include "filedialogplugin_core_global.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+
+class FileDialogHandleDBus;
+
+namespace filedialog_core {
+
+/*!
+ * \brief FileDialogPool keeps fully constructed, hidden dialogs ready for createDialog.
+ *
+ * Dialogs are built one per event loop turn, a while after the last checkout so the
+ * shown dialog gets its first paint first. How many dialogs are kept and how long the
+ * idle process stays alive depend on the memory available.
+ */
+class FileDialogPool : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY(FileDialogPool)
+
+public:
+    static FileDialogPool &instance();
+
+    FileDialogHandleDBus *take();
+    void scheduleRefill();
+    void drain();
+    int idleCount() const;
+    int idleExitSeconds() const;
+
+    static qint64 availableMemoryKiB();
+    static int capacityFor(qint64 availableKiB);
+    static int idleExitSecondsFor(qint64 availableKiB);
+
+private:
+    explicit FileDialogPool(QObject *parent = nullptr);
+    void refillOne();
+
+    QList<QPointer<FileDialogHandleDBus>> idleHandles;
+    QTimer refillTimer;
+};
+
+}
+
+#endif   // FILEDIALOGPOOL_H
@@ -8,6 +8,7 @@
 #include "utils/corehelper.h"
 
 #include <dfm-base/base/schemefactory.h>
+#include <dfm-base/base/standardpaths.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/dfm_event_defines.h>
 #include <dfm-base/mimetype/dmimedatabase.h>
@@ -55,8 +56,8 @@ FileDialogPrivate::FileDialogPrivate(FileDialog *qq)
     //! see FileManagerWindowsManager::createWindow
     q->setProperty("_dfm_Disable_RestoreWindowState_", true);
 
-    QSettings qtSets(QSettings::UserScope, QLatin1String("QtProject"));
-    lastVisitedDir = qtSets.value("FileDialog/lastVisited").toUrl();
+    lastVisitedDir = loadLastVisited();
+    savedVisitedDir = lastVisitedDir;
 
     delaySaveTimer = new QTimer(this);
     delaySaveTimer->setInterval(3000);
@@ -65,7 +66,9 @@ FileDialogPrivate::FileDialogPrivate(FileDialog *qq)
 
 FileDialogPrivate::~FileDialogPrivate()
 {
-    saveLastVisited();
+    // 预创建后未使用的对话框不能用旧的目录覆盖其他对话框保存的记录
+    if (lastVisitedDir != savedVisitedDir)
+        saveLastVisited();
 }
 
 void FileDialogPrivate::handleSaveAcceptBtnClicked()
@@ -226,6 +229,13 @@ void FileDialogPrivate::saveLastVisited()
 {
     QSettings qtSets(QSettings::UserScope, QLatin1String("QtProject"));
     qtSets.setValue("FileDialog/lastVisited", lastVisitedDir.toString());
+    savedVisitedDir = lastVisitedDir;
+}
+
+QUrl FileDialogPrivate::loadLastVisited()
+{
+    QSettings qtSets(QSettings::UserScope, QLatin1String("QtProject"));
+    return qtSets.value("FileDialog/lastVisited").toUrl();
 }
 
 /*!
@@ -296,6 +306,27 @@ QUrl FileDialog::lastVisitedUrl() const
     return d->lastVisitedDir;
 }
 
+/*!
+ * \brief FileDialog::restoreDefaultState 预创建的对话框交给应用前调用，
+ * 恢复新建时的过滤器和选择模式，并进入最近访问的目录
+ */
+void FileDialog::restoreDefaultState()
+{
+    if (!d->nameFilters.isEmpty())
+        setNameFilters({});
+    if (d->acceptMode != QFileDialog::AcceptOpen)
+        setAcceptMode(QFileDialog::AcceptOpen);
+    if (d->fileMode != QFileDialog::AnyFile)
+        setFileMode(QFileDialog::AnyFile);
+
+    // 在池中等待期间，其他对话框可能更新了最近访问的目录
+    QUrl url = FileDialogPrivate::loadLastVisited();
+    if (!url.isValid())
+        url = QUrl::fromLocalFile(StandardPaths::location(StandardPaths::kHomePath));
+    if (!UniversalUtils::urlEquals(url, currentUrl()))
+        cd(url);
+}
+
 void FileDialog::setDirectory(const QString &directory)
 {
     QUrl url = UrlRoute::fromLocalFile(directory);
@@ -34,6 +34,7 @@ public:
     bool saveClosedSate() const override;
     void updateAsDefaultSize();
     QUrl lastVisitedUrl() const;
+    void restoreDefaultState();
 
 public:
     QFileDialog::ViewMode currentViewMode() const;
@@ -37,6 +37,7 @@ public:
     void handleOpenNewWindow(const QUrl &url);
     bool checkFileSuffix(const QString &filename, QString &suffix);
     void setLastVisited(const QUrl &dir);
+    static QUrl loadLastVisited();
 
 public Q_SLOTS:
     void saveLastVisited();
@@ -61,6 +62,7 @@ private:
     QFileDialog::Options options;
     QUrl currentUrl;
     QUrl lastVisitedDir;
+    QUrl savedVisitedDir;
     QTimer *delaySaveTimer { nullptr };
 
     static QStringList cleanFilterList(const QString &filter)
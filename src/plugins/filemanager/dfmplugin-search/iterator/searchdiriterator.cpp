@@ -84,10 +84,10 @@ void SearchDirIteratorPrivate::doSearch()
 void SearchDirIteratorPrivate::onMatched(const QString &id)
 {
     if (taskId == id) {
-        // 直接在主线程更新结果，但使用高效的双缓冲机制
-        const auto &results = SearchManager::instance()->matchedResults(taskId);
+        // 只取上次之后新增的结果，追加到缓冲中等待遍历线程消费
+        const auto &results = SearchManager::instance()->matchedResultsSince(taskId, resultCursor);
         if (!results.isEmpty()) {
-            resultBuffer.updateResults(results);
+            resultBuffer.appendResults(results);
             hasConsumedResults.store(false, std::memory_order_release);   // 标记有新数据
         }
 
@@ -190,38 +190,36 @@ QList<QSharedPointer<SortFileInfo>> SearchDirIterator::sortFileInfoList()
 
     const auto results = d->resultBuffer.consumeResults();
 
-    // 如果没有新结果且搜索已完成，返回空
-    if (results.isEmpty() && d->searchFinished.load(std::memory_order_acquire))
+    // 没有新结果时不重复返回已有结果
+    if (results.isEmpty())
         return {};
 
-    // TODO (perf) : 存在性能问题，重复获取全量数据
-    // 在子线程中处理数据，不影响主线程
-    // 使用两个QList分别装载文件夹和文件，然后合并
-    // 时间复杂度：O(n)，空间复杂度：O(n)，性能优于stable_partition
-    QList<QSharedPointer<SortFileInfo>> dirs;
-    QList<QSharedPointer<SortFileInfo>> files;
-
-    // 预分配空间以提高性能（可选优化）
-    const int totalCount = results.size();
-    dirs.reserve(totalCount / 4);   // 估算文件夹占比约25%
-    files.reserve(totalCount);   // 文件可能占大部分
-
-    for (auto it = results.begin(); it != results.end(); ++it) {
+    // 只为新增结果生成排序信息，已有的直接复用
+    // 文件夹和文件分别累积，返回时文件夹在前，文件在后
+    for (const auto &searchResult : results) {
+        const QUrl &url = searchResult.url();
         auto sortInfo = QSharedPointer<SortFileInfo>(new SortFileInfo());
-        sortInfo->setUrl(it.key());
-        sortInfo->setHighlightContent(it->highlightedContent());
+        sortInfo->setUrl(url);
+        sortInfo->setHighlightContent(searchResult.highlightedContent());
         doCompleteSortInfo(sortInfo);
 
+        // 同一文件出现了更高分的结果（如内容匹配）时替换原有条目，该情况很少
+        const auto existing = d->resultSortInfos.value(url);
+        if (existing && !d->resultDirs.removeOne(existing))
+            d->resultFiles.removeOne(existing);
+        d->resultSortInfos.insert(url, sortInfo);
+
         if (sortInfo->isDir()) {
-            dirs.append(sortInfo);
+            d->resultDirs.append(sortInfo);
         } else {
-            files.append(sortInfo);
+            d->resultFiles.append(sortInfo);
         }
     }
 
-    // 合并结果：文件夹在前，文件在后
-    result = std::move(dirs);
-    result.append(files);
+    // 下游按全量结果处理，这里只拼接已有指针
+    result.reserve(d->resultDirs.size() + d->resultFiles.size());
+    result.append(d->resultDirs);
+    result.append(d->resultFiles);
 
     // 标记结果已被消费，避免重复处理
     d->hasConsumedResults.store(true, std::memory_order_release);
@@ -305,39 +303,36 @@ void SearchDirIterator::doCompleteSortInfo(SortInfoPointer sortInfo)
 void SearchResultBuffer::updateResults(const DFMSearchResultMap &newResults)
 {
     QMutexLocker lock(&writerMutex);
+    pending = newResults.values();
+}
 
-    // 写入非活跃缓冲区
-    if (useBufferA.load(std::memory_order_acquire)) {
-        bufferB = newResults;
-        useBufferA.store(false, std::memory_order_release);   // 原子切换
-    } else {
-        bufferA = newResults;
-        useBufferA.store(true, std::memory_order_release);   // 原子切换
-    }
+void SearchResultBuffer::appendResults(const DFMSearchResultMap &newResults)
+{
+    QMutexLocker lock(&writerMutex);
+
+    // 只追加新增结果，每批的开销与新增数量相关，与尚未消费的数量无关
+    for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it)
+        pending.append(it.value());
 }
 
-DFMSearchResultMap SearchResultBuffer::getResults() const
+DFMSearchResultList SearchResultBuffer::getResults() const
 {
-    // 无锁读取活跃缓冲区
-    return useBufferA.load(std::memory_order_acquire) ? bufferA : bufferB;
+    QMutexLocker lock(&writerMutex);
+    return pending;
 }
 
-DFMSearchResultMap SearchResultBuffer::consumeResults()
+DFMSearchResultList SearchResultBuffer::consumeResults()
 {
     QMutexLocker lock(&writerMutex);
-    DFMSearchResultMap results;
-    if (useBufferA.load(std::memory_order_acquire)) {
-        results.swap(bufferA);
-    } else {
-        results.swap(bufferB);
-    }
+    DFMSearchResultList results;
+    results.swap(pending);
     return results;
 }
 
 bool SearchResultBuffer::isEmpty() const
 {
-    // 检查当前活跃缓冲区是否为空
-    return useBufferA.load(std::memory_order_acquire) ? bufferA.isEmpty() : bufferB.isEmpty();
+    QMutexLocker lock(&writerMutex);
+    return pending.isEmpty();
 }
 
 }
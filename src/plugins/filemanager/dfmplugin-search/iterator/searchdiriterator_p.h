@@ -17,6 +17,7 @@
 #include <QMutex>
 #include <QScopedPointer>
 #include <QWaitCondition>
+#include <QHash>
 #include <atomic>
 #include <mutex>
 
@@ -24,30 +25,31 @@ DFMBASE_USE_NAMESPACE
 
 namespace dfmplugin_search {
 
-// 双缓冲搜索结果管理器
+// 搜索结果缓冲：生产者追加增量，消费者整体取走
 class SearchResultBuffer
 {
 public:
     SearchResultBuffer() = default;
     ~SearchResultBuffer() = default;
 
-    // 生产者：更新搜索结果（主线程调用）
+    // 生产者：替换尚未消费的结果（主线程调用）
     void updateResults(const DFMSearchResultMap &newResults);
 
-    // 消费者：获取当前搜索结果快照（子线程调用）
-    DFMSearchResultMap getResults() const;
+    // 生产者：把增量结果追加到尚未消费的结果之后（主线程调用）
+    void appendResults(const DFMSearchResultMap &newResults);
 
-    // 消费者：获取并清空当前搜索结果（子线程调用）
-    DFMSearchResultMap consumeResults();
+    // 消费者：获取尚未消费的结果快照，隐式共享不复制数据（子线程调用）
+    DFMSearchResultList getResults() const;
+
+    // 消费者：取走并清空尚未消费的结果（子线程调用）
+    DFMSearchResultList consumeResults();
 
     // 检查是否有数据
     bool isEmpty() const;
 
 private:
-    mutable DFMSearchResultMap bufferA;
-    mutable DFMSearchResultMap bufferB;
-    std::atomic<bool> useBufferA { true };
-    mutable QMutex writerMutex;   // 只保护写操作
+    DFMSearchResultList pending;   // 尚未消费的结果，同一文件可能出现多次，后者优先
+    mutable QMutex writerMutex;
 };
 
 class SearchDirIterator;
@@ -77,7 +79,13 @@ public:
     std::atomic<bool> searchFinished { false };   // 搜索是否完成(原子操作保证线程安全)
     std::atomic<bool> searchStoped { false };   // 搜索是否停止(原子操作保证线程安全)
 
-    SearchResultBuffer resultBuffer;   // 双缓冲搜索结果
+    SearchResultBuffer resultBuffer;   // 尚未消费的增量搜索结果
+    int resultCursor { 0 };   // 已从搜索任务取到的结果日志位置
+
+    // 已生成的排序信息，只在遍历线程中访问；每批只为新增结果执行 stat
+    QHash<QUrl, SortInfoPointer> resultSortInfos;
+    QList<SortInfoPointer> resultDirs;
+    QList<SortInfoPointer> resultFiles;
     QScopedPointer<LocalFileWatcher> searchRootWatcher;   // 文件监视器
     std::once_flag searchOnceFlag;   // 一次性标志
     SearchDirIterator *q = nullptr;   // 指向父类的指针
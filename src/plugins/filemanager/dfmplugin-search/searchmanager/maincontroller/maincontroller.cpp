@@ -71,6 +71,14 @@ DFMSearchResultMap MainController::getResults(QString taskId)
     return {};
 }
 
+DFMSearchResultMap MainController::getResultsSince(QString taskId, int &cursor)
+{
+    if (taskManager.contains(taskId))
+        return taskManager[taskId]->getResultsSince(cursor);
+
+    return {};
+}
+
 QList<QUrl> MainController::getResultUrls(QString taskId)
 {
     if (taskManager.contains(taskId))
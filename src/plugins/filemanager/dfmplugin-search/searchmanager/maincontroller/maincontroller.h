@@ -26,6 +26,9 @@ private:
     
     // 获取统一的搜索结果
     DFMSearchResultMap getResults(QString taskId);
+
+    // 获取游标之后新增的搜索结果
+    DFMSearchResultMap getResultsSince(QString taskId, int &cursor);
     
     // 为兼容性保留的接口
     QList<QUrl> getResultUrls(QString taskId);
@@ -37,13 +37,32 @@ SimplifiedSearchWorker::~SimplifiedSearchWorker()
 DFMSearchResultMap SimplifiedSearchWorker::getResults()
 {
     QReadLocker locker(&rwLock);
-    return resultMap;
+    DFMSearchResultMap results;
+    for (auto it = resultIndex.constBegin(); it != resultIndex.constEnd(); ++it)
+        results.insert(it.key(), resultLog.at(it.value()).second);
+
+    return results;
 }
 
 QList<QUrl> SimplifiedSearchWorker::getResultUrls()
 {
     QReadLocker locker(&rwLock);
-    return resultMap.keys();
+    return resultIndex.keys();
+}
+
+DFMSearchResultMap SimplifiedSearchWorker::getResultsSince(int &cursor)
+{
+    QReadLocker locker(&rwLock);
+    DFMSearchResultMap results;
+    for (int i = qMax(cursor, 0); i < resultLog.size(); ++i) {
+        const auto &entry = resultLog.at(i);
+        // 已被后续更高分条目取代的旧条目不再返回
+        if (resultIndex.value(entry.first, -1) == i)
+            results.insert(entry.first, entry.second);
+    }
+
+    cursor = resultLog.size();
+    return results;
 }
 
 void SimplifiedSearchWorker::startSearch()
@@ -54,7 +73,8 @@ void SimplifiedSearchWorker::startSearch()
 
     {
         QWriteLocker locker(&rwLock);
-        resultMap.clear();
+        resultLog.clear();
+        resultIndex.clear();
     }
 
     // 创建搜索器并启动搜索
@@ -193,28 +213,18 @@ void SimplifiedSearchWorker::mergeResults(AbstractSearcher *searcher)
     if (newResults.isEmpty())
         return;
 
-    // 合并到主结果集
-    {
-        QWriteLocker locker(&rwLock);
+    // 追加到结果日志，只有新url或更高分的结果才会追加
+    QWriteLocker locker(&rwLock);
+    for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it) {
+        const QUrl &url = it.key();
+        auto existing = resultIndex.constFind(url);
 
-        // 第一次直接复制结果
-        if (resultMap.isEmpty()) {
-            resultMap = newResults;
-            return;
-        }
-
-        // 合并结果，保留匹配分数更高的结果
-        for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it) {
-            const QUrl &url = it.key();
-            auto existing = resultMap.find(url);
+        if (existing != resultIndex.constEnd()
+            && it.value().matchScore() <= resultLog.at(existing.value()).second.matchScore())
+            continue;
 
-            if (existing != resultMap.end()) {
-                if (it.value().matchScore() > existing.value().matchScore())
-                    resultMap[url] = it.value();
-            } else {
-                resultMap.insert(url, it.value());
-            }
-        }
+        resultIndex.insert(url, resultLog.size());
+        resultLog.append(qMakePair(url, it.value()));
     }
 }
 
@@ -334,6 +344,17 @@ DFMSearchResultMap TaskCommander::getResults() const
     return results;
 }
 
+DFMSearchResultMap TaskCommander::getResultsSince(int &cursor) const
+{
+    if (!d->searchWorker) {
+        fmWarning() << "Search worker not available for getting results";
+        return DFMSearchResultMap();
+    }
+
+    // 读取受工作线程的读写锁保护，可直接调用
+    return d->searchWorker->getResultsSince(cursor);
+}
+
 QList<QUrl> TaskCommander::getResultsUrls() const
 {
     if (!d->searchWorker) {
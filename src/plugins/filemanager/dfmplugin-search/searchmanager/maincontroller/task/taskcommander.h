@@ -28,6 +28,7 @@ private:
     
     // 获取搜索结果
     DFMSearchResultMap getResults() const;
+    DFMSearchResultMap getResultsSince(int &cursor) const;
     QList<QUrl> getResultsUrls() const;
     
     // 控制搜索流程
@@ -17,6 +17,8 @@
 #include <QAtomicInt>
 #include <QMap>
 #include <QSet>
+#include <QHash>
+#include <QVector>
 #include <QThread>
 #include <QMutex>
 #include <QTimer>
@@ -40,6 +42,9 @@ public:
     Q_INVOKABLE DFMSearchResultMap getResults();
     Q_INVOKABLE QList<QUrl> getResultUrls();
 
+    // 获取游标之后新增的结果，并将游标移到日志末尾
+    DFMSearchResultMap getResultsSince(int &cursor);
+
     // 控制搜索流程
     Q_INVOKABLE void startSearch();
     Q_INVOKABLE void stopSearch();
@@ -67,7 +72,11 @@ private:
     QString searchKeyword;
 
     QList<AbstractSearcher *> searchers;
-    DFMSearchResultMap resultMap;
+
+    // 追加式结果日志，消费者按游标只取增量；
+    // 同一url出现更高分结果时追加新条目，resultIndex指向最新的位置
+    QVector<QPair<QUrl, DFMSearchResult>> resultLog;
+    QHash<QUrl, int> resultIndex;
 
     QReadWriteLock rwLock;
     QMutex mutex;
@@ -9,63 +9,15 @@
 #include <dfm-base/base/schemefactory.h>
 
 #include <QDebug>
-#include <QDirIterator>
-#include <QFileInfo>
-#include <QApplication>
 #include <QMetaObject>
 #include <QTimer>
 
 DFMBASE_USE_NAMESPACE
 DPSEARCH_USE_NAMESPACE
 
-// ================= IteratorSearcherBridge 实现 =================
-IteratorSearcherBridge::IteratorSearcherBridge(QObject *parent)
-    : QObject(parent)
-{
-    // 确保桥接类在主线程创建
-    Q_ASSERT(thread() == qApp->thread());
-}
-
-IteratorSearcherBridge::~IteratorSearcherBridge() = default;
-
-void IteratorSearcherBridge::setSearcher(IteratorSearcher *searcher)
-{
-    // 弱引用指向搜索器
-    searcherPtr = searcher;
-
-    connect(searcherPtr, &IteratorSearcher::requestCreateIterator,
-            this, &IteratorSearcherBridge::createIterator,
-            Qt::QueuedConnection);
-    connect(this, &IteratorSearcherBridge::iteratorCreated,
-            searcherPtr, &IteratorSearcher::onIteratorCreated,
-            Qt::QueuedConnection);
-}
-
-void IteratorSearcherBridge::createIterator(const QUrl &url)
-{
-    // 始终在主线程中执行
-    Q_ASSERT(thread() == qApp->thread());
-
-    // 创建目录迭代器
-    auto iterator = DirIteratorFactory::create(url, QStringList(),
-                                            QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files);
-
-    if (!iterator) {
-        fmWarning() << "Failed to create directory iterator for URL:" << url.toString();
-        // 如果创建失败，发出空迭代器信号
-        emit iteratorCreated(nullptr);
-        return;
-    }
+// 遍历线程数上限，网络文件系统上过多的并发请求反而更慢
+static constexpr int kMaxWalkerCount { 4 };
 
-    // 设置查询属性
-    iterator->setProperty("QueryAttributes", "standard::name,standard::type,standard::size,"
-                        "standard::is-symlink,standard::symlink-target,access::*,time::*");
-
-    // 发送给工作线程
-    emit iteratorCreated(iterator);
-}
-
-// ================= IteratorSearcher 实现 =================
 IteratorSearcher::IteratorSearcher(const QUrl &url, const QString &key, QObject *parent)
     : AbstractSearcher(url, SearchHelper::instance()->checkWildcardAndToRegularExpression(key), parent),
       status(kReady),
@@ -76,10 +28,14 @@ IteratorSearcher::IteratorSearcher(const QUrl &url, const QString &key, QObject
     // 创建正则表达式，忽略大小写
     regex = QRegularExpression(keyword, QRegularExpression::CaseInsensitiveOption);
 
-    // 连接处理目录的信号
-    connect(this, &IteratorSearcher::requestProcessNextDirectory,
-            this, &IteratorSearcher::processDirectory,
-            Qt::QueuedConnection);
+    // 不含通配符的关键字等价于 *key*，文件名中不会出现'/'，可直接做子串匹配
+    // '['、']' 在通配符中表示字符集，仍走正则匹配
+    literalMatch = !key.isEmpty() && !key.contains('*') && !key.contains('?')
+            && !key.contains('[') && !key.contains(']');
+    if (literalMatch)
+        literalMatcher = QStringMatcher(key, Qt::CaseInsensitive);
+
+    walkPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), kMaxWalkerCount));
 
     // 配置批处理定时器
     batchTimer->setSingleShot(true);
@@ -88,8 +44,14 @@ IteratorSearcher::IteratorSearcher(const QUrl &url, const QString &key, QObject
 
 IteratorSearcher::~IteratorSearcher()
 {
-    // 清理资源
-    pendingDirs.clear();
+    // 通知遍历线程退出，并等待其结束后再释放成员
+    status.storeRelease(kTerminated);
+    {
+        QMutexLocker lk(&walkMutex);
+        pendingDirs.clear();
+    }
+    walkCondition.wakeAll();
+    walkPool.waitForDone();
 
     // 确保停止定时器
     if (batchTimer->isActive())
@@ -104,20 +66,17 @@ bool IteratorSearcher::search()
         return false;
     }
 
-    // 从根URL开始搜索
-    pendingDirs.enqueue(searchUrl);
-
-    // 创建桥接类实例，总是在主线程中运行
-    // 确保桥接类在主线程上创建
-    QObject *mainThread = qApp;
-    QMetaObject::invokeMethod(mainThread, [this]() {
-        // 这个lambda在主线程中运行
-        bridge = QSharedPointer<IteratorSearcherBridge>::create();
-        bridge->setSearcher(this);
+    // 从根URL开始搜索，目录迭代器全部在遍历线程中创建，不占用主线程
+    const int walkerCount = walkPool.maxThreadCount();
+    {
+        QMutexLocker lk(&walkMutex);
+        pendingDirs.enqueue(searchUrl);
+        busyWalkers = 0;
+        runningWalkers = walkerCount;
+    }
 
-        // 通知构造函数bridge已准备好
-        emit requestProcessNextDirectory();
-    }, Qt::BlockingQueuedConnection);
+    for (int i = 0; i < walkerCount; ++i)
+        walkPool.start([this] { walkWorker(); });
 
     return true;
 }
@@ -127,11 +86,15 @@ void IteratorSearcher::stop()
     // 标记为终止状态
     QAtomicInt previousState = status.fetchAndStoreRelease(kTerminated);
 
-    // 只在之前为运行状态时执行清理
-    if (previousState == kRuning) {
-        // 清理待处理目录
+    // 唤醒等待目录的遍历线程，让其退出
+    {
+        QMutexLocker lk(&walkMutex);
         pendingDirs.clear();
+    }
+    walkCondition.wakeAll();
 
+    // 只在之前为运行状态时执行清理
+    if (previousState == kRuning) {
         // 确保处理挖掘的结果
         if (hasItem())
             emit unearthed(this);
@@ -169,55 +132,57 @@ QList<QUrl> IteratorSearcher::takeAllUrls()
     return urls;
 }
 
-void IteratorSearcher::processDirectory()
+void IteratorSearcher::walkWorker()
 {
-    // 检查状态
-    if (status.loadAcquire() != kRuning) {
-        fmDebug() << "Directory processing skipped - not in running state";
-        return;
-    }
+    forever {
+        QUrl dirUrl;
+        {
+            QMutexLocker lk(&walkMutex);
+            // 队列为空但仍有线程在遍历时，等待其产出子目录
+            while (pendingDirs.isEmpty() && busyWalkers > 0 && status.loadAcquire() == kRuning)
+                walkCondition.wait(&walkMutex);
+
+            if (pendingDirs.isEmpty() || status.loadAcquire() != kRuning) {
+                walkCondition.wakeAll();
+                if (--runningWalkers == 0)
+                    QMetaObject::invokeMethod(this, &IteratorSearcher::onWalkFinished, Qt::QueuedConnection);
+                return;
+            }
 
-    // 如果队列为空且状态为运行中，标记为完成
-    if (pendingDirs.isEmpty()) {
-        status.storeRelease(kCompleted);
-        fmDebug() << "Iterator search completed - no more directories to process";
-        emit finished();
-        return;
-    }
+            dirUrl = pendingDirs.dequeue();
+            ++busyWalkers;
+        }
 
-    // 从队列获取下一个目录
-    QUrl currentUrl = pendingDirs.dequeue();
+        QList<QUrl> subDirs;
+        DFMSearchResultMap newResults;
+        processDirectory(dirUrl, subDirs, newResults);
 
-    // 在主线程中请求创建迭代器
-    emit requestCreateIterator(currentUrl);
-}
+        // 处理结果
+        if (!newResults.isEmpty() && status.loadAcquire() == kRuning)
+            addResults(newResults);
 
-void IteratorSearcher::onIteratorCreated(QSharedPointer<DFMBASE_NAMESPACE::AbstractDirIterator> iterator)
-{
-    // 检查状态
-    if (status.loadAcquire() != kRuning) {
-        fmDebug() << "Iterator creation callback ignored - not in running state";
-        return;
-    }
-
-    // 处理迭代器结果
-    if (iterator) {
-        processIteratorResults(iterator);
-    } else {
-        fmWarning() << "Received null iterator from bridge";
+        // 将子目录添加到队列
+        QMutexLocker lk(&walkMutex);
+        for (const QUrl &subDir : subDirs)
+            pendingDirs.enqueue(subDir);
+        --busyWalkers;
+        walkCondition.wakeAll();
     }
-
-    // 请求处理下一个目录
-    requestNextDirectory();
 }
 
-void IteratorSearcher::processIteratorResults(QSharedPointer<DFMBASE_NAMESPACE::AbstractDirIterator> iterator)
+void IteratorSearcher::processDirectory(const QUrl &dirUrl, QList<QUrl> &subDirs, DFMSearchResultMap &results)
 {
-    if (status.loadAcquire() != kRuning)
+    // 创建目录迭代器
+    auto iterator = DirIteratorFactory::create(dirUrl, QStringList(),
+                                               QDir::NoDotAndDotDot | QDir::Dirs | QDir::Files);
+    if (!iterator) {
+        fmWarning() << "Failed to create directory iterator for URL:" << dirUrl.toString();
         return;
+    }
 
-    DFMSearchResultMap newResults;
-    QList<QUrl> subDirs;
+    // 设置查询属性
+    iterator->setProperty("QueryAttributes", "standard::name,standard::type,standard::size,"
+                                             "standard::is-symlink,standard::symlink-target,access::*,time::*");
 
     // 使用迭代器处理目录条目
     while (iterator->hasNext() && status.loadAcquire() == kRuning) {
@@ -229,25 +194,23 @@ void IteratorSearcher::processIteratorResults(QSharedPointer<DFMBASE_NAMESPACE::
 
         // 添加子目录到搜索队列
         if (info->isAttributes(OptInfoType::kIsDir) && !info->isAttributes(OptInfoType::kIsSymLink)) {
-            const auto &dirUrl = info->urlOf(UrlInfoType::kUrl);
-            if (!dirUrl.path().startsWith("/sys/")) {
-                subDirs << dirUrl;
+            const auto &subDirUrl = info->urlOf(UrlInfoType::kUrl);
+            if (!subDirUrl.path().startsWith("/sys/")) {
+                subDirs << subDirUrl;
             }
         }
 
-        // The keyword check (the regex)
-        if (regex.match(info->displayOf(DisPlayInfoType::kFileDisplayName)).hasMatch())
-            addResultToMap(fileUrl, newResults);
+        if (matchName(info->displayOf(DisPlayInfoType::kFileDisplayName)))
+            addResultToMap(fileUrl, results);
     }
+}
 
-    // 将子目录添加到队列
-    for (const QUrl &subDir : subDirs) {
-        pendingDirs.enqueue(subDir);
-    }
+bool IteratorSearcher::matchName(const QString &name) const
+{
+    if (literalMatch)
+        return literalMatcher.indexIn(name) >= 0;
 
-    // 处理结果
-    if (!newResults.isEmpty() && status.loadAcquire() == kRuning)
-        addResults(newResults);
+    return regex.match(name).hasMatch();
 }
 
 void IteratorSearcher::addResultToMap(const QUrl &fileUrl, DFMSearchResultMap &results)
@@ -266,49 +229,55 @@ void IteratorSearcher::addResults(const DFMSearchResultMap &newResults)
     if (newResults.isEmpty())
         return;
 
-    int currentBatchSize = 0;
-    // 批量处理结果
+    bool publishNow = false;
+    // 批量处理结果，由遍历线程调用
     {
         QMutexLocker lk(&mutex);
-        for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it) {
-            // 同时添加到总结果集
+        for (auto it = newResults.constBegin(); it != newResults.constEnd(); ++it)
             resultMap.insert(it.key(), it.value());
 
-            // 将新结果合并到批处理结果中
-            batchedResults.insert(it.key(), it.value());
-        }
-        currentBatchSize = batchedResults.size();
+        batchedCount += newResults.size();
+        // 当积累的批处理结果达到阈值时，或首次有结果时，立即发布
+        publishNow = batchedCount >= batchResultLimit || !firstBatchPublished;
     }
 
-    // 当积累的批处理结果达到阈值时，或首次有结果时，立即发布
-    if (currentBatchSize >= batchResultLimit || !batchTimer->isActive())
-        publishBatchedResults();
+    // 发布总在搜索器所在线程执行，已有请求在排队时不再重复投递
+    if (publishNow && publishPending.testAndSetAcquire(0, 1))
+        QMetaObject::invokeMethod(this, &IteratorSearcher::publishBatchedResults, Qt::QueuedConnection);
 }
 
 void IteratorSearcher::publishBatchedResults()
 {
+    publishPending.storeRelease(0);
+
     // 检查状态
     if (status.loadAcquire() != kRuning)
         return;
 
-    // 只有当有结果时才通知
-    if (!batchedResults.isEmpty()) {
-        {
-            QMutexLocker lk(&mutex);
-            // 清空批处理结果，下一批重新开始
-            batchedResults.clear();
-        }
+    bool hasBatch = false;
+    {
+        QMutexLocker lk(&mutex);
+        // 清空批处理计数，下一批重新开始
+        hasBatch = batchedCount > 0;
+        batchedCount = 0;
+        firstBatchPublished = firstBatchPublished || hasBatch;
+    }
 
-        // 通知新结果
+    // 只有当有结果时才通知
+    if (hasBatch)
         emit unearthed(this);
-    }
 
     // 重新计时
     batchTimer->start(batchTimeLimit);
 }
 
-void IteratorSearcher::requestNextDirectory()
+void IteratorSearcher::onWalkFinished()
 {
-    // 通过信号请求处理下一个目录
-    emit requestProcessNextDirectory();
+    // 被 stop() 终止时由 stop() 负责通知
+    if (!status.testAndSetRelease(kRuning, kCompleted))
+        return;
+
+    batchTimer->stop();
+    fmDebug() << "Iterator search completed - no more directories to process";
+    emit finished();
 }
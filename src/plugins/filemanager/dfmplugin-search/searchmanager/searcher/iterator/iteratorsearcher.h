@@ -10,22 +10,15 @@
 
 #include <QMutex>
 #include <QRegularExpression>
-#include <QSharedPointer>
+#include <QStringMatcher>
 #include <QQueue>
-#include <QPointer>
-#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
 #include <QTimer>
 #include <QAtomicInt>
 
-DFMBASE_BEGIN_NAMESPACE
-class AbstractDirIterator;
-DFMBASE_END_NAMESPACE
-
 DPSEARCH_BEGIN_NAMESPACE
 
-// 前向声明
-class IteratorSearcherBridge;
-
 class IteratorSearcher : public AbstractSearcher
 {
     Q_OBJECT
@@ -47,74 +40,56 @@ public:
     // Static method to check if a URL is supported
     static bool isSupportSearch(const QUrl &url) { return true; }
 
-signals:
-    // 改为内部使用的信号
-    void requestProcessNextDirectory();
-    void requestCreateIterator(const QUrl &url);
+private slots:
+    // 发布批量结果，总是在搜索器所在线程执行
+    void publishBatchedResults();
 
-public slots:
-    // 处理迭代器创建回调
-    void onIteratorCreated(QSharedPointer<DFMBASE_NAMESPACE::AbstractDirIterator> iterator);
-    
-    // 处理目录
-    void processDirectory();
+    // 所有遍历线程退出后的收尾
+    void onWalkFinished();
 
 private:
-    // 处理迭代器结果
-    void processIteratorResults(QSharedPointer<DFMBASE_NAMESPACE::AbstractDirIterator> iterator);
-    
+    // 遍历线程入口，从共享队列中领取目录直到队列耗尽
+    void walkWorker();
+
+    // 遍历单个目录，子目录写入 subDirs，匹配结果写入 results
+    void processDirectory(const QUrl &dirUrl, QList<QUrl> &subDirs, DFMSearchResultMap &results);
+
+    // 文件名是否匹配关键字
+    bool matchName(const QString &name) const;
+
     // 添加单个结果到结果映射
     void addResultToMap(const QUrl &fileUrl, DFMSearchResultMap &results);
-    
-    // 添加多个结果并发出信号
-    void addResults(const DFMSearchResultMap &newResults);
-    
-    // 请求处理队列中的下一个目录
-    void requestNextDirectory();
 
-    // 发布批量结果
-    void publishBatchedResults();
+    // 添加多个结果，必要时请求发布
+    void addResults(const DFMSearchResultMap &newResults);
 
 private:
     QAtomicInt status = kReady;
     DFMSearchResultMap resultMap;
     mutable QMutex mutex;
     QRegularExpression regex;
+
+    // 关键字不含通配符时，直接做忽略大小写的子串匹配，不走正则
+    bool literalMatch { false };
+    QStringMatcher literalMatcher;
+
+    // 多线程遍历共享的目录队列
+    QThreadPool walkPool;
+    QMutex walkMutex;
+    QWaitCondition walkCondition;
     QQueue<QUrl> pendingDirs;
-    
-    // 用于主线程与工作线程间通信的桥接对象
-    QSharedPointer<IteratorSearcherBridge> bridge;
+    int busyWalkers { 0 };
+    int runningWalkers { 0 };
 
     // 批量处理相关
     QTimer *batchTimer;               // 批量定时器
-    DFMSearchResultMap batchedResults; // 批量结果
+    int batchedCount { 0 };           // 未发布的结果数量
+    bool firstBatchPublished { false };
+    QAtomicInt publishPending { 0 };  // 已投递但尚未执行的发布请求
     int batchResultLimit;             // 批量结果限制
     int batchTimeLimit;               // 批量时间限制(毫秒)
 };
 
-// 线程间安全通信的桥接类，总是在主线程中使用
-class IteratorSearcherBridge : public QObject
-{
-    Q_OBJECT
-public:
-    explicit IteratorSearcherBridge(QObject *parent = nullptr);
-    ~IteratorSearcherBridge() override;
-
-    // 设置关联的搜索器指针
-    void setSearcher(IteratorSearcher *searcher);
-    
-    // 请求创建迭代器 (在主线程调用)
-    void createIterator(const QUrl &url);
-
-signals:
-    // 迭代器创建完成信号 (发送给工作线程)
-    void iteratorCreated(QSharedPointer<DFMBASE_NAMESPACE::AbstractDirIterator> iterator);
-
-private:
-    // 使用QPointer跟踪搜索器生命周期
-    QPointer<IteratorSearcher> searcherPtr;
-};
-
 DPSEARCH_END_NAMESPACE
 
 #endif   // ITERATORSEARCHER_H
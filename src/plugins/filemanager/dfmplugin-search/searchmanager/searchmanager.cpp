@@ -53,6 +53,15 @@ DFMSearchResultMap SearchManager::matchedResults(const QString &taskId)
     return {};
 }
 
+DFMSearchResultMap SearchManager::matchedResultsSince(const QString &taskId, int &cursor)
+{
+    if (mainController)
+        return mainController->getResultsSince(taskId, cursor);
+
+    fmWarning() << "MainController not available, cannot retrieve results for taskId:" << taskId;
+    return {};
+}
+
 QList<QUrl> SearchManager::matchedResultUrls(const QString &taskId)
 {
     // Get real-time result URLs from controller
@@ -28,6 +28,9 @@ public:
     
     // 获取统一的搜索结果数据
     DFMSearchResultMap matchedResults(const QString &taskId);
+
+    // 只获取游标之后新增的结果，游标随之前移
+    DFMSearchResultMap matchedResultsSince(const QString &taskId, int &cursor);
     
     // 为向后兼容保留的接口，只获取URL列表
     QList<QUrl> matchedResultUrls(const QString &taskId);
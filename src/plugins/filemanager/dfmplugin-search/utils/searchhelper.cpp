@@ -12,6 +12,7 @@
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/hiddenlistcache.h>
 
 #include <dfm-framework/dpf.h>
 
@@ -301,46 +302,9 @@ QString SearchHelper::wildcardToRegularExpression(const QString &pattern)
     return anchoredPattern(rx);
 }
 
-bool SearchHelper::isHiddenFile(const QString &fileName, QHash<QString, QSet<QString>> &filters, const QString &searchPath)
+bool SearchHelper::isHiddenFile(const QString &fileName, const QString &searchPath)
 {
-    if (!fileName.startsWith(searchPath) || fileName == searchPath)
-        return false;
-
-    QFileInfo fileInfo(fileName);
-    if (fileInfo.isHidden())
-        return true;
-
-    const auto &fileParentPath = fileInfo.absolutePath();
-    const auto &hiddenFileConfig = fileParentPath + "/.hidden";
-
-    // 判断.hidden文件是否存在，不存在说明该路径下没有隐藏文件
-    if (!QFile::exists(hiddenFileConfig))
-        return isHiddenFile(fileParentPath, filters, searchPath);
-
-    if (filters[fileParentPath].isEmpty()) {
-        QFile file(hiddenFileConfig);
-        // 判断.hidden文件中的内容是否为空，空则表示该路径下没有隐藏文件
-        if (file.isReadable() && file.size() > 0) {
-            if (!file.open(QFile::ReadOnly))
-                return false;
-
-            QByteArray data = file.readAll();
-            file.close();
-#if (QT_VERSION <= QT_VERSION_CHECK(5, 15, 0))
-            const auto &hiddenFiles = QSet<QString>::fromList(QString(data).split('\n', QString::SkipEmptyParts));
-#else
-            auto &&list { QString(data).split('\n', Qt::SkipEmptyParts) };
-            const auto &hiddenFiles = QSet<QString>(list.begin(), list.end());
-#endif
-            filters[fileParentPath] = hiddenFiles;
-        } else {
-            return isHiddenFile(fileParentPath, filters, searchPath);
-        }
-    }
-
-    return filters[fileParentPath].contains(fileInfo.fileName())
-            ? true
-            : isHiddenFile(fileParentPath, filters, searchPath);
+    return HiddenListCache::instance().isHiddenBelow(fileName, searchPath);
 }
 
 bool SearchHelper::allowRepeatUrl(const QUrl &cur, const QUrl &pre)
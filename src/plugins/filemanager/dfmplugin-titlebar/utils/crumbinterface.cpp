@@ -4,15 +4,20 @@
 
 #include "crumbinterface.h"
 #include "utils/titlebarhelper.h"
+#include "utils/dirnameindex.h"
 
 #include <dfm-base/base/urlroute.h>
 #include <dfm-base/base/schemefactory.h>
 #include <dfm-base/dfm_global_defines.h>
 #include <dfm-base/utils/universalutils.h>
 #include <dfm-base/utils/fileutils.h>
+#include <dfm-base/utils/protocolutils.h>
 
 #include <dfm-framework/event/event.h>
 
+#include <QFutureWatcher>
+#include <QtConcurrent>
+
 using namespace dfmplugin_titlebar;
 DFMBASE_USE_NAMESPACE
 
@@ -101,6 +106,14 @@ void CrumbInterface::requestCompletionList(const QUrl &url)
         folderCompleterJobPointer->stopAndDeleteLater();
         folderCompleterJobPointer->setParent(nullptr);
     }
+    ++completionSerial;
+
+    // 本地目录只需要子目录名，不再为每个子项创建 FileInfo
+    if (url.isLocalFile() && ProtocolUtils::isLocalFile(url)) {
+        requestLocalCompletionList(url.toLocalFile());
+        return;
+    }
+
     folderCompleterJobPointer = new TraversalDirThread(url, QStringList(),
                                                        QDir::AllDirs | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::NoIteratorFlags);
     folderCompleterJobPointer->setQueryAttributes("standard::standard::name");
@@ -130,10 +143,47 @@ void CrumbInterface::requestCompletionList(const QUrl &url)
  */
 void CrumbInterface::cancelCompletionListTransmission()
 {
+    ++completionSerial;
     if (folderCompleterJobPointer)
         folderCompleterJobPointer->stop();
 }
 
+void CrumbInterface::requestLocalCompletionList(const QString &dirPath)
+{
+    const quint64 serial = completionSerial;
+    QStringList names;
+    if (DirNameIndex::instance()->cachedDirNames(dirPath, &names)) {
+        QMetaObject::invokeMethod(
+                this, [this, serial, names]() {
+                    onLocalCompletionReady(serial, names);
+                },
+                Qt::QueuedConnection);
+        return;
+    }
+
+    auto watcher = new QFutureWatcher<QStringList>(this);
+    connect(watcher, &QFutureWatcher<QStringList>::finished, this, [this, watcher, serial]() {
+        onLocalCompletionReady(serial, watcher->result());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([dirPath]() {
+        QStringList names;
+        DirNameIndex::instance()->dirNames(dirPath, &names);
+        return names;
+    }));
+}
+
+void CrumbInterface::onLocalCompletionReady(quint64 serial, const QStringList &names)
+{
+    // 已被新的请求或取消替代
+    if (serial != completionSerial)
+        return;
+
+    if (!names.isEmpty())
+        emit completionFound(names);
+    emit completionListTransmissionCompleted();
+}
+
 void CrumbInterface::onUpdateChildren(QList<QUrl> children)
 {
     QStringList list;
@@ -48,7 +48,11 @@ private slots:
     void onUpdateChildren(QList<QUrl> children);
 
 private:
+    void requestLocalCompletionList(const QString &dirPath);
+    void onLocalCompletionReady(quint64 serial, const QStringList &names);
+
     QString curScheme;
+    quint64 completionSerial { 0 };
     QPointer<DFMBASE_NAMESPACE::TraversalDirThread> folderCompleterJobPointer;
 };
 
@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dirnameindex.h"
+
+#include <dfm-base/utils/mtimeutils.h>
+
+#include <QFile>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include <algorithm>
+
+using namespace dfmplugin_titlebar;
+DFMBASE_USE_NAMESPACE
+
+namespace {
+
+// glibc only wraps getdents64 since 2.30
+struct LinuxDirent64
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+
+constexpr int kDirentBufferSize { 64 * 1024 };
+// parents the user completed lately, typing rarely goes back further
+constexpr int kMaxEntries { 8 };
+
+inline qint64 mtimeNs(const struct stat &st)
+{
+    return qint64(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+}
+
+inline QString normalizedPath(const QString &dirPath)
+{
+    QString path = dirPath;
+    while (path.size() > 1 && path.endsWith('/'))
+        path.chop(1);
+    return path;
+}
+
+}   // namespace
+
+DirNameIndex *DirNameIndex::instance()
+{
+    static DirNameIndex index;
+    return &index;
+}
+
+/*!
+ * \brief DirNameIndex::cachedDirNames Get the names of a directory already read, without reading it
+ * \return false if the directory is not cached or changed since it was read
+ */
+bool DirNameIndex::cachedDirNames(const QString &dirPath, QStringList *names)
+{
+    QMutexLocker locker(&mutex);
+    const Entry *entry = freshEntry(normalizedPath(dirPath));
+    if (!entry)
+        return false;
+
+    *names = entry->names;
+    return true;
+}
+
+/*!
+ * \brief DirNameIndex::dirNames Get the sorted subdirectory names of dirPath, reading it if not cached
+ * \return false if the directory can not be read
+ */
+bool DirNameIndex::dirNames(const QString &dirPath, QStringList *names)
+{
+    const QString path = normalizedPath(dirPath);
+    if (cachedDirNames(path, names))
+        return true;
+
+    // read without the lock, lookups of other directories are not held up by a large one
+    Entry entry;
+    entry.dirPath = path;
+    if (!readDirNames(path, &entry))
+        return false;
+    *names = entry.names;
+
+    QMutexLocker locker(&mutex);
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&path](const Entry &e) { return e.dirPath == path; }),
+                  entries.end());
+    entries.prepend(entry);
+    while (entries.size() > kMaxEntries)
+        entries.removeLast();
+    return true;
+}
+
+/*!
+ * \brief DirNameIndex::complete Get the subdirectory names of dirPath starting with prefix, in order
+ */
+QStringList DirNameIndex::complete(const QString &dirPath, const QString &prefix)
+{
+    QStringList names;
+    if (!dirNames(dirPath, &names))
+        return {};
+
+    QStringList result;
+    for (auto it = std::lower_bound(names.cbegin(), names.cend(), prefix);
+         it != names.cend() && it->startsWith(prefix); ++it)
+        result.append(*it);
+    return result;
+}
+
+void DirNameIndex::clear()
+{
+    QMutexLocker locker(&mutex);
+    entries.clear();
+}
+
+bool DirNameIndex::readDirNames(const QString &dirPath, Entry *dirEntry)
+{
+    int fd = open(QFile::encodeName(dirPath).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    // the mtime is taken before reading, a change during the read makes the entry stale
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    dirEntry->mtimeNs = mtimeNs(st);
+    dirEntry->racy = MtimeUtils::isRacy(dirEntry->mtimeNs);
+
+    QStringList *names = &dirEntry->names;
+    names->clear();
+    bool ok = true;
+    QByteArray buffer(kDirentBufferSize, Qt::Uninitialized);
+    forever {
+        long size = syscall(SYS_getdents64, fd, buffer.data(), buffer.size());
+        if (size == 0)
+            break;
+        if (size < 0) {
+            if (errno == EINTR)
+                continue;
+            ok = false;
+            break;
+        }
+
+        for (long pos = 0; pos < size;) {
+            auto entry = reinterpret_cast<const LinuxDirent64 *>(buffer.constData() + pos);
+            pos += entry->d_reclen;
+            const char *name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+                continue;
+
+            bool isDir = entry->d_type == DT_DIR;
+            // links to directories are completed as QDir::AllDirs did
+            if (entry->d_type == DT_LNK || entry->d_type == DT_UNKNOWN) {
+                struct stat entrySt;
+                isDir = fstatat(fd, name, &entrySt, 0) == 0 && S_ISDIR(entrySt.st_mode);
+            }
+            if (isDir)
+                names->append(QFile::decodeName(name));
+        }
+    }
+    close(fd);
+
+    if (!ok)
+        return false;
+
+    std::sort(names->begin(), names->end());
+    return true;
+}
+
+const DirNameIndex::Entry *DirNameIndex::freshEntry(const QString &dirPath)
+{
+    for (int i = 0; i < entries.size(); ++i) {
+        if (entries.at(i).dirPath != dirPath)
+            continue;
+
+        struct stat st;
+        if (stat(QFile::encodeName(dirPath).constData(), &st) != 0 || mtimeNs(st) != entries.at(i).mtimeNs) {
+            entries.removeAt(i);
+            return nullptr;
+        }
+        // an unchanged mtime only proves the listing once it is out of the racy window
+        if (entries.at(i).racy) {
+            if (MtimeUtils::isRacy(entries.at(i).mtimeNs)) {
+                entries.removeAt(i);
+                return nullptr;
+            }
+            entries[i].racy = false;
+        }
+        if (i > 0)
+            entries.move(i, 0);
+        return &entries.first();
+    }
+    return nullptr;
+}
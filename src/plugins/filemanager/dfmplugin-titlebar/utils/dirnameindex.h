@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DIRNAMEINDEX_H
+#define DIRNAMEINDEX_H
+
+#include "dfmplugin_titlebar_global.h"
+
+#include <QMutex>
+#include <QStringList>
+#include <QList>
+
+namespace dfmplugin_titlebar {
+
+/*!
+ * \brief DirNameIndex keeps the subdirectory names of recently completed local directories.
+ *
+ * A directory is read with getdents64 only, no file info is built. Its names are
+ * kept sorted so a prefix is found by binary search. Every lookup compares the
+ * directory mtime with the one seen at read time and drops the entry if it changed.
+ * A directory modified in the last seconds before it was read is read again until
+ * its mtime is old enough to reveal any later change.
+ */
+class DirNameIndex
+{
+    Q_DISABLE_COPY(DirNameIndex)
+
+public:
+    static DirNameIndex *instance();
+
+    bool cachedDirNames(const QString &dirPath, QStringList *names);
+    bool dirNames(const QString &dirPath, QStringList *names);
+    QStringList complete(const QString &dirPath, const QString &prefix);
+    void clear();
+
+private:
+    struct Entry
+    {
+        QString dirPath;
+        qint64 mtimeNs { -1 };
+        bool racy { false };   // modified too recently for its mtime to tell later changes apart
+        QStringList names;   // sorted
+    };
+
+    DirNameIndex() = default;
+    static bool readDirNames(const QString &dirPath, Entry *entry);
+    const Entry *freshEntry(const QString &dirPath);
+
+    QMutex mutex;
+    QList<Entry> entries;   // most recently used first
+};
+
+}
+
+#endif   // DIRNAMEINDEX_H
@@ -11,7 +11,6 @@
 #include <dfm-base/file/local/asyncfileinfo.h>
 
 #include <dfm-io/denumerator.h>
-#include <dfm-io/dfmio_utils.h>
 
 #include <QSharedPointer>
 
@@ -31,8 +30,7 @@ VaultFileIterator::VaultFileIterator(const QUrl &url, const QStringList &nameFil
     if (!dfmioDirIterator)
         fmCritical("Vault: create DEnumerator failed!");
 
-    const QUrl &hidUrl = DFMIO::DFMUtils::buildFilePath(localUrl.toString().toStdString().c_str(), ".hidden", nullptr);
-    hideFileList = DFMIO::DFMUtils::hideListFromUrl(hidUrl);
+    hideFileList = HiddenListCache::instance().hiddenNames(localUrl.path());
 }
 
 VaultFileIterator::~VaultFileIterator()
@@ -75,7 +73,7 @@ const FileInfoPointer VaultFileIterator::fileInfo() const
     if (fileName.startsWith(".")) {
         isHidden = true;
     } else {
-        isHidden = hideFileList.contains(fileName);
+        isHidden = hideFileList && hideFileList->contains(fileName);
     }
 
     QSharedPointer<FileInfo> info = QSharedPointer<AsyncFileInfo>(new AsyncFileInfo(url, fileinfo));
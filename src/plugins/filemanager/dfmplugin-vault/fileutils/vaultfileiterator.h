@@ -7,6 +7,7 @@
 
 #include "dfmplugin_vault_global.h"
 #include <dfm-base/file/local/localdiriterator.h>
+#include <dfm-base/utils/hiddenlistcache.h>
 
 namespace dfmplugin_vault {
 class VaultFileIterator : public DFMBASE_NAMESPACE::AbstractDirIterator
@@ -39,7 +40,7 @@ public:
 private:
     QSharedPointer<dfmio::DEnumerator> dfmioDirIterator { Q_NULLPTR };
     QUrl currentUrl;
-    QSet<QString> hideFileList;
+    DFMBASE_NAMESPACE::HiddenListCache::HiddenNames hideFileList;
 };
 }
 #endif   // VAULTFILEDIRITERATOR_H
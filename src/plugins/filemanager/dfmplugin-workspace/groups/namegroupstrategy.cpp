@@ -155,18 +155,11 @@ bool NameGroupStrategy::isChinese(const QChar &ch) const
 
 QString NameGroupStrategy::getPinyin(const QChar &ch) const
 {
-    // Use the existing Pinyin::Chinese2Pinyin function
-    QString singleChar = QString(ch);
-    QString pinyinResult = Pinyin::Chinese2Pinyin(singleChar);
-
-    if (!pinyinResult.isEmpty()) {
-        // The function returns a space-separated string, take the first word
-        QStringList pinyinWords = pinyinResult.split(' ', Qt::SkipEmptyParts);
-        if (!pinyinWords.isEmpty() && !pinyinWords.first().isEmpty()) {
-            return pinyinWords.first();
-        }
-    }
+    const QLatin1String &pinyin = Pinyin::CharPinyin(ch);
+    if (pinyin.size() > 0)
+        return pinyin;
 
-    fmDebug() << "NameGroupStrategy: Failed to convert Chinese character to pinyin:" << ch;
-    return QString();   // Conversion failed
+    // like Chinese2Pinyin, a character missing from the table is kept as it is
+    fmDebug() << "NameGroupStrategy: No pinyin for character, keeping it:" << ch;
+    return QString(ch);
 }
@@ -16,8 +16,8 @@
 #include <dfm-base/mimetype/mimetypedisplaymanager.h>
 #include <dfm-base/utils/sortutils.h>
 #include <dfm-base/utils/protocolutils.h>
+#include <dfm-base/utils/hiddenlistcache.h>
 
-#include <dfm-io/dfmio_utils.h>
 
 #include <QStandardPaths>
 
@@ -27,6 +27,54 @@ using namespace dfmplugin_workspace;
 using namespace dfmbase::Global;
 using namespace dfmio;
 
+void VisibleRowIndex::reset(const QList<QUrl> &urls)
+{
+    rows.clear();
+    rows.reserve(urls.count());
+    // 倒序插入，重复的 url 保留第一次出现的位置
+    for (int i = urls.count() - 1; i >= 0; --i)
+        rows.insert(urls.at(i), i);
+}
+
+void VisibleRowIndex::inserted(const QList<QUrl> &urls, int row)
+{
+    // 其后的行号加一，只修改指向该位置的记录；倒序遍历，相邻的重复 url 不会被加两次
+    for (int i = urls.count() - 1; i > row; --i) {
+        auto it = rows.find(urls.at(i));
+        if (it != rows.end() && it.value() == i - 1)
+            it.value() = i;
+    }
+
+    const QUrl &url = urls.at(row);
+    auto it = rows.find(url);
+    if (it == rows.end())
+        rows.insert(url, row);
+    else if (it.value() > row)
+        it.value() = row;
+}
+
+void VisibleRowIndex::removed(const QList<QUrl> &urls, int row, const QUrl &url)
+{
+    const bool wasFirst = rows.value(url, -1) == row;
+    bool found = false;
+    // 其后的行号减一；被删除的 url 如有重复，改为指向下一次出现的位置
+    for (int i = row; i < urls.count(); ++i) {
+        const QUrl &cur = urls.at(i);
+        auto it = rows.find(cur);
+        if (it == rows.end())
+            continue;
+        if (it.value() == i + 1) {
+            it.value() = i;
+        } else if (wasFirst && !found && cur == url) {
+            it.value() = i;
+            found = true;
+        }
+    }
+
+    if (wasFirst && !found)
+        rows.remove(url);
+}
+
 namespace {
 template<class T>
 void insertToList(QList<T> &list, int index, const T &t)
@@ -219,15 +267,12 @@ FileItemDataPointer FileSortWorker::childData(const int index)
 {
     if (!isCurrentGroupingEnabled) {
         // Traditional mode: use original logic
-        QUrl url;
-        {
-            QReadLocker lk(&locker);
-            if (index < 0 || index >= visibleChildren.count()) {
-                fmDebug() << "Invalid index for childData:" << index << "visible children count:" << visibleChildren.count();
-                return nullptr;
-            }
-            url = visibleChildren.at(index);
+        const auto snapshot = visibleChildrenSnapshot();
+        if (index < 0 || index >= snapshot->urls.count()) {
+            fmDebug() << "Invalid index for childData:" << index << "visible children count:" << snapshot->urls.count();
+            return nullptr;
         }
+        const QUrl &url = snapshot->urls.at(index);
 
         QReadLocker lk(&childrenDataLocker);
         return childrenDataMap.value(url);
@@ -265,9 +310,9 @@ int FileSortWorker::getChildShowIndex(const QUrl &url)
 
 QList<QUrl> FileSortWorker::getChildrenUrls()
 {
-    QReadLocker lk(&locker);
-    fmDebug() << "Getting children URLs, count:" << visibleChildren.size();
-    return visibleChildren;
+    const auto snapshot = visibleChildrenSnapshot();
+    fmDebug() << "Getting children URLs, count:" << snapshot->urls.size();
+    return snapshot->urls;
 }
 
 ItemRoles FileSortWorker::getSortRole() const
@@ -383,6 +428,7 @@ void FileSortWorker::handleTraversalFinish(const QString &key, bool noDataProduc
 
         QWriteLocker visLock(&locker);
         visibleChildren.clear();
+        publishVisibleChildren();
 
         children.clear();
     }
@@ -543,15 +589,15 @@ void FileSortWorker::handleWatcherRemoveChildren(const QList<SortInfoPointer> &c
         int showIndex = -1;
         {
             QReadLocker lk(&locker);
-            if (!visibleChildren.contains(sortInfo->fileUrl()))
+            showIndex = getChildShowIndexInternal(sortInfo->fileUrl());
+            if (showIndex < 0)
                 continue;
-            showIndex = visibleChildren.indexOf(sortInfo->fileUrl());
         }
 
         doModelChanged(ModelChangeType::kRemoveRows, showIndex, 1);
         {
             QWriteLocker lk(&locker);
-            visibleChildren.removeAt(showIndex);
+            removeVisibleChild(showIndex);
         }
         doModelChanged(ModelChangeType::kRemoveFinished);
     }
@@ -604,7 +650,10 @@ void FileSortWorker::handleWatcherUpdateHideFile(const QUrl &hidUrl)
     auto hiddenFileInfo = InfoFactory::create<FileInfo>(hidUrl);
     if (!hiddenFileInfo)
         return;
-    auto hidlist = DFMUtils::hideListFromUrl(QUrl::fromLocalFile(hiddenFileInfo->pathOf(PathInfoType::kFilePath)));
+    // .hidden 刚刚变化，丢弃缓存的内容后重新读取
+    const QString &hiddenDirPath = hiddenFileInfo->pathOf(PathInfoType::kAbsolutePath);
+    HiddenListCache::instance().invalidate(hiddenDirPath);
+    const auto &hidlist = HiddenListCache::instance().hiddenNames(hiddenDirPath);
     auto parentUrl = makeParentUrl(hidUrl);
     for (const auto &child : children.value(parentUrl)) {
         if (isCanceled)
@@ -616,7 +665,7 @@ void FileSortWorker::handleWatcherUpdateHideFile(const QUrl &hidUrl)
         if (fileName.startsWith(".")) {
             child->setHide(true);
         } else {
-            child->setHide(hidlist.contains(fileName));
+            child->setHide(hidlist->contains(fileName));
         }
         auto info = item->fileInfo();
         if (!info)
@@ -862,8 +911,8 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
     int childIndex = -1;
     {
         QReadLocker lk(&locker);
-        childVisible = visibleChildren.contains(url);
-        childIndex = visibleChildren.indexOf(url);
+        childIndex = getChildShowIndexInternal(url);
+        childVisible = childIndex >= 0;
     }
 
     if (childVisible) {
@@ -871,7 +920,7 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
             doModelChanged(ModelChangeType::kRemoveRows, childIndex, 1);
             {
                 QWriteLocker lk(&locker);
-                visibleChildren.removeAt(childIndex);
+                removeVisibleChild(childIndex);
             }
             doModelChanged(ModelChangeType::kRemoveFinished);
             return false;
@@ -923,7 +972,7 @@ bool FileSortWorker::handleUpdateFile(const QUrl &url)
         doModelChanged(ModelChangeType::kInsertRows, showIndex, 1);
         {
             QWriteLocker lk(&locker);
-            insertToList(visibleChildren, showIndex, sortInfo->fileUrl());
+            insertVisibleChild(showIndex, sortInfo->fileUrl());
         }
         doModelChanged(ModelChangeType::kInsertFinished);
         added = true;
@@ -955,6 +1004,7 @@ void FileSortWorker::handleRefresh()
     {
         QWriteLocker lk(&locker);
         visibleChildren.clear();
+        publishVisibleChildren();
     }
     children.clear();
     visibleTreeChildren.clear();
@@ -1198,6 +1248,7 @@ bool FileSortWorker::handleAddChildren(const QString &key,
 
         QWriteLocker vlk(&locker);
         visibleChildren.clear();
+        publishVisibleChildren();
 
         this->children.clear();
     }
@@ -1406,6 +1457,7 @@ void FileSortWorker::filterTreeDirFiles(const QUrl &parent, const bool byInfo)
             {
                 QWriteLocker lk(&locker);
                 visibleChildren.clear();
+                publishVisibleChildren();
             }
             doModelChanged(ModelChangeType::kRemoveFinished);
         }
@@ -1487,7 +1539,7 @@ bool FileSortWorker::addChild(const SortInfoPointer &sortInfo,
     doModelChanged(ModelChangeType::kInsertRows, showIndex, 1);
     {
         QWriteLocker lk(&locker);
-        insertToList(visibleChildren, showIndex, sortInfo->fileUrl());
+        insertVisibleChild(showIndex, sortInfo->fileUrl());
     }
     doModelChanged(ModelChangeType::kInsertFinished);
 
@@ -1807,6 +1859,7 @@ void FileSortWorker::removeVisibleChildren(const int startPos, const int size)
 
         QWriteLocker lk(&locker);
         visibleChildren = visibleList;
+        publishVisibleChildren();
     }
 
     doModelChanged(ModelChangeType::kRemoveFinished, 0, 0);
@@ -2199,8 +2252,7 @@ int FileSortWorker::findRealShowIndex(const QUrl &preItemUrl)
 
 int FileSortWorker::indexOfVisibleChild(const QUrl &itemUrl)
 {
-    QReadLocker lk(&locker);
-    return visibleChildren.indexOf(itemUrl);
+    return getChildShowIndexInternal(itemUrl);
 }
 
 int FileSortWorker::setVisibleChildren(const int startPos, const QList<QUrl> &filterUrls, const FileSortWorker::InsertOpt opt, const int endPos)
@@ -2224,6 +2276,7 @@ int FileSortWorker::setVisibleChildren(const int startPos, const QList<QUrl> &fi
 
     QWriteLocker lk(&locker);
     visibleChildren = visibleList;
+    publishVisibleChildren();
 
     return visibleList.length();
 }
@@ -2383,14 +2436,56 @@ void FileSortWorker::clearGroupedData()
 
 int FileSortWorker::childrenCountInternal()
 {
-    QReadLocker lk(&locker);
-    return visibleChildren.count();
+    return visibleChildrenSnapshot()->urls.count();
 }
 
 int FileSortWorker::getChildShowIndexInternal(const QUrl &url)
 {
-    QReadLocker lk(&locker);
-    return visibleChildren.indexOf(url);
+    QMutexLocker lk(&snapshotMutex);
+    return visibleRows.indexOf(url);
+}
+
+VisibleChildrenSnapshotPointer FileSortWorker::visibleChildrenSnapshot() const
+{
+    QMutexLocker lk(&snapshotMutex);
+    return visibleSnapshot;
+}
+
+void FileSortWorker::publishVisibleChildren()
+{
+    // 调用方持有 locker 写锁，快照只共享 visibleChildren 的数据，不做深拷贝
+    VisibleChildrenSnapshotPointer snapshot(new VisibleChildrenSnapshot(++snapshotVersion, visibleChildren));
+    VisibleRowIndex rows;
+    rows.reset(visibleChildren);
+    QMutexLocker lk(&snapshotMutex);
+    visibleSnapshot.swap(snapshot);
+    visibleRows.swap(rows);
+}
+
+void FileSortWorker::insertVisibleChild(int index, const QUrl &url)
+{
+    // 调用方持有 locker 写锁
+    if (index < 0 || index > visibleChildren.size())
+        index = visibleChildren.size();
+    visibleChildren.insert(index, url);
+
+    VisibleChildrenSnapshotPointer snapshot(new VisibleChildrenSnapshot(++snapshotVersion, visibleChildren));
+    QMutexLocker lk(&snapshotMutex);
+    visibleSnapshot.swap(snapshot);
+    visibleRows.inserted(visibleChildren, index);
+}
+
+void FileSortWorker::removeVisibleChild(int index)
+{
+    // 调用方持有 locker 写锁
+    if (index < 0 || index >= visibleChildren.size())
+        return;
+    const QUrl url = visibleChildren.takeAt(index);
+
+    VisibleChildrenSnapshotPointer snapshot(new VisibleChildrenSnapshot(++snapshotVersion, visibleChildren));
+    QMutexLocker lk(&snapshotMutex);
+    visibleSnapshot.swap(snapshot);
+    visibleRows.removed(visibleChildren, index, url);
 }
 
 void FileSortWorker::doModelChanged(const ModelChangeType type, int index, int count)
@@ -22,9 +22,41 @@
 #include <QDirIterator>
 #include <QReadWriteLock>
 #include <QMultiMap>
+#include <QMutex>
 
 using namespace dfmbase;
 namespace dfmplugin_workspace {
+
+// 可见文件列表的只读快照，排序线程每次修改后整体替换，
+// GUI 线程读取时只复制指针，不会被排序、过滤阻塞
+class VisibleChildrenSnapshot
+{
+public:
+    explicit VisibleChildrenSnapshot(quint64 ver = 0, const QList<QUrl> &list = {})
+        : version(ver), urls(list) { }
+
+    const quint64 version;
+    const QList<QUrl> urls;
+};
+using VisibleChildrenSnapshotPointer = QSharedPointer<const VisibleChildrenSnapshot>;
+
+// 可见文件的行号索引，重复的 url 记录第一次出现的位置，与 QList::indexOf 一致；
+// 单行插入/删除时只修正其后的行号，不重建哈希表
+class VisibleRowIndex
+{
+public:
+    void reset(const QList<QUrl> &urls);
+    // urls 为插入后的列表
+    void inserted(const QList<QUrl> &urls, int row);
+    // urls 为删除后的列表，url 原来位于 row
+    void removed(const QList<QUrl> &urls, int row, const QUrl &url);
+    int indexOf(const QUrl &url) const { return rows.value(url, -1); }
+    void swap(VisibleRowIndex &other) { rows.swap(other.rows); }
+
+private:
+    QHash<QUrl, int> rows;
+};
+
 class FileSortWorker : public QObject
 {
     Q_OBJECT
@@ -273,6 +305,10 @@ private:
 
     int childrenCountInternal();
     int getChildShowIndexInternal(const QUrl &url);
+    VisibleChildrenSnapshotPointer visibleChildrenSnapshot() const;
+    void publishVisibleChildren();
+    void insertVisibleChild(int index, const QUrl &url);
+    void removeVisibleChild(int index);
     void doModelChanged(const ModelChangeType type, int index = 0, int count = 0);
 
 private:
@@ -284,6 +320,12 @@ private:
     QHash<QUrl, FileItemDataPointer> childrenDataMap {};
     QList<QUrl> visibleChildren {};
     mutable QReadWriteLock locker;
+    // 修改 visibleChildren 后需在 locker 写锁内调用 publishVisibleChildren，
+    // 单行修改使用 insertVisibleChild/removeVisibleChild
+    VisibleChildrenSnapshotPointer visibleSnapshot { new VisibleChildrenSnapshot };
+    VisibleRowIndex visibleRows;   // 与 visibleSnapshot 一起更新，由 snapshotMutex 保护
+    mutable QMutex snapshotMutex;
+    quint64 snapshotVersion { 0 };
     FileViewFilterCallback filterCallback { nullptr };
     QVariant filterData;
     FileItemDataPointer rootdata { nullptr };
@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "fanotifywatcher.h"
+
+#include <QSocketNotifier>
+
+#include <fcntl.h>
+#include <sys/fanotify.h>
+#include <sys/statfs.h>
+#include <unistd.h>
+#include <climits>
+#include <cerrno>
+#include <cstring>
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+namespace {
+
+#ifdef FAN_REPORT_DFID_NAME
+#    ifdef FAN_RENAME
+// FAN_RENAME (5.17+) reports both ends of a move in one event
+constexpr uint64_t kMoveMask = FAN_RENAME;
+#    else
+constexpr uint64_t kMoveMask = FAN_MOVED_FROM | FAN_MOVED_TO;
+#    endif
+// FAN_CLOSE_WRITE instead of FAN_MODIFY, the indexer only needs the final content
+constexpr uint64_t kEventMask = FAN_CREATE | FAN_DELETE | FAN_CLOSE_WRITE | kMoveMask | FAN_ONDIR;
+#endif
+
+quint64 fsidKey(int val0, int val1)
+{
+    return (quint64(quint32(val0)) << 32) | quint32(val1);
+}
+
+}   // namespace
+
+FanotifyWatcher::FanotifyWatcher(QObject *parent)
+    : QObject(parent)
+{
+}
+
+FanotifyWatcher::~FanotifyWatcher()
+{
+    stop();
+}
+
+bool FanotifyWatcher::init()
+{
+#ifdef FAN_REPORT_DFID_NAME
+    if (fanotifyFd >= 0)
+        return true;
+
+    fanotifyFd = fanotify_init(FAN_CLASS_NOTIF | FAN_CLOEXEC | FAN_NONBLOCK | FAN_REPORT_DFID_NAME,
+                               O_RDONLY | O_CLOEXEC);
+    if (fanotifyFd < 0) {
+        fmInfo() << "FanotifyWatcher: fanotify is not available:" << strerror(errno);
+        return false;
+    }
+
+    notifier = new QSocketNotifier(fanotifyFd, QSocketNotifier::Read, this);
+    connect(notifier, &QSocketNotifier::activated, this, &FanotifyWatcher::readEvents);
+    return true;
+#else
+    fmInfo() << "FanotifyWatcher: built without FAN_REPORT_DFID_NAME support";
+    return false;
+#endif
+}
+
+bool FanotifyWatcher::addFilesystem(const QString &path)
+{
+#ifdef FAN_REPORT_DFID_NAME
+    if (fanotifyFd < 0 || path.isEmpty())
+        return false;
+
+    const QByteArray localPath = path.toLocal8Bit();
+    struct statfs fsInfo;
+    if (statfs(localPath.constData(), &fsInfo) != 0) {
+        fmWarning() << "FanotifyWatcher: statfs failed for" << path << strerror(errno);
+        return false;
+    }
+
+    // fanotify reports the same fsid as statfs
+    const quint64 key = fsidKey(fsInfo.f_fsid.__val[0], fsInfo.f_fsid.__val[1]);
+    if (mountFds.contains(key))
+        return true;
+
+    int dirFd = open(localPath.constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+        fmWarning() << "FanotifyWatcher: Failed to open" << path << strerror(errno);
+        return false;
+    }
+
+    if (fanotify_mark(fanotifyFd, FAN_MARK_ADD | FAN_MARK_FILESYSTEM, kEventMask, AT_FDCWD, localPath.constData()) != 0) {
+        fmWarning() << "FanotifyWatcher: Failed to mark filesystem of" << path << strerror(errno);
+        close(dirFd);
+        return false;
+    }
+
+    mountFds.insert(key, dirFd);
+    fmInfo() << "FanotifyWatcher: Watching the filesystem of" << path;
+    return true;
+#else
+    Q_UNUSED(path)
+    return false;
+#endif
+}
+
+void FanotifyWatcher::stop()
+{
+    if (notifier) {
+        notifier->setEnabled(false);
+        delete notifier;
+        notifier = nullptr;
+    }
+
+    // closing the group removes its marks
+    if (fanotifyFd >= 0) {
+        close(fanotifyFd);
+        fanotifyFd = -1;
+    }
+
+    for (int fd : std::as_const(mountFds))
+        close(fd);
+    mountFds.clear();
+}
+
+QString FanotifyWatcher::resolveDirectory(const void *fid) const
+{
+#ifdef FAN_REPORT_DFID_NAME
+    auto info = static_cast<const fanotify_event_info_fid *>(fid);
+    const int mountFd = mountFds.value(fsidKey(info->fsid.val[0], info->fsid.val[1]), -1);
+    if (mountFd < 0)
+        return {};
+
+    auto handle = reinterpret_cast<file_handle *>(const_cast<unsigned char *>(info->handle));
+    int dirFd = open_by_handle_at(mountFd, handle, O_PATH | O_CLOEXEC);
+    if (dirFd < 0) {
+        // ESTALE: the directory is already gone
+        if (errno != ESTALE)
+            fmDebug() << "FanotifyWatcher: open_by_handle_at failed:" << strerror(errno);
+        return {};
+    }
+
+    char target[PATH_MAX];
+    const QByteArray procPath = "/proc/self/fd/" + QByteArray::number(dirFd);
+    ssize_t len = readlink(procPath.constData(), target, sizeof(target));
+    close(dirFd);
+    if (len <= 0 || len >= static_cast<ssize_t>(sizeof(target)))
+        return {};
+
+    return QString::fromLocal8Bit(target, static_cast<int>(len));
+#else
+    Q_UNUSED(fid)
+    return {};
+#endif
+}
+
+void FanotifyWatcher::readEvents()
+{
+#ifdef FAN_REPORT_DFID_NAME
+    alignas(fanotify_event_metadata) char buffer[16384];
+
+    forever {
+        ssize_t len = read(fanotifyFd, buffer, sizeof(buffer));
+        if (len <= 0) {
+            if (len < 0 && errno != EAGAIN && errno != EINTR)
+                fmWarning() << "FanotifyWatcher: read failed:" << strerror(errno);
+            return;
+        }
+
+        auto meta = reinterpret_cast<fanotify_event_metadata *>(buffer);
+        for (; FAN_EVENT_OK(meta, len); meta = FAN_EVENT_NEXT(meta, len)) {
+            if (meta->vers != FANOTIFY_METADATA_VERSION) {
+                fmWarning() << "FanotifyWatcher: Unexpected fanotify metadata version" << meta->vers;
+                return;
+            }
+
+            if (meta->fd >= 0)
+                close(meta->fd);
+
+            if (meta->mask & FAN_Q_OVERFLOW) {
+                Q_EMIT overflowed();
+                continue;
+            }
+
+            // Every record is the parent directory handle followed by the entry name,
+            // FAN_RENAME carries one record for each end of the move
+            QString dirPath, name, oldDirPath, oldName, newDirPath, newName;
+            const char *record = reinterpret_cast<const char *>(meta) + meta->metadata_len;
+            const char *end = reinterpret_cast<const char *>(meta) + meta->event_len;
+            while (record + sizeof(fanotify_event_info_header) <= end) {
+                auto header = reinterpret_cast<const fanotify_event_info_header *>(record);
+                if (header->len == 0 || record + header->len > end)
+                    break;
+
+                auto fid = reinterpret_cast<const fanotify_event_info_fid *>(record);
+                auto handle = reinterpret_cast<const file_handle *>(fid->handle);
+                const char *entryName = reinterpret_cast<const char *>(handle->f_handle) + handle->handle_bytes;
+
+                switch (header->info_type) {
+                case FAN_EVENT_INFO_TYPE_DFID_NAME:
+                    dirPath = resolveDirectory(fid);
+                    name = QString::fromLocal8Bit(entryName);
+                    break;
+#    ifdef FAN_RENAME
+                case FAN_EVENT_INFO_TYPE_OLD_DFID_NAME:
+                    oldDirPath = resolveDirectory(fid);
+                    oldName = QString::fromLocal8Bit(entryName);
+                    break;
+                case FAN_EVENT_INFO_TYPE_NEW_DFID_NAME:
+                    newDirPath = resolveDirectory(fid);
+                    newName = QString::fromLocal8Bit(entryName);
+                    break;
+#    endif
+                default:
+                    break;
+                }
+
+                record += header->len;
+            }
+
+            const bool isDir = meta->mask & FAN_ONDIR;
+
+#    ifdef FAN_RENAME
+            if ((meta->mask & FAN_RENAME) && (!oldDirPath.isEmpty() || !newDirPath.isEmpty())) {
+                // an end that could not be resolved is reported as outside the watched tree
+                Q_EMIT moved(oldDirPath, oldDirPath.isEmpty() ? QString() : oldName,
+                             newDirPath, newDirPath.isEmpty() ? QString() : newName, isDir);
+            }
+#    endif
+
+            if (dirPath.isEmpty() || name.isEmpty() || name == ".")
+                continue;
+
+            // merged events keep the order create -> write -> delete
+            if (meta->mask & FAN_CREATE)
+                Q_EMIT created(dirPath, name, isDir);
+            if (meta->mask & FAN_MOVED_TO)
+                Q_EMIT moved({}, {}, dirPath, name, isDir);
+            if ((meta->mask & FAN_CLOSE_WRITE) && !isDir)
+                Q_EMIT modified(dirPath, name);
+            if (meta->mask & FAN_MOVED_FROM)
+                Q_EMIT moved(dirPath, name, {}, {}, isDir);
+            if (meta->mask & FAN_DELETE)
+                Q_EMIT deleted(dirPath, name, isDir);
+        }
+    }
+#endif
+}
+
+SERVICETEXTINDEX_END_NAMESPACE
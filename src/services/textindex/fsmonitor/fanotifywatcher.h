@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2025 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FANOTIFYWATCHER_H
+#define FANOTIFYWATCHER_H
+
+#include "service_textindex_global.h"
+
+#include <QObject>
+#include <QHash>
+#include <QStringList>
+
+class QSocketNotifier;
+
+SERVICETEXTINDEX_BEGIN_NAMESPACE
+
+// FanotifyWatcher: whole-filesystem change notification based on fanotify
+//
+// One FAN_MARK_FILESYSTEM mark with FAN_REPORT_DFID_NAME covers every directory
+// of a filesystem, so no directory crawl and no per-directory watch is needed.
+// Events report the parent directory handle plus the entry name, the handle is
+// resolved back to a path with open_by_handle_at().
+//
+// Requires Linux 5.9+ and CAP_SYS_ADMIN / CAP_DAC_READ_SEARCH, callers should
+// fall back to inotify when init() or addFilesystem() fails.
+class FanotifyWatcher : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(FanotifyWatcher)
+
+public:
+    explicit FanotifyWatcher(QObject *parent = nullptr);
+    ~FanotifyWatcher() override;
+
+    // Create the fanotify group, false if the kernel or privileges don't allow it
+    bool init();
+
+    // Mark the whole filesystem containing path, a filesystem is only marked once
+    bool addFilesystem(const QString &path);
+
+    // Remove all marks and close the group
+    void stop();
+
+    // Number of marked filesystems
+    int markCount() const { return mountFds.size(); }
+
+Q_SIGNALS:
+    void created(const QString &path, const QString &name, bool isDir);
+    void deleted(const QString &path, const QString &name, bool isDir);
+    void modified(const QString &path, const QString &name);
+    void moved(const QString &fromPath, const QString &fromName,
+               const QString &toPath, const QString &toName, bool isDir);
+
+    // Emitted when the kernel queue overflowed and events were dropped
+    void overflowed();
+
+private:
+    void readEvents();
+    QString resolveDirectory(const void *fid) const;
+
+    int fanotifyFd { -1 };
+    QSocketNotifier *notifier { nullptr };
+
+    // fsid -> an open directory on that filesystem, used by open_by_handle_at
+    QHash<quint64, int> mountFds;
+};
+
+SERVICETEXTINDEX_END_NAMESPACE
+
+#endif   // FANOTIFYWATCHER_H
@@ -114,6 +114,7 @@ bool FSEventCollectorPrivate::startCollecting()
     deletedFilesList.clear();
     modifiedFilesList.clear();
     movedFilesList.clear();
+    directoryPaths.clear();
 
     // Start the FSMonitor
     if (!fsMonitor.start()) {
@@ -152,6 +153,7 @@ void FSEventCollectorPrivate::stopCollecting()
     deletedFilesList.clear();
     modifiedFilesList.clear();
     movedFilesList.clear();
+    directoryPaths.clear();
 
     fmInfo() << "FSEventCollector: Stopped event collection";
 }
@@ -166,7 +168,7 @@ bool FSEventCollectorPrivate::shouldIndexFile(const QString &path) const
         return true;
 
     // Always track directories regardless of extension
-    if (isDirectory(path))
+    if (directoryPaths.contains(path) || isDirectory(path))
         return true;
 
     // Get file suffix for extension check
@@ -205,16 +207,12 @@ void FSEventCollectorPrivate::handleFileCreated(const QString &path, const QStri
         }
     } else {
         // Check if this file is under a directory that's already in the created list
+        // Entries created before their parent directory are pruned when flushing
         if (!isChildOfAnyPath(fullPath, createdFilesList)) {
             // Only insert if file has supported extension or is a directory
             if (shouldIndexFile(fullPath)) {
                 createdFilesList.insert(fullPath);
                 fmDebug() << "FSEventCollector: Added to created list:" << fullPath;
-
-                // If this is a directory, remove any files in the list that are under this directory
-                if (isDirectory(fullPath)) {
-                    removeRedundantEntries(createdFilesList);
-                }
             }
         }
     }
@@ -373,17 +371,24 @@ void FSEventCollectorPrivate::handleFileMoved(const QString &fromPath, const QSt
 
 void FSEventCollectorPrivate::handleDirectoryCreated(const QString &path, const QString &name)
 {
+    directoryPaths.insert(normalizePath(path, name));
     handleFileCreated(path, name);
 }
 
 void FSEventCollectorPrivate::handleDirectoryDeleted(const QString &path, const QString &name)
 {
+    // The directory is gone, it can only be recognized by the event type
+    directoryPaths.insert(normalizePath(path, name));
     handleFileDeleted(path, name);
 }
 
 void FSEventCollectorPrivate::handleDirectoryMoved(const QString &fromPath, const QString &fromName,
                                                    const QString &toPath, const QString &toName)
 {
+    if (!fromPath.isEmpty())
+        directoryPaths.insert(normalizePath(fromPath, fromName));
+    if (!toPath.isEmpty())
+        directoryPaths.insert(normalizePath(toPath, toName));
     handleFileMoved(fromPath, fromName, toPath, toName);
 }
 
@@ -403,6 +408,7 @@ void FSEventCollectorPrivate::flushCollectedEvents()
     deletedFilesList.clear();
     modifiedFilesList.clear();
     movedFilesList.clear();
+    directoryPaths.clear();
 
     // Log statistics
     fmInfo() << "FSEventCollector: Flushing events - Created:" << created.size()
@@ -432,28 +438,17 @@ void FSEventCollectorPrivate::flushCollectedEvents()
 
 void FSEventCollectorPrivate::removeRedundantEntries(QSet<QString> &filesList)
 {
-    QSet<QString> directoryPaths;
-    QSet<QString> filePaths;
-
-    // First, separate directories from files
-    for (const QString &path : filesList) {
-        if (isDirectory(path)) {
-            directoryPaths.insert(path);
-        } else {
-            filePaths.insert(path);
-        }
-    }
-
-    // Remove any files that are under any of the directories
-    QSet<QString> redundantPaths;
-    for (const QString &filePath : filePaths) {
-        if (isChildOfAnyPath(filePath, directoryPaths)) {
-            redundantPaths.insert(filePath);
+    // A path whose ancestor is also in the list is covered by that directory,
+    // no need to know which entries are directories
+    QStringList redundantPaths;
+    for (const QString &path : std::as_const(filesList)) {
+        if (isChildOfAnyPath(path, filesList)) {
+            redundantPaths.append(path);
         }
     }
 
     // Remove redundant paths from the original list
-    for (const QString &path : redundantPaths) {
+    for (const QString &path : std::as_const(redundantPaths)) {
         filesList.remove(path);
         fmDebug() << "FSEventCollector: Removed redundant entry, parent directory exists in list:" << path;
     }
@@ -466,30 +461,21 @@ bool FSEventCollectorPrivate::isChildOfAnyPath(const QString &path, const QSet<Q
         return false;
     }
 
-    // For each potential parent directory in the set
-    for (const QString &potentialParent : pathSet) {
-        // Skip if the potential parent is not a directory
-        if (!isDirectory(potentialParent)) {
-            continue;
-        }
-
-        // Check if path starts with potentialParent + "/"
-        // First, normalize both paths to ensure consistent comparison
-        QString normalizedPath = QDir::cleanPath(path);
-        QString normalizedParent = QDir::cleanPath(potentialParent);
-
-        // Make sure the parent path ends with a separator
-        if (!normalizedParent.endsWith('/')) {
-            normalizedParent += '/';
-        }
-
-        // Path is a child if it starts with the parent path (including the trailing slash)
-        if (normalizedPath.startsWith(normalizedParent)) {
+    // Paths are already absolute and clean (see buildPath), so walk up the
+    // ancestors and look each one up, instead of comparing against every entry.
+    // Anything that has children is a directory, no need to stat it.
+    QString ancestor = path;
+    int pos = ancestor.lastIndexOf('/');
+    while (pos > 0) {
+        ancestor.truncate(pos);
+        if (pathSet.contains(ancestor)) {
             return true;
         }
+        pos = ancestor.lastIndexOf('/');
     }
 
-    return false;
+    // The root directory itself
+    return pos == 0 && path.size() > 1 && pathSet.contains(QStringLiteral("/"));
 }
 
 bool FSEventCollectorPrivate::isDirectory(const QString &path) const
@@ -508,23 +494,9 @@ void FSEventCollectorPrivate::cleanupRedundantEntries()
     // 1. Are under directories in the created list (creation supersedes modification)
     // 2. Are under directories in the deleted list (deletion supersedes modification)
 
-    // First, get all directory paths from created and deleted lists
-    QSet<QString> allDirectories;
-    for (const QString &path : std::as_const(createdFilesList)) {
-        if (isDirectory(path)) {
-            allDirectories.insert(path);
-        }
-    }
-    for (const QString &path : std::as_const(deletedFilesList)) {
-        if (isDirectory(path)) {
-            allDirectories.insert(path);
-        }
-    }
-
-    // Remove any modified files that are under these directories
     QSet<QString> redundantModified;
     for (const QString &modifiedPath : std::as_const(modifiedFilesList)) {
-        if (isChildOfAnyPath(modifiedPath, allDirectories)) {
+        if (isChildOfAnyPath(modifiedPath, createdFilesList) || isChildOfAnyPath(modifiedPath, deletedFilesList)) {
             redundantModified.insert(modifiedPath);
             fmDebug() << "FSEventCollector: Removed redundant modified entry, parent directory in created/deleted lists:" << modifiedPath;
         }
@@ -670,6 +642,7 @@ void FSEventCollector::clearEvents()
     d->deletedFilesList.clear();
     d->modifiedFilesList.clear();
     d->movedFilesList.clear();
+    d->directoryPaths.clear();
 
     fmInfo() << "FSEventCollector: Cleared all collected events";
 }
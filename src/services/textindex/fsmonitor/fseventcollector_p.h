@@ -61,7 +61,7 @@ public:
     // Remove redundant file entries that are under directories already in the list
     void removeRedundantEntries(QSet<QString> &filesList);
 
-    // Check if a path is a child of any path in the given set
+    // Check if any ancestor directory of a path is in the given set, O(path depth)
     bool isChildOfAnyPath(const QString &path, const QSet<QString> &pathSet) const;
 
     // Check if path is a directory
@@ -106,6 +106,10 @@ public:
 
     // New: Track moved/renamed files separately for efficient index updates
     QHash<QString, QString> movedFilesList;   // fromPath -> toPath mapping
+
+    // Paths reported by directory events in this collection period,
+    // saves a stat per path and still knows deleted directories
+    QSet<QString> directoryPaths;
 };
 
 SERVICETEXTINDEX_END_NAMESPACE
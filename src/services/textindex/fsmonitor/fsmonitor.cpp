@@ -22,6 +22,8 @@
 #include <QTimer>
 #include <QCoreApplication>
 
+#include <algorithm>
+
 DFMBASE_USE_NAMESPACE
 DCORE_USE_NAMESPACE
 
@@ -149,6 +151,13 @@ bool FSMonitorPrivate::startMonitoring()
     watchedDirectories.clear();
     resourceLimitReached = false;   // Reset resource limit flag
 
+    // A filesystem mark covers the whole tree, no directory crawl needed
+    if (useFanotify && startFanotify()) {
+        fmInfo() << "FSMonitor: Started monitoring with fanotify, marked filesystems:"
+                 << fanotifyWatcher->markCount();
+        return true;
+    }
+
     // Start worker thread
     if (!workerThread.isRunning()) {
         workerThread.start();
@@ -177,6 +186,9 @@ void FSMonitorPrivate::stopMonitoring()
 
     active = false;
 
+    // Closing the fanotify group removes all its marks
+    fanotifyWatcher.reset();
+
     // Clear all watched directories
     if (!watchedDirectories.isEmpty() && watcher) {
         watcher->removePaths(watchedDirectories.values());
@@ -199,6 +211,137 @@ void FSMonitorPrivate::travelRootDirectories()
     }
 }
 
+bool FSMonitorPrivate::startFanotify()
+{
+    QScopedPointer<FanotifyWatcher> fanotify(new FanotifyWatcher());
+    if (!fanotify->init()) {
+        return false;
+    }
+
+    // Either every filesystem is marked or inotify is used, never a partially watched tree
+    const QStringList mountPaths = fanotifyMountPaths();
+    for (const QString &path : mountPaths) {
+        if (!fanotify->addFilesystem(path)) {
+            fmInfo() << "FSMonitor: fanotify can't watch" << path << ", falling back to inotify";
+            return false;
+        }
+    }
+
+    QObject::connect(fanotify.data(), &FanotifyWatcher::created,
+                     q_ptr, [this](const QString &path, const QString &name, bool isDir) {
+                         if (!isFanotifyPathAccepted(path, name)) {
+                             return;
+                         }
+                         if (isDir) {
+                             Q_EMIT q_ptr->directoryCreated(path, name);
+                         } else {
+                             Q_EMIT q_ptr->fileCreated(path, name);
+                         }
+                     });
+
+    QObject::connect(fanotify.data(), &FanotifyWatcher::deleted,
+                     q_ptr, [this](const QString &path, const QString &name, bool isDir) {
+                         if (!isFanotifyPathAccepted(path, name)) {
+                             return;
+                         }
+                         if (isDir) {
+                             Q_EMIT q_ptr->directoryDeleted(path, name);
+                         } else {
+                             Q_EMIT q_ptr->fileDeleted(path, name);
+                         }
+                     });
+
+    QObject::connect(fanotify.data(), &FanotifyWatcher::modified,
+                     q_ptr, [this](const QString &path, const QString &name) {
+                         if (isFanotifyPathAccepted(path, name)) {
+                             Q_EMIT q_ptr->fileModified(path, name);
+                         }
+                     });
+
+    QObject::connect(fanotify.data(), &FanotifyWatcher::moved,
+                     q_ptr, [this](const QString &fromPath, const QString &fromName,
+                                   const QString &toPath, const QString &toName, bool isDir) {
+                         // An end outside the monitored tree is reported empty, like inotify does
+                         const bool fromAccepted = !fromPath.isEmpty() && isFanotifyPathAccepted(fromPath, fromName);
+                         const bool toAccepted = !toPath.isEmpty() && isFanotifyPathAccepted(toPath, toName);
+                         if (!fromAccepted && !toAccepted) {
+                             return;
+                         }
+
+                         const QString from = fromAccepted ? fromPath : QString();
+                         const QString fromFile = fromAccepted ? fromName : QString();
+                         const QString to = toAccepted ? toPath : QString();
+                         const QString toFile = toAccepted ? toName : QString();
+                         if (isDir) {
+                             Q_EMIT q_ptr->directoryMoved(from, fromFile, to, toFile);
+                         } else {
+                             Q_EMIT q_ptr->fileMoved(from, fromFile, to, toFile);
+                         }
+                     });
+
+    QObject::connect(fanotify.data(), &FanotifyWatcher::overflowed,
+                     q_ptr, [this]() {
+                         fmWarning() << "FSMonitor: fanotify event queue overflowed, some events were lost";
+                         Q_EMIT q_ptr->errorOccurred(QStringLiteral("fanotify event queue overflowed"));
+                     });
+
+    fanotifyWatcher.swap(fanotify);
+    return true;
+}
+
+QStringList FSMonitorPrivate::fanotifyMountPaths() const
+{
+    QStringList paths = rootPaths;
+
+    // Local filesystems mounted below a root are not covered by the root's mark
+    const auto volumes = QStorageInfo::mountedVolumes();
+    for (const QStorageInfo &storage : volumes) {
+        const QString mountPoint = storage.rootPath();
+        if (paths.contains(mountPoint)) {
+            continue;
+        }
+
+        const bool underRoot = std::any_of(rootPaths.cbegin(), rootPaths.cend(), [&mountPoint](const QString &root) {
+            return mountPoint.startsWith(root.endsWith('/') ? root : root + '/');
+        });
+        if (underRoot && !shouldExcludePath(mountPoint)) {
+            paths.append(mountPoint);
+        }
+    }
+
+    return paths;
+}
+
+bool FSMonitorPrivate::isFanotifyPathAccepted(const QString &path, const QString &name) const
+{
+    if (path.isEmpty() || name.isEmpty()) {
+        return false;
+    }
+
+    // The mark covers the whole filesystem, only keep events inside the roots
+    const bool underRoot = std::any_of(rootPaths.cbegin(), rootPaths.cend(), [&path](const QString &root) {
+        return path == root || path.startsWith(root.endsWith('/') ? root : root + '/');
+    });
+    if (!underRoot) {
+        return false;
+    }
+
+    const QString fullPath = path.endsWith('/') ? path + name : path + '/' + name;
+
+    // inotify never watches hidden or blacklisted directories, so skip their whole subtree here
+    if (!showHidden() && (name.startsWith('.') || DFMSEARCH::Global::isHiddenPathOrInHiddenDir(fullPath))) {
+        return false;
+    }
+
+    for (const QString &blackPath : blacklistedPaths) {
+        if (fullPath.contains(blackPath)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void FSMonitorPrivate::setupWorkerThread()
 {
     // Create worker and move to thread
@@ -745,6 +888,9 @@ double FSMonitor::maxResourceUsage() const
 int FSMonitor::currentWatchCount() const
 {
     Q_D(const FSMonitor);
+    if (d->fanotifyWatcher) {
+        return d->fanotifyWatcher->markCount();
+    }
     return d->watchedDirectories.size();
 }
 
@@ -772,4 +918,22 @@ bool FSMonitor::useFastScan() const
     return d->useFastScan;
 }
 
+void FSMonitor::setUseFanotify(bool enable)
+{
+    Q_D(FSMonitor);
+
+    if (d->active) {
+        fmWarning() << "FSMonitor: Cannot change fanotify setting while monitor is active";
+        return;
+    }
+
+    d->useFanotify = enable;
+}
+
+bool FSMonitor::useFanotify() const
+{
+    Q_D(const FSMonitor);
+    return d->useFanotify;
+}
+
 SERVICETEXTINDEX_END_NAMESPACE
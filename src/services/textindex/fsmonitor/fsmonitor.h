@@ -24,11 +24,12 @@ SERVICETEXTINDEX_BEGIN_NAMESPACE
 
 class FSMonitorPrivate;
 
-// FSMonitor: A recursive file system monitor based on DFileSystemWatcher
+// FSMonitor: A recursive file system monitor based on fanotify or DFileSystemWatcher
 // Monitors user's home directory and handles file/directory events for indexing
 //
 // Features:
-// - Recursively watches directories
+// - Uses a fanotify filesystem mark when permitted, no crawl and no watch limit
+// - Otherwise recursively watches directories with inotify
 // - Manages system resource usage by limiting watch count
 // - Excludes blacklisted, system, external, and network mounts automatically
 // - Skips symbolic links to prevent circular watch issues
@@ -85,6 +86,12 @@ public:
     // Check if fast scanning is enabled
     bool useFastScan() const;
 
+    // Enable or disable the fanotify backend (must be called before start)
+    void setUseFanotify(bool enable);
+
+    // Check if the fanotify backend is enabled
+    bool useFanotify() const;
+
 Q_SIGNALS:
     // Emitted when a file is created
     void fileCreated(const QString &path, const QString &name);
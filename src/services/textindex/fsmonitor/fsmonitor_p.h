@@ -7,6 +7,7 @@
 
 #include "fsmonitor.h"
 #include "fsmonitorworker.h"
+#include "fanotifywatcher.h"
 
 #include <QFileInfo>
 #include <QSet>
@@ -40,6 +41,15 @@ public:
     // Process the root directories using traditional method
     void travelRootDirectories();
 
+    // Try the fanotify backend, one mark per filesystem instead of one watch per directory
+    bool startFanotify();
+
+    // Paths whose filesystems need a fanotify mark: the roots and local mounts below them
+    QStringList fanotifyMountPaths() const;
+
+    // Check if a fanotify event is inside the roots and not excluded
+    bool isFanotifyPathAccepted(const QString &path, const QString &name) const;
+
     // Get the maximum number of watches supported by the system
     int getMaxUserWatches() const;
 
@@ -98,10 +108,16 @@ public:
     // Fast scan control
     bool useFastScan { true };   // Whether to try fast scan first
 
+    // Backend control
+    bool useFanotify { true };   // Whether to try fanotify before inotify
+
     // Data members
     FSMonitor *q_ptr;
     QScopedPointer<Dtk::Core::DFileSystemWatcher> watcher;
 
+    // fanotify backend, null while the inotify watcher is in use
+    QScopedPointer<FanotifyWatcher> fanotifyWatcher;
+
     // Worker thread members
     QThread workerThread;
     FSMonitorWorker *worker { nullptr };